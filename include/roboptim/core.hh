@@ -28,6 +28,11 @@
 
 // Main headers.
 # include <roboptim/core/result-with-warnings.hh>
+# include <roboptim/core/async-solver.hh>
+# include <roboptim/core/augmented-lagrangian.hh>
+# include <roboptim/core/auto-scaling.hh>
+# include <roboptim/core/binary-log.hh>
+# include <roboptim/core/constraint-block.hh>
 # include <roboptim/core/derivable-function.hh>
 # include <roboptim/core/derivable-parametrized-function.hh>
 # include <roboptim/core/finite-difference-gradient.hh>
@@ -37,13 +42,17 @@
 # include <roboptim/core/function/identity.hh>
 # include <roboptim/core/indent.hh>
 # include <roboptim/core/linear-function.hh>
+# include <roboptim/core/multi-start.hh>
 # include <roboptim/core/n-times-derivable-function.hh>
 # include <roboptim/core/numeric-linear-function.hh>
 # include <roboptim/core/numeric-quadratic-function.hh>
 # include <roboptim/core/parametrized-function.hh>
+# include <roboptim/core/portfolio.hh>
+# include <roboptim/core/presolve.hh>
 # include <roboptim/core/problem.hh>
 # include <roboptim/core/quadratic-function.hh>
 # include <roboptim/core/result.hh>
+# include <roboptim/core/sampling.hh>
 # include <roboptim/core/solver-error.hh>
 # include <roboptim/core/solver-factory.hh>
 # include <roboptim/core/solver-warning.hh>
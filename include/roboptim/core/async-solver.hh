@@ -0,0 +1,243 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_ASYNC_SOLVER_HH
+# define ROBOPTIM_CORE_ASYNC_SOLVER_HH
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+
+# include <stdexcept>
+# include <string>
+
+# include <boost/date_time/posix_time/posix_time_types.hpp>
+# include <boost/noncopyable.hpp>
+# include <boost/optional.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/future.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/thread.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/generic-solver.hh>
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Cooperative cancellation request.
+  ///
+  /// Copies of a token share the same state: cancelling one copy
+  /// cancels all the operations using any of them.
+  class ROBOPTIM_DLLAPI CancellationToken
+  {
+  public:
+    /// \brief Create a new (not cancelled) token.
+    CancellationToken ();
+
+    /// \brief Cancel the operations using this token.
+    void cancel () throw ();
+
+    /// \brief Whether the token has been cancelled.
+    bool cancelled () const throw ();
+
+  private:
+    template <typename S>
+    friend class AsyncSolver;
+
+    /// \brief State shared by the copies.
+    struct State
+    {
+      State ();
+
+      /// \brief Protect the state (and the operations using it).
+      boost::mutex mutex;
+      /// \brief Notified on cancellation (and by the operations).
+      boost::condition_variable changed;
+      /// \brief Whether the token has been cancelled.
+      bool cancelled;
+    };
+
+    /// \brief Shared state.
+    boost::shared_ptr<State> state_;
+  };
+
+  /// \brief Run a solver in the background.
+  ///
+  /// solve starts the optimization on its own thread and returns a
+  /// future of the solver result at once.
+  ///
+  /// The optimization can be interrupted by a cancellation token or
+  /// by a deadline. Both are checked from the solver iteration
+  /// callback, which then asks the solver to stop (see
+  /// SolverState::requestStop). The result of an interrupted solver
+  /// is:
+  /// - a ResultWithWarnings, if the solver returned a result (the
+  ///   warning gives the reason of the interruption),
+  /// - a SolverError otherwise, whose last state is the best point
+  ///   seen by the iteration callback (lowest cost, or last iterate
+  ///   if the solver does not provide the cost).
+  ///
+  /// As the interruption is cooperative, a watchdog also makes the
+  /// future ready (with such a SolverError) once the solver is
+  /// cancelled or past its deadline (plus a grace period, zero by
+  /// default), even if the solver ignores the stop request or does
+  /// not support iteration callbacks. The solver then runs to
+  /// completion in the background and its result is dropped.
+  ///
+  /// The solver is used from another thread: it must not be used
+  /// while running, and must outlive the AsyncSolver.
+  ///
+  /// \tparam S solver type
+  template <typename S>
+  class AsyncSolver : public boost::noncopyable
+  {
+  public:
+    /// \brief Solver type.
+    typedef S solver_t;
+    /// \brief Problem type.
+    typedef typename solver_t::problem_t problem_t;
+    /// \brief Import vector type.
+    typedef typename problem_t::vector_t vector_t;
+    /// \brief Import value type.
+    typedef typename problem_t::value_type value_type;
+    /// \brief Solver result type.
+    typedef GenericSolver::result_t result_t;
+    /// \brief Solver state type.
+    typedef typename solver_t::solverState_t solverState_t;
+    /// \brief Iteration callback type.
+    typedef typename solver_t::callback_t callback_t;
+    /// \brief Future solver result.
+    typedef boost::shared_future<result_t> future_t;
+    /// \brief Duration type.
+    typedef boost::posix_time::time_duration duration_t;
+
+    /// \brief Wrap a solver.
+    ///
+    /// The iteration callback of the solver is replaced (see
+    /// setIterationCallback).
+    explicit AsyncSolver (solver_t& solver) throw ();
+
+    /// \brief Interrupt and wait for the solver.
+    ~AsyncSolver () throw ();
+
+    /// \brief Wrapped solver.
+    solver_t& solver () throw ()
+    {
+      return solver_;
+    }
+
+    /// \brief Set the iteration callback, called before the
+    /// interruption checks.
+    void setIterationCallback (const callback_t& callback) throw ();
+
+    /// \brief Set the time left to the solver to return after an
+    /// interruption, before the watchdog makes the future ready.
+    void setGracePeriod (const duration_t& grace) throw ();
+
+    /// \brief Whether the solver supports iteration callbacks (and
+    /// so cooperative interruptions).
+    bool interruptible () const throw ()
+    {
+      return interruptible_;
+    }
+
+    /// \brief Start the optimization.
+    ///
+    /// \param token cancellation token
+    /// \param timeout wall-clock time budget (unlimited by default)
+    /// \return future solver result
+    future_t solve (const CancellationToken& token = CancellationToken (),
+		    const duration_t& timeout = boost::posix_time::pos_infin)
+      throw (std::runtime_error);
+
+    /// \brief Whether the solver is still running.
+    ///
+    /// The solver may keep running after the future is ready, if it
+    /// has been interrupted by the watchdog.
+    bool running () const throw ();
+
+    /// \brief Wait for the solver to return.
+    void wait () throw ();
+
+  private:
+    /// \brief Solver thread main function.
+    void run ();
+
+    /// \brief Watchdog thread main function.
+    void watch ();
+
+    /// \brief Iteration callback: track the best point and check
+    /// the interruptions.
+    void callback (const problem_t& problem, solverState_t& state);
+
+    /// \brief Reason of the interruption, or an empty string.
+    ///
+    /// The token mutex must be locked.
+    std::string interruption () const;
+
+    /// \brief Result of an interrupted solver.
+    ///
+    /// \param result solver result, or null if the solver is still
+    /// running
+    result_t interrupted (const result_t* result) const;
+
+    /// \brief Make the future ready. The token mutex must be locked.
+    void fulfill (const result_t& result);
+
+    /// \brief Wrapped solver.
+    solver_t& solver_;
+    /// \brief User iteration callback.
+    callback_t callback_;
+    /// \brief Whether the solver supports iteration callbacks.
+    bool interruptible_;
+    /// \brief Grace period after an interruption.
+    duration_t grace_;
+
+    /// \brief Cancellation token of the current optimization.
+    CancellationToken token_;
+    /// \brief Deadline of the current optimization.
+    boost::posix_time::ptime deadline_;
+    /// \brief Promise of the current optimization.
+    boost::shared_ptr<boost::promise<result_t> > promise_;
+    /// \brief Whether the solver returned.
+    bool done_;
+    /// \brief Whether the future is ready.
+    bool fulfilled_;
+    /// \brief Whether the wrapper is destroyed.
+    bool abandoned_;
+    /// \brief Reason of the interruption.
+    std::string reason_;
+    /// \brief Best point seen by the iteration callback.
+    boost::optional<vector_t> bestX_;
+    /// \brief Cost of the best point.
+    boost::optional<value_type> bestCost_;
+
+    /// \brief Solver thread.
+    boost::shared_ptr<boost::thread> solverThread_;
+    /// \brief Watchdog thread.
+    boost::shared_ptr<boost::thread> watchdogThread_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/async-solver.hxx>
+#endif //! ROBOPTIM_CORE_ASYNC_SOLVER_HH
@@ -0,0 +1,279 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_ASYNC_SOLVER_HXX
+# define ROBOPTIM_CORE_ASYNC_SOLVER_HXX
+# include <limits>
+
+# include <boost/bind.hpp>
+# include <boost/date_time/posix_time/posix_time.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/variant/get.hpp>
+
+# include <roboptim/core/result-with-warnings.hh>
+# include <roboptim/core/solver-error.hh>
+# include <roboptim/core/solver-warning.hh>
+
+namespace roboptim
+{
+  template <typename S>
+  AsyncSolver<S>::AsyncSolver (solver_t& solver) throw ()
+    : solver_ (solver),
+      callback_ (),
+      interruptible_ (true),
+      grace_ (boost::posix_time::seconds (0)),
+      token_ (),
+      deadline_ (boost::posix_time::pos_infin),
+      promise_ (),
+      done_ (true),
+      fulfilled_ (true),
+      abandoned_ (false),
+      reason_ (),
+      bestX_ (),
+      bestCost_ (),
+      solverThread_ (),
+      watchdogThread_ ()
+  {
+    try
+      {
+	solver_.setIterationCallback
+	  (boost::bind (&AsyncSolver<S>::callback, this, _1, _2));
+      }
+    catch (const std::runtime_error&)
+      {
+	// Only the watchdog can interrupt this solver.
+	interruptible_ = false;
+      }
+  }
+
+  template <typename S>
+  AsyncSolver<S>::~AsyncSolver () throw ()
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (token_.state_->mutex);
+      abandoned_ = true;
+    }
+    token_.state_->changed.notify_all ();
+    wait ();
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::setIterationCallback (const callback_t& callback) throw ()
+  {
+    callback_ = callback;
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::setGracePeriod (const duration_t& grace) throw ()
+  {
+    grace_ = grace;
+  }
+
+  template <typename S>
+  std::string
+  AsyncSolver<S>::interruption () const
+  {
+    if (abandoned_ || token_.state_->cancelled)
+      return "cancelled";
+    if (!deadline_.is_special ()
+	&& boost::posix_time::microsec_clock::universal_time () >= deadline_)
+      return "deadline exceeded";
+    return std::string ();
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::callback (const problem_t& problem, solverState_t& state)
+  {
+    if (callback_)
+      callback_ (problem, state);
+
+    boost::unique_lock<boost::mutex> lock (token_.state_->mutex);
+    if (state.cost ())
+      {
+	if (!bestCost_ || *state.cost () < *bestCost_)
+	  {
+	    bestCost_ = *state.cost ();
+	    bestX_ = state.x ();
+	  }
+      }
+    else if (!bestCost_)
+      bestX_ = state.x ();
+
+    if (reason_.empty ())
+      reason_ = interruption ();
+    if (!reason_.empty ())
+      state.requestStop ();
+  }
+
+  template <typename S>
+  typename AsyncSolver<S>::result_t
+  AsyncSolver<S>::interrupted (const result_t* result) const
+  {
+    const std::string message = "optimization interrupted: " + reason_;
+
+    // The solver returned a (partial) result: keep it.
+    if (result)
+      if (const Result* solution = detail::solution (*result))
+	{
+	  ResultWithWarnings partial (solution->inputSize,
+				      solution->outputSize);
+	  static_cast<Result&> (partial) = *solution;
+	  if (result->which () == GenericSolver::SOLVER_VALUE_WARNINGS)
+	    partial.warnings = boost::get<ResultWithWarnings> (*result).warnings;
+	  partial.warnings.push_back (SolverWarning (message));
+	  return partial;
+	}
+
+    // Otherwise, report the best point seen so far.
+    SolverError error (message);
+    if (result && result->which () == GenericSolver::SOLVER_ERROR
+	&& boost::get<SolverError> (*result).lastState ())
+      error.lastState () = boost::get<SolverError> (*result).lastState ();
+    else if (bestX_)
+      {
+	Result last (solver_.problem ().function ().inputSize (),
+		     solver_.problem ().function ().outputSize ());
+	last.x = *bestX_;
+	last.value.setConstant
+	  (bestCost_
+	   ? *bestCost_ : std::numeric_limits<value_type>::quiet_NaN ());
+	error.lastState () = last;
+      }
+    return error;
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::fulfill (const result_t& result)
+  {
+    promise_->set_value (result);
+    fulfilled_ = true;
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::run ()
+  {
+    result_t result = NoSolution ();
+    try
+      {
+	solver_.reset ();
+	result = solver_.minimum ();
+      }
+    catch (const std::exception& e)
+      {
+	result = SolverError (e.what ());
+      }
+
+    boost::unique_lock<boost::mutex> lock (token_.state_->mutex);
+    done_ = true;
+    if (!fulfilled_)
+      fulfill (reason_.empty () ? result : interrupted (&result));
+    token_.state_->changed.notify_all ();
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::watch ()
+  {
+    using boost::posix_time::ptime;
+
+    boost::unique_lock<boost::mutex> lock (token_.state_->mutex);
+    ptime giveUp (boost::posix_time::pos_infin);
+    while (!done_)
+      {
+	const ptime now = boost::posix_time::microsec_clock::universal_time ();
+	if (giveUp.is_special ())
+	  {
+	    if (reason_.empty ())
+	      reason_ = interruption ();
+	    if (!reason_.empty ())
+	      giveUp = now + grace_;
+	  }
+
+	// The solver did not return in time: drop it.
+	if (!giveUp.is_special () && now >= giveUp)
+	  {
+	    if (!fulfilled_)
+	      fulfill (interrupted (0));
+	    return;
+	  }
+
+	const ptime wakeUp = giveUp.is_special () ? deadline_ : giveUp;
+	if (wakeUp.is_special ())
+	  token_.state_->changed.wait (lock);
+	else
+	  token_.state_->changed.timed_wait (lock, wakeUp);
+      }
+  }
+
+  template <typename S>
+  typename AsyncSolver<S>::future_t
+  AsyncSolver<S>::solve (const CancellationToken& token,
+			 const duration_t& timeout)
+    throw (std::runtime_error)
+  {
+    if (running ())
+      throw std::runtime_error ("asynchronous solver is already running");
+    wait ();
+
+    token_ = token;
+    deadline_ = timeout.is_pos_infinity ()
+      ? boost::posix_time::ptime (boost::posix_time::pos_infin)
+      : boost::posix_time::microsec_clock::universal_time () + timeout;
+    promise_ = boost::make_shared<boost::promise<result_t> > ();
+    done_ = false;
+    fulfilled_ = false;
+    reason_.clear ();
+    bestX_ = solver_.problem ().startingPoint ();
+    bestCost_.reset ();
+
+    future_t future (promise_->get_future ());
+    solverThread_ = boost::make_shared<boost::thread>
+      (boost::bind (&AsyncSolver<S>::run, this));
+    watchdogThread_ = boost::make_shared<boost::thread>
+      (boost::bind (&AsyncSolver<S>::watch, this));
+    return future;
+  }
+
+  template <typename S>
+  bool
+  AsyncSolver<S>::running () const throw ()
+  {
+    if (!solverThread_)
+      return false;
+    boost::unique_lock<boost::mutex> lock (token_.state_->mutex);
+    return !done_;
+  }
+
+  template <typename S>
+  void
+  AsyncSolver<S>::wait () throw ()
+  {
+    if (solverThread_)
+      solverThread_->join ();
+    if (watchdogThread_)
+      watchdogThread_->join ();
+    solverThread_.reset ();
+    watchdogThread_.reset ();
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_ASYNC_SOLVER_HXX
@@ -0,0 +1,319 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HH
+# define ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HH
+# include <stdexcept>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include <boost/scoped_ptr.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/numeric-linear-function.hh>
+# include <roboptim/core/parameter-handle.hh>
+# include <roboptim/core/solver.hh>
+# include <roboptim/core/solver-factory.hh>
+# include <roboptim/core/solver-state.hh>
+# include <roboptim/core/filter/chain.hh>
+# include <roboptim/core/filter/plus.hh>
+# include <roboptim/core/filter/product.hh>
+# include <roboptim/core/filter/scalar.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Shifted constraints violation of an augmented Lagrangian.
+  ///
+  /// The constraints g (x) in [l, u] are stacked. Given the
+  /// multipliers lambda and the penalty rho, each row is:
+  ///
+  /// \f[ r_i (x) = \sqrt{\rho} (v_i - P_i (v_i)),
+  ///     \quad v = g (x) + \frac{\lambda}{\rho} \f]
+  ///
+  /// where P_i is the projection on [l_i, u_i]. Half the squared
+  /// norm of r is the penalty term of the Powell-Hestenes-Rockafellar
+  /// augmented Lagrangian; it is continuously differentiable.
+  ///
+  /// Changing the multipliers, the penalty or the bounds changes the
+  /// version of the residual: filters caching its evaluations
+  /// (e.g. Chain) evaluate it again.
+  class ROBOPTIM_DLLAPI AugmentedLagrangianResidual
+    : public DifferentiableFunction
+  {
+  public:
+    /// \brief Constraint type.
+    typedef boost::shared_ptr<const DifferentiableFunction> constraint_t;
+    /// \brief Constraints vector type.
+    typedef std::vector<constraint_t> constraints_t;
+    /// \brief Bounds of each constraint.
+    typedef std::vector<intervals_t> bounds_t;
+
+    /// \brief Build the residual of some constraints.
+    ///
+    /// \param inputSize input size of the constraints
+    /// \param constraints constraints functions
+    /// \param bounds bounds of each constraint
+    /// \throw std::runtime_error if the sizes do not match
+    AugmentedLagrangianResidual (size_type inputSize,
+				 const constraints_t& constraints,
+				 const bounds_t& bounds)
+      throw (std::runtime_error);
+
+    ~AugmentedLagrangianResidual () throw ();
+
+    std::size_t version () const throw ();
+
+    /// \brief Lower bounds of the stacked constraints.
+    const vector_t& lower () const throw ()
+    {
+      return lower_;
+    }
+
+    /// \brief Upper bounds of the stacked constraints.
+    const vector_t& upper () const throw ()
+    {
+      return upper_;
+    }
+
+    /// \brief Multipliers estimate.
+    const vector_t& multipliers () const throw ()
+    {
+      return multipliers_;
+    }
+
+    /// \brief Set the multipliers estimate.
+    void setMultipliers (const vector_t& multipliers)
+      throw (std::runtime_error);
+
+    /// \brief Set the bounds of the stacked constraints.
+    void setBounds (const vector_t& lower, const vector_t& upper)
+      throw (std::runtime_error);
+
+    /// \brief Penalty parameter.
+    value_type penalty () const throw ()
+    {
+      return penalty_;
+    }
+
+    /// \brief Set the penalty parameter (positive).
+    void setPenalty (value_type penalty) throw (std::runtime_error);
+
+    /// \brief Evaluate the stacked constraints.
+    void constraints (result_ref result, const argument_t& x) const throw ();
+
+  protected:
+    void impl_compute (result_ref result, const argument_t& x)
+      const throw ();
+    void impl_gradient (gradient_t& gradient, const argument_t& x,
+			size_type functionId = 0)
+      const throw ();
+    void impl_jacobian (jacobian_ref jacobian, const argument_t& x)
+      const throw ();
+
+  private:
+    /// \brief Whether a shifted constraint is outside its bounds.
+    bool outside (size_type row, value_type value) const throw ();
+
+    /// \brief Constraints.
+    constraints_t constraints_;
+    /// \brief Constraint and row of the constraint of each row.
+    std::vector<std::pair<std::size_t, size_type> > rows_;
+    /// \brief First row of each constraint.
+    std::vector<size_type> offsets_;
+    /// \brief Lower bounds.
+    vector_t lower_;
+    /// \brief Upper bounds.
+    vector_t upper_;
+    /// \brief Multipliers.
+    vector_t multipliers_;
+    /// \brief Penalty.
+    value_type penalty_;
+  };
+
+  /// \brief Augmented Lagrangian solver.
+  ///
+  /// Solve a constrained problem through a sequence of
+  /// bound-constrained subproblems, each one solved by a plug-in
+  /// (i.e. the built-in lbfgsb plug-in). The cost of the subproblems
+  /// is built with filters:
+  ///
+  /// \f[ L (x) = f (x) + \frac{1}{2} \sum_i r_i (x)^2 \f]
+  ///
+  /// where r is an AugmentedLagrangianResidual. Between two outer
+  /// iterations, the multipliers are updated and the penalty is
+  /// increased if the constraints violation did not decrease enough.
+  /// The subproblem cost and the sub-solver are built once: the
+  /// multipliers and the penalty are updated in place and each
+  /// subproblem is warm started from the previous subproblem result.
+  /// The next solves rebind the sub-solver to the problem data (the
+  /// sub-solver is only reloaded if its name changes).
+  ///
+  /// The following parameters are available:
+  /// - augmented-lagrangian.solver (string): sub-solver plug-in,
+  /// - augmented-lagrangian.max-iterations (int): maximum number of
+  ///   outer iterations,
+  /// - augmented-lagrangian.tolerance (double): tolerance on the
+  ///   constraints violation and complementarity,
+  /// - augmented-lagrangian.penalty (double): initial penalty,
+  /// - augmented-lagrangian.penalty-factor (double): penalty increase
+  ///   factor,
+  /// - augmented-lagrangian.max-penalty (double): largest penalty.
+  /// .
+  /// The other parameters are given to the sub-solver.
+  ///
+  /// The result multipliers lambda are such that the gradient of
+  /// f + lambda . g vanishes at a bound-constrained stationary
+  /// point. A warm-started solve starts from the multipliers of the
+  /// warm start result and from the last penalty.
+  ///
+  /// The iteration callback is called after each outer iteration.
+  ///
+  /// \pre the cost function type is DifferentiableFunction and the
+  /// constraints are differentiable functions (constraints scales
+  /// are ignored).
+  ///
+  /// \tparam S solver type of the problem and of the sub-solver
+  template <typename S>
+  class AugmentedLagrangianSolver : public S
+  {
+  public:
+    /// \brief Parent type.
+    typedef S parent_t;
+    /// \brief Solver type.
+    typedef S solver_t;
+    /// \brief Import problem type.
+    typedef typename solver_t::problem_t problem_t;
+    /// \brief Import cost function type.
+    typedef typename problem_t::function_t function_t;
+    /// \brief Import vector type.
+    typedef typename solver_t::vector_t vector_t;
+    /// \brief Import value type.
+    typedef typename function_t::value_type value_type;
+    /// \brief Import size type.
+    typedef typename function_t::size_type size_type;
+    /// \brief Import callback type.
+    typedef typename solver_t::callback_t callback_t;
+    /// \brief Import solver state type.
+    typedef typename solver_t::solverState_t solverState_t;
+
+    /// \brief Residual type.
+    typedef AugmentedLagrangianResidual residual_t;
+    /// \brief Squared residuals.
+    typedef Product<DifferentiableFunction, DifferentiableFunction>
+    squares_t;
+    /// \brief Sum of the squared residuals.
+    typedef Chain<NumericLinearFunction, squares_t> sum_t;
+    /// \brief Penalty term.
+    typedef Scalar<sum_t> penalty_t;
+    /// \brief Subproblem cost.
+    typedef Plus<function_t, penalty_t> cost_t;
+
+    /// \brief Build the solver.
+    ///
+    /// \param problem constrained problem
+    /// \param solver default sub-solver plug-in
+    explicit AugmentedLagrangianSolver (const problem_t& problem,
+					const std::string& solver = "lbfgsb")
+      throw ();
+
+    virtual ~AugmentedLagrangianSolver () throw ();
+
+    /// \brief Solve the problem.
+    virtual void solve () throw ();
+
+    /// \brief Set the per-iteration callback (called after each
+    /// outer iteration).
+    virtual void setIterationCallback (callback_t callback)
+      throw (std::runtime_error);
+
+    /// \brief Number of outer iterations of the last solve.
+    int outerIterations () const throw ()
+    {
+      return outerIterations_;
+    }
+
+    /// \brief Penalty reached by the last solve.
+    value_type lastPenalty () const throw ()
+    {
+      return lastPenalty_;
+    }
+
+  private:
+    /// \brief Resolve the parameters handles.
+    void resolveParameters ();
+
+    /// \brief Build the subproblem cost and the sub-solver, or
+    /// rebind them to the problem data.
+    ///
+    /// \param x starting point
+    /// \throw std::runtime_error if the sub-solver cannot be loaded
+    void prepare (const vector_t& x);
+
+    /// \brief Set the multipliers and the penalty of the subproblem
+    /// cost.
+    void updateCost (const vector_t& multipliers, value_type penalty);
+
+    /// \brief Sub-solver plug-in name.
+    ParameterHandle<std::string, Parameter> solverName_;
+    /// \brief Maximum number of outer iterations.
+    ParameterHandle<int, Parameter> maxIterations_;
+    /// \brief Tolerance on the violation and complementarity.
+    ParameterHandle<value_type, Parameter> tolerance_;
+    /// \brief Initial penalty.
+    ParameterHandle<value_type, Parameter> penalty_;
+    /// \brief Penalty increase factor.
+    ParameterHandle<value_type, Parameter> penaltyFactor_;
+    /// \brief Largest penalty.
+    ParameterHandle<value_type, Parameter> maxPenalty_;
+
+    /// \brief Per-iteration callback.
+    callback_t callback_;
+    /// \brief State given to the callback.
+    solverState_t state_;
+
+    /// \brief Residual of the subproblem cost.
+    boost::shared_ptr<residual_t> residual_;
+    /// \brief Sum of the squared residuals (caches the residual).
+    boost::shared_ptr<sum_t> sum_;
+    /// \brief Subproblem cost.
+    boost::shared_ptr<cost_t> cost_;
+    /// \brief Subproblem.
+    boost::scoped_ptr<problem_t> subproblem_;
+    /// \brief Sub-solver factory.
+    boost::scoped_ptr<SolverFactory<solver_t> > factory_;
+    /// \brief Plug-in name of the sub-solver factory.
+    std::string factoryName_;
+
+    /// \brief Number of outer iterations of the last solve.
+    int outerIterations_;
+    /// \brief Penalty reached by the last solve (negative before the
+    /// first solve).
+    value_type lastPenalty_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/augmented-lagrangian.hxx>
+#endif //! ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HH
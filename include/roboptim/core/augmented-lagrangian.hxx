@@ -0,0 +1,377 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HXX
+# define ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HXX
+# include <algorithm>
+# include <exception>
+# include <limits>
+
+# include <boost/foreach.hpp>
+# include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/scoped_ptr.hpp>
+# include <boost/static_assert.hpp>
+# include <boost/type_traits/is_base_of.hpp>
+# include <boost/variant/apply_visitor.hpp>
+# include <boost/variant/get.hpp>
+# include <boost/variant/static_visitor.hpp>
+
+# include <roboptim/core/result-with-warnings.hh>
+# include <roboptim/core/solver-error.hh>
+# include <roboptim/core/solver-factory.hh>
+# include <roboptim/core/solver-warning.hh>
+# include <roboptim/core/util.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Get a constraint as a differentiable function.
+    struct AsDifferentiableFunction
+      : public boost::static_visitor<AugmentedLagrangianResidual::constraint_t>
+    {
+      template <typename U>
+      AugmentedLagrangianResidual::constraint_t
+      operator () (const boost::shared_ptr<U>& constraint) const
+      {
+	return constraint;
+      }
+    };
+  } // end of namespace detail.
+
+  template <typename S>
+  AugmentedLagrangianSolver<S>::AugmentedLagrangianSolver
+  (const problem_t& pb, const std::string& solver) throw ()
+    : parent_t (pb),
+      solverName_ (),
+      maxIterations_ (),
+      tolerance_ (),
+      penalty_ (),
+      penaltyFactor_ (),
+      maxPenalty_ (),
+      callback_ (),
+      state_ (this->problem_),
+      residual_ (),
+      sum_ (),
+      cost_ (),
+      subproblem_ (),
+      factory_ (),
+      factoryName_ (),
+      outerIterations_ (0),
+      lastPenalty_ (-1.)
+  {
+    solverName_ = this->registerParameter
+      ("augmented-lagrangian.solver", "sub-solver plug-in", solver);
+    maxIterations_ = this->registerParameter
+      ("augmented-lagrangian.max-iterations",
+       "maximum number of outer iterations", 50);
+    tolerance_ = this->registerParameter
+      ("augmented-lagrangian.tolerance",
+       "tolerance on the constraints violation and complementarity",
+       value_type (1e-6));
+    penalty_ = this->registerParameter
+      ("augmented-lagrangian.penalty", "initial penalty", value_type (10.));
+    penaltyFactor_ = this->registerParameter
+      ("augmented-lagrangian.penalty-factor", "penalty increase factor",
+       value_type (10.));
+    maxPenalty_ = this->registerParameter
+      ("augmented-lagrangian.max-penalty", "largest penalty",
+       value_type (1e10));
+  }
+
+  template <typename S>
+  AugmentedLagrangianSolver<S>::~AugmentedLagrangianSolver () throw ()
+  {
+  }
+
+  template <typename S>
+  void
+  AugmentedLagrangianSolver<S>::setIterationCallback (callback_t callback)
+    throw (std::runtime_error)
+  {
+    callback_ = callback;
+  }
+
+  template <typename S>
+  void
+  AugmentedLagrangianSolver<S>::resolveParameters ()
+  {
+    solverName_ =
+      this->template parameterHandle<std::string>
+      ("augmented-lagrangian.solver");
+    maxIterations_ =
+      this->template parameterHandle<int>
+      ("augmented-lagrangian.max-iterations");
+    tolerance_ =
+      this->template parameterHandle<value_type>
+      ("augmented-lagrangian.tolerance");
+    penalty_ =
+      this->template parameterHandle<value_type>
+      ("augmented-lagrangian.penalty");
+    penaltyFactor_ =
+      this->template parameterHandle<value_type>
+      ("augmented-lagrangian.penalty-factor");
+    maxPenalty_ =
+      this->template parameterHandle<value_type>
+      ("augmented-lagrangian.max-penalty");
+  }
+
+  template <typename S>
+  void
+  AugmentedLagrangianSolver<S>::prepare (const vector_t& x)
+  {
+    const problem_t& pb = this->problem ();
+    const function_t& f = pb.function ();
+
+    if (!cost_)
+      {
+	residual_t::constraints_t constraints;
+	for (std::size_t i = 0; i < pb.constraints ().size (); ++i)
+	  constraints.push_back
+	    (boost::apply_visitor (detail::AsDifferentiableFunction (),
+				   pb.constraints ()[i]));
+	residual_ = boost::make_shared<residual_t>
+	  (f.inputSize (), constraints, pb.boundsVector ());
+
+	NumericLinearFunction::matrix_t ones (1, residual_->outputSize ());
+	ones.setOnes ();
+	NumericLinearFunction::vector_t zero (1);
+	zero.setZero ();
+	sum_ = boost::make_shared<sum_t>
+	  (boost::make_shared<NumericLinearFunction> (ones, zero),
+	   boost::make_shared<squares_t> (residual_, residual_));
+
+	// The cost function is not owned: the problem outlives the
+	// subproblem.
+	cost_ = boost::make_shared<cost_t>
+	  (boost::shared_ptr<function_t> (const_cast<function_t*> (&f),
+					  detail::NullDeleter ()),
+	   boost::make_shared<penalty_t> (sum_, value_type (.5)));
+	subproblem_.reset (new problem_t (*cost_));
+      }
+
+    // The problem data may have been rebound since the last solve.
+    residual_->setBounds (pb.constraintsLowerBounds (),
+			  pb.constraintsUpperBounds ());
+    subproblem_->argumentBounds () = pb.argumentBounds ();
+    subproblem_->argumentScales () = pb.argumentScales ();
+    subproblem_->startingPoint () = x;
+
+    if (factory_ && factoryName_ == *solverName_)
+      {
+	solver_t& solver = (*factory_) ();
+	solver.clearWarmStart ();
+	solver.rebind (*subproblem_);
+	return;
+      }
+
+    factory_.reset ();
+    factoryName_.clear ();
+    factory_.reset (new SolverFactory<solver_t> (*solverName_, *subproblem_));
+    factoryName_ = *solverName_;
+  }
+
+  template <typename S>
+  void
+  AugmentedLagrangianSolver<S>::updateCost (const vector_t& multipliers,
+					    value_type penalty)
+  {
+    residual_->setMultipliers (multipliers);
+    residual_->setPenalty (penalty);
+  }
+
+  template <typename S>
+  void
+  AugmentedLagrangianSolver<S>::solve () throw ()
+  {
+    BOOST_STATIC_ASSERT ((boost::is_base_of<function_t, cost_t>::value));
+
+    typedef typename solver_t::parameters_t parameters_t;
+
+    const problem_t& pb = this->problem ();
+    const function_t& f = pb.function ();
+    const size_type n = f.inputSize ();
+
+    outerIterations_ = 0;
+
+    // The parameters may have been replaced since the last solve.
+    try
+      {
+	resolveParameters ();
+      }
+    catch (const std::exception& e)
+      {
+	this->result_ = SolverError
+	  ((boost::format ("invalid solver parameter: %1%")
+	    % e.what ()).str ());
+	return;
+      }
+
+    Result last (n, 1);
+    if (pb.startingPoint ())
+      last.x = *pb.startingPoint ();
+    vector_t& x = last.x;
+
+    try
+      {
+	prepare (x);
+      }
+    catch (const std::exception& e)
+      {
+	this->result_ = SolverError
+	  ((boost::format ("failed to load the sub-solver: %1%")
+	    % e.what ()).str ());
+	return;
+      }
+    solver_t& solver = (*factory_) ();
+
+    const std::string prefix ("augmented-lagrangian.");
+    BOOST_FOREACH (const typename parameters_t::value_type& parameter,
+		   this->parameters ())
+      if (parameter.first.compare (0, prefix.size (), prefix) != 0)
+	solver.parameters ()[parameter.first] = parameter.second;
+
+    const size_type m = residual_->outputSize ();
+    const typename problem_t::constVectorMap_t lower =
+      pb.constraintsLowerBounds ();
+    const typename problem_t::constVectorMap_t upper =
+      pb.constraintsUpperBounds ();
+
+    // Initial multipliers and penalty.
+    vector_t lambda (m);
+    lambda.setZero ();
+    value_type rho = std::max (*penalty_, value_type (1e-8));
+    if (this->hasWarmStart ())
+      {
+	if (this->warmStartMultipliers ().size () == m)
+	  lambda = this->warmStartMultipliers ();
+	if (lastPenalty_ > 0.)
+	  rho = lastPenalty_;
+      }
+
+    vector_t g (m);
+    g.setZero ();
+    vector_t shifted (m);
+    vector_t projected (m);
+    value_type previous = std::numeric_limits<value_type>::infinity ();
+
+    bool converged = false;
+    bool stopped = false;
+    std::vector<SolverWarning> warnings;
+    state_.clearStopRequest ();
+
+    while (outerIterations_ < *maxIterations_)
+      {
+	// The subproblem cost is updated in place for the new
+	// multipliers and penalty.
+	updateCost (lambda, rho);
+
+	// Start from the previous subproblem result.
+	if (outerIterations_ > 0)
+	  solver.warmStart (last);
+
+	const typename solver_t::result_t& subresult = solver.minimum ();
+	const Result* result = detail::solution (subresult);
+	if (!result)
+	  {
+	    std::string message ("no solution");
+	    if (const SolverError* error = boost::get<SolverError> (&subresult))
+	      message = error->what ();
+
+	    Result lastState (n, 1);
+	    lastState.x = x;
+	    f (lastState.value, x);
+	    lastState.constraints = g;
+	    lastState.lambda = lambda;
+	    this->result_ = SolverError
+	      ((boost::format
+		("sub-solver failed at outer iteration %1%: %2%")
+		% outerIterations_ % message).str (), lastState);
+	    lastPenalty_ = rho;
+	    return;
+	  }
+	++outerIterations_;
+
+	warnings.clear ();
+	if (const ResultWithWarnings* withWarnings =
+	    boost::get<ResultWithWarnings> (&subresult))
+	  warnings = withWarnings->warnings;
+
+	last = *result;
+	residual_->constraints (g, x);
+
+	// First-order multipliers update. The measure vanishes at a
+	// feasible point where the multipliers are complementary.
+	shifted = g + lambda / rho;
+	projected = shifted.cwiseMax (lower).cwiseMin (upper);
+	const value_type measure = (m > 0)
+	  ? (g - projected).template lpNorm<Eigen::Infinity> () : 0.;
+	lambda = rho * (shifted - projected);
+
+	if (callback_)
+	  {
+	    vector_t value (1);
+	    f (value, x);
+	    state_.x () = x;
+	    state_.cost () = value[0];
+	    state_.constraintViolation () = (m > 0)
+	      ? (g - g.cwiseMax (lower).cwiseMin (upper))
+	      .template lpNorm<Eigen::Infinity> () : 0.;
+	    callback_ (pb, state_);
+	  }
+
+	if (measure <= *tolerance_)
+	  {
+	    converged = true;
+	    break;
+	  }
+	if (state_.stopRequested ())
+	  {
+	    stopped = true;
+	    break;
+	  }
+
+	if (measure > .25 * previous)
+	  rho = std::min (rho * *penaltyFactor_,
+			  std::max (*maxPenalty_, rho));
+	previous = measure;
+      }
+    lastPenalty_ = rho;
+
+    ResultWithWarnings result (n, 1);
+    result.x = x;
+    f (result.value, x);
+    result.constraints = g;
+    result.lambda = lambda;
+
+    if (converged && warnings.empty ())
+      {
+	this->result_ = static_cast<const Result&> (result);
+	return;
+      }
+    if (!converged)
+      warnings.push_back
+	(SolverWarning (stopped
+			? "stopped by the iteration callback"
+			: "maximum number of outer iterations reached"));
+    result.warnings = warnings;
+    this->result_ = result;
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_AUGMENTED_LAGRANGIAN_HXX
@@ -0,0 +1,218 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_AUTO_SCALING_HH
+# define ROBOPTIM_CORE_AUTO_SCALING_HH
+# include <cstddef>
+# include <stdexcept>
+# include <vector>
+
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/problem.hh>
+# include <roboptim/core/filter/scaling.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Compute the scales of a problem from its derivatives.
+  ///
+  /// The cost gradient and the constraints jacobian are sampled at
+  /// the starting point (or at the projection of zero on the argument
+  /// bounds if there is none) and at a few random points within the
+  /// argument bounds. Then:
+  /// - each argument scale \f$s_j\f$ is set from the magnitudes of
+  ///   the j-th column of the derivatives,
+  /// - each row scale \f$r_i\f$ (cost and constraints rows) is set
+  ///   from the magnitudes of the i-th row of the derivatives of the
+  ///   problem scaled by \f$s\f$.
+  /// .
+  ///
+  /// The magnitudes are combined with one of these rules:
+  /// - GEOMETRIC_MEAN: geometric mean of the smallest and largest
+  ///   non-zero magnitudes,
+  /// - EQUILIBRATION: largest magnitude, so that the largest scaled
+  ///   derivative of each row and column is one.
+  /// .
+  ///
+  /// Scales follow the solvers convention: the scaled argument is
+  /// \f$\tilde{x} = s \circ x\f$ and the scaled functions are
+  /// \f$r \circ f (\tilde{x} \oslash s)\f$ (see Scaling). Scales are
+  /// clamped to [minimumScale (), maximumScale ()]; rows and columns
+  /// whose derivatives are zero keep a unit scale.
+  ///
+  /// The computed scales can be written in the problem (see apply),
+  /// or used through scaled views of the problem functions, which
+  /// share the functions instead of copying them.
+  ///
+  /// \tparam P problem type
+  template <typename P>
+  class AutoScaling
+  {
+  public:
+    /// \brief Problem type.
+    typedef P problem_t;
+
+    /// \brief Cost function type.
+    typedef typename problem_t::function_t function_t;
+    /// \brief Function traits (dense or sparse).
+    typedef typename function_t::traits_t traits_t;
+
+    /// \brief Import value type.
+    typedef typename problem_t::value_type value_type;
+    /// \brief Import vector type.
+    typedef typename problem_t::vector_t vector_t;
+    /// \brief Import size type.
+    typedef typename problem_t::size_type size_type;
+    /// \brief Jacobian type.
+    typedef typename GenericFunctionTraits<traits_t>::jacobian_t jacobian_t;
+
+    /// \brief Differentiable function type.
+    typedef GenericDifferentiableFunction<traits_t> differentiableFunction_t;
+
+    /// \brief Scaled cost function.
+    typedef Scaling<function_t> scaledCost_t;
+    /// \brief Scaled constraint.
+    typedef Scaling<differentiableFunction_t> scaledConstraint_t;
+
+    /// \brief Rule combining the derivatives magnitudes.
+    enum Rule
+      {
+	/// \brief Geometric mean of the extreme magnitudes.
+	GEOMETRIC_MEAN,
+	/// \brief Largest magnitude.
+	EQUILIBRATION
+      };
+
+    /// \brief Compute the scales of a problem.
+    ///
+    /// \param problem scaled problem
+    /// \param rule magnitudes combination rule
+    /// \param samples number of sampled points (at least one)
+    explicit AutoScaling (const problem_t& problem,
+			  Rule rule = GEOMETRIC_MEAN,
+			  std::size_t samples = 1)
+      throw (std::runtime_error);
+
+    ~AutoScaling () throw ();
+
+    /// \brief Scaled problem.
+    const problem_t& problem () const throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Points where the derivatives have been sampled.
+    const std::vector<vector_t>& samples () const throw ()
+    {
+      return samples_;
+    }
+
+    /// \brief Argument scales \f$s\f$.
+    const vector_t& argumentScales () const throw ()
+    {
+      return argumentScales_;
+    }
+
+    /// \brief Cost scale.
+    value_type costScale () const throw ()
+    {
+      return costScale_;
+    }
+
+    /// \brief Stacked constraints rows scales.
+    const vector_t& constraintsScales () const throw ()
+    {
+      return constraintsScales_;
+    }
+
+    /// \brief Smallest scale.
+    static value_type minimumScale () throw ()
+    {
+      return 1e-8;
+    }
+
+    /// \brief Largest scale.
+    static value_type maximumScale () throw ()
+    {
+      return 1e8;
+    }
+
+    /// \brief Write the argument and constraints scales in a problem.
+    ///
+    /// The problem has no cost scale: use costScale or scaledCost.
+    ///
+    /// \param problem problem with the same structure as the scaled
+    /// problem (i.e. the scaled problem itself)
+    void apply (problem_t& problem) const throw (std::runtime_error);
+
+    /// \brief Map an argument to the scaled space.
+    vector_t scaleArgument (const vector_t& x) const throw ();
+
+    /// \brief Map a scaled argument back to the original space.
+    vector_t unscaleArgument (const vector_t& x) const throw ();
+
+    /// \brief Scaled view of the cost function.
+    ///
+    /// The view refers to the cost function of the problem, which
+    /// must outlive it.
+    boost::shared_ptr<scaledCost_t> scaledCost () const
+      throw (std::runtime_error);
+
+    /// \brief Scaled view of a constraint.
+    ///
+    /// \param constraintId constraint index
+    boost::shared_ptr<scaledConstraint_t>
+    scaledConstraint (std::size_t constraintId) const
+      throw (std::runtime_error);
+
+  private:
+    /// \brief Scale of a row or column from its magnitudes.
+    static value_type combine (Rule rule, value_type min, value_type max);
+
+    /// \brief Choose the sampled points.
+    void sample (std::size_t samples);
+
+    /// \brief Scaled problem.
+    const problem_t& problem_;
+
+    /// \brief Magnitudes combination rule.
+    Rule rule_;
+
+    /// \brief Sampled points.
+    std::vector<vector_t> samples_;
+
+    /// \brief Argument scales.
+    vector_t argumentScales_;
+
+    /// \brief Cost scale.
+    value_type costScale_;
+
+    /// \brief Stacked constraints rows scales.
+    vector_t constraintsScales_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/auto-scaling.hxx>
+#endif //! ROBOPTIM_CORE_AUTO_SCALING_HH
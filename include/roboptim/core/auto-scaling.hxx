@@ -0,0 +1,342 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_AUTO_SCALING_HXX
+# define ROBOPTIM_CORE_AUTO_SCALING_HXX
+# include <algorithm>
+# include <cmath>
+# include <limits>
+
+# include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/static_assert.hpp>
+# include <boost/type_traits/is_base_of.hpp>
+# include <boost/random/mersenne_twister.hpp>
+# include <boost/random/uniform_real_distribution.hpp>
+# include <boost/variant/apply_visitor.hpp>
+# include <boost/variant/static_visitor.hpp>
+
+# include <roboptim/core/constraint-block.hh>
+# include <roboptim/core/util.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Smallest and largest non-zero magnitudes of each row or
+    /// column of the sampled derivatives.
+    struct Magnitudes
+    {
+      explicit Magnitudes (Function::size_type size)
+	: min (Function::vector_t::Constant
+	       (size, std::numeric_limits<Function::value_type>::infinity ())),
+	  max (Function::vector_t::Zero (size))
+      {}
+
+      void add (Function::size_type k, Function::value_type v)
+      {
+	v = std::fabs (v);
+	if (v == 0.)
+	  return;
+	min[k] = std::min (min[k], v);
+	max[k] = std::max (max[k], v);
+      }
+
+      Function::vector_t min;
+      Function::vector_t max;
+    };
+
+    /// \brief Collect the magnitudes of each column.
+    struct ColumnMagnitudes
+    {
+      explicit ColumnMagnitudes (Magnitudes& magnitudes)
+	: magnitudes_ (magnitudes)
+      {}
+
+      void operator () (Function::size_type, Function::size_type j,
+			Function::value_type v)
+      {
+	magnitudes_.add (j, v);
+      }
+
+    private:
+      Magnitudes& magnitudes_;
+    };
+
+    /// \brief Collect the magnitudes of each row, once the columns
+    /// are scaled.
+    struct RowMagnitudes
+    {
+      RowMagnitudes (Magnitudes& magnitudes,
+		     const Function::vector_t& argumentScales,
+		     Function::size_type offset)
+	: magnitudes_ (magnitudes),
+	  argumentScales_ (argumentScales),
+	  offset_ (offset)
+      {}
+
+      void operator () (Function::size_type i, Function::size_type j,
+			Function::value_type v)
+      {
+	magnitudes_.add (offset_ + i, v / argumentScales_[j]);
+      }
+
+    private:
+      Magnitudes& magnitudes_;
+      const Function::vector_t& argumentScales_;
+      Function::size_type offset_;
+    };
+
+    /// \brief Visit the non-zero coefficients of a dense matrix.
+    template <typename V>
+    void visitNonZeros (const Function::matrix_t& matrix, V& visitor)
+    {
+      for (Function::size_type i = 0; i < matrix.rows (); ++i)
+	for (Function::size_type j = 0; j < matrix.cols (); ++j)
+	  if (matrix (i, j) != 0.)
+	    visitor (i, j, matrix (i, j));
+    }
+
+    /// \brief Visit the non-zero coefficients of a sparse matrix.
+    template <typename V>
+    void visitNonZeros (const SparseFunction::matrix_t& matrix, V& visitor)
+    {
+      typedef SparseFunction::matrix_t matrix_t;
+      for (matrix_t::Index k = 0; k < matrix.outerSize (); ++k)
+	for (matrix_t::InnerIterator it (matrix, k); it; ++it)
+	  visitor (it.row (), it.col (), it.value ());
+    }
+
+    /// \brief Get a constraint as a differentiable function.
+    template <typename D>
+    struct DifferentiableConstraint
+      : public boost::static_visitor<boost::shared_ptr<D> >
+    {
+      template <typename U>
+      boost::shared_ptr<D> operator () (const U& constraint) const
+      {
+	return boost::dynamic_pointer_cast<D> (constraint);
+      }
+    };
+  } // end of namespace detail.
+
+  template <typename P>
+  AutoScaling<P>::AutoScaling (const problem_t& problem,
+			       Rule rule,
+			       std::size_t samples)
+    throw (std::runtime_error)
+    : problem_ (problem),
+      rule_ (rule),
+      samples_ (),
+      argumentScales_ (),
+      costScale_ (1.),
+      constraintsScales_ ()
+  {
+    BOOST_STATIC_ASSERT
+      ((boost::is_base_of<differentiableFunction_t, function_t>::value));
+
+    if (samples < 1)
+      throw std::runtime_error
+	("Failed to scale problem: at least one sample is required");
+
+    const size_type n = problem.function ().inputSize ();
+    const size_type m = problem.constraintsOutputSize ();
+    sample (samples);
+
+    // Sample the derivatives.
+    ConstraintBlock<problem_t> block (problem);
+    std::vector<jacobian_t> costJacobians (samples_.size ());
+    std::vector<jacobian_t> constraintsJacobians (samples_.size ());
+    for (std::size_t k = 0; k < samples_.size (); ++k)
+      {
+	costJacobians[k] = problem.function ().jacobian (samples_[k]);
+	if (m > 0)
+	  constraintsJacobians[k] = block.jacobian (samples_[k]);
+      }
+
+    // Columns.
+    detail::Magnitudes columns (n);
+    detail::ColumnMagnitudes columnVisitor (columns);
+    for (std::size_t k = 0; k < samples_.size (); ++k)
+      {
+	detail::visitNonZeros (costJacobians[k], columnVisitor);
+	if (m > 0)
+	  detail::visitNonZeros (constraintsJacobians[k], columnVisitor);
+      }
+
+    argumentScales_.resize (n);
+    for (size_type j = 0; j < n; ++j)
+      argumentScales_[j] = combine (rule_, columns.min[j], columns.max[j]);
+
+    // Rows: the cost row comes first, then the constraints rows.
+    detail::Magnitudes rows (1 + m);
+    detail::RowMagnitudes costVisitor (rows, argumentScales_, 0);
+    detail::RowMagnitudes constraintsVisitor (rows, argumentScales_, 1);
+    for (std::size_t k = 0; k < samples_.size (); ++k)
+      {
+	detail::visitNonZeros (costJacobians[k], costVisitor);
+	if (m > 0)
+	  detail::visitNonZeros (constraintsJacobians[k], constraintsVisitor);
+      }
+
+    costScale_ = 1. / combine (rule_, rows.min[0], rows.max[0]);
+    constraintsScales_.resize (m);
+    for (size_type i = 0; i < m; ++i)
+      constraintsScales_[i] =
+	1. / combine (rule_, rows.min[1 + i], rows.max[1 + i]);
+  }
+
+  template <typename P>
+  AutoScaling<P>::~AutoScaling () throw ()
+  {
+  }
+
+  template <typename P>
+  typename AutoScaling<P>::value_type
+  AutoScaling<P>::combine (Rule rule, value_type min, value_type max)
+  {
+    if (max == 0.)
+      return 1.;
+    const value_type magnitude =
+      rule == EQUILIBRATION ? max : std::sqrt (min * max);
+    return std::min (maximumScale (), std::max (minimumScale (), magnitude));
+  }
+
+  template <typename P>
+  void
+  AutoScaling<P>::sample (std::size_t samples)
+  {
+    const size_type n = problem_.function ().inputSize ();
+
+    // First point: starting point, or zero projected on the bounds.
+    vector_t x0 (n);
+    if (problem_.startingPoint ())
+      x0 = *problem_.startingPoint ();
+    else
+      x0 = vector_t::Zero (n)
+	.cwiseMax (problem_.argumentLowerBounds ())
+	.cwiseMin (problem_.argumentUpperBounds ());
+    samples_.push_back (x0);
+
+    // Other points: uniformly drawn within the bounds. Infinite
+    // bounds are replaced by a unit-relative box around the first
+    // point. The generator is seeded so that scales are reproducible.
+    boost::random::mt19937 generator (5489u);
+    for (std::size_t k = 1; k < samples; ++k)
+      {
+	vector_t x (n);
+	for (size_type j = 0; j < n; ++j)
+	  {
+	    const value_type width = 1. + std::fabs (x0[j]);
+	    value_type lower = problem_.argumentLowerBounds ()[j];
+	    value_type upper = problem_.argumentUpperBounds ()[j];
+	    if (lower == -function_t::infinity ())
+	      lower = std::min (x0[j], upper) - width;
+	    if (upper == function_t::infinity ())
+	      upper = std::max (x0[j], lower) + width;
+	    boost::random::uniform_real_distribution<value_type>
+	      distribution (lower, upper);
+	    x[j] = distribution (generator);
+	  }
+	samples_.push_back (x);
+      }
+  }
+
+  template <typename P>
+  void
+  AutoScaling<P>::apply (problem_t& problem) const throw (std::runtime_error)
+  {
+    if (problem.function ().inputSize () != argumentScales_.size ()
+	|| problem.constraintsOutputSize () != constraintsScales_.size ())
+      throw std::runtime_error
+	("Failed to apply scales: problem sizes do not match");
+
+    for (size_type j = 0; j < argumentScales_.size (); ++j)
+      problem.argumentScales ()[static_cast<std::size_t> (j)] =
+	argumentScales_[j];
+
+    size_type offset = 0;
+    for (std::size_t i = 0; i < problem.constraints ().size (); ++i)
+      {
+	typename problem_t::scales_t scales (problem.scalesVector ()[i].size ());
+	for (std::size_t k = 0; k < scales.size (); ++k)
+	  scales[k] = constraintsScales_[offset++];
+	problem.setConstraintScales (i, scales);
+      }
+  }
+
+  template <typename P>
+  typename AutoScaling<P>::vector_t
+  AutoScaling<P>::scaleArgument (const vector_t& x) const throw ()
+  {
+    return x.cwiseProduct (argumentScales_);
+  }
+
+  template <typename P>
+  typename AutoScaling<P>::vector_t
+  AutoScaling<P>::unscaleArgument (const vector_t& x) const throw ()
+  {
+    return x.cwiseQuotient (argumentScales_);
+  }
+
+  template <typename P>
+  boost::shared_ptr<typename AutoScaling<P>::scaledCost_t>
+  AutoScaling<P>::scaledCost () const throw (std::runtime_error)
+  {
+    // The cost function is held by reference in the problem.
+    boost::shared_ptr<function_t> cost
+      (const_cast<function_t*> (&problem_.function ()),
+       detail::NullDeleter ());
+    return boost::make_shared<scaledCost_t>
+      (cost, vector_t::Constant (1, costScale_), argumentScales_);
+  }
+
+  template <typename P>
+  boost::shared_ptr<typename AutoScaling<P>::scaledConstraint_t>
+  AutoScaling<P>::scaledConstraint (std::size_t constraintId) const
+    throw (std::runtime_error)
+  {
+    if (constraintId >= problem_.constraints ().size ())
+      {
+	boost::format fmt
+	  ("Failed to scale constraint: invalid constraint id"
+	   " (%d, number of constraints is %d)");
+	fmt % constraintId % problem_.constraints ().size ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    boost::shared_ptr<differentiableFunction_t> constraint =
+      boost::apply_visitor
+      (detail::DifferentiableConstraint<differentiableFunction_t> (),
+       problem_.constraints ()[constraintId]);
+    if (!constraint)
+      throw std::runtime_error
+	("Failed to scale constraint: constraint is not differentiable");
+
+    size_type offset = 0;
+    for (std::size_t i = 0; i < constraintId; ++i)
+      offset += static_cast<size_type> (problem_.scalesVector ()[i].size ());
+
+    return boost::make_shared<scaledConstraint_t>
+      (constraint,
+       constraintsScales_.segment (offset, constraint->outputSize ()),
+       argumentScales_);
+  }
+
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_AUTO_SCALING_HXX
@@ -0,0 +1,258 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_BINARY_LOG_HH
+# define ROBOPTIM_CORE_BINARY_LOG_HH
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+
+# include <cstddef>
+# include <fstream>
+# include <iosfwd>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+# include <boost/noncopyable.hpp>
+
+# include <Eigen/Sparse>
+
+# include <roboptim/core/portability.hh>
+# include <roboptim/core/function.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Layout of a binary optimization log.
+  ///
+  /// A binary log is a single append-only file made of a header
+  /// holding the schema, followed by one fixed-size record per
+  /// logged iteration. Record i starts at
+  /// headerSize + i * recordSize, which gives constant time access to
+  /// any iteration.
+  ///
+  /// All values are stored in the native byte order (the header
+  /// holds a byte order mark checked by the reader):
+  ///
+  /// Header:
+  /// - magic string "ROBOPTLG" (8 bytes),
+  /// - uint32: format version, uint32: byte order mark,
+  /// - uint64: header size, uint64: record size,
+  /// - uint64: input size, uint64: jacobian capacity,
+  /// - uint64: number of constraints,
+  /// - for each constraint, uint64: output size, uint64: name length,
+  ///   then the name characters.
+  /// .
+  ///
+  /// Record, stored column by column:
+  /// - uint64: iteration,
+  /// - double: cost, double: constraint violation,
+  /// - double[input size]: x,
+  /// - double[total constraints output size]: stacked constraints,
+  /// - uint64: number of jacobian nonzeros (at most the capacity),
+  /// - uint32[capacity]: rows, uint32[capacity]: columns,
+  ///   double[capacity]: values.
+  /// .
+  struct ROBOPTIM_DLLAPI BinaryLogSchema
+  {
+    typedef Function::size_type size_type;
+
+    BinaryLogSchema ()
+      : inputSize (0),
+	constraintsNames (),
+	constraintsSizes (),
+	jacobianCapacity (0)
+    {}
+
+    /// \brief Total output size of the stacked constraints.
+    size_type constraintsOutputSize () const throw ();
+
+    /// \brief Size of one record in bytes.
+    std::size_t recordSize () const throw ();
+
+    /// \brief Problem input size.
+    size_type inputSize;
+    /// \brief Name of each constraint.
+    std::vector<std::string> constraintsNames;
+    /// \brief Output size of each constraint.
+    std::vector<size_type> constraintsSizes;
+    /// \brief Maximum number of jacobian nonzeros per record, zero if
+    /// the jacobian is not logged.
+    std::size_t jacobianCapacity;
+  };
+
+  /// \brief One iteration of a binary optimization log.
+  struct ROBOPTIM_DLLAPI BinaryLogRecord
+  {
+    typedef Function::value_type value_type;
+    typedef Function::size_type size_type;
+    typedef Function::vector_t vector_t;
+    /// \brief Jacobian coefficient of the stacked constraints.
+    typedef Eigen::Triplet<value_type> triplet_t;
+
+    BinaryLogRecord ()
+      : iteration (0),
+	cost (0.),
+	constraintViolation (0.),
+	x (),
+	constraints (),
+	jacobian ()
+    {}
+
+    /// \brief Store the nonzero coefficients of a dense jacobian.
+    template <typename D>
+    void setJacobian (const Eigen::MatrixBase<D>& j);
+
+    /// \brief Store the nonzero coefficients of a sparse jacobian.
+    template <typename S, int O, typename I>
+    void setJacobian (const Eigen::SparseMatrix<S, O, I>& j);
+
+    boost::uint64_t iteration;
+    value_type cost;
+    value_type constraintViolation;
+    vector_t x;
+    /// \brief Stacked constraints values.
+    vector_t constraints;
+    /// \brief Nonzero coefficients of the stacked constraints jacobian.
+    std::vector<triplet_t> jacobian;
+  };
+
+  /// \brief Write a binary optimization log.
+  ///
+  /// Records are buffered, call flush () to make sure they reach the
+  /// file. As records have a fixed size, a log cut by a crash stays
+  /// readable up to the last complete record.
+  class ROBOPTIM_DLLAPI BinaryLogWriter : public boost::noncopyable
+  {
+  public:
+    /// \brief Create the file and write its header.
+    ///
+    /// \param filename log file, overwritten if it exists
+    /// \param schema log layout
+    BinaryLogWriter (const std::string& filename,
+		     const BinaryLogSchema& schema)
+      throw (std::runtime_error);
+
+    ~BinaryLogWriter () throw ();
+
+    const BinaryLogSchema& schema () const throw ()
+    {
+      return schema_;
+    }
+
+    /// \brief Number of written records.
+    std::size_t size () const throw ()
+    {
+      return size_;
+    }
+
+    /// \brief Append a record.
+    ///
+    /// The record is checked against the schema. Appending does not
+    /// allocate memory.
+    void append (const BinaryLogRecord& record) throw (std::runtime_error);
+
+    void flush () throw (std::runtime_error);
+
+  private:
+    BinaryLogSchema schema_;
+    std::ofstream stream_;
+    /// \brief Serialized record.
+    std::vector<char> buffer_;
+    std::size_t size_;
+  };
+
+  /// \brief Read a binary optimization log.
+  class ROBOPTIM_DLLAPI BinaryLogReader : public boost::noncopyable
+  {
+  public:
+    /// \brief Open a log and read its header.
+    explicit BinaryLogReader (const std::string& filename)
+      throw (std::runtime_error);
+
+    ~BinaryLogReader () throw ();
+
+    const BinaryLogSchema& schema () const throw ()
+    {
+      return schema_;
+    }
+
+    /// \brief Number of complete records in the file.
+    ///
+    /// The file size is read again, so that a log still being
+    /// written can be followed.
+    std::size_t size () throw (std::runtime_error);
+
+    /// \brief Read the i-th record.
+    void read (std::size_t i, BinaryLogRecord& record)
+      throw (std::runtime_error);
+
+    /// \brief Export the records as CSV.
+    ///
+    /// One line per record: iteration, cost, constraint violation,
+    /// x, then the stacked constraints.
+    void exportCsv (std::ostream& stream) throw (std::runtime_error);
+
+    /// \brief Export the jacobian coefficients as CSV.
+    ///
+    /// One line per nonzero coefficient: iteration, row, column, value.
+    void exportJacobianCsv (std::ostream& stream) throw (std::runtime_error);
+
+  private:
+    std::string filename_;
+    BinaryLogSchema schema_;
+    std::ifstream stream_;
+    std::size_t headerSize_;
+    /// \brief Serialized record.
+    std::vector<char> buffer_;
+  };
+
+  template <typename D>
+  void
+  BinaryLogRecord::setJacobian (const Eigen::MatrixBase<D>& j)
+  {
+    jacobian.clear ();
+    for (typename D::Index row = 0; row < j.rows (); ++row)
+      for (typename D::Index col = 0; col < j.cols (); ++col)
+	if (j.coeff (row, col) != 0.)
+	  jacobian.push_back
+	    (triplet_t (static_cast<int> (row), static_cast<int> (col),
+			j.coeff (row, col)));
+  }
+
+  template <typename S, int O, typename I>
+  void
+  BinaryLogRecord::setJacobian (const Eigen::SparseMatrix<S, O, I>& j)
+  {
+    typedef Eigen::SparseMatrix<S, O, I> matrix_t;
+
+    jacobian.clear ();
+    for (typename matrix_t::Index k = 0; k < j.outerSize (); ++k)
+      for (typename matrix_t::InnerIterator it (j, k); it; ++it)
+	jacobian.push_back
+	  (triplet_t (static_cast<int> (it.row ()),
+		      static_cast<int> (it.col ()), it.value ()));
+  }
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_BINARY_LOG_HH
@@ -0,0 +1,219 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_CONSTRAINT_BLOCK_HH
+# define ROBOPTIM_CORE_CONSTRAINT_BLOCK_HH
+# include <cstddef>
+# include <vector>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/problem.hh>
+# include <roboptim/core/thread-pool.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Stacked view of the constraints of a problem.
+  ///
+  /// The constraints of a problem are stored separately, as a vector
+  /// of variants. This class computes once the row offset of each
+  /// constraint and then evaluates all the constraints into one
+  /// contiguous vector \f$g(x)\f$, and assembles one global
+  /// constraint jacobian (dense or sparse) in place.
+  ///
+  /// Rows are ordered as the constraints of the problem: the rows of
+  /// the i-th constraint start at offsets ()[i].
+  ///
+  /// The view keeps a reference to the problem. It does not see
+  /// the constraints added after it has been built.
+  ///
+  /// Constraints can be evaluated concurrently on a thread pool (see
+  /// setThreadPool). As a solver, a block is meant to be used by one
+  /// thread at a time: the pool spreads one evaluation over several
+  /// threads.
+  ///
+  /// \tparam P problem type
+  template <typename P>
+  class ConstraintBlock
+  {
+  public:
+    /// \brief Problem type.
+    typedef P problem_t;
+
+    /// \brief Import value type.
+    typedef typename problem_t::value_type value_type;
+    /// \brief Import vector type.
+    typedef typename problem_t::vector_t vector_t;
+    /// \brief Import size type.
+    typedef typename problem_t::size_type size_type;
+
+    /// \brief Jacobian type.
+    typedef typename GenericFunctionTraits
+    <typename problem_t::function_t::traits_t>::jacobian_t jacobian_t;
+
+    /// \brief Row offsets type.
+    typedef std::vector<size_type> offsets_t;
+
+    /// \brief Constraint indices, in dispatch order.
+    typedef std::vector<std::size_t> schedule_t;
+
+    /// \brief Build the view.
+    ///
+    /// \param problem viewed problem
+    explicit ConstraintBlock (const problem_t& problem) throw ();
+
+    ~ConstraintBlock () throw ();
+
+    /// \brief Viewed problem.
+    const problem_t& problem () const throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Input size (number of optimization variables).
+    size_type inputSize () const throw ()
+    {
+      return problem_.function ().inputSize ();
+    }
+
+    /// \brief Output size (total number of constraint rows).
+    size_type outputSize () const throw ()
+    {
+      return offsets_.back ();
+    }
+
+    /// \brief First row of each constraint.
+    ///
+    /// Contains one more element than there are constraints: the
+    /// last one is the output size.
+    const offsets_t& offsets () const throw ()
+    {
+      return offsets_;
+    }
+
+    /// \brief Evaluate the constraints concurrently on a thread pool.
+    ///
+    /// The time spent evaluating each constraint is measured and
+    /// averaged over the calls. Constraints are then dispatched
+    /// heaviest first, so that a few heavy constraints start early
+    /// and the cheap ones fill the gaps of the other threads.
+    ///
+    /// \param pool pool used for evaluation, null to disable
+    /// concurrent evaluation.
+    void setThreadPool (ThreadPool* pool) throw ();
+
+    /// \brief Thread pool used for evaluation (may be null).
+    ThreadPool* threadPool () const throw ()
+    {
+      return threadPool_;
+    }
+
+    /// \brief Dispatch order of the constraints values evaluation.
+    const schedule_t& valueSchedule () const throw ()
+    {
+      return valueSchedule_.order;
+    }
+
+    /// \brief Dispatch order of the constraints jacobians evaluation.
+    const schedule_t& jacobianSchedule () const throw ()
+    {
+      return jacobianSchedule_.order;
+    }
+
+    /// \brief Evaluate the stacked constraints.
+    ///
+    /// \param x point at which the constraints will be evaluated
+    /// \return stacked constraints values
+    vector_t operator () (const vector_t& x) const throw ();
+
+    /// \brief Evaluate the stacked constraints.
+    ///
+    /// \param result stacked constraints values, of size outputSize ()
+    /// \param x point at which the constraints will be evaluated
+    void operator () (vector_t& result, const vector_t& x) const throw ();
+
+    /// \brief Compute the global constraint jacobian.
+    ///
+    /// \param x point at which the jacobian will be computed
+    /// \return stacked constraints jacobian
+    jacobian_t jacobian (const vector_t& x) const throw ();
+
+    /// \brief Compute the global constraint jacobian.
+    ///
+    /// A sparse jacobian is filled row by row, without triplets.
+    ///
+    /// \param jacobian jacobian of size (outputSize (), inputSize ())
+    /// \param x point at which the jacobian will be computed
+    void jacobian (jacobian_t& jacobian, const vector_t& x) const throw ();
+
+  private:
+    /// \brief Learned evaluation cost of the constraints.
+    struct Schedule
+    {
+      explicit Schedule (std::size_t n);
+
+      /// \brief Record the cost of one constraint evaluation.
+      ///
+      /// \param i constraint index
+      /// \param cost evaluation time (in microseconds)
+      void record (std::size_t i, double cost);
+
+      /// \brief Sort the constraints by decreasing cost.
+      void update ();
+
+      /// \brief Average evaluation time of each constraint.
+      std::vector<double> costs;
+      /// \brief Constraint indices, heaviest first.
+      schedule_t order;
+    };
+
+    /// \brief Evaluate the k-th scheduled constraint (pool task).
+    void evaluateTask (vector_t& result, const vector_t& x,
+		       std::size_t k) const;
+
+    /// \brief Compute the k-th scheduled constraint jacobian into
+    /// its block (pool task).
+    void jacobianTask (const vector_t& x, std::size_t k) const;
+
+    /// \brief Viewed problem.
+    const problem_t& problem_;
+
+    /// \brief First row of each constraint.
+    offsets_t offsets_;
+
+    /// \brief Thread pool used for evaluation (may be null).
+    ThreadPool* threadPool_;
+
+    /// \brief Constraints values evaluation schedule.
+    mutable Schedule valueSchedule_;
+
+    /// \brief Constraints jacobians evaluation schedule.
+    mutable Schedule jacobianSchedule_;
+
+    /// \brief Jacobian of each constraint, for concurrent evaluation.
+    mutable std::vector<jacobian_t> blocks_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/constraint-block.hxx>
+#endif //! ROBOPTIM_CORE_CONSTRAINT_BLOCK_HH
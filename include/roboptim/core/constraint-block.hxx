@@ -0,0 +1,363 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_CONSTRAINT_BLOCK_HXX
+# define ROBOPTIM_CORE_CONSTRAINT_BLOCK_HXX
+# include <algorithm>
+# include <cassert>
+
+# include <boost/bind.hpp>
+# include <boost/date_time/posix_time/posix_time_types.hpp>
+# include <boost/variant/apply_visitor.hpp>
+# include <boost/variant/static_visitor.hpp>
+
+# include <roboptim/core/detail/workspace.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Output size of a constraint.
+    template <typename P>
+    struct ConstraintOutputSize
+      : public boost::static_visitor<typename P::size_type>
+    {
+      template <typename U>
+      typename P::size_type operator () (const U& constraint) const
+      {
+	return constraint->outputSize ();
+      }
+    };
+
+    /// \brief Evaluate a constraint into its rows of a stacked vector.
+    template <typename P>
+    struct EvaluateConstraintRows : public boost::static_visitor<>
+    {
+      typedef typename P::vector_t vector_t;
+      typedef typename P::size_type size_type;
+
+      EvaluateConstraintRows (vector_t& result, size_type offset,
+			      const vector_t& x)
+	: result_ (result),
+	  offset_ (offset),
+	  x_ (x)
+      {}
+
+      template <typename U>
+      void operator () (const U& constraint) const
+      {
+	ScopedBuffer<vector_t> value (constraint->outputSize ());
+	(*constraint) (*value, x_);
+	result_.segment (offset_, constraint->outputSize ()) = *value;
+      }
+
+    private:
+      vector_t& result_;
+      size_type offset_;
+      const vector_t& x_;
+    };
+
+    /// \brief Compute a constraint jacobian.
+    template <typename J>
+    struct ComputeConstraintJacobian : public boost::static_visitor<>
+    {
+      ComputeConstraintJacobian (J& jacobian, const Function::vector_t& x)
+	: jacobian_ (jacobian),
+	  x_ (x)
+      {}
+
+      template <typename U>
+      void operator () (const U& constraint) const
+      {
+	constraint->jacobian (jacobian_, x_);
+      }
+
+    private:
+      J& jacobian_;
+      const Function::vector_t& x_;
+    };
+
+    /// \brief Copy a dense jacobian into rows of a larger jacobian.
+    inline void
+    copyJacobianRows (Function::matrix_t& jacobian,
+		      Function::size_type offset,
+		      const Function::matrix_t& block)
+    {
+      jacobian.middleRows (offset, block.rows ()) = block;
+    }
+
+    /// \brief Append a sparse jacobian to the rows of a larger
+    /// jacobian.
+    ///
+    /// Rows must be appended in order.
+    inline void
+    copyJacobianRows (SparseFunction::matrix_t& jacobian,
+		      SparseFunction::size_type offset,
+		      const SparseFunction::matrix_t& block)
+    {
+      typedef SparseFunction::matrix_t matrix_t;
+      for (matrix_t::Index row = 0; row < block.outerSize (); ++row)
+	{
+	  jacobian.startVec (offset + row);
+	  for (matrix_t::InnerIterator it (block, row); it; ++it)
+	    jacobian.insertBack (offset + row, it.col ()) = it.value ();
+	}
+    }
+
+    /// \brief Compute a constraint jacobian into its rows of a
+    /// stacked jacobian.
+    template <typename P>
+    struct JacobianConstraintRows : public boost::static_visitor<>
+    {
+      typedef typename P::vector_t vector_t;
+      typedef typename P::size_type size_type;
+      typedef typename ConstraintBlock<P>::jacobian_t jacobian_t;
+
+      JacobianConstraintRows (jacobian_t& jacobian, size_type offset,
+			      const vector_t& x)
+	: jacobian_ (jacobian),
+	  offset_ (offset),
+	  x_ (x)
+      {}
+
+      template <typename U>
+      void operator () (const U& constraint) const
+      {
+	ScopedBuffer<jacobian_t> block
+	  (constraint->outputSize (), constraint->inputSize ());
+	block->setZero ();
+	constraint->jacobian (*block, x_);
+	copyJacobianRows (jacobian_, offset_, *block);
+      }
+
+    private:
+      jacobian_t& jacobian_;
+      size_type offset_;
+      const vector_t& x_;
+    };
+
+    /// \brief Order constraint indices by decreasing cost.
+    struct HeavierConstraint
+    {
+      explicit HeavierConstraint (const std::vector<double>& costs)
+	: costs_ (costs)
+      {}
+
+      bool operator () (std::size_t lhs, std::size_t rhs) const
+      {
+	return costs_[lhs] > costs_[rhs];
+      }
+
+    private:
+      const std::vector<double>& costs_;
+    };
+
+    /// \brief Current time, in microseconds.
+    inline double
+    microseconds ()
+    {
+      static const boost::posix_time::ptime
+	epoch (boost::posix_time::microsec_clock::universal_time ());
+      return static_cast<double>
+	((boost::posix_time::microsec_clock::universal_time () - epoch)
+	 .total_microseconds ());
+    }
+
+    /// \brief Terminate a jacobian filled by copyJacobianRows.
+    inline void
+    finalizeJacobianRows (Function::matrix_t&)
+    {}
+
+    /// \brief Terminate a jacobian filled by copyJacobianRows.
+    inline void
+    finalizeJacobianRows (SparseFunction::matrix_t& jacobian)
+    {
+      jacobian.finalize ();
+    }
+  } // end of namespace detail.
+
+  template <typename P>
+  ConstraintBlock<P>::Schedule::Schedule (std::size_t n)
+    : costs (n, 0.),
+      order (n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      order[i] = i;
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::Schedule::record (std::size_t i, double cost)
+  {
+    // Exponential moving average: follow slow changes of the costs
+    // while smoothing the timing noise.
+    costs[i] = (costs[i] > 0.) ? .7 * costs[i] + .3 * cost : cost;
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::Schedule::update ()
+  {
+    std::stable_sort (order.begin (), order.end (),
+		      detail::HeavierConstraint (costs));
+  }
+
+  template <typename P>
+  ConstraintBlock<P>::ConstraintBlock (const problem_t& problem) throw ()
+    : problem_ (problem),
+      offsets_ (problem.constraints ().size () + 1),
+      threadPool_ (0),
+      valueSchedule_ (problem.constraints ().size ()),
+      jacobianSchedule_ (problem.constraints ().size ()),
+      blocks_ ()
+  {
+    offsets_[0] = 0;
+    for (std::size_t i = 0; i < problem.constraints ().size (); ++i)
+      offsets_[i + 1] = offsets_[i]
+	+ boost::apply_visitor (detail::ConstraintOutputSize<P> (),
+				problem.constraints ()[i]);
+  }
+
+  template <typename P>
+  ConstraintBlock<P>::~ConstraintBlock () throw ()
+  {}
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::setThreadPool (ThreadPool* pool) throw ()
+  {
+    threadPool_ = pool;
+
+    if (!pool || !blocks_.empty ())
+      return;
+
+    blocks_.resize (problem_.constraints ().size ());
+    for (std::size_t i = 0; i < blocks_.size (); ++i)
+      {
+	blocks_[i].resize (offsets_[i + 1] - offsets_[i], inputSize ());
+	blocks_[i].setZero ();
+      }
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::evaluateTask (vector_t& result, const vector_t& x,
+				    std::size_t k) const
+  {
+    const std::size_t i = valueSchedule_.order[k];
+    const double start = detail::microseconds ();
+    boost::apply_visitor
+      (detail::EvaluateConstraintRows<P> (result, offsets_[i], x),
+       problem_.constraints ()[i]);
+    valueSchedule_.record (i, detail::microseconds () - start);
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::jacobianTask (const vector_t& x, std::size_t k) const
+  {
+    const std::size_t i = jacobianSchedule_.order[k];
+    const double start = detail::microseconds ();
+    // Blocks are reused: clear them as the public API does.
+    blocks_[i].setZero ();
+    boost::apply_visitor
+      (detail::ComputeConstraintJacobian<jacobian_t> (blocks_[i], x),
+       problem_.constraints ()[i]);
+    jacobianSchedule_.record (i, detail::microseconds () - start);
+  }
+
+  template <typename P>
+  typename ConstraintBlock<P>::vector_t
+  ConstraintBlock<P>::operator () (const vector_t& x) const throw ()
+  {
+    vector_t result (outputSize ());
+    result.setZero ();
+    (*this) (result, x);
+    return result;
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::operator () (vector_t& result, const vector_t& x)
+    const throw ()
+  {
+    assert (x.size () == inputSize ());
+    assert (result.size () == outputSize ());
+    assert (offsets_.size () == problem_.constraints ().size () + 1);
+
+    if (threadPool_)
+      {
+	// Constraints write disjoint rows of the result.
+	threadPool_->run (problem_.constraints ().size (),
+			  boost::bind (&ConstraintBlock<P>::evaluateTask,
+				       this, boost::ref (result),
+				       boost::cref (x), _1));
+	valueSchedule_.update ();
+	return;
+      }
+
+    for (std::size_t i = 0; i < problem_.constraints ().size (); ++i)
+      boost::apply_visitor
+	(detail::EvaluateConstraintRows<P> (result, offsets_[i], x),
+	 problem_.constraints ()[i]);
+  }
+
+  template <typename P>
+  typename ConstraintBlock<P>::jacobian_t
+  ConstraintBlock<P>::jacobian (const vector_t& x) const throw ()
+  {
+    jacobian_t jacobian (outputSize (), inputSize ());
+    jacobian.setZero ();
+    this->jacobian (jacobian, x);
+    return jacobian;
+  }
+
+  template <typename P>
+  void
+  ConstraintBlock<P>::jacobian (jacobian_t& jacobian, const vector_t& x)
+    const throw ()
+  {
+    assert (x.size () == inputSize ());
+    assert (jacobian.rows () == outputSize ());
+    assert (jacobian.cols () == inputSize ());
+    assert (offsets_.size () == problem_.constraints ().size () + 1);
+
+    // Sparse jacobians are filled from scratch, row by row.
+    jacobian.setZero ();
+
+    if (threadPool_)
+      {
+	// Compute the blocks concurrently, then append them in order.
+	threadPool_->run (problem_.constraints ().size (),
+			  boost::bind (&ConstraintBlock<P>::jacobianTask,
+				       this, boost::cref (x), _1));
+	jacobianSchedule_.update ();
+
+	for (std::size_t i = 0; i < blocks_.size (); ++i)
+	  detail::copyJacobianRows (jacobian, offsets_[i], blocks_[i]);
+      }
+    else
+      for (std::size_t i = 0; i < problem_.constraints ().size (); ++i)
+	boost::apply_visitor
+	  (detail::JacobianConstraintRows<P> (jacobian, offsets_[i], x),
+	   problem_.constraints ()[i]);
+
+    detail::finalizeJacobianRows (jacobian);
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_CONSTRAINT_BLOCK_HXX
@@ -82,6 +82,12 @@ namespace roboptim
       typedef T2 T_type;					\
     }
 
+    template <typename U, typename V>
+    struct AutopromoteTrait<Chain<U, V> >
+    {
+      typedef typename Chain<U, V>::parentType_t T_type;
+    };
+
     template <typename U, typename V>
     struct AutopromoteTrait<Plus<U, V> >
     {
@@ -106,6 +112,24 @@ namespace roboptim
       typedef typename Scalar<U>::parent_t T_type;
     };
 
+    template <typename U>
+    struct AutopromoteTrait<Scaling<U> >
+    {
+      typedef typename Scaling<U>::parentType_t T_type;
+    };
+
+    template <typename U>
+    struct AutopromoteTrait<MultiConcatenate<U> >
+    {
+      typedef typename MultiConcatenate<U>::parentType_t T_type;
+    };
+
+    template <typename U>
+    struct AutopromoteTrait<MultiPlus<U> >
+    {
+      typedef typename MultiPlus<U>::parentType_t T_type;
+    };
+
     ROBOPTIM_CORE_DECLARE_AUTOPROMOTE
     (GenericNumericQuadraticFunction<EigenMatrixDense>,
      GenericQuadraticFunction<EigenMatrixDense>);
@@ -0,0 +1,131 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_SPSC_RING_HH
+# define ROBOPTIM_CORE_DETAIL_SPSC_RING_HH
+# include <cstddef>
+# include <vector>
+
+# include <boost/atomic.hpp>
+# include <boost/noncopyable.hpp>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Bounded lock-free single-producer single-consumer queue.
+    ///
+    /// The queue owns a fixed set of slots which are reused: the
+    /// producer fills the slot returned by prepare () in place, then
+    /// publishes it with commit (). The consumer reads the slot
+    /// returned by front (), then gives it back with pop (). As slots
+    /// are not destroyed, a producer copying data of a constant size
+    /// into a slot does not allocate memory once the queue is warm.
+    ///
+    /// prepare () and commit () must only be called by the producer
+    /// thread, front () and pop () by the consumer thread. The shared
+    /// indices are sequentially consistent so that a thread can
+    /// publish a flag telling it is about to sleep, then check the
+    /// queue again, without missing the other thread's update.
+    ///
+    /// \tparam T slot type (default constructible)
+    template <typename T>
+    class SpscRing : public boost::noncopyable
+    {
+    public:
+      /// \param capacity maximum number of queued elements
+      explicit SpscRing (std::size_t capacity)
+	: slots_ (capacity + 1),
+	  head_ (0),
+	  tail_ (0)
+      {}
+
+      /// \brief Maximum number of queued elements.
+      std::size_t capacity () const
+      {
+	return slots_.size () - 1;
+      }
+
+      /// \brief Number of queued elements.
+      std::size_t size () const
+      {
+	const std::size_t head = head_.load (boost::memory_order_acquire);
+	const std::size_t tail = tail_.load (boost::memory_order_acquire);
+	return (tail + slots_.size () - head) % slots_.size ();
+      }
+
+      bool empty () const
+      {
+	return size () == 0;
+      }
+
+      bool full () const
+      {
+	return size () == capacity ();
+      }
+
+      /// \brief Slot to fill, null if the queue is full (producer).
+      T* prepare ()
+      {
+	const std::size_t tail = tail_.load (boost::memory_order_relaxed);
+	if (next (tail) == head_.load ())
+	  return 0;
+	return &slots_[tail];
+      }
+
+      /// \brief Publish the slot returned by prepare () (producer).
+      void commit ()
+      {
+	const std::size_t tail = tail_.load (boost::memory_order_relaxed);
+	tail_.store (next (tail));
+      }
+
+      /// \brief Oldest queued element, null if the queue is empty
+      /// (consumer).
+      T* front ()
+      {
+	const std::size_t head = head_.load (boost::memory_order_relaxed);
+	if (head == tail_.load ())
+	  return 0;
+	return &slots_[head];
+      }
+
+      /// \brief Release the element returned by front () (consumer).
+      void pop ()
+      {
+	const std::size_t head = head_.load (boost::memory_order_relaxed);
+	head_.store (next (head));
+      }
+
+    private:
+      std::size_t next (std::size_t i) const
+      {
+	return (i + 1) % slots_.size ();
+      }
+
+      /// \brief Slots, one is always left empty to tell a full queue
+      /// from an empty one.
+      std::vector<T> slots_;
+      /// \brief Index of the oldest element (written by the consumer).
+      boost::atomic<std::size_t> head_;
+      /// \brief Index of the next slot to fill (written by the producer).
+      boost::atomic<std::size_t> tail_;
+    };
+  } // end of namespace detail.
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_DETAIL_SPSC_RING_HH
@@ -0,0 +1,167 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_THREAD_LOCAL_HH
+# define ROBOPTIM_CORE_DETAIL_THREAD_LOCAL_HH
+# include <boost/atomic.hpp>
+# include <boost/thread/thread.hpp>
+
+# ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+#  include <Eigen/Core>
+# endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Per-thread copies of a value.
+    ///
+    /// This is used by filters to store their scratch buffers: each
+    /// thread evaluating a filter gets its own copy of the
+    /// prototype, created the first time the thread accesses it.
+    /// Later accesses do not lock nor allocate memory, so evaluating
+    /// a filter stays allocation-free once each thread has used it
+    /// once.
+    ///
+    /// The prototype is meant to be set up in the owner constructor
+    /// and must not be modified once get () has been called.
+    ///
+    /// The copies are owned by this object and released with it,
+    /// whether their thread is still running (e.g. a ThreadPool
+    /// worker) or not. A thread reusing the identifier of an exited
+    /// thread gets the copy of that thread.
+    template <typename T>
+    class ThreadLocal
+    {
+    public:
+      ThreadLocal ()
+	: prototype_ (),
+	  values_ (0)
+      {}
+
+      explicit ThreadLocal (const T& prototype)
+	: prototype_ (prototype),
+	  values_ (0)
+      {}
+
+      /// \brief Copy the prototype only: per-thread values are not
+      /// shared between objects.
+      ThreadLocal (const ThreadLocal& other)
+	: prototype_ (other.prototype_),
+	  values_ (0)
+      {}
+
+      ~ThreadLocal ()
+      {
+	clear ();
+      }
+
+      ThreadLocal& operator= (const ThreadLocal& other)
+      {
+	if (this != &other)
+	  {
+	    // Forget the values copied from the previous prototype.
+	    clear ();
+	    prototype_ = other.prototype_;
+	  }
+	return *this;
+      }
+
+      /// \brief Value copied for each new thread.
+      T& prototype ()
+      {
+	return prototype_;
+      }
+
+      /// \brief Value copied for each new thread.
+      const T& prototype () const
+      {
+	return prototype_;
+      }
+
+      /// \brief Value owned by the calling thread.
+      T& get () const
+      {
+	const boost::thread::id thread = boost::this_thread::get_id ();
+	for (Node* node = values_.load (boost::memory_order_acquire);
+	     node; node = node->next)
+	  if (node->thread == thread)
+	    return node->value;
+	return insert (thread);
+      }
+
+    private:
+      /// \brief Value of one thread.
+      struct Node
+      {
+	Node (boost::thread::id t, const T& v)
+	  : thread (t),
+	    value (v),
+	    next (0)
+	{}
+
+	boost::thread::id thread;
+	T value;
+	Node* next;
+      };
+
+      /// \brief Copy the prototype for a new thread.
+      T& insert (boost::thread::id thread) const
+      {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	// The first access usually happens while evaluating a
+	// function, where Eigen allocations are forbidden.
+	const bool mallocAllowed = Eigen::internal::is_malloc_allowed ();
+	Eigen::internal::set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	Node* node = new Node (thread, prototype_);
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	Eigen::internal::set_is_malloc_allowed (mallocAllowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+	// Other threads may insert their value concurrently.
+	Node* head = values_.load (boost::memory_order_relaxed);
+	do
+	  node->next = head;
+	while (!values_.compare_exchange_weak
+	       (head, node, boost::memory_order_release,
+		boost::memory_order_relaxed));
+	return node->value;
+      }
+
+      /// \brief Release the values of all the threads.
+      void clear ()
+      {
+	Node* node = values_.exchange (0);
+	while (node)
+	  {
+	    Node* next = node->next;
+	    delete node;
+	    node = next;
+	  }
+      }
+
+      /// \brief Value copied for each new thread.
+      T prototype_;
+
+      /// \brief Value of each thread (lock-free list).
+      mutable boost::atomic<Node*> values_;
+    };
+  } // end of namespace detail.
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_DETAIL_THREAD_LOCAL_HH
@@ -0,0 +1,275 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_WORKSPACE_HH
+# define ROBOPTIM_CORE_DETAIL_WORKSPACE_HH
+# include <cstddef>
+# include <map>
+# include <utility>
+# include <vector>
+
+# include <boost/noncopyable.hpp>
+# include <boost/thread/tss.hpp>
+
+# ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+#  include <Eigen/Core>
+# endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Per-thread pool of scratch buffers.
+    ///
+    /// Filters borrow their scratch buffers from the workspace of the
+    /// calling thread for the duration of one evaluation (see
+    /// ScopedBuffer) instead of owning them. A released buffer is
+    /// reused by the next request of the same type and size, whatever
+    /// the filter asking for it.
+    ///
+    /// As a filter graph is evaluated depth-first, the lifetimes of
+    /// the scratch buffers are nested: buffers of nodes which are not
+    /// evaluated at the same time (e.g. siblings) share the same
+    /// memory, and the workspace only holds the buffers needed by the
+    /// deepest evaluation path instead of one set per node.
+    ///
+    /// Buffers are reused as they are: a borrowed buffer holds
+    /// whatever its previous user left in it. Filters reserve their
+    /// buffers when they are built (see reserve ()), so that the
+    /// building thread does not allocate when evaluating them. A
+    /// thread borrowing a size it does not own yet allocates it on
+    /// the fly, with Eigen allocations allowed; once warm, borrowing
+    /// and releasing buffers does not allocate memory.
+    ///
+    /// \note This is a pool, not a planner: the buffers are separate
+    /// heap blocks, not offsets into one arena computed from the
+    /// filter graph.
+    ///
+    /// \tparam B buffer type (Eigen dense or sparse vector or matrix)
+    template <typename B>
+    class Workspace : public boost::noncopyable
+    {
+    public:
+      /// \brief Buffer size type.
+      typedef typename B::Index size_type;
+
+      /// \brief Workspace of the calling thread.
+      static Workspace& local ()
+      {
+	Workspace* workspace = local_.get ();
+	if (!workspace)
+	  {
+	    AllowMalloc allow;
+	    workspace = new Workspace ();
+	    local_.reset (workspace);
+	  }
+	return *workspace;
+      }
+
+      ~Workspace ()
+      {
+	for (std::size_t i = 0; i < buffers_.size (); ++i)
+	  delete buffers_[i];
+      }
+
+      /// \brief Borrow a buffer.
+      ///
+      /// The content of the buffer is unspecified.
+      ///
+      /// \param rows buffer rows
+      /// \param cols buffer columns
+      B& acquire (size_type rows, size_type cols)
+      {
+	Pool* pool = find (rows, cols);
+	if (!pool || pool->free.empty ())
+	  pool = &grow (rows, cols, 1);
+
+	B* buffer = pool->free.back ();
+	pool->free.pop_back ();
+	return *buffer;
+      }
+
+      /// \brief Make sure count buffers of a given size are available.
+      ///
+      /// Filters call this when they are built, so that their
+      /// evaluation does not allocate.
+      ///
+      /// \param rows buffer rows
+      /// \param cols buffer columns
+      /// \param count number of buffers
+      void reserve (size_type rows, size_type cols, std::size_t count = 1)
+      {
+	Pool* pool = find (rows, cols);
+	std::size_t available = pool ? pool->free.size () : 0;
+	if (available < count)
+	  grow (rows, cols, count - available);
+      }
+
+      /// \brief Give back a buffer obtained through acquire ().
+      void release (B& buffer)
+      {
+	// The pool exists and its capacity has been reserved by grow.
+	find (buffer.rows (), buffer.cols ())->free.push_back (&buffer);
+      }
+
+      /// \brief Number of buffers owned by the workspace.
+      std::size_t size () const
+      {
+	return buffers_.size ();
+      }
+
+    private:
+      Workspace ()
+	: pools_ (),
+	  buffers_ ()
+      {}
+
+      /// \brief Allow Eigen allocations while in scope.
+      ///
+      /// Growing the workspace may happen inside an evaluation, where
+      /// Eigen allocations are forbidden when allocation checks are
+      /// enabled.
+      struct AllowMalloc
+      {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	AllowMalloc ()
+	  : allowed (Eigen::internal::is_malloc_allowed ())
+	{
+	  Eigen::internal::set_is_malloc_allowed (true);
+	}
+
+	~AllowMalloc ()
+	{
+	  Eigen::internal::set_is_malloc_allowed (allowed);
+	}
+
+	bool allowed;
+#else
+	AllowMalloc ()
+	{}
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      };
+
+      /// \brief Buffer size.
+      typedef std::pair<size_type, size_type> key_t;
+
+      /// \brief Buffers of a given size.
+      struct Pool
+      {
+	Pool ()
+	  : free (),
+	    size (0)
+	{}
+
+	/// \brief Available buffers.
+	std::vector<B*> free;
+	/// \brief Number of buffers of this size.
+	std::size_t size;
+      };
+
+      /// \brief Pool of a given size, or null if there is none yet.
+      Pool* find (size_type rows, size_type cols)
+      {
+	typename std::map<key_t, Pool>::iterator
+	  it = pools_.find (key_t (rows, cols));
+	return it == pools_.end () ? 0 : &it->second;
+      }
+
+      /// \brief Allocate count more buffers of a given size.
+      Pool& grow (size_type rows, size_type cols, std::size_t count)
+      {
+	AllowMalloc allow;
+	Pool& pool = pools_[key_t (rows, cols)];
+	// Reserve first so that neither push_back here nor release ()
+	// can throw.
+	buffers_.reserve (buffers_.size () + count);
+	pool.free.reserve (pool.size + count);
+	for (std::size_t i = 0; i < count; ++i)
+	  {
+	    B* buffer = new B (rows, cols);
+	    buffers_.push_back (buffer);
+	    pool.free.push_back (buffer);
+	    ++pool.size;
+	  }
+	return pool;
+      }
+
+      /// \brief Buffers, by size.
+      std::map<key_t, Pool> pools_;
+
+      /// \brief All the buffers owned by the workspace.
+      std::vector<B*> buffers_;
+
+      /// \brief Workspace of each thread.
+      static boost::thread_specific_ptr<Workspace> local_;
+    };
+
+    template <typename B>
+    boost::thread_specific_ptr<Workspace<B> > Workspace<B>::local_;
+
+    /// \brief Scratch buffer borrowed from the thread workspace.
+    ///
+    /// The buffer is given back to the workspace when this object is
+    /// destroyed. Its content is unspecified when acquired: callers
+    /// which do not overwrite it entirely (e.g. derivative buffers
+    /// handed to another function) must clear it first.
+    template <typename B>
+    class ScopedBuffer : public boost::noncopyable
+    {
+    public:
+      /// \brief Buffer size type.
+      typedef typename Workspace<B>::size_type size_type;
+
+      explicit ScopedBuffer (size_type rows, size_type cols = 1)
+	: workspace_ (Workspace<B>::local ()),
+	  buffer_ (workspace_.acquire (rows, cols))
+      {}
+
+      ~ScopedBuffer ()
+      {
+	workspace_.release (buffer_);
+      }
+
+      B& operator* () const
+      {
+	return buffer_;
+      }
+
+      B* operator-> () const
+      {
+	return &buffer_;
+      }
+
+    private:
+      Workspace<B>& workspace_;
+      B& buffer_;
+    };
+
+    /// \brief Reserve count buffers in the workspace of the calling thread.
+    ///
+    /// \see Workspace::reserve
+    template <typename B>
+    void reserveBuffer (typename Workspace<B>::size_type rows,
+			typename Workspace<B>::size_type cols = 1,
+			std::size_t count = 1)
+    {
+      Workspace<B>::local ().reserve (rows, cols, count);
+    }
+  } // end of namespace detail.
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_DETAIL_WORKSPACE_HH
@@ -33,12 +33,16 @@
   ROBOPTIM_FUNCTION_FWD_TYPEDEFS (PARENT);			\
   typedef parent_t::gradient_t gradient_t;			\
   typedef parent_t::jacobian_t jacobian_t;			\
+  typedef parent_t::jacobian_ref jacobian_ref;			\
+  typedef parent_t::const_jacobian_ref const_jacobian_ref;	\
   struct e_n_d__w_i_t_h__s_e_m_i_c_o_l_o_n
 
 # define ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_(PARENT)	\
   ROBOPTIM_FUNCTION_FWD_TYPEDEFS_ (PARENT);			\
   typedef typename parent_t::gradient_t gradient_t;		\
   typedef typename parent_t::jacobian_t jacobian_t;		\
+  typedef typename parent_t::jacobian_ref jacobian_ref;		\
+  typedef typename parent_t::const_jacobian_ref const_jacobian_ref; \
   struct e_n_d__w_i_t_h__s_e_m_i_c_o_l_o_n
 
 namespace roboptim
@@ -87,6 +91,14 @@ namespace roboptim
     typedef typename GenericFunctionTraits<T>::gradient_t gradient_t;
     /// \brief Jacobian type.
     typedef typename GenericFunctionTraits<T>::jacobian_t jacobian_t;
+    /// \brief Output type of a jacobian evaluation.
+    ///
+    /// Dense jacobians can be written into a block of a larger
+    /// matrix, sparse jacobians are written into a whole matrix.
+    typedef typename GenericFunctionTraits<T>::jacobian_ref jacobian_ref;
+    /// \brief Read-only view of a jacobian.
+    typedef typename GenericFunctionTraits<T>::const_jacobian_ref
+    const_jacobian_ref;
 
     /// \brief Jacobian size type (pair of values).
     typedef std::pair<size_type, size_type> jacobianSize_t;
@@ -120,7 +132,7 @@ namespace roboptim
     ///
     /// \param jacobian checked jacobian
     /// \return true if valid, false if not
-    bool isValidJacobian (const jacobian_t& jacobian) const throw ()
+    bool isValidJacobian (const_jacobian_ref jacobian) const throw ()
     {
       return jacobian.rows () == jacobianSize ().first
 	&& jacobian.cols () == jacobianSize ().second;
@@ -144,7 +156,7 @@ namespace roboptim
     /// or after the jacobian computation.
     /// \param jacobian jacobian will be stored in this argument
     /// \param argument point at which the jacobian will be computed
-    void jacobian (jacobian_t& jacobian, const argument_t& argument)
+    void jacobian (jacobian_ref jacobian, const argument_t& argument)
       const throw ()
     {
       LOG4CXX_TRACE (this->logger,
@@ -205,6 +217,53 @@ namespace roboptim
       assert (isValidGradient (gradient));
     }
 
+    /// \brief Computes the directional derivative.
+    ///
+    /// The directional derivative is the jacobian-vector product
+    /// \f$J(x) d\f$. With a unit direction, it is one column of the
+    /// jacobian.
+    ///
+    /// \param argument point at which the derivative will be computed
+    /// \param direction derivation direction
+    /// \return directional derivative
+    result_t directionalDerivative (const argument_t& argument,
+				    const argument_t& direction)
+      const throw ()
+    {
+      result_t derivative (this->outputSize ());
+      derivative.setZero ();
+      this->directionalDerivative (derivative, argument, direction);
+      return derivative;
+    }
+
+    /// \brief Computes the directional derivative.
+    ///
+    /// Program will abort if the derivative size is wrong before
+    /// or after the computation.
+    /// \param derivative derivative will be stored in this argument
+    /// \param argument point at which the derivative will be computed
+    /// \param direction derivation direction
+    void directionalDerivative (result_t& derivative,
+				const argument_t& argument,
+				const argument_t& direction) const throw ()
+    {
+      LOG4CXX_TRACE (this->logger,
+		     "Evaluating directional derivative at point: "
+		     << argument
+		     << " (direction: " << direction << ")");
+      assert (argument.size () == this->inputSize ());
+      assert (direction.size () == this->inputSize ());
+      assert (this->isValidResult (derivative));
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      Eigen::internal::set_is_malloc_allowed (false);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      this->impl_directionalDerivative (derivative, argument, direction);
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      Eigen::internal::set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      assert (this->isValidResult (derivative));
+    }
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
@@ -229,7 +288,23 @@ namespace roboptim
     /// \warning Do not call this function directly, call #jacobian instead.
     /// \param jacobian jacobian will be store in this argument
     /// \param arg point where the jacobian will be computed
-    virtual void impl_jacobian (jacobian_t& jacobian, const argument_t& arg)
+    virtual void impl_jacobian (jacobian_ref jacobian, const argument_t& arg)
+      const throw ();
+
+    /// \brief Directional derivative evaluation.
+    ///
+    /// Computes the jacobian-vector product, can be overridden by
+    /// concrete classes. The default behavior is to compute the whole
+    /// jacobian, concrete classes should propagate the direction
+    /// instead (forward mode) when they can.
+    /// \warning Do not call this function directly, call
+    /// #directionalDerivative instead.
+    /// \param derivative derivative will be stored in this argument
+    /// \param argument point where the derivative will be computed
+    /// \param direction derivation direction
+    virtual void impl_directionalDerivative (result_t& derivative,
+					     const argument_t& argument,
+					     const argument_t& direction)
       const throw ();
 
     /// \brief Gradient evaluation.
@@ -19,6 +19,7 @@
 # define ROBOPTIM_CORE_DIFFERENTIABLE_FUNCTION_HXX
 # include <boost/algorithm/string/replace.hpp>
 
+# include "roboptim/core/detail/workspace.hh"
 # include "roboptim/core/indent.hh"
 # include "roboptim/core/util.hh"
 
@@ -35,7 +36,7 @@ namespace roboptim
   template <>
   inline void
   GenericDifferentiableFunction<EigenMatrixSparse>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& argument)
+  (jacobian_ref jacobian, const argument_t& argument)
     const throw ()
   {
 #ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
@@ -62,7 +63,7 @@ namespace roboptim
 
   template <typename T>
   void
-  GenericDifferentiableFunction<T>::impl_jacobian (jacobian_t& jacobian,
+  GenericDifferentiableFunction<T>::impl_jacobian (jacobian_ref jacobian,
 						   const argument_t& argument)
     const throw ()
   {
@@ -73,6 +74,24 @@ namespace roboptim
       jacobian.row (i) = gradient (argument, i);
   }
 
+  template <typename T>
+  void
+  GenericDifferentiableFunction<T>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    Eigen::internal::set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    detail::ScopedBuffer<jacobian_t> jacobian
+      (this->outputSize (), this->inputSize ());
+    jacobian->setZero ();
+    this->jacobian (*jacobian, argument);
+    derivative = *jacobian * direction;
+  }
+
   template <typename T>
   std::ostream&
   GenericDifferentiableFunction<T>::print (std::ostream& o) const throw ()
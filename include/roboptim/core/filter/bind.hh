@@ -24,6 +24,7 @@
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 
@@ -33,6 +34,11 @@ namespace roboptim
   ///
   // This allows to reduce any function input space by setting some
   // inputs to particular values.
+  //
+  // The free and bound input indices are computed once when the
+  // filter is built. The bound values can then be updated without
+  // rebuilding the filter (i.e. to bind the current state of a
+  // receding-horizon controller at each step).
   template <typename U>
   class Bind : public detail::AutopromoteTrait<U>::T_type
   {
@@ -43,11 +49,19 @@ namespace roboptim
     typedef boost::shared_ptr<Bind> BindShPtr_t;
     typedef std::vector<boost::optional<value_type> > boundValues_t;
 
+    /// \brief Input indices vector.
+    typedef std::vector<size_type> indices_t;
+
     explicit Bind (boost::shared_ptr<U> origin,
 		   const boundValues_t& selector)
       throw (std::exception);
     ~Bind () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + origin_->version ();
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -58,22 +72,83 @@ namespace roboptim
       return origin_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    /// \brief Origin function indices of the free inputs.
+    const indices_t& freeIndices () const
+    {
+      return freeIndices_;
+    }
+
+    /// \brief Origin function indices of the bound inputs.
+    const indices_t& boundIndices () const
+    {
+      return boundIndices_;
+    }
+
+    /// \brief Bound values, in the boundIndices () order.
+    const vector_t& boundValues () const
+    {
+      return boundValues_;
+    }
+
+    /// \brief Update the bound values.
+    ///
+    /// Must not be called while the function is being evaluated.
+    /// \param boundValues new values, in the boundIndices () order
+    void setBoundValues (const vector_t& boundValues)
+      throw (std::runtime_error);
+
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
   private:
+    /// \brief Build the origin function argument.
+    ///
+    /// \param originX origin function argument
+    /// \param x free inputs
+    void originArgument (argument_t& originX, const argument_t& x)
+      const throw ();
+
+    /// \brief Keep the free columns of the origin gradient (dense case).
+    void freeGradient (gradient_t& gradient, const gradient_t& origin,
+		       EigenMatrixDense) const throw ();
+
+    /// \brief Keep the free columns of the origin gradient (sparse case).
+    void freeGradient (gradient_t& gradient, const gradient_t& origin,
+		       EigenMatrixSparse) const throw ();
+
+    /// \brief Keep the free columns of the origin jacobian (dense case).
+    void freeJacobian (jacobian_ref jacobian, const jacobian_t& origin,
+		       EigenMatrixDense) const throw ();
+
+    /// \brief Keep the free columns of the origin jacobian (sparse case).
+    void freeJacobian (jacobian_ref jacobian, const jacobian_t& origin,
+		       EigenMatrixSparse) const throw ();
+
     boost::shared_ptr<U> origin_;
-    boundValues_t boundValues_;
-    mutable argument_t x_;
-    mutable gradient_t gradient_;
-    mutable jacobian_t jacobian_;
+
+    /// \brief Origin function indices of the free inputs.
+    indices_t freeIndices_;
+
+    /// \brief Free input index of each origin function input, -1 if
+    /// the input is bound.
+    indices_t freePositions_;
+
+    /// \brief Origin function indices of the bound inputs.
+    indices_t boundIndices_;
+
+    /// \brief Bound values.
+    vector_t boundValues_;
   };
 
   template <typename U>
@@ -34,15 +34,12 @@ namespace roboptim
        (boost::format ("bind(%1%)")
 	% origin->getName ()).str ()),
       origin_ (origin),
-      boundValues_ (boundValues),
-      x_ (origin->inputSize ()),
-      gradient_ (origin->inputSize ()),
-      jacobian_ (origin->outputSize (),
-		 origin->inputSize ())
+      freeIndices_ (),
+      freePositions_ (boundValues.size (), -1),
+      boundIndices_ (),
+      boundValues_ (static_cast<size_type> (boundValues.size ())
+		    - this->inputSize ())
   {
-    gradient_.setZero ();
-    jacobian_.setZero ();
-
     if (origin->inputSize () -
 	static_cast<size_type> (boundValues.size ()) != 0)
       {
@@ -54,25 +51,69 @@ namespace roboptim
 	  % origin->inputSize () % boundValues.size ();
 	throw std::runtime_error (fmt.str ().c_str ());
       }
+
+    freeIndices_.reserve (static_cast<std::size_t> (this->inputSize ()));
+    boundIndices_.reserve (static_cast<std::size_t> (boundValues_.size ()));
+    for (std::size_t idx = 0; idx < boundValues.size (); ++idx)
+      if (boundValues[idx])
+	{
+	  boundValues_[static_cast<size_type> (boundIndices_.size ())] =
+	    *(boundValues[idx]);
+	  boundIndices_.push_back (static_cast<size_type> (idx));
+	}
+      else
+	{
+	  freePositions_[idx] = static_cast<size_type> (freeIndices_.size ());
+	  freeIndices_.push_back (static_cast<size_type> (idx));
+	}
+
+    detail::reserveBuffer<argument_t> (origin->inputSize (), 1, 2);
+    detail::reserveBuffer<gradient_t> (origin->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (origin->outputSize (), origin->inputSize ());
   }
 
   template <typename U>
   Bind<U>::~Bind () throw ()
   {}
 
+  template <typename U>
+  void
+  Bind<U>::setBoundValues (const vector_t& boundValues)
+    throw (std::runtime_error)
+  {
+    if (boundValues.size () != boundValues_.size ())
+      {
+	boost::format fmt
+	  ("bound values size (%d) does not match"
+	   " the number of bound inputs (%d)");
+	fmt % boundValues.size () % boundValues_.size ();
+	throw std::runtime_error (fmt.str ());
+      }
+    boundValues_ = boundValues;
+    this->touch ();
+  }
+
+  template <typename U>
+  void
+  Bind<U>::originArgument (argument_t& originX, const argument_t& x)
+    const throw ()
+  {
+    for (std::size_t i = 0; i < boundIndices_.size (); ++i)
+      originX[boundIndices_[i]] = boundValues_[static_cast<size_type> (i)];
+    for (std::size_t i = 0; i < freeIndices_.size (); ++i)
+      originX[freeIndices_[i]] = x[static_cast<size_type> (i)];
+  }
+
   template <typename U>
   void
   Bind<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = x[id++];
-    origin_->operator () (result, x_);
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    originArgument (*originX, x);
+    origin_->operator () (result, *originX);
   }
 
   template <typename U>
@@ -82,48 +123,112 @@ namespace roboptim
 			  size_type functionId)
     const throw ()
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = argument[id++];
-    origin_->gradient (gradient_, x_, functionId);
-
-    id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (!boundValues_[idx])
-	gradient.coeffRef (id++) =
-	  gradient_.coeffRef (static_cast<size_type> (idx));
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<gradient_t> originGradient (origin_->inputSize ());
+    originGradient->setZero ();
+    originArgument (*originX, argument);
+    origin_->gradient (*originGradient, *originX, functionId);
+    freeGradient (gradient, *originGradient,
+		  typename parentType_t::traits_t ());
   }
 
   template <typename U>
   void
-  Bind<U>::impl_jacobian (jacobian_t& jacobian,
+  Bind<U>::impl_jacobian (jacobian_ref jacobian,
 			  const argument_t& argument)
     const throw ()
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = argument[id++];
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<jacobian_t> originJacobian
+      (origin_->outputSize (), origin_->inputSize ());
+    originJacobian->setZero ();
+    originArgument (*originX, argument);
+    origin_->jacobian (*originJacobian, *originX);
+
+    assert (originJacobian->rows () == jacobian.rows ());
+    freeJacobian (jacobian, *originJacobian,
+		  typename parentType_t::traits_t ());
+  }
 
-    origin_->jacobian (jacobian_, x_);
+  template <typename U>
+  void
+  Bind<U>::freeGradient (gradient_t& gradient, const gradient_t& origin,
+			 EigenMatrixDense) const throw ()
+  {
+    for (std::size_t i = 0; i < freeIndices_.size (); ++i)
+      gradient[static_cast<size_type> (i)] = origin[freeIndices_[i]];
+  }
 
-    assert (jacobian_.rows () == jacobian.rows ());
+  template <typename U>
+  void
+  Bind<U>::freeGradient (gradient_t& gradient, const gradient_t& origin,
+			 EigenMatrixSparse) const throw ()
+  {
+    // Only the nonzeros are visited. Free positions increase with the
+    // origin indices: the coefficients are inserted in order.
+    gradient.setZero ();
+    gradient.reserve (origin.nonZeros ());
+    for (typename gradient_t::InnerIterator it (origin); it; ++it)
+      {
+	const size_type position =
+	  freePositions_[static_cast<std::size_t> (it.index ())];
+	if (position >= 0)
+	  gradient.insertBack (position) = it.value ();
+      }
+  }
 
-    id = 0;
-    for (size_type col = 0; col < jacobian_.cols (); ++col)
-      if (!boundValues_[static_cast<std::size_t> (col)])
-	{
-	  for (size_type row = 0; row < jacobian_.rows (); ++row)
-	    jacobian.coeffRef (row, id) = jacobian_.coeffRef (row, col);
-	  ++id;
-	}
+  template <typename U>
+  void
+  Bind<U>::freeJacobian (jacobian_ref jacobian, const jacobian_t& origin,
+			 EigenMatrixDense) const throw ()
+  {
+    for (std::size_t i = 0; i < freeIndices_.size (); ++i)
+      jacobian.col (static_cast<size_type> (i)) =
+	origin.col (freeIndices_[i]);
   }
 
+  template <typename U>
+  void
+  Bind<U>::freeJacobian (jacobian_ref jacobian, const jacobian_t& origin,
+			 EigenMatrixSparse) const throw ()
+  {
+    // Only the nonzeros are visited. The jacobian is row-major and
+    // free positions increase with the origin columns: each row is
+    // filled in order.
+    jacobian.setZero ();
+    jacobian.reserve (origin.nonZeros ());
+    for (size_type row = 0; row < origin.outerSize (); ++row)
+      {
+	jacobian.startVec (row);
+	for (typename jacobian_t::InnerIterator it (origin, row); it; ++it)
+	  {
+	    const size_type position =
+	      freePositions_[static_cast<std::size_t> (it.col ())];
+	    if (position >= 0)
+	      jacobian.insertBack (row, position) = it.value ();
+	  }
+      }
+    jacobian.finalize ();
+  }
+
+  template <typename U>
+  void
+  Bind<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<argument_t> originDirection (origin_->inputSize ());
+    originArgument (*originX, argument);
+    // Bound variables do not move: their direction stays zero.
+    originDirection->setZero ();
+    for (std::size_t i = 0; i < freeIndices_.size (); ++i)
+      (*originDirection)[freeIndices_[i]] =
+	direction[static_cast<size_type> (i)];
+    origin_->directionalDerivative (derivative, *originX, *originDirection);
+  }
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_FILTER_BIND_HXX
@@ -23,6 +23,8 @@
 # include <map>
 
 # include <boost/shared_ptr.hpp>
+# include <boost/thread/locks.hpp>
+# include <boost/thread/mutex.hpp>
 
 # include <roboptim/core/n-times-derivable-function.hh>
 
@@ -62,6 +64,10 @@ namespace roboptim
   /// point (exactly!), the cached function prevents useless
   /// computation by caching the function result.
   ///
+  /// The cache is shared by all the threads evaluating the function
+  /// and protected by a mutex. The wrapped function is evaluated
+  /// without holding the lock, so it must be reentrant itself.
+  ///
   /// This filter is experimental in this release.
   template <typename T>
   class CachedFunction : public T
@@ -81,6 +87,9 @@ namespace roboptim
     /// \brief Import result type.
     typedef typename GenericDifferentiableFunction<traits_t>::
     result_t result_t;
+    /// \brief Import result reference type.
+    typedef typename GenericDifferentiableFunction<traits_t>::
+    result_ref result_ref;
     /// \brief Import argument type.
     typedef typename GenericDifferentiableFunction<traits_t>::
     argument_t argument_t;
@@ -93,6 +102,9 @@ namespace roboptim
     /// \brief Import jacobian type.
     typedef typename GenericDifferentiableFunction<traits_t>::
     jacobian_t jacobian_t;
+    /// \brief Import jacobian reference type.
+    typedef typename GenericDifferentiableFunction<traits_t>::
+    jacobian_ref jacobian_ref;
     /// \brief Import interval type.
     typedef typename GenericDifferentiableFunction<traits_t>::
     interval_t interval_t;
@@ -110,10 +122,15 @@ namespace roboptim
     explicit CachedFunction (boost::shared_ptr<const T> fct) throw ();
     ~CachedFunction () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return T::version () + function_->version ();
+    }
+
     void reset () throw ();
 
   protected:
-    virtual void impl_compute (result_t& result, const argument_t& argument)
+    virtual void impl_compute (result_ref result, const argument_t& argument)
       const throw ();
 
 
@@ -122,7 +139,7 @@ namespace roboptim
 				size_type functionId = 0)
       const throw ();
 
-    virtual void impl_jacobian (jacobian_t& jacobian, const argument_t& arg)
+    virtual void impl_jacobian (jacobian_ref jacobian, const argument_t& arg)
       const throw ();
 
     virtual void impl_hessian (hessian_t& hessian,
@@ -139,6 +156,9 @@ namespace roboptim
     mutable std::vector<gradientCache_t> gradientCache_;
     mutable jacobianCache_t jacobianCache_;
     mutable std::vector<hessianCache_t> hessianCache_;
+
+    /// \brief Protect the caches.
+    mutable boost::mutex mutex_;
   };
 
   /// @}
@@ -44,7 +44,8 @@ namespace roboptim
       function_ (fct),
       cache_ (derivativeSize<T>::value),
       gradientCache_ (static_cast<std::size_t> (fct->outputSize ())),
-      hessianCache_ (static_cast<std::size_t> (fct->outputSize ()))
+      hessianCache_ (static_cast<std::size_t> (fct->outputSize ())),
+      mutex_ ()
   {
   }
 
@@ -57,6 +58,7 @@ namespace roboptim
   void
   CachedFunction<T>::reset () throw ()
   {
+    boost::lock_guard<boost::mutex> lock (mutex_);
     cache_.clear ();
     gradientCache_.clear ();
     hessianCache_.clear ();
@@ -65,18 +67,22 @@ namespace roboptim
 
   template <typename T>
   void
-  CachedFunction<T>::impl_compute (result_t& result,
+  CachedFunction<T>::impl_compute (result_ref result,
 				   const argument_t& argument)
     const throw ()
   {
-    typename CachedFunction<T>::functionCache_t::
-      const_iterator it = cache_[0].find (argument);
-    if (it != cache_[0].end ())
-      {
-        result = it->second;
-        return;
-      }
+    {
+      boost::lock_guard<boost::mutex> lock (mutex_);
+      typename CachedFunction<T>::functionCache_t::
+	const_iterator it = cache_[0].find (argument);
+      if (it != cache_[0].end ())
+	{
+	  result = it->second;
+	  return;
+	}
+    }
     (*function_) (result, argument);
+    boost::lock_guard<boost::mutex> lock (mutex_);
     cache_[0][argument] = result;
   }
 
@@ -108,15 +114,19 @@ namespace roboptim
                                     size_type functionId)
     const throw ()
   {
-    typename CachedFunction<T>::gradientCache_t::
-      const_iterator it = gradientCache_
-      [static_cast<std::size_t> (functionId)].find (argument);
-    if (it != gradientCache_[static_cast<std::size_t> (functionId)].end ())
-      {
-        gradient = it->second;
-        return;
-      }
+    {
+      boost::lock_guard<boost::mutex> lock (mutex_);
+      typename CachedFunction<T>::gradientCache_t::
+	const_iterator it = gradientCache_
+	[static_cast<std::size_t> (functionId)].find (argument);
+      if (it != gradientCache_[static_cast<std::size_t> (functionId)].end ())
+	{
+	  gradient = it->second;
+	  return;
+	}
+    }
     function_->gradient (gradient, argument, functionId);
+    boost::lock_guard<boost::mutex> lock (mutex_);
     gradientCache_[static_cast<std::size_t> (functionId)][argument]
       = gradient;
   }
@@ -125,7 +135,7 @@ namespace roboptim
   template <>
   inline void
   CachedFunction<Function>::impl_jacobian
-  (jacobian_t&,
+  (jacobian_ref ,
    const argument_t&) const throw ()
   {
     assert (0);
@@ -134,7 +144,7 @@ namespace roboptim
   template <>
   inline void
   CachedFunction<SparseFunction>::impl_jacobian
-  (jacobian_t&,
+  (jacobian_ref ,
    const argument_t&) const throw ()
   {
     assert (0);
@@ -144,17 +154,21 @@ namespace roboptim
   template <typename T>
   void
   CachedFunction<T>::impl_jacobian
-  (jacobian_t& jacobian,
+  (jacobian_ref jacobian,
    const argument_t& argument) const throw ()
   {
-    typename CachedFunction<T>::jacobianCache_t::
-      const_iterator it = jacobianCache_.find (argument);
-    if (it != jacobianCache_.end ())
-      {
-        jacobian = it->second;
-        return;
-      }
+    {
+      boost::lock_guard<boost::mutex> lock (mutex_);
+      typename CachedFunction<T>::jacobianCache_t::
+	const_iterator it = jacobianCache_.find (argument);
+      if (it != jacobianCache_.end ())
+	{
+	  jacobian = it->second;
+	  return;
+	}
+    }
     function_->jacobian (jacobian, argument);
+    boost::lock_guard<boost::mutex> lock (mutex_);
     jacobianCache_[argument] = jacobian;
   }
 
@@ -211,6 +225,7 @@ namespace roboptim
       }
 #endif
     function_->hessian (hessian, argument, functionId);
+    boost::lock_guard<boost::mutex> lock (mutex_);
     hessianCache_[static_cast<std::size_t> (functionId)][argument] = hessian;
   }
 
@@ -272,14 +287,18 @@ namespace roboptim
   {
     typename T::vector_t x (1);
     x[0] = argument;
-    typename CachedFunction<T>::functionCache_t::
-      const_iterator it = cache_[order].find (x);
-    if (it != cache_[order].end ())
-      {
-        derivative = it->second;
-        return;
-      }
+    {
+      boost::lock_guard<boost::mutex> lock (mutex_);
+      typename CachedFunction<T>::functionCache_t::
+	const_iterator it = cache_[order].find (x);
+      if (it != cache_[order].end ())
+	{
+	  derivative = it->second;
+	  return;
+	}
+    }
     function_->derivative (derivative, x, order);
+    boost::lock_guard<boost::mutex> lock (mutex_);
     cache_[order][x] = derivative;
   }
 
@@ -23,6 +23,8 @@
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/thread-local.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 
@@ -39,6 +41,18 @@ namespace roboptim
   ///
   /// (left (right (x)))' = left'(right(x)) * right'(x)
   ///
+  /// The right function result and jacobian are cached for the last
+  /// argument, so that evaluating the chain, its gradients and its
+  /// jacobian at the same point only evaluates the right function
+  /// once. The argument is the only key: if the right function value
+  /// changes for other reasons (i.e. parameter update), the cache
+  /// must be invalidated.
+  ///
+  /// When a single gradient is requested and the left gradient is
+  /// sparse enough, the gradient is computed as a
+  /// jacobian-transpose-vector product using only the needed right
+  /// function gradients instead of the whole right jacobian.
+  ///
   /// \param left Left function
   /// \param right Right function
   template <typename U, typename V>
@@ -54,6 +68,11 @@ namespace roboptim
       throw (std::runtime_error);
     ~Chain () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + left_->version () + right_->version ();
+    }
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
@@ -74,41 +93,91 @@ namespace roboptim
       return right_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    /// \brief Force the next evaluation of the right function in all
+    /// threads.
+    ///
+    /// Must not be called while the chain is being evaluated.
+    void invalidate () throw ()
+    {
+      ++generation_;
+    }
+
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
   private:
-    /// \brief Shared pointer to the left function.
-    boost::shared_ptr<U> left_;
-    /// \brief Shared pointer to the right function.
-    boost::shared_ptr<V> right_;
+    /// \brief Per-thread cache.
+    ///
+    /// Temporary buffers are borrowed from the thread workspace,
+    /// only the cached right function evaluation is kept here.
+    struct Buffers
+    {
+      /// \brief Right function result.
+      result_t rightResult;
+
+      /// \brief Right function jacobian.
+      jacobian_t jacobianRight;
 
-    /// \name Buffers
-    /// \{
+      /// \brief Argument for which rightResult has been computed.
+      argument_t rightResultArgument;
 
-    /// \brief Temporary buffer to store right function result.
-    mutable result_t rightResult_;
+      /// \brief Generation of rightResult.
+      std::size_t rightResultGeneration;
 
-    /// \brief Temporary buffer to store left function gradient.
-    mutable gradient_t gradientLeft_;
+      /// \brief Argument for which jacobianRight has been computed.
+      argument_t jacobianRightArgument;
 
-    /// \brief Temporary buffer to store right function gradient.
-    mutable gradient_t gradientRight_;
+      /// \brief Generation of jacobianRight.
+      std::size_t jacobianRightGeneration;
+    };
 
-    /// \brief Temporary buffer to store left function jacobian.
-    mutable jacobian_t jacobianLeft_;
+    /// \brief Is the cached right jacobian valid for x?
+    bool jacobianRightCached (const Buffers& buffers, const argument_t& x)
+      const throw ()
+    {
+      return buffers.jacobianRightGeneration == rightGeneration ()
+	&& buffers.jacobianRightArgument == x;
+    }
+
+    /// \brief Generation of the right function evaluations.
+    ///
+    /// Changes on invalidate () and whenever the version of the
+    /// right function changes.
+    std::size_t rightGeneration () const throw ()
+    {
+      return generation_ + right_->version ();
+    }
+
+    /// \brief Evaluate the right function at x unless already cached.
+    void updateRightResult (Buffers& buffers, const argument_t& x)
+      const throw ();
+
+    /// \brief Evaluate the right jacobian at x unless already cached.
+    void updateJacobianRight (Buffers& buffers, const argument_t& x)
+      const throw ();
+
+    /// \brief Shared pointer to the left function.
+    boost::shared_ptr<U> left_;
+    /// \brief Shared pointer to the right function.
+    boost::shared_ptr<V> right_;
 
-    /// \brief Temporary buffer to store right function jacobian.
-    mutable jacobian_t jacobianRight_;
+    /// \brief Current generation, the cached evaluations of previous
+    /// generations are invalid.
+    std::size_t generation_;
 
-    /// \}
+    /// \brief Buffers of each thread evaluating the function.
+    detail::ThreadLocal<Buffers> buffers_;
   };
 
   /// \brief Chain two RobOptim functions.
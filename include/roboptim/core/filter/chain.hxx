@@ -15,8 +15,8 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
 
-#ifndef ROBOPTIM_CORE_FILTER_PLUS_HXX
-# define ROBOPTIM_CORE_FILTER_PLUS_HXX
+#ifndef ROBOPTIM_CORE_FILTER_CHAIN_HXX
+# define ROBOPTIM_CORE_FILTER_CHAIN_HXX
 # include <boost/format.hpp>
 
 namespace roboptim
@@ -33,37 +33,73 @@ namespace roboptim
 	% right->getName ()).str ()),
       left_ (left),
       right_ (right),
-      rightResult_ (right->outputSize ()),
-      gradientLeft_ (left->inputSize ()),
-      gradientRight_ (right->inputSize ()),
-      jacobianLeft_ (left->outputSize (),
-		     left->inputSize ()),
-      jacobianRight_ (right->outputSize (),
-		      right->inputSize ())
+      generation_ (1),
+      buffers_ ()
   {
     if (left->inputSize () != right->outputSize ())
       throw std::runtime_error
 	("left input size and right output size mismatch");
 
-    rightResult_.setZero ();
-    gradientLeft_.setZero ();
-    gradientRight_.setZero ();
-    jacobianLeft_.setZero ();
-    jacobianRight_.setZero ();
+    Buffers& buffers = buffers_.prototype ();
+    buffers.rightResult.resize (right->outputSize ());
+    buffers.rightResult.setZero ();
+    buffers.jacobianRight.resize (right->outputSize (), right->inputSize ());
+    buffers.jacobianRight.setZero ();
+    buffers.rightResultArgument.resize (right->inputSize ());
+    buffers.rightResultArgument.setZero ();
+    buffers.rightResultGeneration = 0;
+    buffers.jacobianRightArgument.resize (right->inputSize ());
+    buffers.jacobianRightArgument.setZero ();
+    buffers.jacobianRightGeneration = 0;
+
+    detail::reserveBuffer<gradient_t> (left->inputSize ());
+    detail::reserveBuffer<gradient_t> (right->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (left->outputSize (), left->inputSize ());
   }
 
   template <typename U, typename V>
   Chain<U, V>::~Chain () throw ()
   {}
 
+  template <typename U, typename V>
+  void
+  Chain<U, V>::updateRightResult (Buffers& buffers, const argument_t& x)
+    const throw ()
+  {
+    const std::size_t generation = rightGeneration ();
+    if (buffers.rightResultGeneration == generation
+	&& buffers.rightResultArgument == x)
+      return;
+    (*right_) (buffers.rightResult, x);
+    buffers.rightResultArgument = x;
+    buffers.rightResultGeneration = generation;
+  }
+
+  template <typename U, typename V>
+  void
+  Chain<U, V>::updateJacobianRight (Buffers& buffers, const argument_t& x)
+    const throw ()
+  {
+    if (jacobianRightCached (buffers, x))
+      return;
+    // The buffer is reused: clear it as the public API does (sparse
+    // functions may insert their coefficients).
+    buffers.jacobianRight.setZero ();
+    right_->jacobian (buffers.jacobianRight, x);
+    buffers.jacobianRightArgument = x;
+    buffers.jacobianRightGeneration = rightGeneration ();
+  }
+
   template <typename U, typename V>
   void
   Chain<U, V>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    (*right_) (rightResult_, x);
-    (*left_) (result, rightResult_);
+    Buffers& buffers = buffers_.get ();
+    updateRightResult (buffers, x);
+    (*left_) (result, buffers.rightResult);
   }
 
   template <typename U, typename V>
@@ -73,24 +109,78 @@ namespace roboptim
 			 size_type functionId)
     const throw ()
   {
-    (*right_) (rightResult_, x);
-    left_->gradient (gradientLeft_, rightResult_, functionId);
-    right_->jacobian (jacobianRight_, x);
-    gradient = gradientLeft_.adjoint () * jacobianRight_;
+    Buffers& buffers = buffers_.get ();
+    detail::ScopedBuffer<gradient_t> gradientLeft (left_->inputSize ());
+    gradientLeft->setZero ();
+    updateRightResult (buffers, x);
+    left_->gradient (*gradientLeft, buffers.rightResult, functionId);
+
+    // Count the right function gradients needed by the row-wise
+    // product. If all the rows of the chain are requested, computing
+    // them row by row costs about outputSize times this value.
+    size_type nonZeros = 0;
+    for (size_type k = 0; k < right_->outputSize (); ++k)
+      if (gradientLeft->coeff (k) != 0.)
+	++nonZeros;
+
+    if (jacobianRightCached (buffers, x)
+	|| nonZeros * left_->outputSize () >= right_->outputSize ())
+      {
+	updateJacobianRight (buffers, x);
+	gradient = gradientLeft->adjoint () * buffers.jacobianRight;
+	return;
+      }
+
+    // Row-wise path: J_right^T * grad_left, skipping the right
+    // function outputs which do not contribute.
+    detail::ScopedBuffer<gradient_t> gradientRight (right_->inputSize ());
+    gradient.setZero ();
+    for (size_type k = 0; k < right_->outputSize (); ++k)
+      {
+	const value_type weight = gradientLeft->coeff (k);
+	if (weight == 0.)
+	  continue;
+	gradientRight->setZero ();
+	right_->gradient (*gradientRight, x, k);
+	gradient += weight * *gradientRight;
+      }
   }
 
   template <typename U, typename V>
   void
-  Chain<U, V>::impl_jacobian (jacobian_t& jacobian,
+  Chain<U, V>::impl_jacobian (jacobian_ref jacobian,
 			      const argument_t& x)
     const throw ()
   {
-    (*right_) (rightResult_, x);
-    left_->jacobian (jacobianLeft_, rightResult_);
-    right_->jacobian (jacobianRight_, x);
-    jacobian = jacobianLeft_ * jacobianRight_;
+    Buffers& buffers = buffers_.get ();
+    detail::ScopedBuffer<jacobian_t> jacobianLeft
+      (left_->outputSize (), left_->inputSize ());
+    jacobianLeft->setZero ();
+    updateRightResult (buffers, x);
+    left_->jacobian (*jacobianLeft, buffers.rightResult);
+    updateJacobianRight (buffers, x);
+    jacobian = *jacobianLeft * buffers.jacobianRight;
   }
 
+  template <typename U, typename V>
+  void
+  Chain<U, V>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    // Forward mode: J d = J_left (right (x)) (J_right (x) d).
+    Buffers& buffers = buffers_.get ();
+    detail::ScopedBuffer<result_t> derivativeRight (right_->outputSize ());
+    updateRightResult (buffers, argument);
+    if (jacobianRightCached (buffers, argument))
+      *derivativeRight = buffers.jacobianRight * direction;
+    else
+      right_->directionalDerivative (*derivativeRight, argument, direction);
+    left_->directionalDerivative
+      (derivative, buffers.rightResult, *derivativeRight);
+  }
 } // end of namespace roboptim.
 
-#endif //! ROBOPTIM_CORE_FILTER_PLUS_HXX
+#endif //! ROBOPTIM_CORE_FILTER_CHAIN_HXX
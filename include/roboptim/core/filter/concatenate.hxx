@@ -32,22 +32,17 @@ namespace roboptim
 	% left->getName ()
 	% right->getName ()).str ()),
       left_ (left),
-      right_ (right),
-      resultLeft_ (left->outputSize ()),
-      resultRight_ (right->outputSize ()),
-      jacobianLeft_ (left->outputSize (),
-		     left->inputSize ()),
-      jacobianRight_ (right->outputSize (),
-		      right->inputSize ())
-
+      right_ (right)
   {
     if (left->inputSize () != right->inputSize ())
       throw std::runtime_error ("left and right input size are not the same");
 
-    resultLeft_.setZero ();
-    resultRight_.setZero ();
-    jacobianLeft_.setZero ();
-    jacobianRight_.setZero ();
+    detail::reserveBuffer<result_t> (left->outputSize ());
+    detail::reserveBuffer<result_t> (right->outputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (left->outputSize (), left->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (right->outputSize (), right->inputSize ());
   }
 
   template <typename U>
@@ -57,13 +52,16 @@ namespace roboptim
   template <typename U>
   void
   Concatenate<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    left_->operator () (resultLeft_, x);
-    right_->operator () (resultRight_, x);
-    result.segment (0, left_->outputSize ()) = resultLeft_;
-    result.segment (left_->inputSize (), right_->outputSize ()) = resultRight_;
+    detail::ScopedBuffer<result_t> resultLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> resultRight (right_->outputSize ());
+    left_->operator () (*resultLeft, x);
+    right_->operator () (*resultRight, x);
+    result.segment (0, left_->outputSize ()) = *resultLeft;
+    result.segment (left_->outputSize (), right_->outputSize ()) =
+      *resultRight;
   }
 
   template <typename U>
@@ -81,16 +79,39 @@ namespace roboptim
 
   template <typename U>
   void
-  Concatenate<U>::impl_jacobian (jacobian_t& jacobian,
+  Concatenate<U>::impl_jacobian (jacobian_ref jacobian,
 				 const argument_t& x)
     const throw ()
   {
-    left_->jacobian (jacobianLeft_, x);
-    right_->jacobian (jacobianRight_, x);
+    detail::ScopedBuffer<jacobian_t> jacobianLeft
+      (left_->outputSize (), left_->inputSize ());
+    detail::ScopedBuffer<jacobian_t> jacobianRight
+      (right_->outputSize (), right_->inputSize ());
+    jacobianLeft->setZero ();
+    jacobianRight->setZero ();
+    left_->jacobian (*jacobianLeft, x);
+    right_->jacobian (*jacobianRight, x);
     jacobian.middleRows (0, left_->outputSize ()) =
-      jacobianLeft_;
+      *jacobianLeft;
     jacobian.middleRows (left_->outputSize (), right_->outputSize ()) =
-      jacobianRight_;
+      *jacobianRight;
+  }
+
+  template <typename U>
+  void
+  Concatenate<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<result_t> derivativeLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> derivativeRight (right_->outputSize ());
+    left_->directionalDerivative (*derivativeLeft, argument, direction);
+    right_->directionalDerivative (*derivativeRight, argument, direction);
+    derivative.segment (0, left_->outputSize ()) = *derivativeLeft;
+    derivative.segment (left_->outputSize (), right_->outputSize ()) =
+      *derivativeRight;
   }
 } // end of namespace roboptim.
 
@@ -25,6 +25,7 @@
 # include <boost/type_traits/is_base_of.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 
@@ -32,6 +33,9 @@ namespace roboptim
 {
   /// \brief Return the derivative of a function.
   ///
+  /// The derivative is evaluated through the directional derivative
+  /// of the origin function, without computing its whole jacobian.
+  ///
   /// Know issue: for now it returns a non-differentiable function.
   template <typename U>
   class Derivative;
@@ -75,18 +79,24 @@ namespace roboptim
 	 origin->outputSize (),
 	 "derivative of " + origin->getName ()),
 	origin_ (origin),
-	variableId_ (variableId),
-	jacobian_ (origin->outputSize (),
-		   origin->inputSize ()),
-	hessian_ (origin->inputSize (),
-		  origin->inputSize ())
+	variableId_ (variableId)
     {
       assert (variableId_ < this->inputSize ());
+
+      detail::reserveBuffer<argument_t> (origin->inputSize ());
+      detail::reserveBuffer<typename U::result_t> (origin->outputSize ());
+      detail::reserveBuffer<matrix_t>
+	(origin->inputSize (), origin->inputSize ());
     }
 
     ~Derivative () throw ()
     {}
 
+    std::size_t version () const throw ()
+    {
+      return parent_t::version () + origin_->version ();
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -98,12 +108,17 @@ namespace roboptim
     }
 
   protected:
-    // FIXME: this is inefficient.
-    void impl_compute (result_t& result, const argument_t& x)
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ()
     {
-      origin_->jacobian (jacobian_, x);
-      result = jacobian_.block (0, variableId_, this->outputSize (), 1);
+      // One column of the jacobian: derivative along the unit vector.
+      detail::ScopedBuffer<argument_t> direction (origin_->inputSize ());
+      direction->setZero ();
+      (*direction)[variableId_] = 1.;
+      detail::ScopedBuffer<typename U::result_t> derivative
+	(origin_->outputSize ());
+      origin_->directionalDerivative (*derivative, x, *direction);
+      result = *derivative;
     }
 
     void impl_gradient (gradient_t& gradient,
@@ -111,16 +126,18 @@ namespace roboptim
 			size_type functionId = 0)
       const throw ()
     {
-      origin_->hessian (hessian_, x, functionId);
-      for (size_type i = 0; i < this->inputSize (); ++i)
-	gradient.coeffRef (i) = hessian_.coeffRef (i, i);
+      // Gradient of one jacobian column: one row of the (symmetric)
+      // hessian.
+      detail::ScopedBuffer<matrix_t> hessian
+	(origin_->inputSize (), origin_->inputSize ());
+      hessian->setZero ();
+      origin_->hessian (*hessian, x, functionId);
+      gradient = hessian->row (variableId_).transpose ();
     }
 
   private:
     boost::shared_ptr<U> origin_;
     size_type variableId_;
-    mutable matrix_t jacobian_;
-    mutable matrix_t hessian_;
   };
 
   template <typename U>
@@ -21,6 +21,7 @@
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 
@@ -45,6 +46,11 @@ namespace roboptim
     explicit Map (boost::shared_ptr<U> origin, size_type repeat) throw ();
     ~Map () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + origin_->version ();
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -55,24 +61,23 @@ namespace roboptim
       return origin_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
   private:
     boost::shared_ptr<U> origin_;
     size_type repeat_;
-
-    mutable argument_t x_;
-    mutable result_t result_;
-    mutable gradient_t gradient_;
-    mutable jacobian_t jacobian_;
   };
 
   template <typename U>
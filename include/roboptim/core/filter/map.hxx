@@ -32,17 +32,13 @@ namespace roboptim
 	% origin->getName ()
 	% repeat).str ()),
       origin_ (origin),
-      repeat_ (repeat),
-      x_ (origin->inputSize ()),
-      result_ (origin->outputSize ()),
-      gradient_ (origin->inputSize ()),
-      jacobian_ (origin->outputSize (),
-		 origin->inputSize ())
+      repeat_ (repeat)
   {
-    x_.setZero ();
-    result_.setZero ();
-    gradient_.setZero ();
-    jacobian_.setZero ();
+    detail::reserveBuffer<argument_t> (origin->inputSize ());
+    detail::reserveBuffer<result_t> (origin->outputSize ());
+    detail::reserveBuffer<gradient_t> (origin->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (origin->outputSize (), origin->inputSize ());
   }
 
   template <typename U>
@@ -52,15 +48,18 @@ namespace roboptim
   template <typename U>
   void
   Map<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<result_t> originResult (origin_->outputSize ());
     for (size_type i = 0; i < repeat_; ++i)
       {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->operator () (result_, x_);
+	*originX =
+	  x.segment (i * origin_->inputSize (), origin_->inputSize ());
+	origin_->operator () (*originResult, *originX);
 	result.segment (i * origin_->outputSize (), origin_->outputSize ()) =
-	  result_;
+	  *originResult;
       }
   }
 
@@ -71,28 +70,37 @@ namespace roboptim
 			 size_type functionId)
     const throw ()
   {
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<gradient_t> originGradient (origin_->inputSize ());
     for (size_type i = 0; i < repeat_; ++i)
       {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->gradient (gradient_, x_, functionId);
+	*originX =
+	  x.segment (i * origin_->inputSize (), origin_->inputSize ());
+	originGradient->setZero ();
+	origin_->gradient (*originGradient, *originX, functionId);
 
 	//FIXME: should be a segment but Eigen support is still preliminary.
 	for (size_type idx = 0; idx < origin_->inputSize (); ++idx)
 	  gradient.coeffRef (i * origin_->inputSize () + idx) =
-	    gradient_.coeffRef (idx);
+	    originGradient->coeffRef (idx);
       }
   }
 
   template <typename U>
   void
-  Map<U>::impl_jacobian (jacobian_t& jacobian,
+  Map<U>::impl_jacobian (jacobian_ref jacobian,
 			 const argument_t& x)
     const throw ()
   {
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<jacobian_t> originJacobian
+      (origin_->outputSize (), origin_->inputSize ());
     for (size_type i = 0; i < repeat_; ++i)
       {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->jacobian (jacobian_, x_);
+	*originX =
+	  x.segment (i * origin_->inputSize (), origin_->inputSize ());
+	originJacobian->setZero ();
+	origin_->jacobian (*originJacobian, *originX);
 
 	//FIXME: should be a block but Eigen support is still preliminary.
 	for (size_type idx_i = 0; idx_i < origin_->outputSize (); ++idx_i)
@@ -100,10 +108,34 @@ namespace roboptim
 	    jacobian.coeffRef
 	      (i * origin_->outputSize () + idx_i,
 	       i * origin_->inputSize () + idx_j) =
-	      jacobian_.coeffRef (idx_i, idx_j);
+	      originJacobian->coeffRef (idx_i, idx_j);
       }
   }
 
+  template <typename U>
+  void
+  Map<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (origin_->inputSize ());
+    detail::ScopedBuffer<argument_t> originDirection (origin_->inputSize ());
+    detail::ScopedBuffer<result_t> originDerivative (origin_->outputSize ());
+    for (size_type i = 0; i < repeat_; ++i)
+      {
+	*originX =
+	  argument.segment (i * origin_->inputSize (), origin_->inputSize ());
+	*originDirection =
+	  direction.segment (i * origin_->inputSize (), origin_->inputSize ());
+	origin_->directionalDerivative
+	  (*originDerivative, *originX, *originDirection);
+	derivative.segment
+	  (i * origin_->outputSize (), origin_->outputSize ()) =
+	  *originDerivative;
+      }
+  }
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_FILTER_MAP_HXX
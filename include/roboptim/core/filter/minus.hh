@@ -22,6 +22,7 @@
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 namespace roboptim
@@ -40,6 +41,11 @@ namespace roboptim
       throw (std::runtime_error);
     ~Minus () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + left_->version () + right_->version ();
+    }
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
@@ -60,23 +66,23 @@ namespace roboptim
       return right_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
   private:
     boost::shared_ptr<U> left_;
     boost::shared_ptr<V> right_;
-
-    mutable result_t result_;
-    mutable gradient_t gradient_;
-    mutable jacobian_t jacobian_;
   };
 
   template <typename U, typename V>
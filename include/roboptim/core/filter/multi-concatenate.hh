@@ -0,0 +1,164 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HH
+# define ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HH
+# include <stdexcept>
+# include <vector>
+# include <boost/make_shared.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/thread-local.hh>
+# include <roboptim/core/detail/workspace.hh>
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/thread-pool.hh>
+
+
+namespace roboptim
+{
+  /// \brief Concatenate the output of any number of functions.
+  ///
+  /// This is the n-ary version of Concatenate: stacking n functions
+  /// does not build a n-deep tree of binary filters. Each function
+  /// is evaluated directly into its rows of the result (and of the
+  /// jacobian when dense) and each gradient is directly computed by
+  /// the corresponding function.
+  ///
+  /// If a thread pool is set, the functions are evaluated
+  /// concurrently. In that case, the functions must be reentrant
+  /// (filters are) if the same function object appears twice in
+  /// the list.
+  template <typename U>
+  class MultiConcatenate : public detail::AutopromoteTrait<U>::T_type
+  {
+  public:
+    typedef typename detail::AutopromoteTrait<U>::T_type parentType_t;
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
+
+    typedef boost::shared_ptr<MultiConcatenate> MultiConcatenateShPtr_t;
+
+    /// \brief Vector of concatenated functions.
+    typedef std::vector<boost::shared_ptr<U> > functions_t;
+
+    explicit MultiConcatenate (const functions_t& functions)
+      throw (std::runtime_error);
+    ~MultiConcatenate () throw ();
+
+    std::size_t version () const throw ()
+    {
+      std::size_t version = parentType_t::version ();
+      for (std::size_t i = 0; i < functions_.size (); ++i)
+	version += functions_[i]->version ();
+      return version;
+    }
+
+    const functions_t& functions () const
+    {
+      return functions_;
+    }
+
+    /// \brief Offset of the first output of a function.
+    ///
+    /// \param i function index
+    size_type offset (std::size_t i) const
+    {
+      return offsets_[i];
+    }
+
+    /// \brief Evaluate the functions concurrently on a thread pool.
+    ///
+    /// \param pool pool used for evaluation, null to disable
+    /// concurrent evaluation.
+    void setThreadPool (ThreadPool* pool) throw ()
+    {
+      threadPool_ = pool;
+    }
+
+    void impl_compute (result_ref result, const argument_t& x)
+      const throw ();
+
+    void impl_gradient (gradient_t& gradient,
+			const argument_t& argument,
+			size_type functionId = 0)
+      const throw ();
+    void impl_jacobian (jacobian_ref jacobian,
+			const argument_t& arg)
+      const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
+  private:
+    /// \brief Per-thread buffers.
+    ///
+    /// Sparse jacobians cannot be evaluated into a block of a larger
+    /// matrix: they are computed into these buffers, then copied.
+    struct Buffers
+    {
+      /// \brief Sparse jacobian of each function.
+      std::vector<jacobian_t> jacobians;
+    };
+
+    /// \brief Evaluate one function into its rows of the result.
+    void computeFunction (result_ref result, const argument_t& x,
+			  std::size_t i) const;
+
+    /// \brief Compute the jacobian of one function into its rows.
+    void computeJacobian (jacobian_ref jacobian, const argument_t& x,
+			  std::size_t i) const;
+
+    /// \brief Compute the sparse jacobian of one function into its
+    /// buffer.
+    void computeSparseJacobian (Buffers& buffers, const argument_t& x,
+				std::size_t i) const;
+
+    /// \brief Stack the functions jacobians (dense case).
+    void stackJacobians (jacobian_ref jacobian, const argument_t& x,
+			 EigenMatrixDense) const;
+
+    /// \brief Stack the functions jacobians (sparse case).
+    void stackJacobians (jacobian_ref jacobian, const argument_t& x,
+			 EigenMatrixSparse) const;
+
+    /// \brief Run a task for each function, possibly concurrently.
+    void forEachFunction (const ThreadPool::task_t& task) const;
+
+    functions_t functions_;
+
+    /// \brief Offset of each function output (plus total output size).
+    std::vector<size_type> offsets_;
+
+    /// \brief Thread pool used for concurrent evaluation (may be null).
+    ThreadPool* threadPool_;
+
+    /// \brief Buffers of each thread evaluating the function.
+    detail::ThreadLocal<Buffers> buffers_;
+  };
+
+  /// \brief Concatenate any number of functions.
+  template <typename U>
+  boost::shared_ptr<MultiConcatenate<U> >
+  concatenate (const std::vector<boost::shared_ptr<U> >& functions)
+  {
+    return boost::make_shared<MultiConcatenate<U> > (functions);
+  }
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/filter/multi-concatenate.hxx>
+#endif //! ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HH
@@ -0,0 +1,231 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HXX
+# define ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HXX
+# include <algorithm>
+# include <boost/bind.hpp>
+# include <boost/format.hpp>
+# include <boost/type_traits/is_same.hpp>
+
+namespace roboptim
+{
+  namespace
+  {
+    template <typename U>
+    typename U::size_type
+    multiConcatenateOutputSize
+    (const std::vector<boost::shared_ptr<U> >& functions)
+    {
+      typename U::size_type size = 0;
+      for (std::size_t i = 0; i < functions.size (); ++i)
+	size += functions[i]->outputSize ();
+      return size;
+    }
+
+    template <typename U>
+    std::string
+    multiConcatenateName
+    (const std::vector<boost::shared_ptr<U> >& functions)
+    {
+      std::string name = "concatenate(";
+      for (std::size_t i = 0; i < functions.size (); ++i)
+	{
+	  if (i > 0)
+	    name += ", ";
+	  name += functions[i]->getName ();
+	}
+      return name + ")";
+    }
+  } // end of anonymous namespace.
+
+  template <typename U>
+  MultiConcatenate<U>::MultiConcatenate
+  (const functions_t& functions) throw (std::runtime_error)
+    : detail::AutopromoteTrait<U>::T_type
+      (functions.empty () ? 1 : functions[0]->inputSize (),
+       functions.empty () ? 1 : multiConcatenateOutputSize (functions),
+       multiConcatenateName (functions)),
+      functions_ (functions),
+      offsets_ (functions.size () + 1),
+      threadPool_ (0),
+      buffers_ ()
+  {
+    if (functions.empty ())
+      throw std::runtime_error ("no function to concatenate");
+
+    // Only sparse jacobians need buffers.
+    const bool sparse =
+      boost::is_same<typename parentType_t::traits_t,
+		     EigenMatrixSparse>::value;
+    Buffers& buffers = buffers_.prototype ();
+    if (sparse)
+      buffers.jacobians.resize (functions.size ());
+
+    offsets_[0] = 0;
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      {
+	if (functions_[i]->inputSize () != this->inputSize ())
+	  {
+	    boost::format fmt
+	      ("function \"%s\" input size (%d) does not match"
+	       " the first function input size (%d)");
+	    fmt
+	      % functions_[i]->getName ()
+	      % functions_[i]->inputSize ()
+	      % this->inputSize ();
+	    throw std::runtime_error (fmt.str ());
+	  }
+
+	offsets_[i + 1] = offsets_[i] + functions_[i]->outputSize ();
+
+	if (sparse)
+	  buffers.jacobians[i].resize (functions_[i]->outputSize (),
+				       functions_[i]->inputSize ());
+      }
+  }
+
+  template <typename U>
+  MultiConcatenate<U>::~MultiConcatenate () throw ()
+  {}
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::computeFunction (result_ref result,
+					const argument_t& x,
+					std::size_t i) const
+  {
+    (*functions_[i])
+      (result.segment (offsets_[i], functions_[i]->outputSize ()), x);
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::computeJacobian (jacobian_ref jacobian,
+					const argument_t& x,
+					std::size_t i) const
+  {
+    const size_type rows = functions_[i]->outputSize ();
+    // Clear the rows as the public API does.
+    jacobian.middleRows (offsets_[i], rows).setZero ();
+    functions_[i]->jacobian (jacobian.middleRows (offsets_[i], rows), x);
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::computeSparseJacobian (Buffers& buffers,
+					      const argument_t& x,
+					      std::size_t i) const
+  {
+    // Buffers are reused: clear them as the public API does.
+    buffers.jacobians[i].setZero ();
+    functions_[i]->jacobian (buffers.jacobians[i], x);
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::forEachFunction (const ThreadPool::task_t& task) const
+  {
+    if (threadPool_)
+      threadPool_->run (functions_.size (), task);
+    else
+      for (std::size_t i = 0; i < functions_.size (); ++i)
+	task (i);
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::impl_compute
+  (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    forEachFunction (boost::bind (&MultiConcatenate<U>::computeFunction,
+				  this, result, boost::cref (x), _1));
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::impl_gradient (gradient_t& gradient,
+				      const argument_t& x,
+				      size_type functionId)
+    const throw ()
+  {
+    // Find the function computing this output.
+    std::size_t i = static_cast<std::size_t>
+      (std::upper_bound (offsets_.begin (), offsets_.end (), functionId)
+       - offsets_.begin ()) - 1;
+    functions_[i]->gradient (gradient, x, functionId - offsets_[i]);
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::impl_jacobian (jacobian_ref jacobian,
+				      const argument_t& x)
+    const throw ()
+  {
+    stackJacobians (jacobian, x, typename parentType_t::traits_t ());
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::stackJacobians (jacobian_ref jacobian,
+				       const argument_t& x,
+				       EigenMatrixDense) const
+  {
+    forEachFunction (boost::bind (&MultiConcatenate<U>::computeJacobian,
+				  this, jacobian, boost::cref (x), _1));
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::stackJacobians (jacobian_ref jacobian,
+				       const argument_t& x,
+				       EigenMatrixSparse) const
+  {
+    // The tasks may run in other threads: they use the buffers of
+    // the calling thread.
+    Buffers& buffers = buffers_.get ();
+    forEachFunction
+      (boost::bind (&MultiConcatenate<U>::computeSparseJacobian,
+		    this, boost::ref (buffers), boost::cref (x), _1));
+
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      jacobian.middleRows (offsets_[i], functions_[i]->outputSize ()) =
+	buffers.jacobians[i];
+  }
+
+  template <typename U>
+  void
+  MultiConcatenate<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      {
+	detail::ScopedBuffer<result_t> functionDerivative
+	  (functions_[i]->outputSize ());
+	functions_[i]->directionalDerivative
+	  (*functionDerivative, argument, direction);
+	derivative.segment (offsets_[i], functions_[i]->outputSize ()) =
+	  *functionDerivative;
+      }
+  }
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_FILTER_MULTI_CONCATENATE_HXX
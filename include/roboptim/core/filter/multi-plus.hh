@@ -0,0 +1,168 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_MULTI_PLUS_HH
+# define ROBOPTIM_CORE_FILTER_MULTI_PLUS_HH
+# include <stdexcept>
+# include <vector>
+# include <boost/make_shared.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/thread-local.hh>
+# include <roboptim/core/detail/workspace.hh>
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/thread-pool.hh>
+
+namespace roboptim
+{
+  /// \brief Sum any number of RobOptim functions.
+  ///
+  /// This is the n-ary version of Plus: summing n functions uses one
+  /// buffer per function instead of a n-deep tree of binary filters.
+  ///
+  /// If a thread pool is set, the functions are evaluated
+  /// concurrently. In that case, the functions must be reentrant
+  /// (filters are) if the same function object appears twice in
+  /// the list.
+  template <typename U>
+  class MultiPlus : public detail::AutopromoteTrait<U>::T_type
+  {
+  public:
+    typedef typename detail::AutopromoteTrait<U>::T_type parentType_t;
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
+
+    typedef boost::shared_ptr<MultiPlus> MultiPlusShPtr_t;
+
+    /// \brief Vector of summed functions.
+    typedef std::vector<boost::shared_ptr<U> > functions_t;
+
+    explicit MultiPlus (const functions_t& functions)
+      throw (std::runtime_error);
+    ~MultiPlus () throw ();
+
+    std::size_t version () const throw ()
+    {
+      std::size_t version = parentType_t::version ();
+      for (std::size_t i = 0; i < functions_.size (); ++i)
+	version += functions_[i]->version ();
+      return version;
+    }
+
+    const functions_t& functions () const
+    {
+      return functions_;
+    }
+
+    /// \brief Evaluate the functions concurrently on a thread pool.
+    ///
+    /// \param pool pool used for evaluation, null to disable
+    /// concurrent evaluation.
+    void setThreadPool (ThreadPool* pool) throw ()
+    {
+      threadPool_ = pool;
+    }
+
+    void impl_compute (result_ref result, const argument_t& x)
+      const throw ();
+
+    void impl_gradient (gradient_t& gradient,
+			const argument_t& argument,
+			size_type functionId = 0)
+      const throw ();
+    void impl_jacobian (jacobian_ref jacobian,
+			const argument_t& arg)
+      const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
+  private:
+    /// \brief Dense matrix type.
+    typedef Eigen::Matrix<value_type, Eigen::Dynamic, Eigen::Dynamic>
+    denseMatrix_t;
+
+    /// \brief Per-thread buffers.
+    ///
+    /// The first function writes directly into the output. The
+    /// others write directly into one column of a single results
+    /// matrix (resp. one block of rows of a single stacked dense
+    /// jacobian), which is then summed.
+    struct Buffers
+    {
+      /// \brief Result of each function but the first, by column.
+      denseMatrix_t results;
+      /// \brief Gradient of each function.
+      std::vector<gradient_t> gradients;
+      /// \brief Stacked dense jacobians of each function but the first.
+      jacobian_t jacobians;
+      /// \brief Sparse jacobian of each function.
+      std::vector<jacobian_t> sparseJacobians;
+    };
+
+    /// \brief Evaluate one function.
+    ///
+    /// The first function is evaluated directly into the result,
+    /// the others into their column of the results matrix.
+    void computeFunction (Buffers& buffers, result_ref result,
+			  const argument_t& x, std::size_t i) const;
+
+    /// \brief Compute one function gradient.
+    void computeGradient (Buffers& buffers, gradient_t& gradient,
+			  const argument_t& x, size_type functionId,
+			  std::size_t i) const;
+
+    /// \brief Compute the dense jacobian of one function.
+    void computeJacobian (Buffers& buffers, jacobian_ref jacobian,
+			  const argument_t& x, std::size_t i) const;
+
+    /// \brief Compute the sparse jacobian of one function.
+    void computeSparseJacobian (Buffers& buffers, jacobian_ref jacobian,
+				const argument_t& x, std::size_t i) const;
+
+    /// \brief Sum the functions jacobians (dense case).
+    void sumJacobians (Buffers& buffers, jacobian_ref jacobian,
+		       const argument_t& x, EigenMatrixDense) const;
+
+    /// \brief Sum the functions jacobians (sparse case).
+    void sumJacobians (Buffers& buffers, jacobian_ref jacobian,
+		       const argument_t& x, EigenMatrixSparse) const;
+
+    /// \brief Run a task for each function, possibly concurrently.
+    void forEachFunction (const ThreadPool::task_t& task) const;
+
+    functions_t functions_;
+
+    /// \brief Thread pool used for concurrent evaluation (may be null).
+    ThreadPool* threadPool_;
+
+    /// \brief Buffers of each thread evaluating the function.
+    detail::ThreadLocal<Buffers> buffers_;
+  };
+
+  /// \brief Sum any number of functions.
+  template <typename U>
+  boost::shared_ptr<MultiPlus<U> >
+  plus (const std::vector<boost::shared_ptr<U> >& functions)
+  {
+    return boost::make_shared<MultiPlus<U> > (functions);
+  }
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/filter/multi-plus.hxx>
+#endif //! ROBOPTIM_CORE_FILTER_MULTI_PLUS_HH
@@ -0,0 +1,259 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_MULTI_PLUS_HXX
+# define ROBOPTIM_CORE_FILTER_MULTI_PLUS_HXX
+# include <boost/bind.hpp>
+# include <boost/format.hpp>
+# include <boost/type_traits/is_same.hpp>
+
+namespace roboptim
+{
+  namespace
+  {
+    template <typename U>
+    std::string
+    multiPlusName (const std::vector<boost::shared_ptr<U> >& functions)
+    {
+      std::string name;
+      for (std::size_t i = 0; i < functions.size (); ++i)
+	{
+	  if (i > 0)
+	    name += " + ";
+	  name += functions[i]->getName ();
+	}
+      return name;
+    }
+  } // end of anonymous namespace.
+
+  template <typename U>
+  MultiPlus<U>::MultiPlus
+  (const functions_t& functions) throw (std::runtime_error)
+    : detail::AutopromoteTrait<U>::T_type
+      (functions.empty () ? 1 : functions[0]->inputSize (),
+       functions.empty () ? 1 : functions[0]->outputSize (),
+       multiPlusName (functions)),
+      functions_ (functions),
+      threadPool_ (0),
+      buffers_ ()
+  {
+    if (functions.empty ())
+      throw std::runtime_error ("no function to sum");
+
+    const bool sparse =
+      boost::is_same<typename parentType_t::traits_t,
+		     EigenMatrixSparse>::value;
+    const size_type others = static_cast<size_type> (functions.size () - 1);
+
+    // The first function writes directly into the output.
+    Buffers& buffers = buffers_.prototype ();
+    buffers.results.resize (this->outputSize (), others);
+    buffers.results.setZero ();
+    buffers.gradients.resize (functions.size ());
+    if (sparse)
+      buffers.sparseJacobians.resize (functions.size ());
+    else
+      buffers.jacobians.resize (others * this->outputSize (),
+				this->inputSize ());
+
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      {
+	if (functions_[i]->inputSize () != this->inputSize ()
+	    || functions_[i]->outputSize () != this->outputSize ())
+	  {
+	    boost::format fmt
+	      ("function \"%s\" size (%d, %d) does not match"
+	       " the first function size (%d, %d)");
+	    fmt
+	      % functions_[i]->getName ()
+	      % functions_[i]->inputSize ()
+	      % functions_[i]->outputSize ()
+	      % this->inputSize ()
+	      % this->outputSize ();
+	    throw std::runtime_error (fmt.str ());
+	  }
+
+	if (!i)
+	  continue;
+
+	buffers.gradients[i].resize (this->inputSize ());
+	buffers.gradients[i].setZero ();
+	if (sparse)
+	  buffers.sparseJacobians[i].resize (this->outputSize (),
+					     this->inputSize ());
+      }
+  }
+
+  template <typename U>
+  MultiPlus<U>::~MultiPlus () throw ()
+  {}
+
+  template <typename U>
+  void
+  MultiPlus<U>::forEachFunction (const ThreadPool::task_t& task) const
+  {
+    if (threadPool_)
+      threadPool_->run (functions_.size (), task);
+    else
+      for (std::size_t i = 0; i < functions_.size (); ++i)
+	task (i);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::computeFunction (Buffers& buffers, result_ref result,
+				 const argument_t& x, std::size_t i) const
+  {
+    if (i)
+      (*functions_[i]) (buffers.results.col (static_cast<size_type> (i - 1)),
+			x);
+    else
+      (*functions_[i]) (result, x);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::computeGradient (Buffers& buffers, gradient_t& gradient,
+				 const argument_t& x, size_type functionId,
+				 std::size_t i) const
+  {
+    // Buffers are reused: clear them as the public API does.
+    if (i)
+      buffers.gradients[i].setZero ();
+    functions_[i]->gradient
+      (i ? buffers.gradients[i] : gradient, x, functionId);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::computeJacobian (Buffers& buffers, jacobian_ref jacobian,
+				 const argument_t& x, std::size_t i) const
+  {
+    if (!i)
+      {
+	functions_[i]->jacobian (jacobian, x);
+	return;
+      }
+
+    const size_type m = this->outputSize ();
+    const size_type offset = static_cast<size_type> (i - 1) * m;
+    // Buffers are reused: clear them as the public API does.
+    buffers.jacobians.middleRows (offset, m).setZero ();
+    functions_[i]->jacobian (buffers.jacobians.middleRows (offset, m), x);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::computeSparseJacobian (Buffers& buffers,
+				       jacobian_ref jacobian,
+				       const argument_t& x,
+				       std::size_t i) const
+  {
+    if (i)
+      buffers.sparseJacobians[i].setZero ();
+    functions_[i]->jacobian
+      (i ? buffers.sparseJacobians[i] : jacobian, x);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::impl_compute
+  (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    Buffers& buffers = buffers_.get ();
+    forEachFunction (boost::bind (&MultiPlus<U>::computeFunction,
+				  this, boost::ref (buffers), result,
+				  boost::cref (x), _1));
+    if (functions_.size () > 1)
+      result += buffers.results.rowwise ().sum ();
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::impl_gradient (gradient_t& gradient,
+			       const argument_t& x,
+			       size_type functionId)
+    const throw ()
+  {
+    Buffers& buffers = buffers_.get ();
+    forEachFunction (boost::bind (&MultiPlus<U>::computeGradient,
+				  this, boost::ref (buffers),
+				  boost::ref (gradient),
+				  boost::cref (x), functionId, _1));
+    for (std::size_t i = 1; i < functions_.size (); ++i)
+      gradient += buffers.gradients[i];
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::impl_jacobian (jacobian_ref jacobian,
+			       const argument_t& x)
+    const throw ()
+  {
+    sumJacobians (buffers_.get (), jacobian, x,
+		  typename parentType_t::traits_t ());
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::sumJacobians (Buffers& buffers, jacobian_ref jacobian,
+			      const argument_t& x, EigenMatrixDense) const
+  {
+    forEachFunction (boost::bind (&MultiPlus<U>::computeJacobian,
+				  this, boost::ref (buffers), jacobian,
+				  boost::cref (x), _1));
+    const size_type m = this->outputSize ();
+    for (std::size_t i = 1; i < functions_.size (); ++i)
+      jacobian +=
+	buffers.jacobians.middleRows (static_cast<size_type> (i - 1) * m, m);
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::sumJacobians (Buffers& buffers, jacobian_ref jacobian,
+			      const argument_t& x, EigenMatrixSparse) const
+  {
+    forEachFunction (boost::bind (&MultiPlus<U>::computeSparseJacobian,
+				  this, boost::ref (buffers),
+				  boost::ref (jacobian),
+				  boost::cref (x), _1));
+    for (std::size_t i = 1; i < functions_.size (); ++i)
+      jacobian += buffers.sparseJacobians[i];
+  }
+
+  template <typename U>
+  void
+  MultiPlus<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    // Directional derivatives are cheap: they are summed serially.
+    detail::ScopedBuffer<result_t> functionDerivative (this->outputSize ());
+    functions_[0]->directionalDerivative (derivative, argument, direction);
+    for (std::size_t i = 1; i < functions_.size (); ++i)
+      {
+	functions_[i]->directionalDerivative
+	  (*functionDerivative, argument, direction);
+	derivative += *functionDerivative;
+      }
+  }
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_FILTER_MULTI_PLUS_HXX
@@ -32,18 +32,16 @@ namespace roboptim
 	% left->getName ()
 	% right->getName ()).str ()),
       left_ (left),
-      right_ (right),
-      result_ (left->outputSize ()),
-      gradient_ (left->inputSize ()),
-      jacobian_ (left->outputSize (),
-		 left->inputSize ())
+      right_ (right)
   {
     if (left->inputSize () != right->inputSize ()
 	|| left->outputSize () != right->outputSize ())
       throw std::runtime_error ("left and right size mismatch");
-    result_.setZero ();
-    gradient_.setZero ();
-    jacobian_.setZero ();
+
+    detail::reserveBuffer<result_t> (right->outputSize ());
+    detail::reserveBuffer<gradient_t> (right->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (right->outputSize (), right->inputSize ());
   }
 
   template <typename U, typename V>
@@ -53,13 +51,14 @@ namespace roboptim
   template <typename U, typename V>
   void
   Plus<U, V>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
+    detail::ScopedBuffer<result_t> rightResult (right_->outputSize ());
     result.setZero ();
     (*left_) (result, x);
-    (*right_) (result_, x);
-    result += result_;
+    (*right_) (*rightResult, x);
+    result += *rightResult;
   }
 
   template <typename U, typename V>
@@ -69,20 +68,39 @@ namespace roboptim
 			 size_type functionId)
     const throw ()
   {
+    detail::ScopedBuffer<gradient_t> rightGradient (right_->inputSize ());
+    rightGradient->setZero ();
     left_->gradient (gradient, argument, functionId);
-    right_->gradient (gradient_, argument, functionId);
-    gradient += gradient_;
+    right_->gradient (*rightGradient, argument, functionId);
+    gradient += *rightGradient;
   }
 
   template <typename U, typename V>
   void
-  Plus<U, V>::impl_jacobian (jacobian_t& jacobian,
+  Plus<U, V>::impl_jacobian (jacobian_ref jacobian,
 			 const argument_t& argument)
     const throw ()
   {
+    detail::ScopedBuffer<jacobian_t> rightJacobian
+      (right_->outputSize (), right_->inputSize ());
+    rightJacobian->setZero ();
     left_->jacobian (jacobian, argument);
-    right_->jacobian (jacobian_, argument);
-    jacobian += jacobian_;
+    right_->jacobian (*rightJacobian, argument);
+    jacobian += *rightJacobian;
+  }
+
+  template <typename U, typename V>
+  void
+  Plus<U, V>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<result_t> rightDerivative (right_->outputSize ());
+    left_->directionalDerivative (derivative, argument, direction);
+    right_->directionalDerivative (*rightDerivative, argument, direction);
+    derivative += *rightDerivative;
   }
 } // end of namespace roboptim.
 
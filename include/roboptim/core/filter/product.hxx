@@ -32,25 +32,16 @@ namespace roboptim
 	% left->getName ()
 	% right->getName ()).str ()),
       left_ (left),
-      right_ (right),
-      resultLeft_ (left->outputSize ()),
-      resultRight_ (left->outputSize ()),
-      gradientLeft_ (left->inputSize ()),
-      gradientRight_ (left->inputSize ()),
-      jacobianLeft_ (left->outputSize (),
-		     left->inputSize ()),
-      jacobianRight_ (left->outputSize (),
-		      left->inputSize ())
+      right_ (right)
   {
     if (left->inputSize () != right->inputSize ()
 	|| left->outputSize () != right->outputSize ())
       throw std::runtime_error ("left and right size mismatch");
-    resultLeft_.setZero ();
-    resultRight_.setZero ();
-    gradientLeft_.setZero ();
-    gradientRight_.setZero ();
-    jacobianLeft_.setZero ();
-    jacobianRight_.setZero ();
+
+    detail::reserveBuffer<result_t> (left->outputSize (), 1, 3);
+    detail::reserveBuffer<gradient_t> (right->inputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (right->outputSize (), right->inputSize ());
   }
 
   template <typename U, typename V>
@@ -60,12 +51,14 @@ namespace roboptim
   template <typename U, typename V>
   void
   Product<U, V>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    (*left_) (resultLeft_, x);
-    (*right_) (resultRight_, x);
-    result.noalias () = resultLeft_.cwiseProduct (resultRight_);
+    detail::ScopedBuffer<result_t> resultLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> resultRight (right_->outputSize ());
+    (*left_) (*resultLeft, x);
+    (*right_) (*resultRight, x);
+    result.noalias () = resultLeft->cwiseProduct (*resultRight);
   }
 
   template <typename U, typename V>
@@ -75,20 +68,98 @@ namespace roboptim
 				size_type functionId)
     const throw ()
   {
-    left_->gradient (gradientLeft_, argument, functionId);
-    right_->gradient (gradientRight_, argument, functionId);
-    gradient = gradientLeft_.cwiseProduct (gradientRight_);
+    // Product rule: (f_i g_i)' = g_i f_i' + f_i g_i'.
+    detail::ScopedBuffer<result_t> resultLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> resultRight (right_->outputSize ());
+    (*left_) (*resultLeft, argument);
+    (*right_) (*resultRight, argument);
+
+    const value_type valueLeft = (*resultLeft)[functionId];
+    const value_type valueRight = (*resultRight)[functionId];
+
+    // Gradients multiplied by zero do not need to be computed, but
+    // the output buffer still has to be reset as it is not zeroed
+    // by the caller.
+    if (valueRight != 0.)
+      {
+	left_->gradient (gradient, argument, functionId);
+	gradient *= valueRight;
+      }
+    else
+      gradient.setZero ();
+    if (valueLeft != 0.)
+      {
+	detail::ScopedBuffer<gradient_t> gradientRight (right_->inputSize ());
+	gradientRight->setZero ();
+	right_->gradient (*gradientRight, argument, functionId);
+	gradient += valueLeft * *gradientRight;
+      }
   }
 
+  namespace detail
+  {
+    /// \brief Multiply each row of a dense matrix by a coefficient.
+    inline void
+    scaleRows (DifferentiableFunction::jacobian_ref matrix,
+	       const Function::vector_t& scale)
+    {
+      matrix = scale.asDiagonal () * matrix;
+    }
+
+    /// \brief Multiply each row of a sparse matrix by a coefficient.
+    ///
+    /// Only the non-zero values are visited.
+    inline void
+    scaleRows (SparseFunction::matrix_t& matrix,
+	       const SparseFunction::vector_t& scale)
+    {
+      typedef SparseFunction::matrix_t matrix_t;
+      for (matrix_t::Index k = 0; k < matrix.outerSize (); ++k)
+	for (matrix_t::InnerIterator it (matrix, k); it; ++it)
+	  it.valueRef () *= scale[it.row ()];
+    }
+  } // end of namespace detail.
+
   template <typename U, typename V>
   void
-  Product<U, V>::impl_jacobian (jacobian_t& jacobian,
+  Product<U, V>::impl_jacobian (jacobian_ref jacobian,
 				const argument_t& argument)
     const throw ()
   {
-    left_->jacobian (jacobianLeft_, argument);
-    right_->jacobian (jacobianRight_, argument);
-    jacobian = jacobianLeft_ * jacobianRight_;
+    // Product rule: J = diag (g) J_f + diag (f) J_g.
+    detail::ScopedBuffer<result_t> resultLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> resultRight (right_->outputSize ());
+    detail::ScopedBuffer<jacobian_t> jacobianRight
+      (right_->outputSize (), right_->inputSize ());
+    jacobianRight->setZero ();
+    (*left_) (*resultLeft, argument);
+    (*right_) (*resultRight, argument);
+    left_->jacobian (jacobian, argument);
+    right_->jacobian (*jacobianRight, argument);
+
+    detail::scaleRows (jacobian, *resultRight);
+    detail::scaleRows (*jacobianRight, *resultLeft);
+    jacobian += *jacobianRight;
+  }
+
+  template <typename U, typename V>
+  void
+  Product<U, V>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    // Product rule: J d = diag (g) J_f d + diag (f) J_g d.
+    detail::ScopedBuffer<result_t> resultLeft (left_->outputSize ());
+    detail::ScopedBuffer<result_t> resultRight (right_->outputSize ());
+    detail::ScopedBuffer<result_t> derivativeRight (right_->outputSize ());
+    (*left_) (*resultLeft, argument);
+    (*right_) (*resultRight, argument);
+    left_->directionalDerivative (derivative, argument, direction);
+    right_->directionalDerivative (*derivativeRight, argument, direction);
+    derivative = derivative.cwiseProduct (*resultRight)
+      + resultLeft->cwiseProduct (*derivativeRight);
   }
 } // end of namespace roboptim.
 
@@ -40,6 +40,11 @@ namespace roboptim
 		     value_type scalar) throw ();
     ~Scalar () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + origin_->version ();
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -50,16 +55,20 @@ namespace roboptim
       return origin_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
   private:
     boost::shared_ptr<U> origin_;
 
@@ -42,7 +42,7 @@ namespace roboptim
   template <typename U>
   void
   Scalar<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
     origin_->operator () (result, x);
@@ -62,7 +62,7 @@ namespace roboptim
 
   template <typename U>
   void
-  Scalar<U>::impl_jacobian (jacobian_t& jacobian,
+  Scalar<U>::impl_jacobian (jacobian_ref jacobian,
 			 const argument_t& argument)
     const throw ()
   {
@@ -70,6 +70,17 @@ namespace roboptim
     jacobian *= scalar_;
   }
 
+  template <typename U>
+  void
+  Scalar<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    origin_->directionalDerivative (derivative, argument, direction);
+    derivative *= scalar_;
+  }
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_FILTER_SCALAR_HXX
@@ -0,0 +1,136 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_SCALING_HH
+# define ROBOPTIM_CORE_FILTER_SCALING_HH
+# include <stdexcept>
+# include <boost/make_shared.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
+# include <roboptim/core/differentiable-function.hh>
+
+
+namespace roboptim
+{
+  /// \brief Scaled view of a function.
+  ///
+  /// Given row scales \f$r\f$ and argument scales \f$s\f$, this
+  /// filter evaluates the function in the scaled space:
+  /// \f[\tilde{f}(\tilde{x}) = r \circ f (\tilde{x} \oslash s)\f]
+  /// where \f$\tilde{x} = s \circ x\f$ is the scaled argument. Its
+  /// jacobian is \f$diag (r) J_f (x) diag (s)^{-1}\f$.
+  ///
+  /// The origin function is shared, not copied: the unscaled view is
+  /// the origin itself.
+  template <typename U>
+  class Scaling : public detail::AutopromoteTrait<U>::T_type
+  {
+  public:
+    typedef typename detail::AutopromoteTrait<U>::T_type parentType_t;
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
+
+    typedef boost::shared_ptr<Scaling> ScalingShPtr_t;
+
+    /// \param origin scaled function
+    /// \param rowScales scale of each output (size m)
+    /// \param argumentScales scale of each argument (size n)
+    explicit Scaling (boost::shared_ptr<U> origin,
+		      const vector_t& rowScales,
+		      const vector_t& argumentScales)
+      throw (std::runtime_error);
+    ~Scaling () throw ();
+
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + origin_->version ();
+    }
+
+    const boost::shared_ptr<U>& origin () const
+    {
+      return origin_;
+    }
+
+    boost::shared_ptr<U>& origin ()
+    {
+      return origin_;
+    }
+
+    const vector_t& rowScales () const
+    {
+      return rowScales_;
+    }
+
+    const vector_t& argumentScales () const
+    {
+      return argumentScales_;
+    }
+
+    /// \brief Map an argument to the scaled space.
+    vector_t scaleArgument (const argument_t& x) const
+    {
+      return x.cwiseProduct (argumentScales_);
+    }
+
+    /// \brief Map a scaled argument back to the original space.
+    vector_t unscaleArgument (const argument_t& x) const
+    {
+      return x.cwiseQuotient (argumentScales_);
+    }
+
+    void impl_compute (result_ref result, const argument_t& x)
+      const throw ();
+
+    void impl_gradient (gradient_t& gradient,
+			const argument_t& argument,
+			size_type functionId = 0)
+      const throw ();
+    void impl_jacobian (jacobian_ref jacobian,
+			const argument_t& arg)
+      const throw ();
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& argument,
+				     const argument_t& direction)
+      const throw ();
+  private:
+    boost::shared_ptr<U> origin_;
+
+    /// \brief Output scales.
+    vector_t rowScales_;
+
+    /// \brief Argument scales.
+    vector_t argumentScales_;
+
+    /// \brief Inverse of the argument scales.
+    vector_t inverseArgumentScales_;
+  };
+
+  template <typename U>
+  boost::shared_ptr<Scaling<U> >
+  scaling (boost::shared_ptr<U> origin,
+	   const typename Scaling<U>::vector_t& rowScales,
+	   const typename Scaling<U>::vector_t& argumentScales)
+  {
+    return boost::make_shared<Scaling<U> >
+      (origin, rowScales, argumentScales);
+  }
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/filter/scaling.hxx>
+#endif //! ROBOPTIM_CORE_FILTER_SCALING_HH
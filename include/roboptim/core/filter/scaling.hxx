@@ -0,0 +1,166 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FILTER_SCALING_HXX
+# define ROBOPTIM_CORE_FILTER_SCALING_HXX
+# include <boost/format.hpp>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Scale a dense gradient: g <- r g / s.
+    inline void
+    scaleGradient (DifferentiableFunction::gradient_t& gradient,
+		   Function::value_type rowScale,
+		   const Function::vector_t& inverseArgumentScales)
+    {
+      gradient = rowScale * gradient.cwiseProduct (inverseArgumentScales);
+    }
+
+    /// \brief Scale a sparse gradient: g <- r g / s.
+    ///
+    /// Only the non-zero values are visited.
+    inline void
+    scaleGradient (DifferentiableSparseFunction::gradient_t& gradient,
+		   SparseFunction::value_type rowScale,
+		   const SparseFunction::vector_t& inverseArgumentScales)
+    {
+      typedef DifferentiableSparseFunction::gradient_t gradient_t;
+      for (gradient_t::InnerIterator it (gradient); it; ++it)
+	it.valueRef () *= rowScale * inverseArgumentScales[it.index ()];
+    }
+
+    /// \brief Scale a dense jacobian: J <- diag (r) J diag (s)^-1.
+    inline void
+    scaleJacobian (DifferentiableFunction::jacobian_ref jacobian,
+		   const Function::vector_t& rowScales,
+		   const Function::vector_t& inverseArgumentScales)
+    {
+      jacobian = rowScales.asDiagonal () * jacobian
+	* inverseArgumentScales.asDiagonal ();
+    }
+
+    /// \brief Scale a sparse jacobian: J <- diag (r) J diag (s)^-1.
+    ///
+    /// Only the non-zero values are visited.
+    inline void
+    scaleJacobian (SparseFunction::matrix_t& jacobian,
+		   const SparseFunction::vector_t& rowScales,
+		   const SparseFunction::vector_t& inverseArgumentScales)
+    {
+      typedef SparseFunction::matrix_t matrix_t;
+      for (matrix_t::Index k = 0; k < jacobian.outerSize (); ++k)
+	for (matrix_t::InnerIterator it (jacobian, k); it; ++it)
+	  it.valueRef () *=
+	    rowScales[it.row ()] * inverseArgumentScales[it.col ()];
+    }
+  } // end of namespace detail.
+
+  template <typename U>
+  Scaling<U>::Scaling
+  (boost::shared_ptr<U> origin,
+   const vector_t& rowScales,
+   const vector_t& argumentScales)
+    throw (std::runtime_error)
+    : detail::AutopromoteTrait<U>::T_type
+      (origin->inputSize (),
+       origin->outputSize (),
+       (boost::format ("scaling(%1%)")
+	% origin->getName ()).str ()),
+      origin_ (origin),
+      rowScales_ (rowScales),
+      argumentScales_ (argumentScales),
+      inverseArgumentScales_ ()
+  {
+    if (rowScales.size () != origin->outputSize ()
+	|| argumentScales.size () != origin->inputSize ())
+      {
+	boost::format fmt
+	  ("scales sizes (%d, %d) do not match function \"%s\""
+	   " output and input sizes (%d, %d)");
+	fmt
+	  % rowScales.size () % argumentScales.size ()
+	  % origin->getName ()
+	  % origin->outputSize () % origin->inputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+    inverseArgumentScales_ = argumentScales.cwiseInverse ();
+
+    detail::reserveBuffer<argument_t> (origin->inputSize (), 1, 2);
+  }
+
+  template <typename U>
+  Scaling<U>::~Scaling () throw ()
+  {}
+
+  template <typename U>
+  void
+  Scaling<U>::impl_compute
+  (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (this->inputSize ());
+    *originX = x.cwiseProduct (inverseArgumentScales_);
+    origin_->operator () (result, *originX);
+    result = result.cwiseProduct (rowScales_);
+  }
+
+  template <typename U>
+  void
+  Scaling<U>::impl_gradient (gradient_t& gradient,
+			     const argument_t& argument,
+			     size_type functionId)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (this->inputSize ());
+    *originX = argument.cwiseProduct (inverseArgumentScales_);
+    origin_->gradient (gradient, *originX, functionId);
+    detail::scaleGradient
+      (gradient, rowScales_[functionId], inverseArgumentScales_);
+  }
+
+  template <typename U>
+  void
+  Scaling<U>::impl_jacobian (jacobian_ref jacobian,
+			     const argument_t& argument)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (this->inputSize ());
+    *originX = argument.cwiseProduct (inverseArgumentScales_);
+    origin_->jacobian (jacobian, *originX);
+    detail::scaleJacobian (jacobian, rowScales_, inverseArgumentScales_);
+  }
+
+  template <typename U>
+  void
+  Scaling<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<argument_t> originX (this->inputSize ());
+    detail::ScopedBuffer<argument_t> originDirection (this->inputSize ());
+    *originX = argument.cwiseProduct (inverseArgumentScales_);
+    *originDirection = direction.cwiseProduct (inverseArgumentScales_);
+    origin_->directionalDerivative (derivative, *originX, *originDirection);
+    derivative = derivative.cwiseProduct (rowScales_);
+  }
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_FILTER_SCALING_HXX
@@ -22,6 +22,7 @@
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/differentiable-function.hh>
 
 
@@ -42,6 +43,11 @@ namespace roboptim
       throw (std::runtime_error);
     ~SelectionById () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parentType_t::version () + origin_->version ();
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -52,22 +58,19 @@ namespace roboptim
       return origin_;
     }
 
-    void impl_compute (result_t& result, const argument_t& x)
+    void impl_compute (result_ref result, const argument_t& x)
       const throw ();
 
     void impl_gradient (gradient_t& gradient,
 			const argument_t& argument,
 			size_type functionId = 0)
       const throw ();
-    void impl_jacobian (jacobian_t& jacobian,
+    void impl_jacobian (jacobian_ref jacobian,
 			const argument_t& arg)
       const throw ();
   private:
     boost::shared_ptr<U> origin_;
     std::vector<bool> selector_;
-
-    mutable result_t result_;
-    mutable gradient_t gradient_;
   };
 
   template <typename U>
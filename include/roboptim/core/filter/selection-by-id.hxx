@@ -32,13 +32,8 @@ namespace roboptim
        (boost::format ("selectionById(%1%)")
 	% origin->getName ()).str ()),
       origin_ (origin),
-      selector_ (selector),
-      result_ (origin->outputSize ()),
-      gradient_ (origin->inputSize ())
+      selector_ (selector)
   {
-    result_.setZero ();
-    gradient_.setZero ();
-
     if (selector.size () != static_cast<std::size_t> (origin->outputSize ()))
       {
 	boost::format fmt
@@ -46,6 +41,9 @@ namespace roboptim
 	fmt % selector.size () % origin->outputSize ();
 	throw std::runtime_error (fmt.str ());
       }
+
+    detail::reserveBuffer<result_t> (origin->outputSize ());
+    detail::reserveBuffer<gradient_t> (origin->inputSize ());
   }
 
   template <typename U>
@@ -55,15 +53,16 @@ namespace roboptim
   template <typename U>
   void
   SelectionById<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    origin_->operator () (result_, x);
+    detail::ScopedBuffer<result_t> originResult (origin_->outputSize ());
+    origin_->operator () (*originResult, x);
 
     size_type id = 0;
-    for (size_type row = 0; row < result_.size (); ++row)
+    for (size_type row = 0; row < originResult->size (); ++row)
       if (selector_[static_cast<std::size_t> (row)])
-	result[id++] = result_[row];
+	result[id++] = (*originResult)[row];
   }
 
   // The gradient size depends on the input size which is not varying
@@ -88,19 +87,21 @@ namespace roboptim
 
   template <typename U>
   void
-  SelectionById<U>::impl_jacobian (jacobian_t& jacobian,
+  SelectionById<U>::impl_jacobian (jacobian_ref jacobian,
 				   const argument_t& argument)
     const throw ()
   {
+    detail::ScopedBuffer<gradient_t> originGradient (origin_->inputSize ());
     size_type row = 0;
     for (size_type functionId = 0;
 	 functionId < origin_->outputSize (); ++functionId)
       {
 	if (selector_[static_cast<std::size_t> (functionId)])
 	  {
-	    origin_->gradient (gradient_, argument, functionId);
+	    originGradient->setZero ();
+	    origin_->gradient (*originGradient, argument, functionId);
 	    for (size_type col = 0; col < jacobian.cols (); ++col)
-	      jacobian.coeffRef (row, col) = gradient_.coeffRef (col);
+	      jacobian.coeffRef (row, col) = originGradient->coeffRef (col);
 	    ++row;
 	  }
       }
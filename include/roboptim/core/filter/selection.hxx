@@ -33,17 +33,14 @@ namespace roboptim
 	% origin->getName ()).str ()),
       origin_ (origin),
       start_ (start),
-      size_ (size),
-      result_ (origin->outputSize ()),
-      jacobian_ (origin->outputSize (),
-		 origin->inputSize ())
+      size_ (size)
   {
     if (start + size > origin->inputSize ())
       throw std::runtime_error ("invalid start/size");
 
-    result_.setZero ();
-    gradient_.setZero ();
-    jacobian_.setZero ();
+    detail::reserveBuffer<result_t> (origin->outputSize ());
+    detail::reserveBuffer<jacobian_t>
+      (origin->outputSize (), origin->inputSize ());
   }
 
   template <typename U>
@@ -53,11 +50,12 @@ namespace roboptim
   template <typename U>
   void
   Selection<U>::impl_compute
-  (result_t& result, const argument_t& x)
+  (result_ref result, const argument_t& x)
     const throw ()
   {
-    origin_->operator () (result_, x);
-    result = result_.segment (start_, size_);
+    detail::ScopedBuffer<result_t> originResult (origin_->outputSize ());
+    origin_->operator () (*originResult, x);
+    result = originResult->segment (start_, size_);
   }
 
   template <typename U>
@@ -72,14 +70,30 @@ namespace roboptim
 
   template <typename U>
   void
-  Selection<U>::impl_jacobian (jacobian_t& jacobian,
+  Selection<U>::impl_jacobian (jacobian_ref jacobian,
 			 const argument_t& argument)
     const throw ()
   {
-    origin_->jacobian (jacobian_, argument);
-    jacobian = jacobian_.block (start_, 0, size_, jacobian_.cols ());
+    detail::ScopedBuffer<jacobian_t> originJacobian
+      (origin_->outputSize (), origin_->inputSize ());
+    originJacobian->setZero ();
+    origin_->jacobian (*originJacobian, argument);
+    jacobian =
+      originJacobian->block (start_, 0, size_, originJacobian->cols ());
   }
 
+  template <typename U>
+  void
+  Selection<U>::impl_directionalDerivative
+  (result_t& derivative,
+   const argument_t& argument,
+   const argument_t& direction)
+    const throw ()
+  {
+    detail::ScopedBuffer<result_t> originDerivative (origin_->outputSize ());
+    origin_->directionalDerivative (*originDerivative, argument, direction);
+    derivative = originDerivative->segment (start_, size_);
+  }
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_FILTER_SELECTION_HXX
@@ -18,8 +18,11 @@
 #ifndef ROBOPTIM_CORE_FILTER_SPLIT_HH
 # define ROBOPTIM_CORE_FILTER_SPLIT_HH
 # include <stdexcept>
+# include <vector>
 # include <boost/shared_ptr.hpp>
 
+# include <roboptim/core/detail/thread-local.hh>
+# include <roboptim/core/detail/workspace.hh>
 # include <roboptim/core/n-times-derivable-function.hh>
 
 namespace roboptim
@@ -27,6 +30,64 @@ namespace roboptim
   /// \addtogroup roboptim_filter
   /// @{
 
+  /// \brief Evaluation buffer shared by several splits.
+  ///
+  /// The buffer stores the last argument the function has been
+  /// evaluated on and the corresponding result. Splits of the same
+  /// function sharing a buffer only evaluate the function once per
+  /// argument.
+  ///
+  /// The argument is the only key: if the wrapped function value
+  /// changes for other reasons (i.e. parameter update), the buffer
+  /// must be invalidated.
+  ///
+  /// Each thread has its own copy of the buffer: splits can be
+  /// evaluated concurrently.
+  template <typename T>
+  class SplitBuffer
+  {
+  public:
+    /// \brief Import size type.
+    typedef typename T::size_type size_type;
+    /// \brief Import result type.
+    typedef typename T::result_t result_t;
+    /// \brief Import argument type.
+    typedef typename T::argument_t argument_t;
+
+    explicit SplitBuffer (boost::shared_ptr<const T> fct) throw ();
+
+    /// \brief Evaluate the function if needed and return its value.
+    const result_t& operator () (const argument_t& argument) const throw ();
+
+    /// \brief Force the next evaluation in all threads.
+    ///
+    /// Must not be called while the splits are being evaluated.
+    void invalidate () throw ()
+    {
+      ++generation_;
+    }
+
+  private:
+    /// \brief Per-thread cached evaluation.
+    struct State
+    {
+      /// \brief Last result.
+      result_t result;
+      /// \brief Argument of the last result.
+      argument_t argument;
+      /// \brief Generation of the last result.
+      std::size_t generation;
+    };
+
+    boost::shared_ptr<const T> function_;
+
+    /// \brief Current generation, the cached results of previous
+    /// generations are invalid.
+    std::size_t generation_;
+
+    /// \brief Cached evaluation of each thread.
+    detail::ThreadLocal<State> state_;
+  };
 
   template <typename T>
   class ROBOPTIM_DLLAPI Split : public T
@@ -40,6 +101,8 @@ namespace roboptim
     typedef typename DifferentiableFunction::vector_t vector_t;
     /// \brief Import result type.
     typedef typename DifferentiableFunction::result_t result_t;
+    /// \brief Import result reference type.
+    typedef typename DifferentiableFunction::result_ref result_ref;
     /// \brief Import argument type.
     typedef typename DifferentiableFunction::argument_t argument_t;
     /// \brief Import gradient type.
@@ -51,12 +114,39 @@ namespace roboptim
     /// \brief Import interval type.
     typedef typename DifferentiableFunction::interval_t interval_t;
 
+    /// \brief Build a split evaluating the function at each call.
+    ///
+    /// \param fct split function
+    /// \param functionId output of fct returned by this function
     explicit Split (boost::shared_ptr<const T> fct,
 		    size_type functionId) throw (std::runtime_error);
+
+    /// \brief Build a split evaluating the function through a
+    /// shared buffer.
+    ///
+    /// \param fct split function
+    /// \param functionId output of fct returned by this function
+    /// \param buffer evaluation buffer of fct
+    explicit Split (boost::shared_ptr<const T> fct,
+		    size_type functionId,
+		    boost::shared_ptr<SplitBuffer<T> > buffer)
+      throw (std::runtime_error);
     ~Split () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return T::version () + function_->version ();
+    }
+
+    /// \brief Evaluation buffer of the split function, null if the
+    /// split is not cached.
+    boost::shared_ptr<SplitBuffer<T> > buffer () const
+    {
+      return buffer_;
+    }
+
   protected:
-    virtual void impl_compute (result_t& result, const argument_t& argument)
+    virtual void impl_compute (result_ref result, const argument_t& argument)
       const throw ();
 
 
@@ -76,9 +166,23 @@ namespace roboptim
   private:
     boost::shared_ptr<const T> function_;
     size_type functionId_;
-    mutable result_t res_;
+    /// \brief Evaluation buffer shared with the other splits (may be
+    /// null).
+    boost::shared_ptr<SplitBuffer<T> > buffer_;
   };
 
+  /// \brief Split a function into scalar functions.
+  ///
+  /// All the splits share the same evaluation buffer: evaluating
+  /// every split on the same argument costs a single evaluation of
+  /// fct.
+  ///
+  /// \param fct split function
+  /// \return one split per output of fct
+  template <typename T>
+  std::vector<boost::shared_ptr<Split<T> > >
+  splitAll (boost::shared_ptr<const T> fct) throw (std::runtime_error);
+
   template <typename P, typename C>
   void addNonScalarConstraint
   (P& problem,
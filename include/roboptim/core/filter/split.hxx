@@ -38,15 +38,59 @@ namespace roboptim
     }
   } // end of anonymous namespace.
 
+  template <typename T>
+  SplitBuffer<T>::SplitBuffer (boost::shared_ptr<const T> fct) throw ()
+    : function_ (fct),
+      generation_ (1),
+      state_ ()
+  {
+    State& state = state_.prototype ();
+    state.result.resize (fct->outputSize ());
+    state.result.setZero ();
+    state.argument.resize (fct->inputSize ());
+    state.argument.setZero ();
+    state.generation = 0;
+  }
+
+  template <typename T>
+  const typename SplitBuffer<T>::result_t&
+  SplitBuffer<T>::operator () (const argument_t& argument) const throw ()
+  {
+    State& state = state_.get ();
+    const std::size_t generation = generation_ + function_->version ();
+    if (state.generation != generation || state.argument != argument)
+      {
+	(*function_) (state.result, argument);
+	state.argument = argument;
+	state.generation = generation;
+      }
+    return state.result;
+  }
+
   template <typename T>
   Split<T>::Split (boost::shared_ptr<const T> fct,
 		   size_type functionId) throw (std::runtime_error)
     : T (fct->inputSize (), 1, splitName (*fct, functionId)),
       function_ (fct),
       functionId_ (functionId),
-      res_ (function_->outputSize ())
+      buffer_ ()
   {
     assert (functionId < fct->outputSize ());
+    detail::reserveBuffer<result_t> (fct->outputSize ());
+  }
+
+  template <typename T>
+  Split<T>::Split (boost::shared_ptr<const T> fct,
+		   size_type functionId,
+		   boost::shared_ptr<SplitBuffer<T> > buffer)
+    throw (std::runtime_error)
+    : T (fct->inputSize (), 1, splitName (*fct, functionId)),
+      function_ (fct),
+      functionId_ (functionId),
+      buffer_ (buffer)
+  {
+    assert (functionId < fct->outputSize ());
+    assert (buffer_);
   }
 
   template <typename T>
@@ -56,12 +100,19 @@ namespace roboptim
 
   template <typename T>
   void
-  Split<T>::impl_compute (result_t& result,
+  Split<T>::impl_compute (result_ref result,
 			  const argument_t& argument)
     const throw ()
   {
-    (*function_) (this->res_, argument);
-    result[0] = this->res_[functionId_];
+    if (buffer_)
+      {
+	result[0] = (*buffer_) (argument)[functionId_];
+	return;
+      }
+
+    detail::ScopedBuffer<result_t> fullResult (function_->outputSize ());
+    (*function_) (*fullResult, argument);
+    result[0] = (*fullResult)[functionId_];
   }
 
 
@@ -151,6 +202,22 @@ namespace roboptim
     function_->derivative (derivative, argument, order);
   }
 
+  template <typename T>
+  std::vector<boost::shared_ptr<Split<T> > >
+  splitAll (boost::shared_ptr<const T> fct) throw (std::runtime_error)
+  {
+    assert (fct);
+
+    boost::shared_ptr<SplitBuffer<T> > buffer (new SplitBuffer<T> (fct));
+
+    std::vector<boost::shared_ptr<Split<T> > > splits;
+    splits.reserve (static_cast<std::size_t> (fct->outputSize ()));
+    for (typename T::size_type i = 0; i < fct->outputSize (); ++i)
+      splits.push_back
+	(boost::shared_ptr<Split<T> > (new Split<T> (fct, i, buffer)));
+    return splits;
+  }
+
   template <typename P, typename C>
   void addNonScalarConstraint
   (P& problem,
@@ -171,13 +238,14 @@ namespace roboptim
 	problem.addConstraint (constraint, interval[0], scale[0]);
       return;
     }
+    std::vector<boost::shared_ptr<Split<C> > > splits =
+      splitAll (boost::shared_ptr<const C> (constraint));
     for (unsigned i = 0; i < constraint->outputSize (); ++i)
       {
-	boost::shared_ptr<Split<C> > split (new Split<C> (constraint, i));
 	if (scale.empty ())
-	  problem.addConstraint (split, interval[i]);
+	  problem.addConstraint (splits[i], interval[i]);
 	else
-	  problem.addConstraint (split, interval[i], scale[i]);
+	  problem.addConstraint (splits[i], interval[i], scale[i]);
       }
   }
 } // end of namespace roboptim
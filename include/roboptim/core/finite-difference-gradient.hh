@@ -161,7 +161,7 @@ namespace roboptim
 
       virtual void computeJacobian
       (value_type epsilon,
-       jacobian_t& jacobian,
+       jacobian_ref jacobian,
        const argument_t& argument,
        argument_t& xEps) const throw ();
 
@@ -278,11 +278,11 @@ namespace roboptim
     ~GenericFiniteDifferenceGradient () throw ();
 
   protected:
-    virtual void impl_compute (result_t&, const argument_t&) const throw ();
+    virtual void impl_compute (result_ref , const argument_t&) const throw ();
     virtual void impl_gradient (gradient_t&,
                                 const argument_t& argument,
                                 size_type = 0) const throw ();
-    virtual void impl_jacobian (jacobian_t& jacobian,
+    virtual void impl_jacobian (jacobian_ref jacobian,
                                 const argument_t& argument) const throw ();
 
     /// \brief Reference to the wrapped function.
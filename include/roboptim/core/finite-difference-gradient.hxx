@@ -233,7 +233,7 @@ namespace roboptim
   template <typename T, typename FdgPolicy>
   void
   GenericFiniteDifferenceGradient<T, FdgPolicy>::impl_compute
-  (result_t& result, const argument_t& argument) const throw ()
+  (result_ref result, const argument_t& argument) const throw ()
   {
     adaptee_ (result, argument);
   }
@@ -252,7 +252,7 @@ namespace roboptim
   template <typename T, typename FdgPolicy>
   void
   GenericFiniteDifferenceGradient<T, FdgPolicy>::impl_jacobian
-  (jacobian_t& jacobian,
+  (jacobian_ref jacobian,
    const argument_t& argument) const throw ()
   {
     this->computeJacobian(epsilon_, jacobian, argument, xEps_);
@@ -399,7 +399,7 @@ namespace roboptim
     inline void
     Policy<EigenMatrixSparse>::computeJacobian
     (value_type epsilon,
-     jacobian_t& jacobian,
+     jacobian_ref jacobian,
      const argument_t& argument,
      argument_t& xEps) const throw ()
     {
@@ -436,7 +436,7 @@ namespace roboptim
     void
     Policy<T>::computeJacobian
     (value_type epsilon,
-     jacobian_t& jacobian,
+     jacobian_ref jacobian,
      const argument_t& argument,
      argument_t& xEps) const throw ()
     {
@@ -17,6 +17,7 @@
 
 #ifndef ROBOPTIM_CORE_FUNCTION_HH
 # define ROBOPTIM_CORE_FUNCTION_HH
+# include <cstddef>
 # include <cstring>
 # include <iomanip>
 # include <iostream>
@@ -48,6 +49,8 @@
   typedef parent_t::size_type size_type;        \
   typedef parent_t::argument_t argument_t;      \
   typedef parent_t::result_t result_t;          \
+  typedef parent_t::result_ref result_ref;      \
+  typedef parent_t::const_result_ref const_result_ref; \
   typedef parent_t::vector_t vector_t;          \
   typedef parent_t::matrix_t matrix_t;          \
   struct e_n_d__w_i_t_h__s_e_m_i_c_o_l_o_n
@@ -58,6 +61,8 @@
   typedef typename parent_t::size_type size_type;	\
   typedef typename parent_t::argument_t argument_t;	\
   typedef typename parent_t::result_t result_t;		\
+  typedef typename parent_t::result_ref result_ref;	\
+  typedef typename parent_t::const_result_ref const_result_ref; \
   typedef typename parent_t::vector_t vector_t;		\
   typedef typename parent_t::matrix_t matrix_t;		\
   struct e_n_d__w_i_t_h__s_e_m_i_c_o_l_o_n
@@ -77,6 +82,10 @@ namespace roboptim
   /// - matrix_t the matrix type (e.g. Eigen::Matrix<double, 1, 2>)
   /// - vector_t the used vector type
   /// - result_t function result type (vector or matrix)
+  /// - result_ref type through which results are written (e.g. an
+  ///   Eigen::Ref, so that a function can be evaluated directly into
+  ///   a block of a larger vector)
+  /// - const_result_ref type through which results are read
   /// - argument_t function argument type (usually vector)
   template <typename T>
   struct GenericFunctionTraits
@@ -143,6 +152,16 @@ namespace roboptim
     /// \brief Type of a function evaluation result.
     typedef typename GenericFunctionTraits<T>::result_t result_t;
 
+    /// \brief Output type of a function evaluation.
+    ///
+    /// Results can be written into any vector expression with a
+    /// contiguous storage, such as a segment of a larger vector.
+    typedef typename GenericFunctionTraits<T>::result_ref result_ref;
+
+    /// \brief Read-only view of a function evaluation result.
+    typedef typename GenericFunctionTraits<T>::const_result_ref
+    const_result_ref;
+
     /// \brief Type of a function evaluation argument.
     typedef typename GenericFunctionTraits<T>::argument_t argument_t;
 
@@ -356,7 +375,7 @@ namespace roboptim
     ///
     /// \param result result that will be checked
     /// \return true if valid, false if not
-    bool isValidResult (const result_t& result) const throw ()
+    bool isValidResult (const_result_ref result) const throw ()
     {
       return result.size () == outputSize ();
     }
@@ -398,9 +417,10 @@ namespace roboptim
     ///
     /// The program will abort if the argument does not have the
     /// expected size.
-    /// \param result result will be stored in this vector
+    /// \param result result will be stored in this vector (or vector
+    /// block)
     /// \param argument point at which the function will be evaluated
-    void operator () (result_t& result, const argument_t& argument)
+    void operator () (result_ref result, const argument_t& argument)
       const throw ()
     {
       LOG4CXX_TRACE
@@ -425,6 +445,23 @@ namespace roboptim
       return name_;
     }
 
+    /// \brief Version of the function.
+    ///
+    /// The version increases each time the function is modified in a
+    /// way which changes its values for a given argument (e.g. new
+    /// bound values of a Bind filter). Filters caching evaluations of
+    /// other functions compare versions to detect stale entries.
+    ///
+    /// Filters add the versions of the functions they wrap, so that
+    /// the version of a function changes whenever one of the
+    /// functions it depends on changes.
+    ///
+    /// \return function version
+    virtual std::size_t version () const throw ()
+    {
+      return version_;
+    }
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
@@ -447,12 +484,22 @@ namespace roboptim
     ///
     /// Evaluate the function, has to be implemented in concrete
     /// classes.  \warning Do not call this function directly, call
-    /// #operator()(result_t&, const argument_t&) const throw ()
+    /// #operator()(result_ref, const argument_t&) const throw ()
     /// instead.  \param result result will be stored in this vector
     /// \param argument point at which the function will be evaluated
-    virtual void impl_compute (result_t& result, const argument_t& argument)
+    virtual void impl_compute (result_ref result, const argument_t& argument)
       const throw () = 0;
 
+    /// \brief Signal a modification of the function values.
+    ///
+    /// Concrete classes call this from their modifiers (see
+    /// #version). It must not be called while the function is being
+    /// evaluated.
+    void touch () throw ()
+    {
+      ++version_;
+    }
+
   private:
     /// \brief Problem dimension.
     size_type inputSize_;
@@ -463,6 +510,9 @@ namespace roboptim
     /// \brief Function name (for user-friendliness).
     std::string name_;
 
+    /// \brief Number of modifications of the function values.
+    std::size_t version_;
+
   protected:
     /// \brief Pointer to function logger (see log4cxx documentation).
     static log4cxx::LoggerPtr logger;
@@ -479,7 +529,8 @@ namespace roboptim
     throw (std::runtime_error)
     : inputSize_ (inputSize),
       outputSize_ (outputSize),
-      name_ (name)
+      name_ (name),
+      version_ (0)
   {
     // Positive size is required.
     assert (inputSize > 0 && outputSize > 0);
@@ -526,10 +577,14 @@ namespace roboptim
     typedef matrix_t::Scalar value_type;
 
     typedef vector_t result_t;
+    typedef Eigen::Ref<result_t> result_ref;
+    typedef const Eigen::Ref<const result_t>& const_result_ref;
     typedef vector_t argument_t;
 
     typedef vector_t gradient_t;
     typedef matrix_t jacobian_t;
+    typedef Eigen::Ref<jacobian_t> jacobian_ref;
+    typedef const Eigen::Ref<const jacobian_t>& const_jacobian_ref;
   };
 
   /// \brief Trait specializing GenericFunction for Eigen sparse matrices.
@@ -543,10 +598,14 @@ namespace roboptim
     typedef matrix_t::Scalar value_type;
 
     typedef vector_t result_t;
+    typedef Eigen::Ref<result_t> result_ref;
+    typedef const Eigen::Ref<const result_t>& const_result_ref;
     typedef vector_t argument_t;
 
     typedef Eigen::SparseVector<double> gradient_t;
     typedef matrix_t jacobian_t;
+    typedef jacobian_t& jacobian_ref;
+    typedef const jacobian_t& const_jacobian_ref;
   };
 
   /// @}
@@ -64,7 +64,7 @@ namespace roboptim
     }
 
   protected:
-    void impl_compute (result_t& result, const argument_t&) const throw ()
+    void impl_compute (result_ref result, const argument_t&) const throw ()
     {
       result = this->offset_;
     }
@@ -75,11 +75,19 @@ namespace roboptim
       gradient.setZero ();
     }
 
-    void impl_jacobian (jacobian_t& jacobian, const argument_t&) const throw ()
+    void impl_jacobian (jacobian_ref jacobian, const argument_t&) const throw ()
     {
       jacobian.setZero ();
     }
 
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t&,
+				     const argument_t&)
+      const throw ()
+    {
+      derivative.setZero ();
+    }
+
   private:
     const vector_t offset_;
   };
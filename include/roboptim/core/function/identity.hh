@@ -62,7 +62,7 @@ namespace roboptim
 
   protected:
 
-    void impl_compute (result_t& result,
+    void impl_compute (result_ref result,
 		       const argument_t& argument)
       const throw ()
     {
@@ -70,12 +70,20 @@ namespace roboptim
     }
 
     void
-    impl_jacobian (jacobian_t& jacobian,
+    impl_jacobian (jacobian_ref jacobian,
 		   const argument_t&) const throw ()
     {
       jacobian.setIdentity ();
     }
 
+    void
+    impl_directionalDerivative (result_t& derivative,
+				const argument_t&,
+				const argument_t& direction) const throw ()
+    {
+      derivative = direction;
+    }
+
     void
     impl_gradient (gradient_t& gradient,
 		   const argument_t& ,
@@ -140,7 +140,7 @@ namespace roboptim
     }
 
   protected:
-    void impl_compute (result_t& result, const argument_t& x) const throw ()
+    void impl_compute (result_ref result, const argument_t& x) const throw ()
     {
       result[0] = applyPolynomial (coeffs_, x);
     }
@@ -148,7 +148,7 @@ namespace roboptim
     void impl_gradient (gradient_t& gradient, const argument_t& x, size_type)
       const throw ();
 
-    void impl_jacobian (jacobian_t& jacobian, const argument_t& x)
+    void impl_jacobian (jacobian_ref jacobian, const argument_t& x)
       const throw ();
 
     void impl_hessian
@@ -192,7 +192,7 @@ namespace roboptim
   template <typename T>
   void
   Polynomial<T>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& x) const throw ()
+  (jacobian_ref jacobian, const argument_t& x) const throw ()
   {
     jacobian.coeffRef (0, 0) = applyPolynomial (dCoeffs_, x);
   }
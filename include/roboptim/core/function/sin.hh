@@ -55,7 +55,7 @@ namespace roboptim
     }
 
   protected:
-    void impl_compute (result_t& result, const argument_t& x) const throw ()
+    void impl_compute (result_ref result, const argument_t& x) const throw ()
     {
       result[0] = std::sin (x[0]);
     }
@@ -63,7 +63,15 @@ namespace roboptim
     void impl_gradient (gradient_t& gradient, const argument_t& x, size_type)
     const throw ();
 
-    void impl_jacobian (jacobian_t& jacobian, const argument_t& x) const throw ();
+    void impl_jacobian (jacobian_ref jacobian, const argument_t& x) const throw ();
+
+    void impl_directionalDerivative (result_t& derivative,
+				     const argument_t& x,
+				     const argument_t& direction)
+      const throw ()
+    {
+      derivative[0] = std::cos (x[0]) * direction[0];
+    }
 
     void impl_hessian
     (hessian_t& hessian, const argument_t& x, size_type) const throw ();
@@ -88,14 +96,14 @@ namespace roboptim
   template <>
   inline void
   Sin<EigenMatrixSparse>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& x) const throw ()
+  (jacobian_ref jacobian, const argument_t& x) const throw ()
   {
     jacobian.insert (0, 0) = std::cos (x[0]);
   }
   template <typename T>
   void
   Sin<T>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& x) const throw ()
+  (jacobian_ref jacobian, const argument_t& x) const throw ()
   {
     jacobian (0, 0) = std::cos (x[0]);
   }
@@ -76,6 +76,8 @@ namespace roboptim
   typedef GenericDifferentiableFunction<EigenMatrixSparse>
   DifferentiableSparseFunction;
 
+  template <typename U, typename V>
+  class Chain;
   template <typename U, typename V>
   class Minus;
   template <typename U, typename V>
@@ -84,6 +86,12 @@ namespace roboptim
   class Product;
   template <typename U>
   class Scalar;
+  template <typename U>
+  class Scaling;
+  template <typename U>
+  class MultiConcatenate;
+  template <typename U>
+  class MultiPlus;
 
 
   class GenericSolver;
@@ -136,6 +144,21 @@ namespace roboptim
   typedef GenericQuadraticFunction<EigenMatrixDense> QuadraticFunction;
   typedef GenericQuadraticFunction<EigenMatrixSparse> QuadraticSparseFunction;
 
+  template <typename S> class AsyncSolver;
+  class AugmentedLagrangianResidual;
+  template <typename S> class AugmentedLagrangianSolver;
+  template <typename P> class AutoScaling;
+  class BinaryLogReader;
+  struct BinaryLogRecord;
+  struct BinaryLogSchema;
+  class BinaryLogWriter;
+  class CancellationToken;
+  template <typename P> class ConstraintBlock;
+  template <typename S> class MultiStart;
+  template <typename P> class Presolve;
+  template <typename T, typename P> class ParameterHandle;
+  class PluginRegistry;
+  template <typename S> class Portfolio;
   template <typename F, typename C = F> class Problem;
   template <typename F, typename C = F> class Solver;
   template <typename T> class SolverFactory;
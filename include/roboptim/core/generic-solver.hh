@@ -158,6 +158,17 @@ namespace roboptim
   ROBOPTIM_DLLAPI std::ostream& operator<< (std::ostream& o,
 					    const NoSolution& ns);
 
+  namespace detail
+  {
+    /// \internal
+    /// \brief Solution held by a solver result.
+    ///
+    /// \return the Result (or ResultWithWarnings) held by result, or
+    /// null if result has no solution
+    ROBOPTIM_DLLAPI const Result*
+    solution (const GenericSolver::result_t& result) throw ();
+  } // end of namespace detail.
+
 } // end of namespace roboptim
 
 #endif //! ROBOPTIM_CORE_GENERIC_SOLVER_HH
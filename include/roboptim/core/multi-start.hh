@@ -0,0 +1,244 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_MULTI_START_HH
+# define ROBOPTIM_CORE_MULTI_START_HH
+# include <cstddef>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+# include <boost/noncopyable.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/generic-solver.hh>
+# include <roboptim/core/sampling.hh>
+# include <roboptim/core/solver-factory.hh>
+# include <roboptim/core/thread-pool.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Solve a problem from several starting points.
+  ///
+  /// Non-convex problems have several local minima: the multi-start
+  /// driver samples starting points within the argument bounds,
+  /// solves the problem from each of them with an independent solver
+  /// instance (loaded from a plug-in, see SolverFactory) and keeps
+  /// the best result.
+  ///
+  /// The starts are run in parallel on a thread pool, so the problem
+  /// functions must support concurrent evaluations.
+  ///
+  /// Infinite argument bounds are replaced by a unit-relative box
+  /// around the problem starting point (or zero).
+  ///
+  /// Once a start reaches the target cost (see setTargetCost), the
+  /// remaining starts are skipped and the running solvers are asked
+  /// to stop through their iteration callback (see
+  /// SolverState::requestStop).
+  ///
+  /// The local minima found can be clustered: results closer than a
+  /// tolerance (see setClusterTolerance) are considered to be the
+  /// same minimum.
+  ///
+  /// \tparam S solver type
+  template <typename S>
+  class MultiStart : public boost::noncopyable
+  {
+  public:
+    /// \brief Solver type.
+    typedef S solver_t;
+    /// \brief Problem type.
+    typedef typename solver_t::problem_t problem_t;
+    /// \brief Cost function type.
+    typedef typename problem_t::function_t function_t;
+    /// \brief Import value type.
+    typedef typename problem_t::value_type value_type;
+    /// \brief Import vector type.
+    typedef typename problem_t::vector_t vector_t;
+    /// \brief Import size type.
+    typedef typename problem_t::size_type size_type;
+    /// \brief Solver result type.
+    typedef GenericSolver::result_t result_t;
+    /// \brief Solver parameters type.
+    typedef typename solver_t::parameters_t parameters_t;
+    /// \brief Solver state type.
+    typedef typename solver_t::solverState_t solverState_t;
+    /// \brief Indices vector.
+    typedef std::vector<size_type> indices_t;
+
+    /// \brief Create a multi-start driver.
+    ///
+    /// \param solver solver plug-in name (for instance ``cfsqp'')
+    /// \param problem problem to solve (copied)
+    /// \param starts number of starting points
+    /// \param method starting points sampling method
+    MultiStart (const std::string& solver, const problem_t& problem,
+		std::size_t starts,
+		SamplingMethod method = SAMPLING_LATIN_HYPERCUBE)
+      throw (std::runtime_error);
+
+    ~MultiStart () throw ();
+
+    /// \brief Problem to solve.
+    const problem_t& problem () const throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Number of starting points.
+    std::size_t starts () const throw ()
+    {
+      return starts_;
+    }
+
+    /// \brief Parameters given to each solver instance.
+    ///
+    /// They override the solvers default parameters.
+    parameters_t& parameters () throw ()
+    {
+      return parameters_;
+    }
+
+    /// \brief Parameters given to each solver instance.
+    const parameters_t& parameters () const throw ()
+    {
+      return parameters_;
+    }
+
+    /// \brief Set the sampling seed (the same seed gives the same
+    /// starting points).
+    void setSeed (boost::uint32_t seed) throw ();
+
+    /// \brief Stop once a start reaches this cost.
+    void setTargetCost (value_type cost) throw ();
+
+    /// \brief Cluster the minima closer than this distance
+    /// (zero: no clustering).
+    void setClusterTolerance (value_type tolerance)
+      throw (std::runtime_error);
+
+    /// \brief Run the starts on this pool instead of the global pool.
+    void setThreadPool (ThreadPool& pool) throw ();
+
+    /// \brief Sample the starting points and solve from each of them.
+    void solve () throw (std::runtime_error);
+
+    /// \brief Sampled starting points.
+    const std::vector<vector_t>& startingPoints () const throw ()
+    {
+      return startingPoints_;
+    }
+
+    /// \brief Result of each start.
+    ///
+    /// Skipped starts (target reached) have no solution.
+    const std::vector<result_t>& results () const throw ()
+    {
+      return results_;
+    }
+
+    /// \brief Whether a start found a solution.
+    bool hasSolution () const throw ();
+
+    /// \brief Index of the start with the lowest cost.
+    std::size_t bestIndex () const throw (std::runtime_error);
+
+    /// \brief Result with the lowest cost.
+    const Result& best () const throw (std::runtime_error);
+
+    /// \brief Whether the target cost has been reached.
+    bool targetReached () const throw ()
+    {
+      return targetReached_;
+    }
+
+    /// \brief Distinct local minima.
+    ///
+    /// Index of the best start of each cluster, by increasing cost.
+    const indices_t& minima () const throw ()
+    {
+      return minima_;
+    }
+
+    /// \brief Cluster (index in minima) of each start.
+    ///
+    /// Starts without solution are associated with -1.
+    const indices_t& clusters () const throw ()
+    {
+      return clusters_;
+    }
+
+  private:
+    /// \brief Map the unit samples to the argument bounds.
+    void sampleStartingPoints () throw (std::runtime_error);
+
+    /// \brief Solve from the i-th starting point.
+    void solveStart (std::size_t i);
+
+    /// \brief Iteration callback: stop when the target is reached.
+    void stopCallback (const problem_t& problem, solverState_t& state);
+
+    /// \brief Cluster the local minima.
+    void cluster () throw ();
+
+    /// \brief Solver plug-in name.
+    std::string solver_;
+    /// \brief Problem to solve.
+    const problem_t problem_;
+    /// \brief Number of starting points.
+    std::size_t starts_;
+    /// \brief Sampling method.
+    SamplingMethod method_;
+    /// \brief Sampling seed.
+    boost::uint32_t seed_;
+    /// \brief Solvers parameters.
+    parameters_t parameters_;
+    /// \brief Whether a target cost is set.
+    bool hasTarget_;
+    /// \brief Target cost.
+    value_type targetCost_;
+    /// \brief Clustering tolerance.
+    value_type clusterTolerance_;
+    /// \brief Thread pool.
+    ThreadPool* pool_;
+
+    /// \brief Sampled starting points.
+    std::vector<vector_t> startingPoints_;
+    /// \brief Result of each start.
+    std::vector<result_t> results_;
+    /// \brief Whether the target cost has been reached.
+    bool targetReached_;
+    /// \brief Distinct local minima.
+    indices_t minima_;
+    /// \brief Cluster of each start.
+    indices_t clusters_;
+    /// \brief Protect the results and the target flag.
+    mutable boost::mutex mutex_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/multi-start.hxx>
+#endif //! ROBOPTIM_CORE_MULTI_START_HH
@@ -0,0 +1,278 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_MULTI_START_HXX
+# define ROBOPTIM_CORE_MULTI_START_HXX
+# include <algorithm>
+# include <cmath>
+# include <utility>
+
+# include <boost/bind.hpp>
+# include <boost/foreach.hpp>
+# include <boost/format.hpp>
+
+# include <roboptim/core/plugin-registry.hh>
+
+namespace roboptim
+{
+  template <typename S>
+  MultiStart<S>::MultiStart (const std::string& solver,
+			     const problem_t& problem,
+			     std::size_t starts,
+			     SamplingMethod method)
+    throw (std::runtime_error)
+    : solver_ (solver),
+      problem_ (problem),
+      starts_ (starts),
+      method_ (method),
+      seed_ (5489u),
+      parameters_ (),
+      hasTarget_ (false),
+      targetCost_ (0.),
+      clusterTolerance_ (0.),
+      pool_ (&ThreadPool::global ()),
+      startingPoints_ (),
+      results_ (),
+      targetReached_ (false),
+      minima_ (),
+      clusters_ (),
+      mutex_ ()
+  {
+    if (!starts)
+      throw std::runtime_error ("Multi-start needs at least one start");
+  }
+
+  template <typename S>
+  MultiStart<S>::~MultiStart () throw ()
+  {}
+
+  template <typename S>
+  void
+  MultiStart<S>::setSeed (boost::uint32_t seed) throw ()
+  {
+    seed_ = seed;
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::setTargetCost (value_type cost) throw ()
+  {
+    hasTarget_ = true;
+    targetCost_ = cost;
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::setClusterTolerance (value_type tolerance)
+    throw (std::runtime_error)
+  {
+    if (tolerance < 0.)
+      {
+	boost::format fmt ("Invalid cluster tolerance (%1%)");
+	fmt % tolerance;
+	throw std::runtime_error (fmt.str ());
+      }
+    clusterTolerance_ = tolerance;
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::setThreadPool (ThreadPool& pool) throw ()
+  {
+    pool_ = &pool;
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::sampleStartingPoints () throw (std::runtime_error)
+  {
+    const size_type n = problem_.function ().inputSize ();
+
+    // Center of the unbounded directions: starting point, or zero
+    // projected on the bounds.
+    vector_t x0 (n);
+    if (problem_.startingPoint ())
+      x0 = *problem_.startingPoint ();
+    else
+      x0 = vector_t::Zero (n)
+	.cwiseMax (problem_.argumentLowerBounds ())
+	.cwiseMin (problem_.argumentUpperBounds ());
+
+    vector_t lower (n);
+    vector_t upper (n);
+    for (size_type j = 0; j < n; ++j)
+      {
+	const value_type width = 1. + std::fabs (x0[j]);
+	lower[j] = problem_.argumentLowerBounds ()[j];
+	upper[j] = problem_.argumentUpperBounds ()[j];
+	if (lower[j] == -function_t::infinity ())
+	  lower[j] = std::min (x0[j], upper[j]) - width;
+	if (upper[j] == function_t::infinity ())
+	  upper[j] = std::max (x0[j], lower[j]) + width;
+      }
+
+    const Function::matrix_t samples =
+      sampleUnitHypercube (starts_, static_cast<std::size_t> (n),
+			   method_, seed_);
+
+    startingPoints_.resize (starts_);
+    for (std::size_t i = 0; i < starts_; ++i)
+      startingPoints_[i] = lower + (upper - lower).cwiseProduct
+	(samples.col (static_cast<size_type> (i)));
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::stopCallback (const problem_t&, solverState_t& state)
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    if (targetReached_)
+      state.requestStop ();
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::solveStart (std::size_t i)
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (mutex_);
+      if (targetReached_)
+	return;
+    }
+
+    problem_t problem (problem_);
+    problem.startingPoint () = startingPoints_[i];
+
+    SolverFactory<solver_t> factory (solver_, problem);
+    solver_t& solver = factory ();
+
+    typedef std::pair<const std::string, Parameter> parameter_t;
+    BOOST_FOREACH (const parameter_t& parameter, parameters_)
+      solver.parameters ()[parameter.first] = parameter.second;
+
+    if (hasTarget_)
+      try
+	{
+	  solver.setIterationCallback
+	    (boost::bind (&MultiStart<S>::stopCallback, this, _1, _2));
+	}
+      catch (const std::runtime_error&)
+	{
+	  // Iteration callbacks are not supported: the solver can only
+	  // be skipped before it starts.
+	}
+
+    const result_t& result = solver.minimum ();
+
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    results_[i] = result;
+    const Result* r = detail::solution (result);
+    if (hasTarget_ && r && r->value[0] <= targetCost_)
+      targetReached_ = true;
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::cluster () throw ()
+  {
+    minima_.clear ();
+    clusters_.assign (starts_, -1);
+
+    // Starts with a solution, by increasing cost.
+    std::vector<std::pair<value_type, std::size_t> > order;
+    for (std::size_t i = 0; i < starts_; ++i)
+      if (const Result* r = detail::solution (results_[i]))
+	order.push_back (std::make_pair (r->value[0], i));
+    std::sort (order.begin (), order.end ());
+
+    // Each solution joins the first (best) minimum close enough, or
+    // becomes a new minimum.
+    for (std::size_t k = 0; k < order.size (); ++k)
+      {
+	const std::size_t i = order[k].second;
+	const vector_t& x = detail::solution (results_[i])->x;
+
+	std::size_t c = 0;
+	if (clusterTolerance_ > 0.)
+	  for (; c < minima_.size (); ++c)
+	    {
+	      const std::size_t m = static_cast<std::size_t> (minima_[c]);
+	      if ((x - detail::solution (results_[m])->x).norm ()
+		  <= clusterTolerance_)
+		break;
+	    }
+	else
+	  c = minima_.size ();
+
+	if (c == minima_.size ())
+	  minima_.push_back (static_cast<size_type> (i));
+	clusters_[i] = static_cast<size_type> (c);
+      }
+  }
+
+  template <typename S>
+  void
+  MultiStart<S>::solve () throw (std::runtime_error)
+  {
+    sampleStartingPoints ();
+    results_.assign (starts_, NoSolution ());
+    targetReached_ = false;
+
+    // Keep the plug-in loaded while the starts create and destroy
+    // their solvers.
+    PluginRegistry& registry = PluginRegistry::instance ();
+    const PluginRegistry::Plugin& plugin = registry.acquire (solver_);
+    try
+      {
+	pool_->run (starts_, boost::bind (&MultiStart<S>::solveStart,
+					  this, _1));
+      }
+    catch (...)
+      {
+	registry.release (plugin);
+	throw;
+      }
+    registry.release (plugin);
+
+    cluster ();
+  }
+
+  template <typename S>
+  bool
+  MultiStart<S>::hasSolution () const throw ()
+  {
+    return !minima_.empty ();
+  }
+
+  template <typename S>
+  std::size_t
+  MultiStart<S>::bestIndex () const throw (std::runtime_error)
+  {
+    if (minima_.empty ())
+      throw std::runtime_error ("Multi-start found no solution");
+    return static_cast<std::size_t> (minima_[0]);
+  }
+
+  template <typename S>
+  const Result&
+  MultiStart<S>::best () const throw (std::runtime_error)
+  {
+    return *detail::solution (results_[bestIndex ()]);
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_MULTI_START_HXX
@@ -93,7 +93,7 @@ namespace roboptim
     /// \param result result will be stored in this vector
     /// \param argument point at which the function will be evaluated
     /// \return computed result
-    void operator () (result_t& result, double argument) const throw ()
+    void operator () (result_ref result, double argument) const throw ()
     {
       assert (isValidResult (result));
       this->impl_compute (result, argument);
@@ -165,7 +165,7 @@ namespace roboptim
     ///
     /// \param result result will be stored in this vector
     /// \param argument point at which the function will be evaluated
-    void impl_compute (result_t& result, const argument_t& argument)
+    void impl_compute (result_ref result, const argument_t& argument)
       const throw ()
     {
       (*this) (result, argument[0]);
@@ -178,7 +178,7 @@ namespace roboptim
     /// #operator()(double) const throw () instead.  \param result
     /// result will be stored in this vector \param t point at which
     /// the function will be evaluated
-    virtual void impl_compute (result_t& result, double t) const throw () = 0;
+    virtual void impl_compute (result_ref result, double t) const throw () = 0;
 
     /// \brief Gradient evaluation.
     ///
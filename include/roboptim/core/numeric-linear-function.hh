@@ -80,10 +80,12 @@ namespace roboptim
     }
 
 
-    void impl_compute (result_t& , const argument_t&) const throw ();
+    void impl_compute (result_ref , const argument_t&) const throw ();
     void impl_gradient (gradient_t&, const argument_t&, size_type = 0)
       const throw ();
-    void impl_jacobian (jacobian_t&, const argument_t&) const throw ();
+    void impl_jacobian (jacobian_ref , const argument_t&) const throw ();
+    void impl_directionalDerivative (result_t&, const argument_t&,
+				     const argument_t&) const throw ();
 
   private:
     /// \brief A matrix.
@@ -66,7 +66,7 @@ namespace roboptim
   // A * x + b
   template <typename T>
   void
-  GenericNumericLinearFunction<T>::impl_compute (result_t& result,
+  GenericNumericLinearFunction<T>::impl_compute (result_ref result,
 						 const argument_t& argument)
     const throw ()
   {
@@ -78,11 +78,21 @@ namespace roboptim
   template <typename T>
   void
   GenericNumericLinearFunction<T>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t&) const throw ()
+  (jacobian_ref jacobian, const argument_t&) const throw ()
   {
     jacobian = this->a_;
   }
 
+  // A * d
+  template <typename T>
+  void
+  GenericNumericLinearFunction<T>::impl_directionalDerivative
+  (result_t& derivative, const argument_t&, const argument_t& direction)
+    const throw ()
+  {
+    derivative.noalias () = a_ * direction;
+  }
+
   // A(i) - sparse specialization
   template <>
   inline void
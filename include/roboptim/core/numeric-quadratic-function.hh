@@ -106,10 +106,10 @@ namespace roboptim
     }
 
   protected:
-    void impl_compute (result_t& , const argument_t&) const throw ();
+    void impl_compute (result_ref , const argument_t&) const throw ();
     void impl_gradient (gradient_t&, const argument_t&, size_type = 0)
       const throw ();
-    void impl_jacobian (jacobian_t&, const argument_t&) const throw ();
+    void impl_jacobian (jacobian_ref , const argument_t&) const throw ();
     void impl_hessian (hessian_t& hessian,
 		       const argument_t& argument,
 		       size_type functionId = 0) const throw ();
@@ -63,7 +63,7 @@ namespace roboptim
   // x^T * A * x + b^T * x + c
   template <typename T>
   void
-  GenericNumericQuadraticFunction<T>::impl_compute (result_t& result,
+  GenericNumericQuadraticFunction<T>::impl_compute (result_ref result,
 						    const argument_t& argument)
     const throw ()
   {
@@ -77,7 +77,7 @@ namespace roboptim
   template <>
   inline void
   GenericNumericQuadraticFunction<EigenMatrixSparse>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& x) const throw ()
+  (jacobian_ref jacobian, const argument_t& x) const throw ()
   {
 #ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
     Eigen::internal::set_is_malloc_allowed (true);
@@ -95,7 +95,7 @@ namespace roboptim
   template <typename T>
   void
   GenericNumericQuadraticFunction<T>::impl_jacobian
-  (jacobian_t& jacobian, const argument_t& x) const throw ()
+  (jacobian_ref jacobian, const argument_t& x) const throw ()
   {
     jacobian.noalias () = 2 * x.transpose () * a_;
     jacobian += b_.transpose ();
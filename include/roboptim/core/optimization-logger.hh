@@ -17,20 +17,37 @@
 
 #ifndef ROBOPTIM_CORE_OPTIMIZATION_LOGGER_HH
 # define ROBOPTIM_CORE_OPTIMIZATION_LOGGER_HH
+# include <algorithm>
+# include <cstddef>
+# include <deque>
+# include <iostream>
+# include <sstream>
+# include <stdexcept>
 # include <string>
 
+# include <boost/atomic.hpp>
 # include <boost/bind.hpp>
 # include <boost/date_time/posix_time/posix_time.hpp>
 # include <boost/filesystem.hpp>
 # include <boost/filesystem/fstream.hpp>
 # include <boost/format.hpp>
+# include <boost/scoped_ptr.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/thread.hpp>
 # include <boost/variant/apply_visitor.hpp>
 # include <boost/variant/static_visitor.hpp>
 # include <boost/utility/enable_if.hpp>
 # include <boost/mpl/vector.hpp>
 # include <boost/type_traits/is_same.hpp>
 
+# include <Eigen/Sparse>
+
+# include <roboptim/core/binary-log.hh>
 # include <roboptim/core/config.hh>
+# include <roboptim/core/constraint-block.hh>
+# include <roboptim/core/detail/spsc-ring.hh>
 
 namespace roboptim
 {
@@ -81,58 +98,216 @@ namespace roboptim
       }
     };
 
+    /// \brief Nonzero coefficients of the rows [offset, offset + size)
+    /// of a dense jacobian, row by row.
+    ///
+    /// Rows are given relative to offset.
+    template <typename D>
+    void jacobianRowsTriplets
+    (const Eigen::MatrixBase<D>& jacobian,
+     typename D::Index offset,
+     typename D::Index size,
+     std::vector<Eigen::Triplet<typename D::Scalar> >& triplets)
+    {
+      typedef Eigen::Triplet<typename D::Scalar> triplet_t;
+
+      triplets.clear ();
+      for (typename D::Index i = 0; i < size; ++i)
+	for (typename D::Index j = 0; j < jacobian.cols (); ++j)
+	  if (jacobian.coeff (offset + i, j) != 0.)
+	    triplets.push_back
+	      (triplet_t (static_cast<int> (i), static_cast<int> (j),
+			  jacobian.coeff (offset + i, j)));
+    }
+
+    /// \brief Nonzero coefficients of the rows [offset, offset + size)
+    /// of a sparse jacobian, in storage order.
+    ///
+    /// Only the stored coefficients are visited: the matrix is
+    /// neither searched nor modified.
+    template <typename S, int O, typename I>
+    void jacobianRowsTriplets
+    (const Eigen::SparseMatrix<S, O, I>& jacobian,
+     typename Eigen::SparseMatrix<S, O, I>::Index offset,
+     typename Eigen::SparseMatrix<S, O, I>::Index size,
+     std::vector<Eigen::Triplet<S> >& triplets)
+    {
+      typedef Eigen::SparseMatrix<S, O, I> matrix_t;
+      typedef typename matrix_t::Index index_t;
+      typedef Eigen::Triplet<S> triplet_t;
+
+      triplets.clear ();
+
+      // Row-major: only visit the constraint rows.
+      const bool rowMajor = matrix_t::IsRowMajor;
+      const index_t begin = rowMajor ? offset : 0;
+      const index_t end = rowMajor ? offset + size : jacobian.outerSize ();
+      for (index_t k = begin; k < end; ++k)
+	for (typename matrix_t::InnerIterator it (jacobian, k); it; ++it)
+	  if (it.row () >= offset && it.row () < offset + size)
+	    triplets.push_back
+	      (triplet_t (static_cast<int> (it.row () - offset),
+			  static_cast<int> (it.col ()), it.value ()));
+    }
+
     template <typename P>
     struct EvaluateConstraintViolation
     {
       typedef typename P::vector_t vector_t;
       typedef typename P::value_type value_type;
-      typedef typename P::intervalsVect_t intervalsVect_t;
-      typedef typename P::interval_t interval_t;
 
+      /// \param constraints stacked constraints values
+      /// \param problem problem providing the stacked bounds
       EvaluateConstraintViolation
-      (const std::vector<vector_t>& constraints,
-       const intervalsVect_t& bounds)
+      (const vector_t& constraints,
+       const P& problem)
         : constraints_ (constraints),
-          bounds_ (bounds)
+          problem_ (problem)
       {}
 
-      value_type computeViolation (const value_type& x,
-                                   const interval_t& x_ul) const
-      {
-        if (x < x_ul.first)
-          return x_ul.first - x;
-        else if (x > x_ul.second)
-          return x - x_ul.second;
-        else return 0.;
-      }
-
       value_type uniformNorm () const
       {
-        value_type norm = 0.;
-        value_type cstr_viol = 0.;
-
-        // For each multidimensional constraint
-        for (std::size_t i = 0; i < constraints_.size (); ++i)
-          {
-            // For each dimension of the constraint
-            for (std::size_t j = 0; j < constraints_[i].size (); ++j)
-              {
-                cstr_viol = computeViolation (constraints_[i][j],
-                                              bounds_[i][j]);
-
-                norm = std::max (norm, fabs (cstr_viol));
-              }
+        if (constraints_.size () == 0)
+          return 0.;
 
-          }
-        return norm;
+        // Distance to the [lower, upper] interval, row by row.
+        return (problem_.constraintsLowerBounds () - constraints_)
+          .cwiseMax (constraints_ - problem_.constraintsUpperBounds ())
+          .cwiseMax (0.).maxCoeff ();
       }
 
     private:
-      const std::vector<vector_t>& constraints_;
-      const intervalsVect_t& bounds_;
+      const vector_t& constraints_;
+      const P& problem_;
     };
   } // end of namespace detail.
 
+  /// \brief Behavior of an asynchronous logger whose queue is full.
+  enum LoggerBackpressure
+    {
+      /// \brief Drop the iteration.
+      LOGGER_DROP,
+      /// \brief Wait until the writer thread frees a slot.
+      LOGGER_BLOCK,
+      /// \brief Wait for one iteration out of samplingPeriod, drop
+      /// the others.
+      LOGGER_SAMPLE
+    };
+
+  /// \brief Storage of the per-iteration logs.
+  enum LoggerFormat
+    {
+      /// \brief One directory of CSV files per iteration, and whole
+      /// run CSV files written at the end.
+      LOGGER_CSV,
+      /// \brief A single binary log file, log.bin (see
+      /// BinaryLogSchema). The journal only holds the solver
+      /// description.
+      LOGGER_BINARY
+    };
+
+  /// \brief Storage of the constraints jacobians in the CSV logs.
+  enum LoggerJacobianFormat
+    {
+      /// \brief Sparse for sparse functions, dense otherwise.
+      LOGGER_JACOBIAN_AUTO,
+      /// \brief All the coefficients, in jacobian.csv.
+      LOGGER_JACOBIAN_DENSE,
+      /// \brief Only the nonzero coefficients.
+      ///
+      /// jacobian-pattern.csv holds the row and column of each
+      /// nonzero coefficient (rows are relative to the constraint).
+      /// It is only written when the pattern differs from the one of
+      /// the previous logged iteration. jacobian-values.csv holds the
+      /// values of the nonzero coefficients, in pattern order.
+      LOGGER_JACOBIAN_SPARSE
+    };
+
+  /// \brief Options of an OptimizationLogger.
+  struct OptimizationLoggerOptions
+  {
+    OptimizationLoggerOptions ()
+      : asynchronous (false),
+	queueSize (64),
+	backpressure (LOGGER_BLOCK),
+	samplingPeriod (10),
+	format (LOGGER_CSV),
+	binaryJacobian (true),
+	jacobianCapacity (0),
+	streaming (false),
+	flushPeriod (10),
+	historySize (100),
+	jacobianFormat (LOGGER_JACOBIAN_AUTO)
+    {}
+
+    /// \brief Whether formatting and I/O are done by a writer thread.
+    ///
+    /// In asynchronous mode, the iteration callback only copies the
+    /// iterate, the cost and the constraint violation given by the
+    /// solver into a bounded queue. The writer thread evaluates
+    /// whatever is missing (cost, constraints and their jacobians)
+    /// and writes the logs. The functions of the problem must then
+    /// be reentrant, as the solver keeps evaluating them meanwhile.
+    bool asynchronous;
+    /// \brief Maximum number of queued iterations (asynchronous mode).
+    std::size_t queueSize;
+    /// \brief What to do when the queue is full (asynchronous mode).
+    LoggerBackpressure backpressure;
+    /// \brief Sampling period of LOGGER_SAMPLE.
+    unsigned samplingPeriod;
+    /// \brief Storage of the per-iteration logs.
+    LoggerFormat format;
+    /// \brief Whether the constraints jacobian is stored in the
+    /// binary log.
+    bool binaryJacobian;
+    /// \brief Maximum number of jacobian nonzeros of a binary log
+    /// record.
+    ///
+    /// If zero, the number of nonzeros of the first jacobian is used
+    /// (i.e. all the coefficients of a dense jacobian). Iterations
+    /// whose jacobian has more nonzeros are not logged, and the next
+    /// flush of the logger throws a std::runtime_error.
+    std::size_t jacobianCapacity;
+    /// \brief Whether the whole run CSV files are written as the
+    /// solver iterates (CSV format).
+    ///
+    /// Each iteration is appended to the *-evolution.csv files, which
+    /// are flushed every flushPeriod iterations, so that the logs
+    /// survive a crash. Only the last historySize iterations are kept
+    /// in memory.
+    bool streaming;
+    /// \brief Number of iterations between two flushes (streaming mode).
+    unsigned flushPeriod;
+    /// \brief Number of iterations kept in memory (streaming mode).
+    std::size_t historySize;
+    /// \brief Storage of the constraints jacobians (CSV format).
+    LoggerJacobianFormat jacobianFormat;
+  };
+
+  /// \brief Summary of an optimization log.
+  struct OptimizationLoggerSummary
+  {
+    OptimizationLoggerSummary ()
+      : iterations (0),
+	lastIteration (0),
+	lastCost (0.),
+	bestIteration (0),
+	bestCost (0.),
+	lastConstraintViolation (0.)
+    {}
+
+    /// \brief Number of logged iterations.
+    std::size_t iterations;
+    /// \brief Callback call number of the last logged iteration.
+    std::size_t lastIteration;
+    double lastCost;
+    /// \brief Callback call number of the iteration with the lowest
+    /// cost.
+    std::size_t bestIteration;
+    double bestCost;
+    double lastConstraintViolation;
+  };
+
   template <typename T>
   class OptimizationLogger
   {
@@ -143,14 +318,48 @@ namespace roboptim
     typedef typename solver_t::problem_t::vector_t vector_t;
     typedef typename solver_t::problem_t::function_t::matrix_t jacobian_t;
     typedef typename solver_t::solverState_t solverState_t;
+    typedef ::roboptim::ConstraintBlock<problem_t> constraintBlock_t;
 
     explicit OptimizationLogger (solver_t& solver,
-				 const boost::filesystem::path& path)
+				 const boost::filesystem::path& path,
+				 const OptimizationLoggerOptions& options =
+				 OptimizationLoggerOptions ())
       : solver_ (solver),
 	path_ (path),
+	options_ (options),
 	output_ (),
 	callbackCallId_ (0),
-	firstTime_ (boost::posix_time::microsec_clock::universal_time ())
+	firstTime_ (boost::posix_time::microsec_clock::universal_time ()),
+	solverDescription_ (),
+	snapshot_ (),
+	queue_ (),
+	writer_ (),
+	mutex_ (),
+	queued_ (),
+	released_ (),
+	writerWaiting_ (false),
+	producerWaiting_ (false),
+	stopping_ (false),
+	droppedIterations_ (0),
+	jacobianPatterns_ (),
+	triplets_ (),
+	constraintBlock_ (),
+	constraintsValue_ (),
+	constraintsJacobian_ (),
+	binaryLog_ (),
+	record_ (),
+	overflowedIterations_ (0),
+	maxJacobianNonZeros_ (0),
+	x_ (),
+	costs_ (),
+	constraintViolations_ (),
+	constraints_ (),
+	summary_ (),
+	costStream_ (),
+	violationStream_ (),
+	xStream_ (),
+	constraintStreams_ (),
+	streamedIterations_ (0)
     {
       lastTime_ = firstTime_;
 
@@ -184,6 +393,16 @@ namespace roboptim
 	<< " - roboptim-core version: " ROBOPTIM_CORE_VERSION "\n"
 	<< std::string (80, '*') << iendl
 	;
+
+      // Start the writer thread.
+      if (options_.asynchronous)
+	{
+	  queue_.reset (new detail::SpscRing<Snapshot>
+			(std::max<std::size_t> (options_.queueSize, 1)));
+	  writer_ = boost::shared_ptr<boost::thread>
+	    (new boost::thread
+	     (boost::bind (&OptimizationLogger<T>::writerLoop, this)));
+	}
     }
 
     virtual ~OptimizationLogger ()
@@ -196,6 +415,17 @@ namespace roboptim
       catch (std::exception& e)
 	{}
 
+      // Write the queued iterations, then stop the writer thread.
+      if (writer_)
+	{
+	  {
+	    boost::lock_guard<boost::mutex> lock (mutex_);
+	    stopping_ = true;
+	  }
+	  queued_.notify_one ();
+	  writer_->join ();
+	}
+
       // Get current time
       boost::posix_time::ptime t =
 	boost::posix_time::microsec_clock::universal_time();
@@ -207,8 +437,40 @@ namespace roboptim
 	<< boost::posix_time::to_iso_extended_string(t) << "Z" << iendl
 	<< " - total elapsed time: "
 	<< (t - firstTime_) << iendl
-	<< std::string (80, '*') << iendl
+	<< " - logged iterations: " << summary_.iterations << iendl
 	;
+      if (summary_.iterations > 0)
+	output_
+	  << " - last cost: " << summary_.lastCost
+	  << " (iteration " << summary_.lastIteration << ")" << iendl
+	  << " - best cost: " << summary_.bestCost
+	  << " (iteration " << summary_.bestIteration << ")" << iendl
+	  << " - last constraint violation: "
+	  << summary_.lastConstraintViolation << iendl;
+      output_ << std::string (80, '*') << iendl;
+
+      // The binary log holds the whole run.
+      if (binaryLog_)
+	{
+	  try
+	    {
+	      binaryLog_->flush ();
+	      checkBinaryLog ();
+	    }
+	  catch (std::exception& e)
+	    {
+	      std::cerr << e.what () << std::endl;
+	    }
+	}
+      if (options_.format != LOGGER_CSV)
+	return;
+
+      // Streamed logs are already written.
+      if (options_.streaming)
+	{
+	  flushStreams ();
+	  return;
+	}
 
       // Cost evolution over time.
       {
@@ -233,23 +495,9 @@ namespace roboptim
 	boost::filesystem::ofstream streamX (path_ / "x-evolution.csv");
 	if (!x_.empty ())
 	  {
-	    for (std::size_t i = 0; i < x_[0].size (); ++i)
-	      {
-		if (i > 0)
-		  streamX << ", ";
-		streamX << "X " << i;
-	      }
-	    streamX << "\n";
+	    writeCsvHeader (streamX, "X ", x_[0].size ());
 	    for (std::size_t nIter = 0; nIter < x_.size (); ++nIter)
-	      {
-		for (std::size_t i = 0; i < x_[nIter].size (); ++i)
-		  {
-		    if (i > 0)
-		      streamX << ", ";
-		    streamX << x_[nIter][i];
-		  }
-		streamX << "\n";
-	      }
+	      writeCsvLine (streamX, x_[nIter]);
 	  }
       }
 
@@ -261,43 +509,76 @@ namespace roboptim
 	  {
 	    boost::filesystem::ofstream streamConstraint
 	      (path_ / (boost::format ("constraint-%d-evolution.csv") % constraintId).str ());
-	    for (std::size_t i = 0; i < constraints_[0][constraintId].size (); ++i)
-	      {
-		if (i > 0)
-		  streamConstraint << ", ";
-		streamConstraint << "output " << i;
-	      }
-	    streamConstraint << "\n";
+	    writeCsvHeader (streamConstraint, "output ",
+			    constraints_[0][constraintId].size ());
 	    for (std::size_t nIter = 0; nIter < constraints_.size (); ++nIter)
-	      {
-		for (std::size_t i = 0; i < constraints_[nIter][constraintId].size (); ++i)
-		  {
-		    if (i > 0)
-		      streamConstraint << ", ";
-		    streamConstraint << constraints_[nIter][constraintId][i];
-		  }
-		streamConstraint << "\n";
-	      }
+	      writeCsvLine (streamConstraint, constraints_[nIter][constraintId]);
           }
     }
 
+    /// \brief Summary of the logged iterations.
+    ///
+    /// The summary is updated at each logged iteration, it does not
+    /// depend on the history kept in memory. In asynchronous mode,
+    /// flush the logger first.
+    const OptimizationLoggerSummary& summary () const throw ()
+    {
+      return summary_;
+    }
+
   private:
+    /// \brief Data copied from the solver state at each iteration.
+    struct Snapshot
+    {
+      Snapshot ()
+	: iteration (0),
+	  elapsed (),
+	  x (),
+	  hasCost (false),
+	  cost (0.),
+	  hasConstraintViolation (false),
+	  constraintViolation (0.)
+      {}
+
+      /// \brief Callback call number.
+      unsigned iteration;
+      /// \brief Time elapsed since the previous callback call.
+      boost::posix_time::time_duration elapsed;
+      /// \brief Current iterate.
+      vector_t x;
+      /// \brief Whether the solver provided the cost.
+      bool hasCost;
+      value_type cost;
+      /// \brief Whether the solver provided the constraint violation.
+      bool hasConstraintViolation;
+      value_type constraintViolation;
+    };
+
     /// \brief Process constraints in the callback.
     /// This method is needed as long as unconstrained problem_t do not have
     /// constraint_t and related methods defined.
     template <typename U>
     typename boost::disable_if<boost::is_same<U, boost::mpl::vector<> > >::type
     process_constraints (const typename solver_t::problem_t& pb,
-                         const typename solver_t::solverState_t& state,
+                         const Snapshot& snapshot,
                          const boost::filesystem::path& iterationPath,
                          const typename solver_t::vector_t& x,
                          value_type& cstrViol)
     {
-      // constraints
+      // constraints: evaluate all of them at once.
+      const constraintBlock_t& block = constraintBlock (pb);
+      const vector_t& constraintsValue = evaluateConstraints (block, x);
+      const jacobian_t& constraintsJacobian = evaluateJacobian (block, x);
+
       std::vector<vector_t> constraintsOneIteration (pb.constraints ().size ());
       for (std::size_t constraintId = 0; constraintId < pb.constraints ().size ();
            ++constraintId)
         {
+          const typename problem_t::size_type offset =
+            block.offsets ()[constraintId];
+          const typename problem_t::size_type size =
+            block.offsets ()[constraintId + 1] - offset;
+
           // Create local path.
           boost::filesystem::path constraintPath =
             iterationPath / (boost::format ("constraint-%d") % constraintId).str ();
@@ -312,8 +593,7 @@ namespace roboptim
           // Log value
           boost::filesystem::ofstream constraintValueStream (constraintPath / "value.csv");
 
-          vector_t constraintValue = boost::apply_visitor
-            (::roboptim::detail::EvaluateConstraint<problem_t> (x), pb.constraints ()[constraintId]);
+          vector_t constraintValue = constraintsValue.segment (offset, size);
           for (std::size_t i = 0; i < constraintValue.size (); ++i)
             {
               constraintValueStream << constraintValue[i];
@@ -324,15 +604,21 @@ namespace roboptim
           constraintsOneIteration[constraintId] = constraintValue;
 
           // Jacobian
+          if (sparseJacobian ())
+            {
+              process_sparse_jacobian
+                (constraintPath, constraintsJacobian, offset, size,
+                 constraintId);
+              continue;
+            }
+
           boost::filesystem::ofstream jacobianStream (constraintPath / "jacobian.csv");
-          jacobian_t jacobian = boost::apply_visitor
-            (::roboptim::detail::JacobianConstraint<problem_t> (x), pb.constraints ()[constraintId]);
-          for (std::size_t i = 0; i < jacobian.rows (); ++i)
+          for (std::size_t i = 0; i < size; ++i)
             {
-              for (std::size_t j = 0; j < jacobian.cols (); ++j)
+              for (std::size_t j = 0; j < constraintsJacobian.cols (); ++j)
                 {
-                  jacobianStream << jacobian.coeffRef (i, j);
-                  if (j < jacobian.cols () - 1)
+                  jacobianStream << constraintsJacobian.coeff (offset + i, j);
+                  if (j < constraintsJacobian.cols () - 1)
                     jacobianStream << ", ";
                 }
               jacobianStream << "\n";
@@ -344,11 +630,11 @@ namespace roboptim
       if (!pb.constraints (). empty ())
         {
           // if the constraint violation was not given by the solver
-          if (!state.constraintViolation ())
+          if (!snapshot.hasConstraintViolation)
             {
               // FIXME: handle argument bounds
               ::roboptim::detail::EvaluateConstraintViolation<problem_t>
-                evalCstrViol (constraintsOneIteration, pb.boundsVector ());
+                evalCstrViol (constraintsValue, pb);
               cstrViol = evalCstrViol.uniformNorm ();
             }
           constraintViolations_.push_back (cstrViol);
@@ -362,10 +648,45 @@ namespace roboptim
     }
 
 
+    /// \brief Stacked constraints of the problem.
+    ///
+    /// The view is built at the first logged iteration, and only
+    /// rebuilt if the solver problem is replaced or constrained
+    /// further.
+    const constraintBlock_t& constraintBlock (const problem_t& pb)
+    {
+      if (!constraintBlock_
+	  || &constraintBlock_->problem () != &pb
+	  || constraintBlock_->offsets ().size ()
+	  != pb.constraints ().size () + 1)
+	constraintBlock_.reset (new constraintBlock_t (pb));
+      return *constraintBlock_;
+    }
+
+    /// \brief Evaluate the stacked constraints into the logger buffer.
+    const vector_t& evaluateConstraints (const constraintBlock_t& block,
+					 const vector_t& x)
+    {
+      constraintsValue_.resize (block.outputSize ());
+      block (constraintsValue_, x);
+      return constraintsValue_;
+    }
+
+    /// \brief Evaluate the stacked jacobian into the logger buffer.
+    const jacobian_t& evaluateJacobian (const constraintBlock_t& block,
+					const vector_t& x)
+    {
+      if (constraintsJacobian_.rows () != block.outputSize ()
+	  || constraintsJacobian_.cols () != block.inputSize ())
+	constraintsJacobian_.resize (block.outputSize (), block.inputSize ());
+      block.jacobian (constraintsJacobian_, x);
+      return constraintsJacobian_;
+    }
+
     template <typename U>
     typename boost::enable_if<boost::is_same<U, boost::mpl::vector<> > >::type
     process_constraints (const typename solver_t::problem_t&,
-                         const typename solver_t::solverState_t&,
+                         const Snapshot&,
                          const boost::filesystem::path&,
                          const typename solver_t::vector_t&,
                          value_type&)
@@ -373,13 +694,133 @@ namespace roboptim
       // Unconstrained problem: do nothing
     }
 
+    /// \brief Whether the jacobians are logged as sparse matrices.
+    bool sparseJacobian () const
+    {
+      if (options_.jacobianFormat == LOGGER_JACOBIAN_AUTO)
+	return boost::is_same<typename problem_t::function_t::traits_t,
+			      EigenMatrixSparse>::value;
+      return options_.jacobianFormat == LOGGER_JACOBIAN_SPARSE;
+    }
+
+    /// \brief Log the nonzero coefficients of a constraint jacobian.
+    void process_sparse_jacobian
+    (const boost::filesystem::path& constraintPath,
+     const jacobian_t& jacobian,
+     typename problem_t::size_type offset,
+     typename problem_t::size_type size,
+     std::size_t constraintId)
+    {
+      ::roboptim::detail::jacobianRowsTriplets
+	  (jacobian, offset, size, triplets_);
+
+      if (jacobianPatterns_.size () <= constraintId)
+	jacobianPatterns_.resize (constraintId + 1);
+      JacobianPattern& pattern = jacobianPatterns_[constraintId];
+
+      // Write the pattern only if it changed.
+      bool samePattern =
+	pattern.valid && pattern.triplets.size () == triplets_.size ();
+      for (std::size_t k = 0; samePattern && k < triplets_.size (); ++k)
+	samePattern = pattern.triplets[k].row () == triplets_[k].row ()
+	  && pattern.triplets[k].col () == triplets_[k].col ();
+
+      if (!samePattern)
+	{
+	  boost::filesystem::ofstream patternStream
+	    (constraintPath / "jacobian-pattern.csv");
+	  patternStream << "Row, Column\n";
+	  for (std::size_t k = 0; k < triplets_.size (); ++k)
+	    patternStream
+	      << triplets_[k].row () << ", " << triplets_[k].col () << "\n";
+	  pattern.triplets = triplets_;
+	  pattern.valid = true;
+	}
+
+      boost::filesystem::ofstream valuesStream
+	(constraintPath / "jacobian-values.csv");
+      for (std::size_t k = 0; k < triplets_.size (); ++k)
+	{
+	  if (k > 0)
+	    valuesStream << ", ";
+	  valuesStream << triplets_[k].value ();
+	}
+      valuesStream << "\n";
+    }
+
+    /// \brief Fill the constraints part of a binary log record.
+    template <typename U>
+    typename boost::disable_if<boost::is_same<U, boost::mpl::vector<> > >::type
+    process_binary_constraints (const typename solver_t::problem_t& pb,
+				const Snapshot& snapshot)
+    {
+      const constraintBlock_t& block = constraintBlock (pb);
+      record_.constraints = evaluateConstraints (block, record_.x);
+      if (options_.binaryJacobian)
+	record_.setJacobian (evaluateJacobian (block, record_.x));
+
+      if (!snapshot.hasConstraintViolation && !pb.constraints ().empty ())
+	{
+	  // FIXME: handle argument bounds
+	  ::roboptim::detail::EvaluateConstraintViolation<problem_t>
+	    evalCstrViol (record_.constraints, pb);
+	  record_.constraintViolation = evalCstrViol.uniformNorm ();
+	}
+    }
+
+    template <typename U>
+    typename boost::enable_if<boost::is_same<U, boost::mpl::vector<> > >::type
+    process_binary_constraints (const typename solver_t::problem_t&,
+				const Snapshot&)
+    {
+      // Unconstrained problem: do nothing
+    }
+
+    /// \brief Describe the constraints in the binary log schema.
+    ///
+    /// Called once, after the first record has been evaluated.
+    template <typename U>
+    typename boost::disable_if<boost::is_same<U, boost::mpl::vector<> > >::type
+    process_binary_schema (const typename solver_t::problem_t& pb,
+			   BinaryLogSchema& schema)
+    {
+      const constraintBlock_t& block = constraintBlock (pb);
+      if (options_.binaryJacobian)
+	schema.jacobianCapacity =
+	  options_.jacobianCapacity
+	  ? options_.jacobianCapacity
+	  : static_cast<std::size_t> (constraintsJacobian_.nonZeros ());
+
+      for (std::size_t constraintId = 0;
+	   constraintId < pb.constraints ().size (); ++constraintId)
+	{
+	  schema.constraintsNames.push_back
+	    (boost::apply_visitor
+	     (::roboptim::detail::ConstraintName (),
+	      pb.constraints ()[constraintId]));
+	  schema.constraintsSizes.push_back
+	    (block.offsets ()[constraintId + 1] - block.offsets ()[constraintId]);
+	}
+    }
+
+    template <typename U>
+    typename boost::enable_if<boost::is_same<U, boost::mpl::vector<> > >::type
+    process_binary_schema (const typename solver_t::problem_t&,
+			   BinaryLogSchema&)
+    {
+      // Unconstrained problem: do nothing
+    }
+
   protected:
     void perIterationCallback (const problem_t& pb,
                                const solverState_t& state)
     {
       try
 	{
-          perIterationCallbackUnsafe (pb, state);
+	  if (queue_)
+	    enqueue (state);
+	  else
+	    perIterationCallbackUnsafe (pb, state);
 	}
       catch (std::exception& e)
 	{
@@ -396,44 +837,370 @@ namespace roboptim
       ++callbackCallId_;
     }
 
+    /// \brief Log an iteration synchronously.
+    ///
+    /// This method is not called in asynchronous mode.
     virtual
     void perIterationCallbackUnsafe
     (const typename solver_t::problem_t& pb,
      const typename solver_t::solverState_t& state)
     {
+      takeSnapshot (snapshot_, state);
+      logIteration (pb, snapshot_);
+    }
+
+  public:
+    /// \brief Wait until the queued iterations are written.
+    ///
+    /// In asynchronous mode, the writer thread uses the problem of
+    /// the solver: flush the logger before modifying it.
+    ///
+    /// \throw std::runtime_error if iterations could not be stored
+    /// in the binary log since the previous flush.
+    void flush ()
+    {
+      if (queue_)
+	{
+	  boost::unique_lock<boost::mutex> lock (mutex_);
+	  producerWaiting_ = true;
+	  while (!queue_->empty ())
+	    released_.wait (lock);
+	  producerWaiting_ = false;
+	}
+      flushStreams ();
+      if (binaryLog_)
+	binaryLog_->flush ();
+      checkBinaryLog ();
+    }
+
+    /// \brief Number of iterations dropped because the queue was full.
+    ///
+    /// Only meaningful once the solver is done, or from the
+    /// iteration callback thread.
+    unsigned droppedIterations () const throw ()
+    {
+      return droppedIterations_;
+    }
+
+    const OptimizationLoggerOptions& options () const throw ()
+    {
+      return options_;
+    }
+
+  private:
+    /// \brief Copy the solver state into a snapshot.
+    ///
+    /// Once the snapshot is warm, this does not allocate memory
+    /// (except for the first iteration).
+    void takeSnapshot (Snapshot& snapshot, const solverState_t& state)
+    {
+      if (callbackCallId_ == 0)
+	{
+	  std::ostringstream stream;
+	  stream << solver_;
+	  solverDescription_ = stream.str ();
+	}
+
+      snapshot.iteration = callbackCallId_;
+      snapshot.elapsed =
+	boost::posix_time::microsec_clock::universal_time () - lastTime_;
+      snapshot.x = state.x ();
+      snapshot.hasCost = !!state.cost ();
+      if (snapshot.hasCost)
+	snapshot.cost = *state.cost ();
+      snapshot.hasConstraintViolation = !!state.constraintViolation ();
+      if (snapshot.hasConstraintViolation)
+	snapshot.constraintViolation = *state.constraintViolation ();
+    }
+
+    /// \brief Queue the current iteration (asynchronous mode).
+    void enqueue (const solverState_t& state)
+    {
+      Snapshot* snapshot = queue_->prepare ();
+      if (!snapshot)
+	{
+	  const bool wait =
+	    options_.backpressure == LOGGER_BLOCK
+	    || (options_.backpressure == LOGGER_SAMPLE
+		&& callbackCallId_ % std::max (options_.samplingPeriod, 1u) == 0);
+	  if (!wait)
+	    {
+	      ++droppedIterations_;
+	      return;
+	    }
+
+	  boost::unique_lock<boost::mutex> lock (mutex_);
+	  producerWaiting_ = true;
+	  while (!(snapshot = queue_->prepare ()))
+	    released_.wait (lock);
+	  producerWaiting_ = false;
+	}
+
+      takeSnapshot (*snapshot, state);
+      queue_->commit ();
+
+      // Only lock the mutex if the writer thread sleeps.
+      if (writerWaiting_)
+	{
+	  boost::lock_guard<boost::mutex> lock (mutex_);
+	  queued_.notify_one ();
+	}
+    }
+
+    /// \brief Writer thread main loop (asynchronous mode).
+    void writerLoop ()
+    {
+      for (;;)
+	{
+	  Snapshot* snapshot = queue_->front ();
+	  if (!snapshot)
+	    {
+	      boost::unique_lock<boost::mutex> lock (mutex_);
+	      writerWaiting_ = true;
+	      while (!(snapshot = queue_->front ()) && !stopping_)
+		queued_.wait (lock);
+	      writerWaiting_ = false;
+
+	      // Stopped, and nothing left to write.
+	      if (!snapshot)
+		return;
+	    }
+
+	  try
+	    {
+	      logIteration (solver_.problem (), *snapshot);
+	    }
+	  catch (std::exception& e)
+	    {
+	      std::cerr << e.what () << std::endl;
+	    }
+	  catch (...)
+	    {
+	      std::cerr << "unknown exception" << std::endl;
+	    }
+	  queue_->pop ();
+
+	  if (producerWaiting_)
+	    {
+	      boost::lock_guard<boost::mutex> lock (mutex_);
+	      released_.notify_all ();
+	    }
+	}
+    }
+
+    /// \brief Append one iteration to the binary log.
+    void logBinaryIteration (const typename solver_t::problem_t& pb,
+			     const Snapshot& snapshot)
+    {
+      record_.iteration = snapshot.iteration;
+      record_.x = snapshot.x;
+      if (!snapshot.hasCost)
+	record_.cost = pb.function ()(snapshot.x)[0];
+      else
+	record_.cost = snapshot.cost;
+      record_.constraintViolation =
+	snapshot.hasConstraintViolation ? snapshot.constraintViolation : 0.;
+
+      process_binary_constraints
+	<typename solver_t::problem_t::constraintsList_t> (pb, snapshot);
+
+      // The schema is known once the first iteration is evaluated.
+      if (!binaryLog_)
+	{
+	  BinaryLogSchema schema;
+	  schema.inputSize = pb.function ().inputSize ();
+	  process_binary_schema
+	    <typename solver_t::problem_t::constraintsList_t> (pb, schema);
+	  binaryLog_.reset
+	    (new BinaryLogWriter ((path_ / "log.bin").string (), schema));
+	}
+
+      // Records have a fixed size: the iteration cannot be stored,
+      // the next flush reports it.
+      if (record_.jacobian.size () > binaryLog_->schema ().jacobianCapacity)
+	{
+	  boost::lock_guard<boost::mutex> lock (mutex_);
+	  ++overflowedIterations_;
+	  maxJacobianNonZeros_ =
+	    std::max (maxJacobianNonZeros_, record_.jacobian.size ());
+	  return;
+	}
+      binaryLog_->append (record_);
+      updateSummary (snapshot.iteration, record_.cost,
+		     record_.constraintViolation);
+    }
+
+    /// \brief Fail if iterations could not be stored in the binary
+    /// log since the last check.
+    void checkBinaryLog ()
+    {
+      boost::lock_guard<boost::mutex> lock (mutex_);
+      if (overflowedIterations_ == 0)
+	return;
+
+      const std::string message =
+	(boost::format
+	 ("%1% iteration(s) missing from the binary log: up to %2% jacobian"
+	  " nonzeros, capacity is %3% (see"
+	  " OptimizationLoggerOptions::jacobianCapacity)")
+	 % overflowedIterations_ % maxJacobianNonZeros_
+	 % binaryLog_->schema ().jacobianCapacity).str ();
+      overflowedIterations_ = 0;
+      maxJacobianNonZeros_ = 0;
+      throw std::runtime_error (message);
+    }
+
+    /// \brief Take a logged iteration into account in the summary.
+    void updateSummary (std::size_t iteration, value_type cost,
+			value_type constraintViolation)
+    {
+      if (summary_.iterations == 0 || cost < summary_.bestCost)
+	{
+	  summary_.bestIteration = iteration;
+	  summary_.bestCost = cost;
+	}
+      ++summary_.iterations;
+      summary_.lastIteration = iteration;
+      summary_.lastCost = cost;
+      summary_.lastConstraintViolation = constraintViolation;
+    }
+
+    /// \brief Write a CSV header: prefix 0, prefix 1, etc.
+    static void writeCsvHeader (std::ostream& stream,
+				const std::string& prefix,
+				std::size_t size)
+    {
+      for (std::size_t i = 0; i < size; ++i)
+	{
+	  if (i > 0)
+	    stream << ", ";
+	  stream << prefix << i;
+	}
+      stream << "\n";
+    }
+
+    /// \brief Write a vector as a CSV line.
+    static void writeCsvLine (std::ostream& stream, const vector_t& v)
+    {
+      for (typename vector_t::Index i = 0; i < v.size (); ++i)
+	{
+	  if (i > 0)
+	    stream << ", ";
+	  stream << v[i];
+	}
+      stream << "\n";
+    }
+
+    /// \brief Append the last iteration to the whole run CSV files
+    /// (streaming mode).
+    void appendEvolution ()
+    {
+      // Open the files once the sizes are known.
+      if (!xStream_.is_open ())
+	{
+	  costStream_.open (path_ / "cost-evolution.csv");
+	  costStream_ << "Cost\n";
+	  xStream_.open (path_ / "x-evolution.csv");
+	  writeCsvHeader (xStream_, "X ", x_.back ().size ());
+	  if (!constraintViolations_.empty ())
+	    {
+	      violationStream_.open
+		(path_ / "constraint-violation-evolution.csv");
+	      violationStream_ << "Constraint violation\n";
+	    }
+	  if (!constraints_.empty ())
+	    for (std::size_t constraintId = 0;
+		 constraintId < constraints_.back ().size (); ++constraintId)
+	      {
+		boost::shared_ptr<boost::filesystem::ofstream> stream
+		  (new boost::filesystem::ofstream
+		   (path_ / (boost::format ("constraint-%d-evolution.csv")
+			     % constraintId).str ()));
+		writeCsvHeader (*stream, "output ",
+				constraints_.back ()[constraintId].size ());
+		constraintStreams_.push_back (stream);
+	      }
+	}
+
+      costStream_ << costs_.back () << "\n";
+      writeCsvLine (xStream_, x_.back ());
+      if (violationStream_.is_open ())
+	violationStream_ << constraintViolations_.back () << "\n";
+      for (std::size_t constraintId = 0;
+	   constraintId < constraintStreams_.size (); ++constraintId)
+	writeCsvLine (*constraintStreams_[constraintId],
+		      constraints_.back ()[constraintId]);
+
+      if (++streamedIterations_ % std::max (options_.flushPeriod, 1u) == 0)
+	flushStreams ();
+
+      // Only keep a bounded window in memory.
+      const std::size_t window =
+	std::max<std::size_t> (options_.historySize, 1);
+      while (x_.size () > window)
+	x_.pop_front ();
+      while (costs_.size () > window)
+	costs_.pop_front ();
+      while (constraintViolations_.size () > window)
+	constraintViolations_.pop_front ();
+      while (constraints_.size () > window)
+	constraints_.pop_front ();
+    }
+
+    /// \brief Flush the journal and the streamed files.
+    void flushStreams ()
+    {
+      output_.flush ();
+      costStream_.flush ();
+      xStream_.flush ();
+      violationStream_.flush ();
+      for (std::size_t i = 0; i < constraintStreams_.size (); ++i)
+	constraintStreams_[i]->flush ();
+    }
+
+    /// \brief Format and write one iteration.
+    void logIteration (const typename solver_t::problem_t& pb,
+		       const Snapshot& snapshot)
+    {
+      if (options_.format == LOGGER_BINARY)
+	{
+	  if (snapshot.iteration == 0)
+	    output_ << solverDescription_ << iendl;
+	  logBinaryIteration (pb, snapshot);
+	  return;
+	}
+
       // Create the iteration-specific directory.
       boost::filesystem::path iterationPath =
-	path_ / (boost::format ("iteration-%d") % callbackCallId_).str ();
+	path_ / (boost::format ("iteration-%d") % snapshot.iteration).str ();
       boost::filesystem::remove_all (iterationPath);
       boost::filesystem::create_directories (iterationPath);
 
       // Compute intermediary values.
       // - Store X
-      const typename solver_t::vector_t& x = state.x ();
+      const typename solver_t::vector_t& x = snapshot.x;
       x_.push_back (x);
-      // - Get current time
-      boost::posix_time::ptime t =
-	boost::posix_time::microsec_clock::universal_time ();
       // - Current cost
       value_type cost;
-      if (!state.cost ())
+      if (!snapshot.hasCost)
         cost = pb.function ()(x)[0];
-      else cost = *state.cost ();
+      else cost = snapshot.cost;
       costs_.push_back (cost);
       // - Current constraint violation
       value_type cstrViol;
-      if (!state.constraintViolation ())
+      if (!snapshot.hasConstraintViolation)
         cstrViol = 0;
-      else cstrViol = *state.constraintViolation ();
+      else cstrViol = snapshot.constraintViolation;
 
       // Update journal
-      if (callbackCallId_ == 0)
-	output_ << solver_ << iendl;
+      if (snapshot.iteration == 0)
+	output_ << solverDescription_ << iendl;
 
       output_
 	<< std::string (80, '+') << iendl
-	<< boost::format ("Callback call number: %d") % callbackCallId_ << iendl
-	<< "Elapsed time since last call: " << (t - lastTime_) << iendl
+	<< boost::format ("Callback call number: %d") % snapshot.iteration
+	<< iendl
+	<< "Elapsed time since last call: " << snapshot.elapsed << iendl
 	<< "- x:" << incindent << iendl
 	<< x << decindent << iendl
 	<< "- f(x):" << incindent << iendl
@@ -456,7 +1223,10 @@ namespace roboptim
 
       // constraints: only process if the problem is constrained
       process_constraints<typename solver_t::problem_t::constraintsList_t>
-        (pb, state, iterationPath, x, cstrViol);
+        (pb, snapshot, iterationPath, x, cstrViol);
+      updateSummary (snapshot.iteration, cost, cstrViol);
+      if (options_.streaming)
+	appendEvolution ();
 
       output_ << std::string (80, '-') << iendl;
     }
@@ -464,14 +1234,14 @@ namespace roboptim
   protected:
     const solver_t& solver () const throw ()
     {
-      solver_;
+      return solver_;
     }
     solver_t& solver () throw ()
     {
-      solver_;
+      return solver_;
     }
 
-    boost::filesystem::path& path () const throw ()
+    const boost::filesystem::path& path () const throw ()
     {
       return path_;
     }
@@ -484,18 +1254,101 @@ namespace roboptim
       return callbackCallId_;
     }
 
+    /// \brief Logged iterates (only the last historySize ones in
+    /// streaming mode).
+    const std::deque<vector_t>& xHistory () const throw ()
+    {
+      return x_;
+    }
+    /// \brief Logged costs (only the last historySize ones in
+    /// streaming mode).
+    const std::deque<value_type>& costHistory () const throw ()
+    {
+      return costs_;
+    }
+
   private:
     solver_t& solver_;
     boost::filesystem::path path_;
+    OptimizationLoggerOptions options_;
     boost::filesystem::ofstream output_;
     unsigned callbackCallId_;
     boost::posix_time::ptime lastTime_;
     boost::posix_time::ptime firstTime_;
 
-    std::vector<vector_t> x_;
-    std::vector<value_type> costs_;
-    std::vector<value_type> constraintViolations_;
-    std::vector<std::vector<vector_t> > constraints_;
+    /// \brief Solver, as displayed at the first iteration.
+    std::string solverDescription_;
+    /// \brief Snapshot of the current iteration (synchronous mode).
+    Snapshot snapshot_;
+
+    /// \brief Iterations waiting for the writer thread.
+    boost::scoped_ptr<detail::SpscRing<Snapshot> > queue_;
+    boost::shared_ptr<boost::thread> writer_;
+    /// \brief Only used to sleep and wake up, the queue is lock-free.
+    boost::mutex mutex_;
+    /// \brief Signaled when an iteration is queued.
+    boost::condition_variable queued_;
+    /// \brief Signaled when an iteration is written.
+    boost::condition_variable released_;
+    boost::atomic<bool> writerWaiting_;
+    boost::atomic<bool> producerWaiting_;
+    bool stopping_;
+    unsigned droppedIterations_;
+
+    /// \brief Jacobian coefficient.
+    typedef Eigen::Triplet<value_type> triplet_t;
+
+    /// \brief Last logged sparsity pattern of a constraint jacobian.
+    struct JacobianPattern
+    {
+      JacobianPattern ()
+	: valid (false),
+	  triplets ()
+      {}
+
+      bool valid;
+      std::vector<triplet_t> triplets;
+    };
+
+    /// \brief Last logged sparsity pattern of each constraint.
+    std::vector<JacobianPattern> jacobianPatterns_;
+    /// \brief Nonzero coefficients of the current jacobian.
+    std::vector<triplet_t> triplets_;
+
+    /// \brief Stacked constraints, built at the first logged iteration.
+    boost::scoped_ptr<constraintBlock_t> constraintBlock_;
+    /// \brief Stacked constraints values of the current iteration.
+    vector_t constraintsValue_;
+    /// \brief Stacked constraints jacobian of the current iteration.
+    jacobian_t constraintsJacobian_;
+
+    /// \brief Binary log, created at the first iteration.
+    boost::scoped_ptr<BinaryLogWriter> binaryLog_;
+    /// \brief Current binary log record.
+    BinaryLogRecord record_;
+    /// \brief Iterations whose jacobian exceeded the binary log
+    /// capacity since the last flush (protected by mutex_).
+    std::size_t overflowedIterations_;
+    /// \brief Largest number of nonzeros of these jacobians.
+    std::size_t maxJacobianNonZeros_;
+
+    /// \brief History of the logged iterations (only the last ones
+    /// in streaming mode).
+    std::deque<vector_t> x_;
+    std::deque<value_type> costs_;
+    std::deque<value_type> constraintViolations_;
+    std::deque<std::vector<vector_t> > constraints_;
+
+    OptimizationLoggerSummary summary_;
+
+    /// \brief Whole run CSV files (streaming mode).
+    boost::filesystem::ofstream costStream_;
+    boost::filesystem::ofstream violationStream_;
+    boost::filesystem::ofstream xStream_;
+    std::vector<boost::shared_ptr<boost::filesystem::ofstream> >
+    constraintStreams_;
+    /// \brief Number of iterations appended to the CSV files.
+    std::size_t streamedIterations_;
   };
 } // end of namespace roboptim
 
@@ -0,0 +1,130 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PARAMETER_HANDLE_HH
+# define ROBOPTIM_CORE_PARAMETER_HANDLE_HH
+# include <map>
+# include <stdexcept>
+# include <string>
+
+# include <boost/variant/get.hpp>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Typed handle on a solver (or solver state) parameter.
+  ///
+  /// Parameters are stored in string-keyed maps of variants: looking
+  /// a parameter up costs string comparisons, a tree walk and a
+  /// variant visit. A handle resolves the parameter once, then
+  /// accesses its value directly (i.e. in iteration callbacks).
+  ///
+  /// The handle stays valid as long as the parameter is not removed
+  /// from its map and its value keeps the same type.
+  ///
+  /// \tparam T parameter value type
+  /// \tparam P parameter type (Parameter or StateParameter)
+  template <typename T, typename P>
+  class ParameterHandle
+  {
+  public:
+    /// \brief Parameter type.
+    typedef P parameter_t;
+    /// \brief Parameters map type.
+    typedef std::map<std::string, parameter_t> parameters_t;
+    /// \brief Value type.
+    typedef T value_t;
+
+    /// \brief Create an unbound handle.
+    ParameterHandle () throw ()
+      : parameter_ (0),
+	value_ (0)
+    {}
+
+    /// \brief Resolve a parameter.
+    ///
+    /// \param parameters parameters map
+    /// \param key parameter name
+    /// \throw std::out_of_range if the parameter does not exist
+    /// \throw boost::bad_get if the parameter is not of type T
+    ParameterHandle (parameters_t& parameters, const std::string& key)
+      : parameter_ (0),
+	value_ (0)
+    {
+      typename parameters_t::iterator it = parameters.find (key);
+      if (it == parameters.end ())
+	throw std::out_of_range ("key " + key + " not found");
+      value_ = &boost::get<value_t> (it->second.value);
+      parameter_ = &it->second;
+    }
+
+    /// \brief Whether the handle is bound to a parameter.
+    bool valid () const throw ()
+    {
+      return value_ != 0;
+    }
+
+    /// \brief Parameter value.
+    value_t& operator* () const throw ()
+    {
+      return *value_;
+    }
+
+    /// \brief Parameter value.
+    value_t* operator-> () const throw ()
+    {
+      return value_;
+    }
+
+    /// \brief Parameter (i.e. to access its description).
+    parameter_t& parameter () const throw ()
+    {
+      return *parameter_;
+    }
+
+  private:
+    /// \brief Resolved parameter.
+    parameter_t* parameter_;
+    /// \brief Resolved value (in the parameter variant).
+    value_t* value_;
+  };
+
+  namespace detail
+  {
+    /// \internal
+    /// \brief Add (or replace) a parameter and resolve it.
+    template <typename T, typename P>
+    ParameterHandle<T, P>
+    registerParameter (std::map<std::string, P>& parameters,
+		       const std::string& key,
+		       const std::string& description,
+		       const T& value)
+    {
+      P& parameter = parameters[key];
+      parameter.description = description;
+      parameter.value = value;
+      return ParameterHandle<T, P> (parameters, key);
+    }
+  } // end of namespace detail.
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PARAMETER_HANDLE_HH
@@ -0,0 +1,156 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_REGISTRY_HH
+# define ROBOPTIM_CORE_PLUGIN_REGISTRY_HH
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+
+# include <cstddef>
+# include <map>
+# include <set>
+# include <stdexcept>
+# include <string>
+
+# include <ltdl.h>
+
+# include <boost/noncopyable.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Process-wide cache of the loaded solver plug-ins.
+  ///
+  /// Loading a plug-in (opening the shared object, resolving its
+  /// symbols and checking that it has been built for the expected
+  /// problem type) is done once per process instead of once per
+  /// solver: the registry keeps the plug-in handle and its resolved
+  /// symbols, and remembers which problem types have already been
+  /// validated.
+  ///
+  /// Plug-ins are reference-counted: each acquire must be balanced
+  /// by a release, and the plug-in is unloaded when its last
+  /// reference is released, unless it has been preloaded.
+  ///
+  /// All the methods are thread-safe.
+  class ROBOPTIM_DLLAPI PluginRegistry : public boost::noncopyable
+  {
+  public:
+    /// \brief Loaded plug-in.
+    ///
+    /// Plug-in data remain valid until the reference acquired on the
+    /// plug-in is released.
+    struct Plugin
+    {
+      Plugin ();
+
+      /// \brief Plug-in name (i.e. ``dummy'').
+      std::string name;
+      /// \brief libltdl handle.
+      lt_dlhandle handle;
+      /// \brief ``create'' symbol.
+      void* create;
+      /// \brief ``destroy'' symbol.
+      void* destroy;
+      /// \brief ``getSizeOfProblem'' symbol.
+      void* getSizeOfProblem;
+      /// \brief ``getTypeIdOfConstraintsList'' symbol.
+      void* getTypeIdOfConstraintsList;
+      /// \brief Number of references.
+      std::size_t references;
+      /// \brief Whether the plug-in stays loaded without references.
+      bool preloaded;
+      /// \brief Problem types this plug-in has been validated for.
+      std::set<std::string> validated;
+    };
+
+    /// \brief Registry of the process.
+    static PluginRegistry& instance ();
+
+    /// \brief Load a plug-in (if needed) and add a reference to it.
+    ///
+    /// \param name plug-in name (i.e. ``dummy'' for the shared object
+    /// roboptim-core-plugin-dummy)
+    /// \return plug-in, valid until the reference is released
+    const Plugin& acquire (const std::string& name)
+      throw (std::runtime_error);
+
+    /// \brief Release a reference acquired through acquire.
+    ///
+    /// The plug-in is unloaded if it was its last reference and it
+    /// has not been preloaded.
+    void release (const Plugin& plugin) throw ();
+
+    /// \brief Check that a plug-in handles a problem type.
+    ///
+    /// The result is cached: the plug-in functions are only called
+    /// the first time a given problem type is checked.
+    ///
+    /// \param plugin acquired plug-in
+    /// \param sizeOfProblem size of the problem type
+    /// \param typeIdOfConstraintsList type id of the problem
+    /// constraints list
+    void validate (const Plugin& plugin,
+		   std::size_t sizeOfProblem,
+		   const char* typeIdOfConstraintsList)
+      throw (std::runtime_error);
+
+    /// \brief Load a plug-in and keep it loaded.
+    ///
+    /// This moves the loading cost out of the first solver
+    /// instantiation (i.e. at startup).
+    void preload (const std::string& name) throw (std::runtime_error);
+
+    /// \brief Unload a preloaded plug-in once it has no reference.
+    void unload (const std::string& name) throw ();
+
+    /// \brief Whether a plug-in is currently loaded.
+    bool isLoaded (const std::string& name) const throw ();
+
+    /// \brief Number of references on a plug-in.
+    std::size_t references (const std::string& name) const throw ();
+
+  private:
+    PluginRegistry ();
+    ~PluginRegistry () throw ();
+
+    /// \brief Plug-ins, by name.
+    typedef std::map<std::string, Plugin> plugins_t;
+
+    /// \brief Load a plug-in. The mutex must be locked.
+    Plugin& load (const std::string& name) throw (std::runtime_error);
+
+    /// \brief Unload a plug-in. The mutex must be locked.
+    void close (plugins_t::iterator it) throw ();
+
+    /// \brief Loaded plug-ins.
+    plugins_t plugins_;
+
+    /// \brief Protect plug-ins and libltdl calls.
+    mutable boost::mutex mutex_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PLUGIN_REGISTRY_HH
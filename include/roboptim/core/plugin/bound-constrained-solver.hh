@@ -0,0 +1,168 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HH
+# define ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HH
+# include <stdexcept>
+
+# include <boost/mpl/vector.hpp>
+
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/linear-function.hh>
+# include <roboptim/core/parameter-handle.hh>
+# include <roboptim/core/solver.hh>
+# include <roboptim/core/solver-state.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Common part of the built-in bound-constrained solvers.
+  ///
+  /// The built-in solvers do not depend on any external library.
+  /// They solve problems whose only constraints are the argument
+  /// bounds: a problem with constraints is rejected with a
+  /// SolverError.
+  ///
+  /// This class checks the problem, projects the starting point on
+  /// the bounds, runs the iteration callback (a stop request of the
+  /// callback interrupts the solver) and builds the result. The
+  /// algorithm itself is implemented by minimize.
+  ///
+  /// The following parameters are available:
+  /// - max-iterations (int): maximum number of iterations,
+  /// - tolerance (double): the solver converges when the infinity
+  ///   norm of the projected gradient step is below this value.
+  /// .
+  ///
+  /// \tparam F cost function type
+  template <typename F>
+  class BoundConstrainedSolver
+    : public Solver<F, boost::mpl::vector<LinearFunction,
+					  DifferentiableFunction> >
+  {
+  public:
+    /// \brief Parent type.
+    typedef Solver<F, boost::mpl::vector<LinearFunction,
+					 DifferentiableFunction> > parent_t;
+
+    /// \brief Import problem type.
+    typedef typename parent_t::problem_t problem_t;
+    /// \brief Import callback type.
+    typedef typename parent_t::callback_t callback_t;
+    /// \brief Import solver state type.
+    typedef typename parent_t::solverState_t solverState_t;
+    /// \brief Import vector type.
+    typedef typename parent_t::vector_t vector_t;
+    /// \brief Import value type.
+    typedef typename F::value_type value_type;
+    /// \brief Import size type.
+    typedef typename F::size_type size_type;
+
+    /// \brief Build a solver from a problem.
+    ///
+    /// \param problem problem that will be solved
+    /// \param maxIterations default maximum number of iterations
+    /// \param tolerance default convergence tolerance
+    BoundConstrainedSolver (const problem_t& problem,
+			    int maxIterations,
+			    value_type tolerance) throw ();
+
+    virtual ~BoundConstrainedSolver () throw ();
+
+    /// \brief Solve the problem.
+    virtual void solve () throw ();
+
+    /// \brief Set the per-iteration callback.
+    ///
+    /// The callback may request the solver to stop (see
+    /// SolverState::requestStop): the result is then a
+    /// ResultWithWarnings holding the last iterate.
+    virtual void setIterationCallback (callback_t callback)
+      throw (std::runtime_error);
+
+  protected:
+    /// \brief Reason why the algorithm stopped.
+    enum Termination
+      {
+	/// \brief The tolerance has been reached.
+	CONVERGED,
+	/// \brief The maximum number of iterations has been reached.
+	MAX_ITERATIONS,
+	/// \brief The iteration callback requested a stop.
+	STOPPED,
+	/// \brief No decrease of the cost could be found.
+	STALLED
+      };
+
+    /// \brief Run the algorithm.
+    ///
+    /// \param x starting point (inside the bounds), replaced by the
+    /// last iterate
+    /// \return why the algorithm stopped
+    ///
+    /// \throw std::exception errors of the functions or of the
+    /// iteration callback, solve reports them as a SolverError
+    virtual Termination minimize (vector_t& x) = 0;
+
+    /// \brief Resolve the parameters handles.
+    ///
+    /// Called before each solve. Solvers adding parameters resolve
+    /// them here, after calling the parent method.
+    ///
+    /// \throw std::exception if a parameter is missing or has an
+    /// invalid type
+    virtual void resolveParameters ();
+
+    /// \brief Project an argument on the bounds.
+    void project (vector_t& x) const throw ();
+
+    /// \brief Infinity norm of the projected gradient step.
+    ///
+    /// This is the norm of P (x - g) - x, where P is the projection
+    /// on the bounds. It is zero at a stationary point.
+    value_type stationarity (const vector_t& x, const vector_t& gradient)
+      const throw ();
+
+    /// \brief Whether a variable is free to move along -gradient.
+    bool isFree (const vector_t& x, const vector_t& gradient, size_type i)
+      const throw ();
+
+    /// \brief Notify the end of an iteration.
+    ///
+    /// \return true if the callback requested a stop
+    bool iterate (const vector_t& x, value_type cost);
+
+    /// \brief Maximum number of iterations.
+    ParameterHandle<int, Parameter> maxIterations_;
+    /// \brief Convergence tolerance.
+    ParameterHandle<value_type, Parameter> tolerance_;
+
+  private:
+    /// \brief Per-iteration callback.
+    callback_t callback_;
+    /// \brief State given to the callback.
+    solverState_t state_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/plugin/bound-constrained-solver.hxx>
+#endif //! ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HH
@@ -0,0 +1,204 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HXX
+# define ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HXX
+# include <algorithm>
+# include <cmath>
+# include <exception>
+
+# include <boost/format.hpp>
+
+# include <roboptim/core/result-with-warnings.hh>
+# include <roboptim/core/solver-error.hh>
+# include <roboptim/core/solver-warning.hh>
+
+namespace roboptim
+{
+  template <typename F>
+  BoundConstrainedSolver<F>::BoundConstrainedSolver (const problem_t& pb,
+						     int maxIterations,
+						     value_type tolerance)
+    throw ()
+    : parent_t (pb),
+      maxIterations_ (),
+      tolerance_ (),
+      callback_ (),
+      state_ (this->problem_)
+  {
+    maxIterations_ = this->registerParameter
+      ("max-iterations", "maximum number of iterations", maxIterations);
+    tolerance_ = this->registerParameter
+      ("tolerance", "tolerance on the projected gradient step", tolerance);
+  }
+
+  template <typename F>
+  BoundConstrainedSolver<F>::~BoundConstrainedSolver () throw ()
+  {
+  }
+
+  template <typename F>
+  void
+  BoundConstrainedSolver<F>::setIterationCallback (callback_t callback)
+    throw (std::runtime_error)
+  {
+    callback_ = callback;
+  }
+
+  template <typename F>
+  void
+  BoundConstrainedSolver<F>::resolveParameters ()
+  {
+    maxIterations_ = this->template parameterHandle<int> ("max-iterations");
+    tolerance_ = this->template parameterHandle<value_type> ("tolerance");
+  }
+
+  template <typename F>
+  void
+  BoundConstrainedSolver<F>::solve () throw ()
+  {
+    const problem_t& pb = this->problem ();
+
+    if (!pb.constraints ().empty ())
+      {
+	this->result_ = SolverError
+	  ("this solver only supports bound constraints");
+	return;
+      }
+
+    // The parameters may have been replaced since the last solve.
+    try
+      {
+	resolveParameters ();
+      }
+    catch (const std::exception& e)
+      {
+	this->result_ = SolverError
+	  ((boost::format ("invalid solver parameter: %1%")
+	    % e.what ()).str ());
+	return;
+      }
+
+    const size_type n = pb.function ().inputSize ();
+    vector_t x (n);
+    if (pb.startingPoint ())
+      x = *pb.startingPoint ();
+    else
+      x.setZero ();
+    project (x);
+
+    state_.clearStopRequest ();
+
+    // The iteration callback is user code: report its errors
+    // instead of letting them escape.
+    Termination termination;
+    ResultWithWarnings result (n, 1);
+    try
+      {
+	termination = minimize (x);
+	result.x = x;
+	pb.function () (result.value, x);
+      }
+    catch (const std::exception& e)
+      {
+	this->result_ = SolverError
+	  ((boost::format ("solver failed: %1%") % e.what ()).str ());
+	return;
+      }
+    catch (...)
+      {
+	this->result_ = SolverError ("solver failed: unknown exception");
+	return;
+      }
+
+    switch (termination)
+      {
+      case CONVERGED:
+	this->result_ = static_cast<const Result&> (result);
+	return;
+      case MAX_ITERATIONS:
+	result.warnings.push_back
+	  (SolverWarning ("maximum number of iterations reached"));
+	break;
+      case STOPPED:
+	result.warnings.push_back
+	  (SolverWarning ("stopped by the iteration callback"));
+	break;
+      case STALLED:
+	result.warnings.push_back
+	  (SolverWarning ("no decrease of the cost function could be found"));
+	break;
+      }
+    this->result_ = result;
+  }
+
+  template <typename F>
+  void
+  BoundConstrainedSolver<F>::project (vector_t& x) const throw ()
+  {
+    const typename problem_t::intervals_t& bounds =
+      this->problem ().argumentBounds ();
+    for (size_type i = 0; i < x.size (); ++i)
+      x[i] = std::min (std::max (x[i], bounds[i].first), bounds[i].second);
+  }
+
+  template <typename F>
+  typename BoundConstrainedSolver<F>::value_type
+  BoundConstrainedSolver<F>::stationarity (const vector_t& x,
+					   const vector_t& gradient)
+    const throw ()
+  {
+    const typename problem_t::intervals_t& bounds =
+      this->problem ().argumentBounds ();
+    value_type norm = 0.;
+    for (size_type i = 0; i < x.size (); ++i)
+      {
+	value_type xi = std::min (std::max (x[i] - gradient[i],
+					    bounds[i].first),
+				  bounds[i].second);
+	norm = std::max (norm, std::abs (xi - x[i]));
+      }
+    return norm;
+  }
+
+  template <typename F>
+  bool
+  BoundConstrainedSolver<F>::isFree (const vector_t& x,
+				     const vector_t& gradient,
+				     size_type i)
+    const throw ()
+  {
+    const typename problem_t::intervals_t& bounds =
+      this->problem ().argumentBounds ();
+    return !((x[i] <= bounds[i].first && gradient[i] > 0.)
+	     || (x[i] >= bounds[i].second && gradient[i] < 0.));
+  }
+
+  template <typename F>
+  bool
+  BoundConstrainedSolver<F>::iterate (const vector_t& x, value_type cost)
+  {
+    if (!callback_)
+      return false;
+    state_.x () = x;
+    state_.cost () = cost;
+    callback_ (this->problem (), state_);
+    return state_.stopRequested ();
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PLUGIN_BOUND_CONSTRAINED_SOLVER_HXX
@@ -0,0 +1,83 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_GAUSS_NEWTON_HH
+# define ROBOPTIM_CORE_PLUGIN_GAUSS_NEWTON_HH
+# include <roboptim/core/sum-of-c1-squares.hh>
+# include <roboptim/core/plugin/bound-constrained-solver.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Gauss-Newton solver for sums of squares.
+  ///
+  /// The cost function is a SumOfC1Squares: the jacobian of its
+  /// base function (the residuals) gives a Gauss-Newton model of the
+  /// cost. The steps are damped as in the Levenberg-Marquardt
+  /// algorithm (Nielsen's damping update). The variables at a bound
+  /// whose gradient points outside the bounds are fixed for the
+  /// iteration, and the step is projected on the bounds.
+  ///
+  /// In addition to the BoundConstrainedSolver parameters, the
+  /// gauss-newton.damping (double) parameter sets the initial
+  /// damping, relative to the largest diagonal element of
+  /// J<sup>T</sup>J. A zero damping starts with pure Gauss-Newton
+  /// steps. The solver also converges when the step is smaller than
+  /// tolerance * (|x| + tolerance).
+  ///
+  /// A warm-started solve starts from the damping reached by the
+  /// previous solve.
+  ///
+  /// \warning the plug-in loader only checks the constraints types:
+  /// the problem cost function must be a SumOfC1Squares.
+  class GaussNewtonSolver
+    : public BoundConstrainedSolver<SumOfC1Squares>
+  {
+  public:
+    /// \brief Bound-constrained solver type.
+    typedef BoundConstrainedSolver<SumOfC1Squares> boundConstrainedSolver_t;
+    /// \brief Define parent's type (exposed through the plug-in).
+    typedef boundConstrainedSolver_t::parent_t parent_t;
+
+    /// \brief Build a solver from a problem.
+    /// \param problem problem that will be solved
+    explicit GaussNewtonSolver (const problem_t& problem) throw ();
+
+    virtual ~GaussNewtonSolver () throw ();
+
+  protected:
+    virtual Termination minimize (vector_t& x);
+    virtual void resolveParameters ();
+
+  private:
+    /// \brief Initial damping.
+    ParameterHandle<value_type, Parameter> damping_;
+
+    /// \brief Damping reached by the last solve (negative before the
+    /// first solve).
+    ///
+    /// A warm-started solve starts from this damping.
+    value_type lastDamping_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PLUGIN_GAUSS_NEWTON_HH
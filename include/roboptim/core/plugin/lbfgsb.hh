@@ -0,0 +1,91 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_LBFGSB_HH
+# define ROBOPTIM_CORE_PLUGIN_LBFGSB_HH
+# include <deque>
+
+# include <roboptim/core/plugin/bound-constrained-solver.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Limited-memory BFGS solver for bound-constrained problems.
+  ///
+  /// The variables at a bound whose gradient points outside the
+  /// bounds are fixed for the iteration. The search direction of
+  /// the free variables is computed by the L-BFGS two-loop recursion
+  /// restricted to these variables, and the step is reduced by
+  /// backtracking along its projection on the bounds until the
+  /// Armijo condition holds.
+  ///
+  /// A warm-started solve keeps the curvature pairs of the previous
+  /// solve: solving a sequence of close problems (i.e. in an
+  /// augmented Lagrangian) reuses the Hessian approximation.
+  ///
+  /// In addition to the BoundConstrainedSolver parameters, the
+  /// lbfgsb.memory (int) parameter sets the number of curvature
+  /// pairs kept.
+  class LbfgsbSolver
+    : public BoundConstrainedSolver<DifferentiableFunction>
+  {
+  public:
+    /// \brief Bound-constrained solver type.
+    typedef BoundConstrainedSolver<DifferentiableFunction>
+    boundConstrainedSolver_t;
+    /// \brief Define parent's type (exposed through the plug-in).
+    typedef boundConstrainedSolver_t::parent_t parent_t;
+
+    /// \brief Build a solver from a problem.
+    /// \param problem problem that will be solved
+    explicit LbfgsbSolver (const problem_t& problem) throw ();
+
+    virtual ~LbfgsbSolver () throw ();
+
+  protected:
+    virtual Termination minimize (vector_t& x);
+    virtual void resolveParameters ();
+
+  private:
+    /// \brief Compute the search direction.
+    ///
+    /// \param direction search direction (zero on the fixed variables)
+    /// \param x current argument
+    /// \param gradient current gradient
+    void searchDirection (vector_t& direction,
+			  const vector_t& x,
+			  const vector_t& gradient) const throw ();
+
+    /// \brief Forget the curvature pairs.
+    void clearMemory () throw ();
+
+    /// \brief Number of curvature pairs kept.
+    ParameterHandle<int, Parameter> memory_;
+
+    /// \brief Argument differences.
+    std::deque<vector_t> s_;
+    /// \brief Gradient differences.
+    std::deque<vector_t> y_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PLUGIN_LBFGSB_HH
@@ -0,0 +1,61 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PLUGIN_PROJECTED_GRADIENT_HH
+# define ROBOPTIM_CORE_PLUGIN_PROJECTED_GRADIENT_HH
+# include <roboptim/core/plugin/bound-constrained-solver.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_solver
+  /// @{
+
+  /// \brief Projected gradient descent solver.
+  ///
+  /// At each iteration, the argument moves along the projection on
+  /// the bounds of the steepest descent direction. The step length
+  /// is a Barzilai-Borwein step, reduced by backtracking until the
+  /// Armijo condition holds.
+  ///
+  /// This solver does not depend on any external library: it is
+  /// meant as a reference solver (i.e. to benchmark the library) and
+  /// as a fallback.
+  class ProjectedGradientSolver
+    : public BoundConstrainedSolver<DifferentiableFunction>
+  {
+  public:
+    /// \brief Bound-constrained solver type.
+    typedef BoundConstrainedSolver<DifferentiableFunction>
+    boundConstrainedSolver_t;
+    /// \brief Define parent's type (exposed through the plug-in).
+    typedef boundConstrainedSolver_t::parent_t parent_t;
+
+    /// \brief Build a solver from a problem.
+    /// \param problem problem that will be solved
+    explicit ProjectedGradientSolver (const problem_t& problem) throw ();
+
+    virtual ~ProjectedGradientSolver () throw ();
+
+  protected:
+    virtual Termination minimize (vector_t& x);
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PLUGIN_PROJECTED_GRADIENT_HH
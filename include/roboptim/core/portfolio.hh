@@ -0,0 +1,237 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PORTFOLIO_HH
+# define ROBOPTIM_CORE_PORTFOLIO_HH
+# include <cstddef>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+# include <boost/function.hpp>
+# include <boost/noncopyable.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/thread.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/generic-solver.hh>
+# include <roboptim/core/plugin-registry.hh>
+# include <roboptim/core/solver-factory.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Race several solvers on the same problem.
+  ///
+  /// No solver is the fastest on every problem: the portfolio runs
+  /// several solver plug-ins (or several parameterizations of the
+  /// same plug-in) concurrently, each one on its own thread and on
+  /// its own copy of the problem, and returns the first acceptable
+  /// result.
+  ///
+  /// The other solvers are then asked to stop through their
+  /// iteration callback (see SolverState::requestStop). As this
+  /// cancellation is cooperative, solve returns without waiting for
+  /// them: they finish in the background and are joined by wait,
+  /// the next solve or the destructor.
+  ///
+  /// Each entry keeps timing statistics over the successive solves,
+  /// which can be used to order or prune the portfolio (see
+  /// ranking).
+  ///
+  /// The problem functions must support concurrent evaluations.
+  ///
+  /// \tparam S solver type
+  template <typename S>
+  class Portfolio : public boost::noncopyable
+  {
+  public:
+    /// \brief Solver type.
+    typedef S solver_t;
+    /// \brief Problem type.
+    typedef typename solver_t::problem_t problem_t;
+    /// \brief Solver result type.
+    typedef GenericSolver::result_t result_t;
+    /// \brief Solver parameters type.
+    typedef typename solver_t::parameters_t parameters_t;
+    /// \brief Solver state type.
+    typedef typename solver_t::solverState_t solverState_t;
+    /// \brief Acceptance test of a result.
+    typedef boost::function<bool (const Result&)> acceptance_t;
+
+    /// \brief Timing statistics of an entry.
+    struct Statistics
+    {
+      Statistics ();
+
+      /// \brief Mean solve time (in seconds).
+      double meanTime () const throw ();
+
+      /// \brief Number of solves started.
+      std::size_t runs;
+      /// \brief Number of races won.
+      std::size_t wins;
+      /// \brief Number of acceptable results (won or not).
+      std::size_t solutions;
+      /// \brief Number of solves without acceptable result.
+      std::size_t failures;
+      /// \brief Number of solves skipped or stopped.
+      std::size_t cancellations;
+      /// \brief Total solve time (in seconds).
+      double totalTime;
+      /// \brief Shortest solve time (in seconds).
+      double minTime;
+      /// \brief Longest solve time (in seconds).
+      double maxTime;
+    };
+
+    /// \brief Create an empty portfolio.
+    ///
+    /// \param problem problem to solve (copied)
+    explicit Portfolio (const problem_t& problem) throw ();
+
+    /// \brief Cancel and wait for the running solvers.
+    ~Portfolio () throw ();
+
+    /// \brief Problem to solve.
+    const problem_t& problem () const throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Add a solver to the portfolio.
+    ///
+    /// The plug-in is loaded at once and stays loaded as long as the
+    /// portfolio exists.
+    ///
+    /// \param solver solver plug-in name (for instance ``cfsqp'')
+    /// \param parameters parameters overriding the solver defaults
+    /// \param name entry name (the plug-in name by default)
+    /// \return entry index
+    std::size_t add (const std::string& solver,
+		     const parameters_t& parameters = parameters_t (),
+		     const std::string& name = std::string ())
+      throw (std::runtime_error);
+
+    /// \brief Number of entries.
+    std::size_t size () const throw ();
+
+    /// \brief Name of an entry.
+    const std::string& name (std::size_t i) const throw (std::runtime_error);
+
+    /// \brief Set the acceptance test of the results.
+    ///
+    /// By default, any Result or ResultWithWarnings is accepted.
+    void setAcceptance (const acceptance_t& acceptance) throw ();
+
+    /// \brief Race the solvers.
+    ///
+    /// \return first acceptable result, or, if no solver returned an
+    /// acceptable result, the first result returned
+    const result_t& solve () throw (std::runtime_error);
+
+    /// \brief Wait for the solvers still running.
+    void wait () throw ();
+
+    /// \brief Whether the last race has a winner.
+    bool hasWinner () const throw ();
+
+    /// \brief Index of the winner of the last race.
+    std::size_t winner () const throw (std::runtime_error);
+
+    /// \brief Result of each entry in the last race.
+    ///
+    /// Waits for the solvers still running.
+    const std::vector<result_t>& results () throw ();
+
+    /// \brief Statistics of an entry.
+    Statistics statistics (std::size_t i) const throw (std::runtime_error);
+
+    /// \brief Entries by decreasing number of wins, then increasing
+    /// mean time.
+    std::vector<std::size_t> ranking () const throw ();
+
+  private:
+    /// \brief Portfolio entry.
+    struct Entry
+    {
+      /// \brief Solver plug-in name.
+      std::string solver;
+      /// \brief Entry name.
+      std::string name;
+      /// \brief Solver parameters.
+      parameters_t parameters;
+      /// \brief Loaded plug-in.
+      const PluginRegistry::Plugin* plugin;
+      /// \brief Statistics.
+      Statistics statistics;
+    };
+
+    /// \brief Check an entry index.
+    void checkEntry (std::size_t i) const throw (std::runtime_error);
+
+    /// \brief Whether a result is acceptable.
+    bool accept (const result_t& result) const;
+
+    /// \brief Thread main function: solve with the i-th entry.
+    void run (std::size_t i);
+
+    /// \brief Store the result of the i-th entry.
+    void finish (std::size_t i, const result_t& result, double time,
+		 bool started);
+
+    /// \brief Iteration callback: stop once the race is over.
+    void stopCallback (const problem_t& problem, solverState_t& state);
+
+    /// \brief Problem to solve.
+    const problem_t problem_;
+    /// \brief Entries.
+    std::vector<Entry> entries_;
+    /// \brief Acceptance test.
+    acceptance_t acceptance_;
+
+    /// \brief Solver threads of the last race.
+    std::vector<boost::shared_ptr<boost::thread> > threads_;
+    /// \brief Result of each entry.
+    std::vector<result_t> results_;
+    /// \brief Result returned by solve.
+    result_t result_;
+    /// \brief Whether an acceptable result has been found.
+    bool over_;
+    /// \brief Winner index.
+    std::size_t winner_;
+    /// \brief First entry to finish.
+    std::size_t first_;
+    /// \brief Number of entries still running.
+    std::size_t pending_;
+
+    /// \brief Protect the race state.
+    mutable boost::mutex mutex_;
+    /// \brief Notified when an entry finishes.
+    boost::condition_variable finished_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/portfolio.hxx>
+#endif //! ROBOPTIM_CORE_PORTFOLIO_HH
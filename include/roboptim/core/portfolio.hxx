@@ -0,0 +1,355 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PORTFOLIO_HXX
+# define ROBOPTIM_CORE_PORTFOLIO_HXX
+# include <algorithm>
+# include <utility>
+
+# include <boost/bind.hpp>
+# include <boost/date_time/posix_time/posix_time.hpp>
+# include <boost/foreach.hpp>
+# include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+
+namespace roboptim
+{
+  template <typename S>
+  Portfolio<S>::Statistics::Statistics ()
+    : runs (0),
+      wins (0),
+      solutions (0),
+      failures (0),
+      cancellations (0),
+      totalTime (0.),
+      minTime (0.),
+      maxTime (0.)
+  {}
+
+  template <typename S>
+  double
+  Portfolio<S>::Statistics::meanTime () const throw ()
+  {
+    return runs ? totalTime / static_cast<double> (runs) : 0.;
+  }
+
+  template <typename S>
+  Portfolio<S>::Portfolio (const problem_t& problem) throw ()
+    : problem_ (problem),
+      entries_ (),
+      acceptance_ (),
+      threads_ (),
+      results_ (),
+      result_ (NoSolution ()),
+      over_ (false),
+      winner_ (0),
+      first_ (0),
+      pending_ (0),
+      mutex_ (),
+      finished_ ()
+  {}
+
+  template <typename S>
+  Portfolio<S>::~Portfolio () throw ()
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (mutex_);
+      over_ = true;
+    }
+    wait ();
+
+    BOOST_FOREACH (const Entry& entry, entries_)
+      PluginRegistry::instance ().release (*entry.plugin);
+  }
+
+  template <typename S>
+  std::size_t
+  Portfolio<S>::add (const std::string& solver,
+		     const parameters_t& parameters,
+		     const std::string& name)
+    throw (std::runtime_error)
+  {
+    wait ();
+
+    Entry entry;
+    entry.solver = solver;
+    entry.name = name.empty () ? solver : name;
+    entry.parameters = parameters;
+    entry.plugin = &PluginRegistry::instance ().acquire (solver);
+    entries_.push_back (entry);
+    return entries_.size () - 1;
+  }
+
+  template <typename S>
+  std::size_t
+  Portfolio<S>::size () const throw ()
+  {
+    return entries_.size ();
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::checkEntry (std::size_t i) const throw (std::runtime_error)
+  {
+    if (i >= entries_.size ())
+      {
+	boost::format fmt ("Invalid portfolio entry (%d, size is %d)");
+	fmt % i % entries_.size ();
+	throw std::runtime_error (fmt.str ());
+      }
+  }
+
+  template <typename S>
+  const std::string&
+  Portfolio<S>::name (std::size_t i) const throw (std::runtime_error)
+  {
+    checkEntry (i);
+    return entries_[i].name;
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::setAcceptance (const acceptance_t& acceptance) throw ()
+  {
+    acceptance_ = acceptance;
+  }
+
+  template <typename S>
+  bool
+  Portfolio<S>::accept (const result_t& result) const
+  {
+    const Result* solution = detail::solution (result);
+    return solution && (!acceptance_ || acceptance_ (*solution));
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::stopCallback (const problem_t&, solverState_t& state)
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    if (over_)
+      state.requestStop ();
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::run (std::size_t i)
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (mutex_);
+      if (over_)
+	{
+	  lock.unlock ();
+	  finish (i, NoSolution (), 0., false);
+	  return;
+	}
+    }
+
+    const Entry& entry = entries_[i];
+    const boost::posix_time::ptime start =
+      boost::posix_time::microsec_clock::universal_time ();
+
+    result_t result = NoSolution ();
+    try
+      {
+	problem_t problem (problem_);
+	SolverFactory<solver_t> factory (entry.solver, problem);
+	solver_t& solver = factory ();
+
+	typedef std::pair<const std::string, Parameter> parameter_t;
+	BOOST_FOREACH (const parameter_t& parameter, entry.parameters)
+	  solver.parameters ()[parameter.first] = parameter.second;
+
+	try
+	  {
+	    solver.setIterationCallback
+	      (boost::bind (&Portfolio<S>::stopCallback, this, _1, _2));
+	  }
+	catch (const std::runtime_error&)
+	  {
+	    // Iteration callbacks are not supported: this solver can
+	    // not be cancelled once started.
+	  }
+
+	result = solver.minimum ();
+      }
+    catch (const std::exception& e)
+      {
+	result = SolverError (e.what ());
+      }
+
+    const double time = 1e-6 * static_cast<double>
+      ((boost::posix_time::microsec_clock::universal_time () - start)
+       .total_microseconds ());
+    finish (i, result, time, true);
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::finish (std::size_t i, const result_t& result, double time,
+			bool started)
+  {
+    const bool acceptable = started && accept (result);
+
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    Statistics& statistics = entries_[i].statistics;
+    results_[i] = result;
+
+    if (started)
+      {
+	if (!statistics.runs++)
+	  statistics.minTime = statistics.maxTime = time;
+	statistics.totalTime += time;
+	statistics.minTime = std::min (statistics.minTime, time);
+	statistics.maxTime = std::max (statistics.maxTime, time);
+	if (first_ == entries_.size ())
+	  first_ = i;
+      }
+
+    if (acceptable)
+      {
+	++statistics.solutions;
+	if (!over_)
+	  {
+	    over_ = true;
+	    winner_ = i;
+	    ++statistics.wins;
+	  }
+      }
+    else if (over_)
+      ++statistics.cancellations;
+    else
+      ++statistics.failures;
+
+    --pending_;
+    finished_.notify_all ();
+  }
+
+  template <typename S>
+  const typename Portfolio<S>::result_t&
+  Portfolio<S>::solve () throw (std::runtime_error)
+  {
+    if (entries_.empty ())
+      throw std::runtime_error ("Portfolio is empty");
+
+    wait ();
+
+    const std::size_t n = entries_.size ();
+    results_.assign (n, NoSolution ());
+    over_ = false;
+    winner_ = first_ = n;
+    pending_ = n;
+
+    for (std::size_t i = 0; i < n; ++i)
+      try
+	{
+	  threads_.push_back
+	    (boost::make_shared<boost::thread>
+	     (boost::bind (&Portfolio<S>::run, this, i)));
+	}
+      catch (const std::exception& e)
+	{
+	  {
+	    boost::unique_lock<boost::mutex> lock (mutex_);
+	    over_ = true;
+	    pending_ -= n - i;
+	  }
+	  wait ();
+	  boost::format fmt ("Failed to start the portfolio solvers: %1%");
+	  fmt % e.what ();
+	  throw std::runtime_error (fmt.str ());
+	}
+
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    while (!over_ && pending_)
+      finished_.wait (lock);
+
+    result_ = results_[(winner_ < n) ? winner_ : first_];
+    return result_;
+  }
+
+  template <typename S>
+  void
+  Portfolio<S>::wait () throw ()
+  {
+    BOOST_FOREACH (boost::shared_ptr<boost::thread>& thread, threads_)
+      thread->join ();
+    threads_.clear ();
+  }
+
+  template <typename S>
+  bool
+  Portfolio<S>::hasWinner () const throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    return winner_ < entries_.size ();
+  }
+
+  template <typename S>
+  std::size_t
+  Portfolio<S>::winner () const throw (std::runtime_error)
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    if (winner_ >= entries_.size ())
+      throw std::runtime_error ("Portfolio race has no winner");
+    return winner_;
+  }
+
+  template <typename S>
+  const std::vector<typename Portfolio<S>::result_t>&
+  Portfolio<S>::results () throw ()
+  {
+    wait ();
+    return results_;
+  }
+
+  template <typename S>
+  typename Portfolio<S>::Statistics
+  Portfolio<S>::statistics (std::size_t i) const throw (std::runtime_error)
+  {
+    checkEntry (i);
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    return entries_[i].statistics;
+  }
+
+  template <typename S>
+  std::vector<std::size_t>
+  Portfolio<S>::ranking () const throw ()
+  {
+    typedef std::pair<std::pair<double, double>, std::size_t> key_t;
+    std::vector<key_t> keys;
+
+    {
+      boost::unique_lock<boost::mutex> lock (mutex_);
+      for (std::size_t i = 0; i < entries_.size (); ++i)
+	{
+	  const Statistics& statistics = entries_[i].statistics;
+	  keys.push_back
+	    (key_t (std::make_pair (-static_cast<double> (statistics.wins),
+				    statistics.meanTime ()), i));
+	}
+    }
+    std::sort (keys.begin (), keys.end ());
+
+    std::vector<std::size_t> ranking (keys.size ());
+    for (std::size_t i = 0; i < keys.size (); ++i)
+      ranking[i] = keys[i].second;
+    return ranking;
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PORTFOLIO_HXX
@@ -0,0 +1,262 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PRESOLVE_HH
+# define ROBOPTIM_CORE_PRESOLVE_HH
+# include <stdexcept>
+# include <vector>
+
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/numeric-linear-function.hh>
+# include <roboptim/core/problem.hh>
+# include <roboptim/core/result.hh>
+# include <roboptim/core/filter/bind.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    template <typename P>
+    struct ReduceConstraint;
+  } // end of namespace detail.
+
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Reduce a problem before solving it.
+  ///
+  /// The presolve builds a smaller problem, equivalent to the
+  /// original one, where:
+  /// - the variables whose lower and upper bounds are equal are fixed
+  ///   and removed,
+  /// - the rows of linear constraints which are duplicated are merged
+  ///   into one row (their bounds are intersected),
+  /// - the rows of linear constraints which are implied by the
+  ///   argument bounds are removed.
+  /// .
+  ///
+  /// The cost function and the non-linear constraints are wrapped in
+  /// a Bind filter. The linear constraints (i.e. the constraints
+  /// whose function inherits from GenericLinearFunction) are rebuilt
+  /// as numeric linear functions of the free variables, keeping only
+  /// the remaining rows.
+  ///
+  /// Solve problem () instead of the original problem, then lift its
+  /// solution back to the original space with liftArgument,
+  /// liftMultipliers or liftResult.
+  ///
+  /// The original problem must outlive the presolve.
+  ///
+  /// \pre the cost function and the non-linear constraints are
+  /// differentiable (but not twice differentiable) functions, as
+  /// required by Bind.
+  ///
+  /// \tparam P problem type
+  template <typename P>
+  class Presolve
+  {
+  public:
+    /// \brief Problem type.
+    typedef P problem_t;
+
+    /// \brief Cost function type.
+    typedef typename problem_t::function_t function_t;
+    /// \brief Function traits (dense or sparse).
+    typedef typename function_t::traits_t traits_t;
+
+    /// \brief Import value type.
+    typedef typename problem_t::value_type value_type;
+    /// \brief Import vector type.
+    typedef typename problem_t::vector_t vector_t;
+    /// \brief Import size type.
+    typedef typename problem_t::size_type size_type;
+    /// \brief Import interval vector type.
+    typedef typename problem_t::intervals_t intervals_t;
+    /// \brief Import scale vector type.
+    typedef typename problem_t::scales_t scales_t;
+
+    /// \brief Reduced cost function type.
+    typedef Bind<function_t> bind_t;
+    /// \brief Reduced linear constraint type.
+    typedef GenericNumericLinearFunction<traits_t> numericLinearFunction_t;
+
+    /// \brief Indices vector.
+    typedef std::vector<size_type> indices_t;
+
+    /// \brief Reduce a problem.
+    ///
+    /// \param problem original problem
+    /// \param epsilon variables whose bounds are closer than epsilon
+    /// are fixed (to the middle of their bounds)
+    explicit Presolve (const problem_t& problem, value_type epsilon = 0.)
+      throw (std::runtime_error);
+
+    ~Presolve () throw ();
+
+    /// \brief Original problem.
+    const problem_t& origin () const throw ()
+    {
+      return origin_;
+    }
+
+    /// \brief Reduced problem.
+    const problem_t& problem () const throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Reduced problem.
+    ///
+    /// The reduced problem can be modified before being solved (i.e.
+    /// to set another starting point).
+    problem_t& problem () throw ()
+    {
+      return problem_;
+    }
+
+    /// \brief Indices of the variables kept in the reduced problem.
+    const indices_t& freeIndices () const throw ()
+    {
+      return cost_->freeIndices ();
+    }
+
+    /// \brief Indices of the fixed variables.
+    const indices_t& fixedIndices () const throw ()
+    {
+      return cost_->boundIndices ();
+    }
+
+    /// \brief Values of the fixed variables.
+    const vector_t& fixedValues () const throw ()
+    {
+      return cost_->boundValues ();
+    }
+
+    /// \brief Reduced row of each original constraint row.
+    ///
+    /// Rows are the stacked constraints rows (see ConstraintBlock).
+    /// Removed rows are associated with -1.
+    const indices_t& rows () const throw ()
+    {
+      return rows_;
+    }
+
+    /// \brief Number of constraints rows removed by the presolve.
+    size_type removedRows () const throw ();
+
+    /// \brief Restrict an original argument to the free variables.
+    vector_t reduceArgument (const vector_t& x) const
+      throw (std::runtime_error);
+
+    /// \brief Lift a reduced argument to the original space.
+    ///
+    /// Fixed variables take their fixed value.
+    vector_t liftArgument (const vector_t& x) const
+      throw (std::runtime_error);
+
+    /// \brief Lift the constraints multipliers of the reduced problem.
+    ///
+    /// The multiplier of a merged row is given to its first
+    /// occurrence; removed rows get a zero multiplier.
+    vector_t liftMultipliers (const vector_t& lambda) const
+      throw (std::runtime_error);
+
+    /// \brief Lift a result of the reduced problem.
+    ///
+    /// The argument and the multipliers are lifted and the original
+    /// constraints are evaluated at the lifted argument.
+    Result liftResult (const Result& result) const
+      throw (std::runtime_error);
+
+  private:
+    template <typename P_>
+    friend struct detail::ReduceConstraint;
+
+    /// \brief Linear rows of a constraint, on the free variables.
+    struct LinearRows
+    {
+      LinearRows ()
+	: linear (false),
+	  a (),
+	  b (),
+	  bounds (),
+	  kept ()
+      {}
+
+      /// \brief Row major sparse matrix.
+      typedef Eigen::SparseMatrix<value_type, Eigen::RowMajor> matrix_t;
+
+      /// \brief Whether the constraint is linear.
+      bool linear;
+      /// \brief Reduced matrix (only its nonzero coefficients).
+      matrix_t a;
+      /// \brief Reduced offset (fixed variables included).
+      vector_t b;
+      /// \brief Rows bounds (intersected with the merged rows).
+      intervals_t bounds;
+      /// \brief Whether each row is kept.
+      std::vector<bool> kept;
+    };
+
+    /// \brief Bound values given to the Bind filters.
+    typedef typename bind_t::boundValues_t boundValues_t;
+
+    /// \brief Find the fixed variables of a problem.
+    static boundValues_t fixedVariables (const problem_t& problem,
+					 value_type epsilon);
+
+    /// \brief Merge duplicated linear rows, then drop the rows implied
+    /// by the argument bounds.
+    void reduceLinearRows () throw (std::runtime_error);
+
+    /// \brief Add the reduced i-th constraint to the reduced problem.
+    template <typename C>
+    void addReducedConstraint (const boost::shared_ptr<C>& constraint,
+			       std::size_t i)
+      throw (std::runtime_error);
+
+    /// \brief Original problem.
+    const problem_t& origin_;
+
+    /// \brief Fixed variables values.
+    boundValues_t fixed_;
+
+    /// \brief Reduced cost function.
+    boost::shared_ptr<bind_t> cost_;
+
+    /// \brief Reduced problem.
+    problem_t problem_;
+
+    /// \brief Analysis of each constraint.
+    std::vector<LinearRows> linearRows_;
+
+    /// \brief Reduced row of each original row.
+    indices_t rows_;
+
+    /// \brief Number of rows of the reduced problem.
+    size_type reducedRows_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/presolve.hxx>
+#endif //! ROBOPTIM_CORE_PRESOLVE_HH
@@ -0,0 +1,592 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PRESOLVE_HXX
+# define ROBOPTIM_CORE_PRESOLVE_HXX
+# include <algorithm>
+# include <map>
+# include <utility>
+
+# include <boost/format.hpp>
+# include <boost/functional/hash.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/mpl/and.hpp>
+# include <boost/mpl/bool.hpp>
+# include <boost/mpl/not.hpp>
+# include <boost/type_traits/is_base_of.hpp>
+# include <boost/type_traits/is_same.hpp>
+# include <boost/variant/apply_visitor.hpp>
+# include <boost/variant/static_visitor.hpp>
+
+# include <roboptim/core/constraint-block.hh>
+# include <roboptim/core/util.hh>
+# include <roboptim/core/detail/autopromote.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Whether a function type can be wrapped in a Bind filter
+    /// of the same type.
+    template <typename C>
+    struct IsBindable
+      : boost::mpl::and_<
+      boost::is_base_of<GenericDifferentiableFunction<typename C::traits_t>,
+			C>,
+      boost::mpl::not_<
+	boost::is_base_of
+	<GenericTwiceDifferentiableFunction<typename C::traits_t>, C> >,
+      boost::is_same<typename AutopromoteTrait<C>::T_type, C> >
+    {};
+
+    /// \brief Copy a sparse row major matrix into a function matrix.
+    template <typename M>
+    void presolveMatrix (Eigen::MatrixXd& dst, const M& src)
+    {
+      dst = src.toDense ();
+    }
+
+    /// \brief Copy a sparse row major matrix into a function matrix.
+    template <typename M>
+    void presolveMatrix
+    (GenericFunctionTraits<EigenMatrixSparse>::matrix_t& dst, const M& src)
+    {
+      dst = src;
+    }
+
+    /// \brief Move a nonzero coefficient of a linear constraint either
+    /// to the reduced matrix or to the offset.
+    ///
+    /// \param columns reduced column of each variable, -1 - k for the
+    /// k-th fixed variable
+    template <typename I, typename V, typename T>
+    void presolveCoefficient (typename V::Index row, typename V::Index col,
+			      typename V::Scalar value, const I& columns,
+			      const V& fixedValues, V& b,
+			      std::vector<T>& triplets)
+    {
+      if (value == 0.)
+	return;
+
+      const typename V::Index k = columns[static_cast<std::size_t> (col)];
+      if (k >= 0)
+	triplets.push_back (T (static_cast<int> (row), static_cast<int> (k),
+			       value));
+      else
+	b[row] += value * fixedValues[-1 - k];
+    }
+
+    /// \brief Split a dense constraint matrix between the reduced
+    /// matrix and the offset.
+    template <typename D, typename I, typename V, typename T>
+    void presolveRows (const Eigen::MatrixBase<D>& a, const I& columns,
+		       const V& fixedValues, V& b, std::vector<T>& triplets)
+    {
+      for (typename D::Index col = 0; col < a.cols (); ++col)
+	for (typename D::Index row = 0; row < a.rows (); ++row)
+	  presolveCoefficient (row, col, a.coeff (row, col), columns,
+			       fixedValues, b, triplets);
+    }
+
+    /// \brief Split a sparse constraint matrix between the reduced
+    /// matrix and the offset.
+    template <typename S, int O, typename J, typename I, typename V,
+	      typename T>
+    void presolveRows (const Eigen::SparseMatrix<S, O, J>& a,
+		       const I& columns, const V& fixedValues, V& b,
+		       std::vector<T>& triplets)
+    {
+      typedef Eigen::SparseMatrix<S, O, J> matrix_t;
+
+      for (typename matrix_t::Index k = 0; k < a.outerSize (); ++k)
+	for (typename matrix_t::InnerIterator it (a, k); it; ++it)
+	  presolveCoefficient (it.row (), it.col (), it.value (), columns,
+			       fixedValues, b, triplets);
+    }
+
+    /// \brief Hash the nonzero coefficients and the offset of a row.
+    template <typename R>
+    std::size_t hashRow (const R& rows, typename R::matrix_t::Index j)
+    {
+      std::size_t seed = 0;
+      for (typename R::matrix_t::InnerIterator it (rows.a, j); it; ++it)
+	{
+	  boost::hash_combine (seed, it.col ());
+	  boost::hash_combine (seed, it.value ());
+	}
+      boost::hash_combine (seed, rows.b[j]);
+      return seed;
+    }
+
+    /// \brief Whether two rows have the same coefficients and offset.
+    template <typename R>
+    bool sameRows (const R& rows1, typename R::matrix_t::Index j1,
+		   const R& rows2, typename R::matrix_t::Index j2)
+    {
+      if (rows1.b[j1] != rows2.b[j2])
+	return false;
+
+      typename R::matrix_t::InnerIterator it1 (rows1.a, j1);
+      typename R::matrix_t::InnerIterator it2 (rows2.a, j2);
+      for (; it1 && it2; ++it1, ++it2)
+	if (it1.col () != it2.col () || it1.value () != it2.value ())
+	  return false;
+      return !it1 && !it2;
+    }
+
+    /// \brief Read the rows of the linear constraints.
+    template <typename P, typename R>
+    struct AnalyseConstraint : public boost::static_visitor<void>
+    {
+      typedef typename P::vector_t vector_t;
+      typedef typename P::function_t::traits_t traits_t;
+      typedef Eigen::Triplet<typename P::value_type> triplet_t;
+
+      /// \param columns reduced column of each variable, -1 - k for
+      /// the k-th fixed variable
+      AnalyseConstraint (R& rows, const typename P::indices_t& columns,
+			 typename P::size_type freeSize,
+			 const vector_t& fixedValues)
+	: rows_ (rows),
+	  columns_ (columns),
+	  freeSize_ (freeSize),
+	  fixedValues_ (fixedValues)
+      {}
+
+      template <typename U>
+      void operator () (const U& constraint) const
+      {
+	const GenericLinearFunction<traits_t>* linear =
+	  dynamic_cast<const GenericLinearFunction<traits_t>*>
+	  (constraint.get ());
+	rows_.linear = !!linear;
+	if (!linear)
+	  return;
+
+	// The jacobian and the value at zero of a linear function
+	// give its matrix and its offset.
+	vector_t zero (linear->inputSize ());
+	zero.setZero ();
+	rows_.b = (*linear) (zero);
+
+	std::vector<triplet_t> triplets;
+	presolveRows (linear->jacobian (zero), columns_, fixedValues_,
+		      rows_.b, triplets);
+	rows_.a.resize (linear->outputSize (), freeSize_);
+	rows_.a.setFromTriplets (triplets.begin (), triplets.end ());
+      }
+
+    private:
+      R& rows_;
+      const typename P::indices_t& columns_;
+      typename P::size_type freeSize_;
+      const vector_t& fixedValues_;
+    };
+
+    /// \brief Add each reduced constraint to the reduced problem.
+    template <typename P>
+    struct ReduceConstraint : public boost::static_visitor<void>
+    {
+      ReduceConstraint (P& presolve, std::size_t i)
+	: presolve_ (presolve),
+	  i_ (i)
+      {}
+
+      template <typename U>
+      void operator () (const U& constraint) const
+      {
+	presolve_.addReducedConstraint (constraint, i_);
+      }
+
+    private:
+      P& presolve_;
+      std::size_t i_;
+    };
+
+    /// \brief Rebuild a linear constraint on the free variables.
+    template <typename C, typename L>
+    boost::shared_ptr<C>
+    rebuildLinearConstraint (const boost::shared_ptr<C>&,
+			     const typename L::matrix_t& a,
+			     const typename L::vector_t& b,
+			     boost::mpl::true_)
+    {
+      return boost::static_pointer_cast<C> (boost::make_shared<L> (a, b));
+    }
+
+    template <typename C, typename L>
+    boost::shared_ptr<C>
+    rebuildLinearConstraint (const boost::shared_ptr<C>& constraint,
+			     const typename L::matrix_t&,
+			     const typename L::vector_t&,
+			     boost::mpl::false_)
+    {
+      boost::format fmt
+	("Failed to presolve constraint '%s': its type cannot hold"
+	 " a numeric linear function");
+      fmt % constraint->getName ();
+      throw std::runtime_error (fmt.str ());
+    }
+
+    /// \brief Wrap a constraint in a Bind filter.
+    template <typename C, typename B>
+    boost::shared_ptr<C>
+    bindConstraint (const boost::shared_ptr<C>& constraint,
+		    const B& fixed,
+		    boost::mpl::true_)
+    {
+      return boost::static_pointer_cast<C>
+	(boost::make_shared<Bind<C> > (constraint, fixed));
+    }
+
+    template <typename C, typename B>
+    boost::shared_ptr<C>
+    bindConstraint (const boost::shared_ptr<C>& constraint,
+		    const B&,
+		    boost::mpl::false_)
+    {
+      boost::format fmt
+	("Failed to presolve constraint '%s': its type cannot be bound");
+      fmt % constraint->getName ();
+      throw std::runtime_error (fmt.str ());
+    }
+  } // end of namespace detail.
+
+  template <typename P>
+  typename Presolve<P>::boundValues_t
+  Presolve<P>::fixedVariables (const problem_t& problem, value_type epsilon)
+  {
+    boundValues_t fixed (problem.argumentBounds ().size ());
+    for (std::size_t i = 0; i < fixed.size (); ++i)
+      {
+	const value_type lower =
+	  function_t::getLowerBound (problem.argumentBounds ()[i]);
+	const value_type upper =
+	  function_t::getUpperBound (problem.argumentBounds ()[i]);
+	if (upper - lower <= epsilon)
+	  fixed[i] = .5 * (lower + upper);
+      }
+    return fixed;
+  }
+
+  template <typename P>
+  Presolve<P>::Presolve (const problem_t& problem, value_type epsilon)
+    throw (std::runtime_error)
+    : origin_ (problem),
+      fixed_ (fixedVariables (problem, epsilon)),
+      // The cost function is not owned: the original problem
+      // outlives the presolve.
+      cost_ (boost::make_shared<bind_t>
+	     (boost::shared_ptr<function_t>
+	      (const_cast<function_t*> (&problem.function ()),
+	       detail::NullDeleter ()),
+	      fixed_)),
+      problem_ (*cost_),
+      linearRows_ (problem.constraints ().size ()),
+      rows_ (),
+      reducedRows_ (0)
+  {
+    BOOST_STATIC_ASSERT ((detail::IsBindable<function_t>::value));
+
+    // Arguments.
+    for (std::size_t k = 0; k < freeIndices ().size (); ++k)
+      {
+	const std::size_t i = static_cast<std::size_t> (freeIndices ()[k]);
+	problem_.argumentBounds ()[k] = origin_.argumentBounds ()[i];
+	problem_.argumentScales ()[k] = origin_.argumentScales ()[i];
+      }
+    if (origin_.startingPoint ())
+      problem_.startingPoint () = reduceArgument (*origin_.startingPoint ());
+
+    // Constraints.
+    indices_t columns (static_cast<std::size_t>
+		       (origin_.function ().inputSize ()));
+    for (std::size_t k = 0; k < freeIndices ().size (); ++k)
+      columns[static_cast<std::size_t> (freeIndices ()[k])] =
+	static_cast<size_type> (k);
+    for (std::size_t k = 0; k < fixedIndices ().size (); ++k)
+      columns[static_cast<std::size_t> (fixedIndices ()[k])] =
+	-1 - static_cast<size_type> (k);
+
+    for (std::size_t i = 0; i < origin_.constraints ().size (); ++i)
+      {
+	linearRows_[i].bounds = origin_.boundsVector ()[i];
+	linearRows_[i].kept.assign (linearRows_[i].bounds.size (), true);
+	detail::AnalyseConstraint<Presolve<P>, LinearRows> analyse
+	  (linearRows_[i], columns,
+	   static_cast<size_type> (freeIndices ().size ()), fixedValues ());
+	boost::apply_visitor (analyse, origin_.constraints ()[i]);
+      }
+    reduceLinearRows ();
+
+    rows_.reserve (static_cast<std::size_t> (origin_.constraintsOutputSize ()));
+    for (std::size_t i = 0; i < origin_.constraints ().size (); ++i)
+      {
+	detail::ReduceConstraint<Presolve<P> > reduce (*this, i);
+	boost::apply_visitor (reduce, origin_.constraints ()[i]);
+      }
+  }
+
+  template <typename P>
+  Presolve<P>::~Presolve () throw ()
+  {
+  }
+
+  template <typename P>
+  void
+  Presolve<P>::reduceLinearRows () throw (std::runtime_error)
+  {
+    typedef std::pair<std::size_t, std::size_t> row_t;
+    typedef std::multimap<std::size_t, row_t> uniqueRows_t;
+    uniqueRows_t uniqueRows;
+
+    // Merge the duplicated rows into their first occurrence. Rows
+    // are indexed by the hash of their nonzero coefficients, then
+    // compared coefficient by coefficient.
+    for (std::size_t i = 0; i < linearRows_.size (); ++i)
+      {
+	LinearRows& rows = linearRows_[i];
+	if (!rows.linear)
+	  continue;
+
+	for (std::size_t j = 0; j < rows.kept.size (); ++j)
+	  {
+	    const size_type j_ = static_cast<size_type> (j);
+	    const std::size_t hash = detail::hashRow (rows, j_);
+
+	    std::pair<typename uniqueRows_t::iterator,
+		      typename uniqueRows_t::iterator> range =
+	      uniqueRows.equal_range (hash);
+	    typename uniqueRows_t::iterator it = range.first;
+	    while (it != range.second
+		   && !detail::sameRows
+		   (linearRows_[it->second.first],
+		    static_cast<size_type> (it->second.second), rows, j_))
+	      ++it;
+	    if (it == range.second)
+	      {
+		uniqueRows.insert (std::make_pair (hash, row_t (i, j)));
+		continue;
+	      }
+
+	    typename function_t::interval_t& bounds =
+	      linearRows_[it->second.first].bounds[it->second.second];
+	    bounds.first = std::max (bounds.first, rows.bounds[j].first);
+	    bounds.second = std::min (bounds.second, rows.bounds[j].second);
+	    if (bounds.first > bounds.second)
+	      {
+		boost::format fmt
+		  ("Failed to presolve: duplicated rows of constraints %d"
+		   " and %d have disjoint bounds (infeasible problem)");
+		fmt % it->second.first % i;
+		throw std::runtime_error (fmt.str ());
+	      }
+	    rows.kept[j] = false;
+	  }
+      }
+
+    // Drop the rows which are satisfied on the whole argument box.
+    for (std::size_t i = 0; i < linearRows_.size (); ++i)
+      {
+	LinearRows& rows = linearRows_[i];
+	if (!rows.linear)
+	  continue;
+
+	for (std::size_t j = 0; j < rows.kept.size (); ++j)
+	  {
+	    if (!rows.kept[j])
+	      continue;
+
+	    const size_type j_ = static_cast<size_type> (j);
+	    value_type lower = rows.b[j_];
+	    value_type upper = rows.b[j_];
+	    for (typename LinearRows::matrix_t::InnerIterator it (rows.a, j_);
+		 it; ++it)
+	      {
+		const value_type a = it.value ();
+		if (a == 0.)
+		  continue;
+		const std::size_t k_ = static_cast<std::size_t> (it.col ());
+		const value_type l = function_t::getLowerBound
+		  (problem_.argumentBounds ()[k_]);
+		const value_type u = function_t::getUpperBound
+		  (problem_.argumentBounds ()[k_]);
+		lower += a > 0. ? a * l : a * u;
+		upper += a > 0. ? a * u : a * l;
+	      }
+
+	    if (rows.bounds[j].first <= lower && upper <= rows.bounds[j].second)
+	      rows.kept[j] = false;
+	  }
+      }
+  }
+
+  template <typename P>
+  template <typename C>
+  void
+  Presolve<P>::addReducedConstraint (const boost::shared_ptr<C>& constraint,
+				     std::size_t i)
+    throw (std::runtime_error)
+  {
+    const LinearRows& rows = linearRows_[i];
+    const intervals_t& bounds = rows.bounds;
+    const scales_t& scales = origin_.scalesVector ()[i];
+
+    if (!rows.linear)
+      {
+	for (std::size_t j = 0; j < bounds.size (); ++j)
+	  rows_.push_back (reducedRows_++);
+	problem_.addConstraint
+	  (detail::bindConstraint
+	   (constraint, fixed_,
+	    boost::mpl::bool_<detail::IsBindable<C>::value> ()),
+	   bounds, scales);
+	return;
+      }
+
+    intervals_t keptBounds;
+    scales_t keptScales;
+    std::vector<typename vector_t::Index> keptRows;
+    for (std::size_t j = 0; j < bounds.size (); ++j)
+      if (rows.kept[j])
+	{
+	  keptBounds.push_back (bounds[j]);
+	  keptScales.push_back (scales[j]);
+	  keptRows.push_back (static_cast<typename vector_t::Index> (j));
+	  rows_.push_back (reducedRows_++);
+	}
+      else
+	rows_.push_back (-1);
+
+    if (keptRows.empty ())
+      return;
+
+    // Kept rows are appended in order to a row major matrix.
+    typename LinearRows::matrix_t a
+      (static_cast<size_type> (keptRows.size ()), rows.a.cols ());
+    a.reserve (rows.a.nonZeros ());
+    vector_t b (static_cast<size_type> (keptRows.size ()));
+    for (std::size_t j = 0; j < keptRows.size (); ++j)
+      {
+	const size_type j_ = static_cast<size_type> (j);
+	a.startVec (j_);
+	for (typename LinearRows::matrix_t::InnerIterator
+	       it (rows.a, keptRows[j]); it; ++it)
+	  a.insertBack (j_, it.col ()) = it.value ();
+	b[j_] = rows.b[keptRows[j]];
+      }
+    a.finalize ();
+
+    typename numericLinearFunction_t::matrix_t reducedA;
+    detail::presolveMatrix (reducedA, a);
+    problem_.addConstraint
+      (detail::rebuildLinearConstraint<C, numericLinearFunction_t>
+       (constraint, reducedA, b,
+	boost::mpl::bool_<boost::is_base_of
+	<C, numericLinearFunction_t>::value> ()),
+       keptBounds, keptScales);
+  }
+
+  template <typename P>
+  typename Presolve<P>::size_type
+  Presolve<P>::removedRows () const throw ()
+  {
+    return static_cast<size_type> (rows_.size ()) - reducedRows_;
+  }
+
+  template <typename P>
+  typename Presolve<P>::vector_t
+  Presolve<P>::reduceArgument (const vector_t& x) const
+    throw (std::runtime_error)
+  {
+    if (x.size () != origin_.function ().inputSize ())
+      {
+	boost::format fmt
+	  ("Failed to reduce argument: invalid size"
+	   " (%d, expected size is %d)");
+	fmt % x.size () % origin_.function ().inputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    vector_t reduced (static_cast<size_type> (freeIndices ().size ()));
+    for (std::size_t k = 0; k < freeIndices ().size (); ++k)
+      reduced[static_cast<size_type> (k)] = x[freeIndices ()[k]];
+    return reduced;
+  }
+
+  template <typename P>
+  typename Presolve<P>::vector_t
+  Presolve<P>::liftArgument (const vector_t& x) const
+    throw (std::runtime_error)
+  {
+    if (x.size () != problem_.function ().inputSize ())
+      {
+	boost::format fmt
+	  ("Failed to lift argument: invalid size"
+	   " (%d, expected size is %d)");
+	fmt % x.size () % problem_.function ().inputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    vector_t lifted (origin_.function ().inputSize ());
+    for (std::size_t k = 0; k < freeIndices ().size (); ++k)
+      lifted[freeIndices ()[k]] = x[static_cast<size_type> (k)];
+    for (std::size_t k = 0; k < fixedIndices ().size (); ++k)
+      lifted[fixedIndices ()[k]] = fixedValues ()[static_cast<size_type> (k)];
+    return lifted;
+  }
+
+  template <typename P>
+  typename Presolve<P>::vector_t
+  Presolve<P>::liftMultipliers (const vector_t& lambda) const
+    throw (std::runtime_error)
+  {
+    if (lambda.size () != reducedRows_)
+      {
+	boost::format fmt
+	  ("Failed to lift multipliers: invalid size"
+	   " (%d, expected size is %d)");
+	fmt % lambda.size () % reducedRows_;
+	throw std::runtime_error (fmt.str ());
+      }
+
+    vector_t lifted (static_cast<size_type> (rows_.size ()));
+    for (std::size_t i = 0; i < rows_.size (); ++i)
+      lifted[static_cast<size_type> (i)] =
+	rows_[i] < 0 ? 0. : lambda[rows_[i]];
+    return lifted;
+  }
+
+  template <typename P>
+  Result
+  Presolve<P>::liftResult (const Result& result) const
+    throw (std::runtime_error)
+  {
+    Result lifted (origin_.function ().inputSize (),
+		   origin_.function ().outputSize ());
+    lifted.x = liftArgument (result.x);
+    lifted.value = result.value;
+    if (!origin_.constraints ().empty ())
+      lifted.constraints = ConstraintBlock<problem_t> (origin_) (lifted.x);
+    if (result.lambda.size () > 0)
+      lifted.lambda = liftMultipliers (result.lambda);
+    return lifted;
+  }
+
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_PRESOLVE_HXX
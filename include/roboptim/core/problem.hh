@@ -125,6 +125,9 @@ namespace roboptim
     /// \brief Scale vector.
     typedef std::vector<value_type> scales_t;
 
+    /// \brief Read-only view of contiguous values.
+    typedef Eigen::Map<const vector_t> constVectorMap_t;
+
     /// \name Constructors and destructors.
     /// \{
 
@@ -174,6 +177,26 @@ namespace roboptim
     /// \return arguments scales
     const scales_t& argumentScales () const throw ();
 
+    /// \brief Lower bounds of the arguments, as a vector.
+    ///
+    /// The bounds are stored contiguously, next to argumentBounds ().
+    /// As the intervals can be modified in place, the stored bounds
+    /// are brought up to date by each call: later modifications of
+    /// argumentBounds () are only seen by a new view. Only modified
+    /// bounds are written, so that unmodified bounds can be viewed
+    /// concurrently.
+    constVectorMap_t argumentLowerBounds () const throw ();
+
+    /// \brief Upper bounds of the arguments, as a vector.
+    ///
+    /// \see argumentLowerBounds
+    constVectorMap_t argumentUpperBounds () const throw ();
+
+    /// \brief Arguments scales, as a vector.
+    ///
+    /// This is a view on argumentScales ().
+    constVectorMap_t argumentScalesMap () const throw ();
+
     /// \}
 
     /// \name Starting point (initial guess).
@@ -206,6 +229,11 @@ namespace roboptim
     intervals_t argumentBounds_;
     /// \brief Arguments' scales.
     scales_t argumentScales_;
+
+    /// \brief Lower bounds of the arguments (see argumentLowerBounds).
+    mutable std::vector<value_type> argumentLower_;
+    /// \brief Upper bounds of the arguments (see argumentLowerBounds).
+    mutable std::vector<value_type> argumentUpper_;
   };
 
 
@@ -323,6 +351,9 @@ namespace roboptim
     /// \brief Scale vector.
     typedef std::vector<value_type> scales_t;
 
+    /// \brief Read-only view of contiguous values.
+    typedef Eigen::Map<const vector_t> constVectorMap_t;
+
     /// \brief Vector of interval vectors. This type is used to take
     /// into account the fact that constraints can have output values
     /// in \f$\mathbb{C}^{m}\f$.
@@ -388,6 +419,26 @@ namespace roboptim
     /// \return arguments scales
     const scales_t& argumentScales () const throw ();
 
+    /// \brief Lower bounds of the arguments, as a vector.
+    ///
+    /// The bounds are stored contiguously, next to argumentBounds ().
+    /// As the intervals can be modified in place, the stored bounds
+    /// are brought up to date by each call: later modifications of
+    /// argumentBounds () are only seen by a new view. Only modified
+    /// bounds are written, so that unmodified bounds can be viewed
+    /// concurrently.
+    constVectorMap_t argumentLowerBounds () const throw ();
+
+    /// \brief Upper bounds of the arguments, as a vector.
+    ///
+    /// \see argumentLowerBounds
+    constVectorMap_t argumentUpperBounds () const throw ();
+
+    /// \brief Arguments scales, as a vector.
+    ///
+    /// This is a view on argumentScales ().
+    constVectorMap_t argumentScalesMap () const throw ();
+
     /// \}
 
 
@@ -437,6 +488,44 @@ namespace roboptim
     /// \return constraints scales vector
     const scalesVect_t& scalesVector () const throw ();
 
+    /// \brief Change the scales of a constraint.
+    ///
+    /// \param constraintId constraint index
+    /// \param scales new scales (one per constraint output)
+    void setConstraintScales (std::size_t constraintId, const scales_t& scales)
+      throw (std::runtime_error);
+
+    /// \brief Change the bounds of a constraint.
+    ///
+    /// \param constraintId constraint index
+    /// \param bounds new bounds (one interval per constraint output)
+    void setConstraintBounds (std::size_t constraintId,
+			      const intervals_t& bounds)
+      throw (std::runtime_error);
+
+    /// \brief Number of stacked constraints rows.
+    size_type constraintsOutputSize () const throw ();
+
+    /// \brief Lower bounds of all the constraints rows.
+    ///
+    /// Constraints are stacked in insertion order. The bounds are
+    /// stored contiguously and kept in sync by addConstraint, so that
+    /// they can be compared directly with the stacked constraints
+    /// values (see ConstraintBlock).
+    ///
+    /// The view is invalidated by the next addConstraint call.
+    constVectorMap_t constraintsLowerBounds () const throw ();
+
+    /// \brief Upper bounds of all the constraints rows.
+    ///
+    /// \see constraintsLowerBounds
+    constVectorMap_t constraintsUpperBounds () const throw ();
+
+    /// \brief Scales of all the constraints rows.
+    ///
+    /// \see constraintsLowerBounds
+    constVectorMap_t constraintsScales () const throw ();
+
     /// \}
 
 
@@ -480,6 +569,17 @@ namespace roboptim
     /// \brief Arguments' scales.
     scales_t argumentScales_;
 
+    /// \brief Lower bounds of the arguments (see argumentLowerBounds).
+    mutable std::vector<value_type> argumentLower_;
+    /// \brief Upper bounds of the arguments (see argumentLowerBounds).
+    mutable std::vector<value_type> argumentUpper_;
+
+    /// \brief Lower bounds of the stacked constraints rows.
+    std::vector<value_type> constraintsLower_;
+    /// \brief Upper bounds of the stacked constraints rows.
+    std::vector<value_type> constraintsUpper_;
+    /// \brief Scales of the stacked constraints rows.
+    std::vector<value_type> constraintsScales_;
   };
 
   /// Example shows problem class use.
@@ -18,8 +18,10 @@
 #ifndef ROBOPTIM_CORE_PROBLEM_HXX
 # define ROBOPTIM_CORE_PROBLEM_HXX
 # include <algorithm>
+# include <cstddef>
 # include <stdexcept>
 # include <boost/format.hpp>
+# include <boost/static_assert.hpp>
 # include <boost/type_traits/is_pointer.hpp>
 # include <boost/type_traits/remove_pointer.hpp>
 # include <boost/variant.hpp>
@@ -32,6 +34,38 @@
 
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \brief Copy the lower and upper bounds of an interval vector.
+    ///
+    /// Only the bounds that differ are written.
+    template <typename I, typename V>
+    void syncBounds (const I& intervals, V& lower, V& upper)
+    {
+      if (lower.size () != intervals.size ())
+	{
+	  lower.resize (intervals.size ());
+	  upper.resize (intervals.size ());
+	}
+      for (std::size_t i = 0; i < intervals.size (); ++i)
+	{
+	  if (lower[i] != intervals[i].first)
+	    lower[i] = intervals[i].first;
+	  if (upper[i] != intervals[i].second)
+	    upper[i] = intervals[i].second;
+	}
+    }
+
+    /// \brief View a std::vector as an Eigen vector.
+    template <typename M>
+    M mapValues (const std::vector<typename M::Scalar>& values)
+    {
+      if (values.empty ())
+	return M (0, 0);
+      return M (&values[0], static_cast<typename M::Index> (values.size ()));
+    }
+  } // end of namespace detail.
+
   //
   // Template specialization for problem without constraint
   //
@@ -40,7 +74,9 @@ namespace roboptim
     : function_ (f),
       startingPoint_ (),
       argumentBounds_ (f.inputSize ()),
-      argumentScales_ (f.inputSize ())
+      argumentScales_ (f.inputSize ()),
+      argumentLower_ (),
+      argumentUpper_ ()
   {
     // Check that in the objective function m = 1 (R^n -> R).
     assert (f.outputSize () == 1);
@@ -50,6 +86,7 @@ namespace roboptim
                function_t::makeInfiniteInterval ());
     // Initialize scale.
     std::fill (argumentScales_.begin (), argumentScales_.end (), 1.);
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
   }
 
   // Copy constructor.
@@ -59,7 +96,9 @@ namespace roboptim
     function_ (pb.function_),
     startingPoint_ (pb.startingPoint_),
     argumentBounds_ (pb.argumentBounds_),
-    argumentScales_ (pb.argumentScales_)
+    argumentScales_ (pb.argumentScales_),
+    argumentLower_ (pb.argumentLower_),
+    argumentUpper_ (pb.argumentUpper_)
   {
   }
 
@@ -71,7 +110,9 @@ namespace roboptim
     : function_ (pb.function_),
       startingPoint_ (pb.startingPoint_),
       argumentBounds_ (pb.argumentBounds_),
-      argumentScales_ (pb.argumentScales_)
+      argumentScales_ (pb.argumentScales_),
+      argumentLower_ (pb.argumentLower_),
+      argumentUpper_ (pb.argumentUpper_)
   {
     // Check that F is a subtype of F_.
     BOOST_STATIC_ASSERT((boost::is_base_of<F, F_>::value));
@@ -194,6 +235,29 @@ namespace roboptim
     return argumentScales_;
   }
 
+  template <typename F>
+  typename Problem<F, boost::mpl::vector<> >::constVectorMap_t
+  Problem<F, boost::mpl::vector<> >::argumentLowerBounds () const throw ()
+  {
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
+    return detail::mapValues<constVectorMap_t> (argumentLower_);
+  }
+
+  template <typename F>
+  typename Problem<F, boost::mpl::vector<> >::constVectorMap_t
+  Problem<F, boost::mpl::vector<> >::argumentUpperBounds () const throw ()
+  {
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
+    return detail::mapValues<constVectorMap_t> (argumentUpper_);
+  }
+
+  template <typename F>
+  typename Problem<F, boost::mpl::vector<> >::constVectorMap_t
+  Problem<F, boost::mpl::vector<> >::argumentScalesMap () const throw ()
+  {
+    return detail::mapValues<constVectorMap_t> (argumentScales_);
+  }
+
   //
   //
   // General template implementation
@@ -206,13 +270,19 @@ namespace roboptim
       boundsVect_ (),
       argumentBounds_ (static_cast<std::size_t> (f.inputSize ())),
       scalesVect_ (),
-      argumentScales_ (static_cast<std::size_t> (f.inputSize ()))
+      argumentScales_ (static_cast<std::size_t> (f.inputSize ())),
+      argumentLower_ (),
+      argumentUpper_ (),
+      constraintsLower_ (),
+      constraintsUpper_ (),
+      constraintsScales_ ()
   {
     // Initialize bound.
     std::fill (argumentBounds_.begin (), argumentBounds_.end (),
                function_t::makeInfiniteInterval ());
     // Initialize scale.
     std::fill (argumentScales_.begin (), argumentScales_.end (), 1.);
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
   }
 
   template <typename F, typename CLIST>
@@ -229,7 +299,12 @@ namespace roboptim
       boundsVect_ (pb.boundsVect_),
       argumentBounds_ (pb.argumentBounds_),
       scalesVect_ (pb.scalesVect_),
-      argumentScales_ (pb.argumentScales_)
+      argumentScales_ (pb.argumentScales_),
+      argumentLower_ (pb.argumentLower_),
+      argumentUpper_ (pb.argumentUpper_),
+      constraintsLower_ (pb.constraintsLower_),
+      constraintsUpper_ (pb.constraintsUpper_),
+      constraintsScales_ (pb.constraintsScales_)
   {
   }
 
@@ -243,7 +318,12 @@ namespace roboptim
       boundsVect_ (pb.boundsVect_),
       argumentBounds_ (pb.argumentBounds_),
       scalesVect_ (pb.scalesVect_),
-      argumentScales_ (pb.argumentScales_)
+      argumentScales_ (pb.argumentScales_),
+      argumentLower_ (pb.argumentLower_),
+      argumentUpper_ (pb.argumentUpper_),
+      constraintsLower_ (pb.constraintsLower_),
+      constraintsUpper_ (pb.constraintsUpper_),
+      constraintsScales_ (pb.constraintsScales_)
   {
     // Check that F is a subtype of F_.
     BOOST_STATIC_ASSERT((boost::is_base_of<F, F_>::value));
@@ -294,6 +374,10 @@ namespace roboptim
     scales_t scales;
     scales.push_back (s);
     scalesVect_.push_back (scales);
+
+    constraintsLower_.push_back (b.first);
+    constraintsUpper_.push_back (b.second);
+    constraintsScales_.push_back (s);
   }
 
   template <typename F, typename CLIST>
@@ -358,6 +442,13 @@ namespace roboptim
 
     boundsVect_.push_back (b);
     scalesVect_.push_back (s);
+
+    for (std::size_t i = 0; i < b.size (); ++i)
+      {
+	constraintsLower_.push_back (b[i].first);
+	constraintsUpper_.push_back (b[i].second);
+      }
+    constraintsScales_.insert (constraintsScales_.end (), s.begin (), s.end ());
   }
 
   template <typename F, typename CLIST>
@@ -408,6 +499,101 @@ namespace roboptim
     return scalesVect_;
   }
 
+  template <typename F, typename CLIST>
+  void
+  Problem<F, CLIST>::setConstraintScales (std::size_t constraintId,
+					  const scales_t& scales)
+    throw (std::runtime_error)
+  {
+    if (constraintId >= scalesVect_.size ())
+      {
+	boost::format fmt
+	  ("Failed to set constraint scales: invalid constraint id"
+	   " (%d, number of constraints is %d)");
+	fmt % constraintId % scalesVect_.size ();
+	throw std::runtime_error (fmt.str ());
+      }
+    if (scales.size () != scalesVect_[constraintId].size ())
+      {
+	boost::format fmt
+	  ("Failed to set constraint scales: scale vector size is invalid"
+	   " (%d, expected size is %d)");
+	fmt % scales.size () % scalesVect_[constraintId].size ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < constraintId; ++i)
+      offset += scalesVect_[i].size ();
+
+    scalesVect_[constraintId] = scales;
+    std::copy (scales.begin (), scales.end (),
+	       constraintsScales_.begin () + static_cast<std::ptrdiff_t> (offset));
+  }
+
+  template <typename F, typename CLIST>
+  void
+  Problem<F, CLIST>::setConstraintBounds (std::size_t constraintId,
+					  const intervals_t& bounds)
+    throw (std::runtime_error)
+  {
+    if (constraintId >= boundsVect_.size ())
+      {
+	boost::format fmt
+	  ("Failed to set constraint bounds: invalid constraint id"
+	   " (%d, number of constraints is %d)");
+	fmt % constraintId % boundsVect_.size ();
+	throw std::runtime_error (fmt.str ());
+      }
+    if (bounds.size () != boundsVect_[constraintId].size ())
+      {
+	boost::format fmt
+	  ("Failed to set constraint bounds: bounds vector size is invalid"
+	   " (%d, expected size is %d)");
+	fmt % bounds.size () % boundsVect_[constraintId].size ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < constraintId; ++i)
+      offset += boundsVect_[i].size ();
+
+    boundsVect_[constraintId] = bounds;
+    for (std::size_t i = 0; i < bounds.size (); ++i)
+      {
+	constraintsLower_[offset + i] = bounds[i].first;
+	constraintsUpper_[offset + i] = bounds[i].second;
+      }
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::size_type
+  Problem<F, CLIST>::constraintsOutputSize () const throw ()
+  {
+    return static_cast<size_type> (constraintsLower_.size ());
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::constraintsLowerBounds () const throw ()
+  {
+    return detail::mapValues<constVectorMap_t> (constraintsLower_);
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::constraintsUpperBounds () const throw ()
+  {
+    return detail::mapValues<constVectorMap_t> (constraintsUpper_);
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::constraintsScales () const throw ()
+  {
+    return detail::mapValues<constVectorMap_t> (constraintsScales_);
+  }
+
   template <typename F, typename CLIST>
   typename Problem<F, CLIST>::scales_t&
   Problem<F, CLIST>::argumentScales () throw ()
@@ -422,6 +608,29 @@ namespace roboptim
     return argumentScales_;
   }
 
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::argumentLowerBounds () const throw ()
+  {
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
+    return detail::mapValues<constVectorMap_t> (argumentLower_);
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::argumentUpperBounds () const throw ()
+  {
+    detail::syncBounds (argumentBounds_, argumentLower_, argumentUpper_);
+    return detail::mapValues<constVectorMap_t> (argumentUpper_);
+  }
+
+  template <typename F, typename CLIST>
+  typename Problem<F, CLIST>::constVectorMap_t
+  Problem<F, CLIST>::argumentScalesMap () const throw ()
+  {
+    return detail::mapValues<constVectorMap_t> (argumentScales_);
+  }
+
 
   namespace detail
   {
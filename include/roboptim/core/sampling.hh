@@ -0,0 +1,119 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_SAMPLING_HH
+# define ROBOPTIM_CORE_SAMPLING_HH
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+
+# include <cstddef>
+# include <stdexcept>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Sampling method of the unit hypercube.
+  enum SamplingMethod
+    {
+      /// \brief Independent uniform points.
+      SAMPLING_UNIFORM,
+      /// \brief Latin hypercube: each coordinate has exactly one
+      /// point in each of the n strata of [0, 1).
+      SAMPLING_LATIN_HYPERCUBE,
+      /// \brief Sobol low-discrepancy sequence (randomized by a
+      /// digital shift).
+      SAMPLING_SOBOL
+    };
+
+  /// \brief Sobol low-discrepancy sequence in [0, 1)^d.
+  ///
+  /// Points are generated in Gray code order (Antonov-Saleev). The
+  /// first dimensions use the Joe-Kuo initial direction numbers,
+  /// the following ones use the next primitive polynomials with
+  /// pseudo-random initial direction numbers.
+  ///
+  /// A non-zero seed randomizes the sequence by a digital shift
+  /// (each coordinate is xored with a random number): the sequence
+  /// keeps its equidistribution properties, but does not start at
+  /// the origin.
+  class ROBOPTIM_DLLAPI SobolSequence
+  {
+  public:
+    /// \brief Build the sequence.
+    ///
+    /// \param dimension points dimension
+    /// \param seed digital shift seed (zero: no shift)
+    explicit SobolSequence (std::size_t dimension, boost::uint32_t seed = 0)
+      throw (std::runtime_error);
+
+    /// \brief Points dimension.
+    std::size_t dimension () const throw ();
+
+    /// \brief Number of points generated so far.
+    boost::uint32_t index () const throw ();
+
+    /// \brief Generate the next point.
+    ///
+    /// \param x point, resized to the dimension
+    void next (Function::vector_t& x) throw (std::runtime_error);
+
+    /// \brief Restart the sequence from its first point.
+    void reset () throw ();
+
+  private:
+    /// \brief Number of bits of the generated numbers.
+    static const std::size_t bits = 32;
+
+    /// \brief Points dimension.
+    std::size_t dimension_;
+    /// \brief Direction numbers (bits per dimension).
+    std::vector<boost::uint32_t> directions_;
+    /// \brief Digital shift (one per dimension).
+    std::vector<boost::uint32_t> shift_;
+    /// \brief Current point (before the shift).
+    std::vector<boost::uint32_t> state_;
+    /// \brief Number of points generated so far.
+    boost::uint32_t index_;
+  };
+
+  /// \brief Sample the unit hypercube [0, 1)^d.
+  ///
+  /// \param n number of points
+  /// \param dimension points dimension
+  /// \param method sampling method
+  /// \param seed pseudo-random generator seed, the same seed gives
+  /// the same points
+  /// \return points (one per column)
+  ROBOPTIM_DLLAPI Function::matrix_t
+  sampleUnitHypercube (std::size_t n, std::size_t dimension,
+		       SamplingMethod method, boost::uint32_t seed = 5489u)
+    throw (std::runtime_error);
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_SAMPLING_HH
@@ -23,12 +23,12 @@
 # include <stdexcept>
 # include <string>
 
-# include <ltdl.h>
 
 # include <boost/static_assert.hpp>
 # include <boost/type_traits/is_base_of.hpp>
 
 # include <roboptim/core/fwd.hh>
+# include <roboptim/core/plugin-registry.hh>
 # include <roboptim/core/solver.hh>
 # include <roboptim/core/solver-error.hh>
 
@@ -46,6 +46,11 @@ namespace roboptim
   /// is provided with GNU Libtool and wraps OS specific behavior into
   /// a uniform interface.
   ///
+  /// Plug-ins are loaded and validated through the PluginRegistry:
+  /// the shared object is only opened by the first factory and stays
+  /// loaded as long as a factory uses it (or if it has been
+  /// preloaded), so building many factories is cheap.
+  ///
   /// \warning The solver lifetime is bound to the factory lifetime,
   /// when the factory goes out of scope, the solver is destroyed too.
   ///
@@ -63,7 +68,8 @@ namespace roboptim
 
     /// \brief Instantiate a factory and load the plug-in.
     ///
-    /// The constructor search for the plug-in and load it.
+    /// The constructor search for the plug-in and load it (unless it
+    /// is already loaded).
     /// If the wanted plug-in can not be found, an exception is thrown.
     ///
     /// \param solver solver name (for instance ``cfsqp'')
@@ -71,7 +77,7 @@ namespace roboptim
     explicit SolverFactory (std::string solver, const problem_t& problem)
       throw (std::runtime_error);
 
-    /// Unload the plug-in and free the instantiated solver.
+    /// Free the instantiated solver and release the plug-in.
     ~SolverFactory () throw ();
 
     /// \brief Retrieve a reference on the solver.
@@ -79,8 +85,8 @@ namespace roboptim
     solver_t& operator () () throw ();
 
   private:
-    /// \brief ltdl plug-in handle.
-    lt_dlhandle handle_;
+    /// \brief Plug-in, owned by the plug-in registry.
+    const PluginRegistry::Plugin* plugin_;
     /// \brief Allocated solver.
     solver_t* solver_;
   };
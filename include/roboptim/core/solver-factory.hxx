@@ -71,128 +71,29 @@ namespace roboptim
   template <typename T>
   SolverFactory<T>::SolverFactory (std::string plugin, const problem_t& pb)
     throw (std::runtime_error)
-    : handle_ (),
+    : plugin_ (),
       solver_ ()
   {
-    typedef std::size_t getsizeofproblem_t ();
-    typedef const char* gettypeidofconstraintslist_t ();
     typedef solver_t* create_t (const problem_t&);
 
-    if (lt_dlinit () > 0)
-      throw std::runtime_error ("failed to initialize libltdl.");
+    PluginRegistry& registry = PluginRegistry::instance ();
+    plugin_ = &registry.acquire (plugin);
 
-    std::stringstream ss;
-    ss << "roboptim-core-plugin-" << plugin;
-    handle_ = lt_dlopenext (ss.str ().c_str ());
-    if (!handle_)
+    try
       {
-	std::stringstream sserror;
-	sserror << "libltdl failed to load plug-in ``"
-		<< ss.str () << "'': " << lt_dlerror ();
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-	throw std::runtime_error (sserror.str ().c_str ());
+	registry.validate
+	  (*plugin_, sizeof (typename solver_t::problem_t),
+	   typeid (typename solver_t::problem_t::constraintsList_t).name ());
+
+	solver_ = unionCast<create_t> (plugin_->create) (pb);
+	if (!solver_)
+	  throw std::runtime_error
+	    ("plug-in ``create'' function failed to create a solver");
       }
-
-    getsizeofproblem_t* getSizeOfProblem =
-      unionCast<getsizeofproblem_t> (lt_dlsym (handle_, "getSizeOfProblem"));
-    if (!getSizeOfProblem)
-      {
-	std::stringstream sserror;
-	sserror << "libltdl failed to find symbol ``getSizeOfProblem'': "
-		<< lt_dlerror ();
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-	throw std::runtime_error (sserror.str ().c_str ());
-      }
-
-    gettypeidofconstraintslist_t* getTypeIdOfConstraintsList =
-      unionCast<gettypeidofconstraintslist_t>
-      (lt_dlsym (handle_, "getTypeIdOfConstraintsList"));
-    if (!getTypeIdOfConstraintsList)
-      {
-        std::stringstream sserror;
-        sserror << "libltdl failed to find symbol"
-                << " ``getTypeIdOfConstraintsList'': "
-                << lt_dlerror ();
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-        throw std::runtime_error (sserror.str ().c_str ());
-      }
-
-    std::size_t sizeOfProblem = getSizeOfProblem ();
-    if (sizeOfProblem != sizeof (typename solver_t::problem_t))
-      {
-	std::stringstream sserror;
-	sserror
-	  << "``Problem'' type size does not match in application and plug-in"
-	  << " (size is " << sizeOfProblem
-	  << " byte(s) but " << sizeof (typename solver_t::problem_t)
-	  << " byte(s) was expected by application)";
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-	throw std::runtime_error (sserror.str ().c_str ());
-      }
-
-    const std::string typeIdOfConstraintsList
-      = demangle(getTypeIdOfConstraintsList ());
-    const std::string expectedTypeIdOfConstraintsList
-      = demangle(typeid
-                 (typename solver_t::problem_t::constraintsList_t).name ());
-    if (typeIdOfConstraintsList != expectedTypeIdOfConstraintsList)
-      {
-        std::stringstream sserror;
-        sserror
-          << "``Problem::constraintsList_t'' type id does not match in"
-          << " application and plug-in. Type id is:\n"
-          << typeIdOfConstraintsList
-          << "\nbut application expected:\n"
-          << expectedTypeIdOfConstraintsList;
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-        throw std::runtime_error (sserror.str ().c_str ());
-      }
-
-    create_t* c =
-      unionCast<create_t> (lt_dlsym (handle_, "create"));
-    if (!c)
+    catch (...)
       {
-	std::stringstream sserror;
-	sserror << "libltdl failed to find symbol ``create'': "
-		<< lt_dlerror ();
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-	throw std::runtime_error (sserror.str ().c_str ());
-      }
-
-    solver_ = c (pb);
-
-    if (!solver_)
-      {
-	std::stringstream sserror;
-	sserror << "libltdl failed to call ``create'': "
-		<< lt_dlerror ();
-
-	if (lt_dlclose (handle_))
-	  sserror << " (lt_dlclose failed too)";
-	if (lt_dlexit ())
-	  sserror << " lt_dlexit failed too";
-	throw std::runtime_error (sserror.str ().c_str ());
+	registry.release (*plugin_);
+	throw;
       }
   }
 
@@ -201,35 +102,10 @@ namespace roboptim
   {
     typedef void destroy_t (solver_t*);
 
-    destroy_t* destructor =
-      unionCast<destroy_t> (lt_dlsym (handle_, "destroy"));
-    if (destructor)
-      {
-        destructor (solver_);
-        solver_ = 0;
-      }
-    else
-      {
-	std::stringstream sserror;
-	sserror << "libltdl failed to call ``destroy'': "
-		<< lt_dlerror ();
-      }
-
-    if (lt_dlclose (handle_))
-      {
-	std::stringstream sserror;
-	sserror << "libltdl failed to close plug-in: "
-		<< lt_dlerror ();
-	std::cerr << sserror << std::endl;
-      }
+    unionCast<destroy_t> (plugin_->destroy) (solver_);
+    solver_ = 0;
 
-    if (lt_dlexit ())
-      {
-	std::stringstream sserror;
-	sserror << "libltdl failed to call ``create'': "
-		<< lt_dlerror ();
-	std::cerr << sserror << std::endl;
-      }
+    PluginRegistry::instance ().release (*plugin_);
   }
 
   template <typename T>
@@ -30,6 +30,7 @@
 
 # include <roboptim/core/fwd.hh>
 # include <roboptim/core/function.hh>
+# include <roboptim/core/parameter-handle.hh>
 # include <roboptim/core/problem.hh>
 
 namespace roboptim
@@ -107,6 +108,25 @@ namespace roboptim
     const boost::optional<value_type>& constraintViolation () const throw ();
     boost::optional<value_type>& constraintViolation () throw ();
 
+    /// \name Stop request
+    ///
+    /// Iteration callbacks request the solver to stop through these
+    /// methods (i.e. to cancel an optimization). The request is
+    /// cooperative: solvers supporting it check stopRequested after
+    /// calling the callback, then return their current state, and
+    /// clear the request when a new optimization starts.
+    /// \{
+
+    /// \brief Ask the solver to stop after the current iteration.
+    void requestStop () throw ();
+
+    /// \brief Whether the solver has been asked to stop.
+    bool stopRequested () const throw ();
+
+    /// \brief Clear the stop request.
+    void clearStopRequest () throw ();
+    /// \}
+
     /// \name Parameters
     /// \{
     const parameters_t& parameters () const throw ();
@@ -118,6 +138,35 @@ namespace roboptim
 
     template <typename T>
     T& getParameter (const std::string& key) throw (std::out_of_range);
+
+    /// \brief Add (or replace) a parameter and get a typed handle
+    /// on it.
+    ///
+    /// \param key parameter name
+    /// \param description parameter description (for humans)
+    /// \param value parameter value (its type is the handle type)
+    template <typename T>
+    ParameterHandle<T, StateParameter<function_t> >
+    registerParameter (const std::string& key,
+		       const std::string& description,
+		       const T& value);
+
+    /// \brief Add (or replace) a string parameter.
+    ///
+    /// String literals are stored as std::string (and not converted
+    /// to bool).
+    ParameterHandle<std::string, StateParameter<function_t> >
+    registerParameter (const std::string& key,
+		       const std::string& description,
+		       const char* value);
+
+    /// \brief Get a typed handle on an existing parameter.
+    ///
+    /// Callbacks resolve the parameters once, then use the handles
+    /// instead of getParameter at each iteration.
+    template <typename T>
+    ParameterHandle<T, StateParameter<function_t> >
+    parameterHandle (const std::string& key);
     /// \}
 
 
@@ -141,6 +190,9 @@ namespace roboptim
     /// hence the use of boost::optional.
     boost::optional<value_type> constraintViolation_;
 
+    /// \brief Whether the solver has been asked to stop.
+    bool stop_;
+
     /// \brief Solver state extra parameters (solver-specific parameters etc.).
     parameters_t parameters_;
   };
@@ -26,7 +26,8 @@ namespace roboptim
   SolverState<P>::SolverState (const problem_t& pb) throw ()
     : boost::noncopyable (),
       cost_ (),
-      constraintViolation_ ()
+      constraintViolation_ (),
+      stop_ (false)
   {
     x_.resize (pb.function ().inputSize ());
     x_.setZero ();
@@ -79,6 +80,27 @@ namespace roboptim
     return constraintViolation_;
   }
 
+  template <typename P>
+  void
+  SolverState<P>::requestStop () throw ()
+  {
+    stop_ = true;
+  }
+
+  template <typename P>
+  bool
+  SolverState<P>::stopRequested () const throw ()
+  {
+    return stop_;
+  }
+
+  template <typename P>
+  void
+  SolverState<P>::clearStopRequest () throw ()
+  {
+    stop_ = false;
+  }
+
   template <typename P>
   const typename SolverState<P>::parameters_t&
   SolverState<P>::parameters () const throw ()
@@ -117,6 +139,35 @@ namespace roboptim
     return boost::get<T> (it->second.value);
   }
 
+  template <typename P>
+  template <typename T>
+  ParameterHandle<T, StateParameter<typename SolverState<P>::function_t> >
+  SolverState<P>::registerParameter (const std::string& key,
+				     const std::string& description,
+				     const T& value)
+  {
+    return detail::registerParameter (parameters_, key, description, value);
+  }
+
+  template <typename P>
+  ParameterHandle<std::string,
+		  StateParameter<typename SolverState<P>::function_t> >
+  SolverState<P>::registerParameter (const std::string& key,
+				     const std::string& description,
+				     const char* value)
+  {
+    return detail::registerParameter
+      (parameters_, key, description, std::string (value));
+  }
+
+  template <typename P>
+  template <typename T>
+  ParameterHandle<T, StateParameter<typename SolverState<P>::function_t> >
+  SolverState<P>::parameterHandle (const std::string& key)
+  {
+    return ParameterHandle<T, StateParameter<function_t> > (parameters_, key);
+  }
+
   template <typename P>
   std::ostream&
   SolverState<P>::print (std::ostream& o) const throw ()
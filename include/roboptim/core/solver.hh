@@ -20,7 +20,9 @@
 # include <roboptim/core/sys.hh>
 # include <roboptim/core/debug.hh>
 
+# include <cstddef>
 # include <map>
+# include <stdexcept>
 # include <string>
 
 # include <boost/function.hpp>
@@ -32,7 +34,9 @@
 
 # include <roboptim/core/fwd.hh>
 # include <roboptim/core/function.hh>
+# include <roboptim/core/parameter-handle.hh>
 # include <roboptim/core/problem.hh>
+# include <roboptim/core/result.hh>
 # include <roboptim/core/generic-solver.hh>
 # include <roboptim/core/solver-state.hh>
 
@@ -60,8 +64,12 @@ namespace roboptim
   /// This class is parametrized by two types:
   /// the cost function type and the constraints type.
   ///
-  /// Solver classes are immutable, the problem can
-  /// not be changed after the class instantiation.
+  /// The functions of the problem can not be changed after the
+  /// class instantiation, but its data (starting point, bounds) can
+  /// be rebound so that the same solver instance, and its internal
+  /// allocations, are reused to solve a sequence of close problems
+  /// (i.e. model predictive control). The solution of the previous
+  /// problem can then be used to warm start the solver.
   ///
   /// \tparam F cost function type
   /// \tparam C constraints functions type
@@ -82,6 +90,9 @@ namespace roboptim
     /// \brief Import vector type from cost function
     typedef typename F::vector_t vector_t;
 
+    /// \brief Import interval vector type from problem.
+    typedef typename problem_t::intervals_t intervals_t;
+
     /// \brief Map of parameters.
     typedef std::map<std::string, Parameter> parameters_t;
 
@@ -137,6 +148,82 @@ namespace roboptim
 
     template <typename T>
     const T& getParameter (const std::string& key) const;
+
+    /// \brief Add (or replace) a parameter and get a typed handle
+    /// on it.
+    ///
+    /// \param key parameter name
+    /// \param description parameter description (for humans)
+    /// \param value parameter value (its type is the handle type)
+    template <typename T>
+    ParameterHandle<T, Parameter>
+    registerParameter (const std::string& key,
+		       const std::string& description,
+		       const T& value);
+
+    /// \brief Add (or replace) a string parameter.
+    ///
+    /// String literals are stored as std::string.
+    ParameterHandle<std::string, Parameter>
+    registerParameter (const std::string& key,
+		       const std::string& description,
+		       const char* value);
+
+    /// \brief Get a typed handle on an existing parameter.
+    ///
+    /// Resolve the parameter once, then use the handle instead of
+    /// getParameter in loops.
+    template <typename T>
+    ParameterHandle<T, Parameter> parameterHandle (const std::string& key);
+    /// \}
+
+    /// \name Rebinding
+    ///
+    /// These methods change the data of the problem and reset the
+    /// solver result. The solver is notified through impl_rebind.
+    /// \{
+
+    /// \brief Change the starting point.
+    void setStartingPoint (const vector_t& x) throw (std::runtime_error);
+
+    /// \brief Change the argument bounds.
+    void setArgumentBounds (const intervals_t& bounds)
+      throw (std::runtime_error);
+
+    /// \brief Change the bounds of a constraint.
+    void setConstraintBounds (std::size_t constraintId,
+			      const intervals_t& bounds)
+      throw (std::runtime_error);
+
+    /// \brief Copy the data of another problem.
+    ///
+    /// The starting point, the argument bounds and scales and the
+    /// constraints bounds and scales are copied.
+    ///
+    /// \pre problem has the same cost function and constraints
+    /// (i.e. the same function objects) as the solver problem.
+    void rebind (const problem_t& problem) throw (std::runtime_error);
+    /// \}
+
+    /// \name Warm start
+    /// \{
+
+    /// \brief Warm start the next solve from a previous result.
+    ///
+    /// The result argument becomes the starting point and its
+    /// multipliers are kept for the solver (see
+    /// warmStartMultipliers). Solvers keeping more state (active
+    /// set, Hessian approximation...) reuse it in impl_warmStart.
+    void warmStart (const Result& result) throw (std::runtime_error);
+
+    /// \brief Forget the warm start data.
+    void clearWarmStart () throw ();
+
+    /// \brief Whether warm start data is available.
+    bool hasWarmStart () const throw ();
+
+    /// \brief Multipliers of the warm start result.
+    const vector_t& warmStartMultipliers () const throw ();
     /// \}
 
     /// \brief Set the per-iteration callback.
@@ -160,12 +247,32 @@ namespace roboptim
     /// \return output stream
     virtual std::ostream& print (std::ostream&) const throw ();
   protected:
+    /// \brief Called when the problem data has been rebound.
+    ///
+    /// Solvers caching problem data (i.e. the bounds) update it here.
+    virtual void impl_rebind () throw ()
+    {}
+
+    /// \brief Called when the solver is warm started.
+    ///
+    /// The starting point and the multipliers are already set.
+    virtual void impl_warmStart (const Result&) throw ()
+    {}
+
     /// \brief Problem that will be solved.
-    const problem_t problem_;
+    ///
+    /// Only its data can be modified, through the rebinding methods.
+    problem_t problem_;
 
     /// \brief Solver parameters (run-time configuration).
     parameters_t parameters_;
 
+    /// \brief Whether the solver has been warm started.
+    bool warmStart_;
+
+    /// \brief Warm start multipliers.
+    vector_t warmStartMultipliers_;
+
     /// \brief Pointer to function logger (see log4cxx documentation).
     static log4cxx::LoggerPtr logger;
   };
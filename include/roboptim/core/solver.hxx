@@ -18,14 +18,74 @@
 #ifndef ROBOPTIM_CORE_SOLVER_HXX
 # define ROBOPTIM_CORE_SOLVER_HXX
 # include <boost/foreach.hpp>
+# include <boost/format.hpp>
 # include <roboptim/core/io.hh>
 
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \brief Copy the constraints data of a problem (no constraints).
+    template <typename F>
+    void rebindConstraints (Problem<F, boost::mpl::vector<> >&,
+			    const Problem<F, boost::mpl::vector<> >&)
+      throw (std::runtime_error)
+    {}
+
+    /// \brief Copy the constraints data of a problem.
+    template <typename F, typename CLIST>
+    void rebindConstraints (Problem<F, CLIST>& dst,
+			    const Problem<F, CLIST>& src)
+      throw (std::runtime_error)
+    {
+      if (src.constraints ().size () != dst.constraints ().size ())
+	{
+	  boost::format fmt
+	    ("Failed to rebind problem: invalid number of constraints"
+	     " (%d, expected %d)");
+	  fmt % src.constraints ().size () % dst.constraints ().size ();
+	  throw std::runtime_error (fmt.str ());
+	}
+
+      // Check all the constraints first: a failed rebind leaves the
+      // problem untouched.
+      for (std::size_t i = 0; i < src.constraints ().size (); ++i)
+	{
+	  if (!(src.constraints ()[i] == dst.constraints ()[i]))
+	    {
+	      boost::format fmt
+		("Failed to rebind problem: constraint %d is not the same"
+		 " function");
+	      fmt % i;
+	      throw std::runtime_error (fmt.str ());
+	    }
+	  if (src.boundsVector ()[i].size () != dst.boundsVector ()[i].size ()
+	      || src.scalesVector ()[i].size ()
+	      != dst.scalesVector ()[i].size ())
+	    {
+	      boost::format fmt
+		("Failed to rebind problem: invalid bounds or scales size"
+		 " for constraint %d");
+	      fmt % i;
+	      throw std::runtime_error (fmt.str ());
+	    }
+	}
+
+      for (std::size_t i = 0; i < src.constraints ().size (); ++i)
+	{
+	  dst.setConstraintBounds (i, src.boundsVector ()[i]);
+	  dst.setConstraintScales (i, src.scalesVector ()[i]);
+	}
+    }
+  } // end of namespace detail.
+
   template <typename F, typename C>
   Solver<F, C>::Solver (const problem_t& pb) throw ()
     : GenericSolver (),
-      problem_ (pb)
+      problem_ (pb),
+      parameters_ (),
+      warmStart_ (false),
+      warmStartMultipliers_ ()
   {
   }
 
@@ -33,7 +93,10 @@ namespace roboptim
   template <typename F_, typename C_>
   Solver<F, C>::Solver (const Problem<F_, C_>& pb) throw ()
     : GenericSolver (),
-      problem_ (pb)
+      problem_ (pb),
+      parameters_ (),
+      warmStart_ (false),
+      warmStartMultipliers_ ()
   {
   }
 
@@ -72,6 +135,139 @@ namespace roboptim
     return boost::get<T> (it->second.value);
   }
 
+  template <typename F, typename C>
+  template <typename T>
+  ParameterHandle<T, Parameter>
+  Solver<F, C>::registerParameter (const std::string& key,
+				   const std::string& description,
+				   const T& value)
+  {
+    return detail::registerParameter (parameters_, key, description, value);
+  }
+
+  template <typename F, typename C>
+  ParameterHandle<std::string, Parameter>
+  Solver<F, C>::registerParameter (const std::string& key,
+				   const std::string& description,
+				   const char* value)
+  {
+    return detail::registerParameter
+      (parameters_, key, description, std::string (value));
+  }
+
+  template <typename F, typename C>
+  template <typename T>
+  ParameterHandle<T, Parameter>
+  Solver<F, C>::parameterHandle (const std::string& key)
+  {
+    return ParameterHandle<T, Parameter> (parameters_, key);
+  }
+
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::setStartingPoint (const vector_t& x)
+    throw (std::runtime_error)
+  {
+    if (x.size () != problem_.function ().inputSize ())
+      {
+	boost::format fmt
+	  ("Failed to set starting point: invalid size (%d, expected %d)");
+	fmt % x.size () % problem_.function ().inputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+    problem_.startingPoint () = x;
+    this->reset ();
+    impl_rebind ();
+  }
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::setArgumentBounds (const intervals_t& bounds)
+    throw (std::runtime_error)
+  {
+    if (bounds.size () != problem_.argumentBounds ().size ())
+      {
+	boost::format fmt
+	  ("Failed to set argument bounds: invalid size (%d, expected %d)");
+	fmt % bounds.size () % problem_.argumentBounds ().size ();
+	throw std::runtime_error (fmt.str ());
+      }
+    problem_.argumentBounds () = bounds;
+    this->reset ();
+    impl_rebind ();
+  }
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::setConstraintBounds (std::size_t constraintId,
+				     const intervals_t& bounds)
+    throw (std::runtime_error)
+  {
+    problem_.setConstraintBounds (constraintId, bounds);
+    this->reset ();
+    impl_rebind ();
+  }
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::rebind (const problem_t& pb) throw (std::runtime_error)
+  {
+    if (&pb.function () != &problem_.function ())
+      throw std::runtime_error
+	("Failed to rebind problem: the cost function is not the same");
+    if (pb.argumentBounds ().size () != problem_.argumentBounds ().size ()
+	|| pb.argumentScales ().size () != problem_.argumentScales ().size ())
+      throw std::runtime_error
+	("Failed to rebind problem: invalid argument bounds or scales size");
+
+    detail::rebindConstraints (problem_, pb);
+    problem_.argumentBounds () = pb.argumentBounds ();
+    problem_.argumentScales () = pb.argumentScales ();
+    problem_.startingPoint () = pb.startingPoint ();
+    this->reset ();
+    impl_rebind ();
+  }
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::warmStart (const Result& result) throw (std::runtime_error)
+  {
+    if (result.x.size () != problem_.function ().inputSize ())
+      {
+	boost::format fmt
+	  ("Failed to warm start: invalid argument size (%d, expected %d)");
+	fmt % result.x.size () % problem_.function ().inputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+    problem_.startingPoint () = result.x;
+    warmStartMultipliers_ = result.lambda;
+    warmStart_ = true;
+    this->reset ();
+    impl_warmStart (result);
+  }
+
+  template <typename F, typename C>
+  void
+  Solver<F, C>::clearWarmStart () throw ()
+  {
+    warmStart_ = false;
+    warmStartMultipliers_.resize (0);
+  }
+
+  template <typename F, typename C>
+  bool
+  Solver<F, C>::hasWarmStart () const throw ()
+  {
+    return warmStart_;
+  }
+
+  template <typename F, typename C>
+  const typename Solver<F, C>::vector_t&
+  Solver<F, C>::warmStartMultipliers () const throw ()
+  {
+    return warmStartMultipliers_;
+  }
 
   template <typename F, typename C>
   std::ostream&
@@ -54,6 +54,7 @@ namespace roboptim {
     typedef typename parent_t::size_type size_type;
     typedef typename parent_t::value_type value_t;
     typedef typename parent_t::result_t result_t;
+    typedef typename parent_t::result_ref result_ref;
     /// @}
     /// \brief Constructor by vector valued functions
     /// The value of this scalar valued function is the sum of the
@@ -66,6 +67,11 @@ namespace roboptim {
 
     virtual ~GenericSumOfC1Squares () throw ();
 
+    std::size_t version () const throw ()
+    {
+      return parent_t::version () + baseFunction_->version ();
+    }
+
     /// \brief Get base function
     /// Base function is the vector valued function given at construction
     /// of this class.
@@ -74,7 +80,7 @@ namespace roboptim {
     /// \brief Compute value of function
     /// Value is sum of squares of coordinates of vector valued base function
     virtual void
-      impl_compute (result_t &result, const argument_t &x) const throw ();
+      impl_compute (result_ref result, const argument_t &x) const throw ();
     /// \brief Gradient
     virtual void
       impl_gradient (gradient_t& gradient, const argument_t& x,
@@ -62,7 +62,7 @@ namespace roboptim {
 
   template <typename T>
   void GenericSumOfC1Squares<T>::
-  impl_compute(result_t &result, const argument_t &x) const throw ()
+  impl_compute(result_ref result, const argument_t &x) const throw ()
   {
 #ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
     Eigen::internal::set_is_malloc_allowed (true);
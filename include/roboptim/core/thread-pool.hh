@@ -0,0 +1,123 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_THREAD_POOL_HH
+# define ROBOPTIM_CORE_THREAD_POOL_HH
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+
+# include <cstddef>
+# include <deque>
+# include <stdexcept>
+# include <string>
+
+# include <boost/function.hpp>
+# include <boost/noncopyable.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/thread.hpp>
+
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_meta_function
+  /// @{
+
+  /// \brief Fixed-size pool of worker threads.
+  ///
+  /// The pool executes batches of independent tasks. A batch is a
+  /// function called once for each index in [0, n), the calling
+  /// thread blocks until the whole batch is done.
+  ///
+  /// While waiting, the calling thread executes the pending tasks of
+  /// its own batch, never the tasks of other batches: a thread in the
+  /// middle of a filter evaluation does not start an unrelated
+  /// evaluation of the same filter. As a consequence, batches can be
+  /// nested (a task can itself run a batch on the same pool) without
+  /// dead-locking the pool.
+  ///
+  /// Tasks must not throw: RobOptim functions do not throw while
+  /// being evaluated. If a task throws anyway, the error is reported
+  /// to the caller as a std::runtime_error once the batch is done.
+  class ROBOPTIM_DLLAPI ThreadPool : public boost::noncopyable
+  {
+  public:
+    /// \brief Task type: called with the index of the task in its batch.
+    typedef boost::function<void (std::size_t)> task_t;
+
+    /// \brief Create a pool of worker threads.
+    ///
+    /// \param nThreads number of worker threads, if zero the number
+    /// of hardware threads minus one is used (the calling thread
+    /// also works).
+    explicit ThreadPool (std::size_t nThreads = 0);
+
+    /// \brief Stop and join the worker threads.
+    ///
+    /// Pending batches are processed before the threads stop.
+    ~ThreadPool () throw ();
+
+    /// \brief Number of worker threads.
+    std::size_t size () const throw ();
+
+    /// \brief Call task (i) for all i in [0, n) and wait.
+    ///
+    /// \param n number of tasks
+    /// \param task task to execute
+    void run (std::size_t n, const task_t& task)
+      throw (std::runtime_error);
+
+    /// \brief Process-wide pool shared by default by parallel filters.
+    static ThreadPool& global ();
+
+  private:
+    struct Batch;
+
+    /// \brief Worker thread main loop.
+    void work ();
+
+    /// \brief Execute the next task of a batch and update it.
+    ///
+    /// The mutex must be locked when calling this method, it is
+    /// unlocked while the task runs.
+    void execute (boost::unique_lock<boost::mutex>& lock, Batch& batch);
+
+    /// \brief Batches with tasks not started yet.
+    std::deque<Batch*> queue_;
+
+    /// \brief Protect the queue and the batches.
+    boost::mutex mutex_;
+
+    /// \brief Notified when tasks are queued.
+    boost::condition_variable taskQueued_;
+
+    /// \brief Ask the workers to stop.
+    bool stop_;
+
+    /// \brief Worker threads.
+    boost::thread_group threads_;
+
+    /// \brief Number of worker threads.
+    std::size_t size_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_THREAD_POOL_HH
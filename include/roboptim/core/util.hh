@@ -45,6 +45,16 @@ namespace roboptim
     jacobian_from_gradients (typename DifferentiableFunction::matrix_t& jac,
                              const std::vector<const T*>& c,
                              const DifferentiableFunction::vector_t& x);
+
+    /// \internal
+    /// \brief Deleter for shared pointers which do not own the object
+    /// (i.e. to pass a function held by reference to a filter).
+    struct NullDeleter
+    {
+      template <typename T>
+      void operator () (T*) const
+      {}
+    };
   } // end of namespace detail.
 
   /// \brief Display a vector.
@@ -0,0 +1,52 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <boost/make_shared.hpp>
+
+#include "roboptim/core/async-solver.hh"
+
+namespace roboptim
+{
+  CancellationToken::State::State ()
+    : mutex (),
+      changed (),
+      cancelled (false)
+  {}
+
+  CancellationToken::CancellationToken ()
+    : state_ (boost::make_shared<State> ())
+  {}
+
+  void
+  CancellationToken::cancel () throw ()
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (state_->mutex);
+      state_->cancelled = true;
+    }
+    state_->changed.notify_all ();
+  }
+
+  bool
+  CancellationToken::cancelled () const throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (state_->mutex);
+    return state_->cancelled;
+  }
+} // end of namespace roboptim
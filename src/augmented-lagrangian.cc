@@ -0,0 +1,233 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <cmath>
+
+#include <boost/format.hpp>
+
+#include "roboptim/core/augmented-lagrangian.hh"
+#include "roboptim/core/detail/workspace.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Number of rows of stacked constraints.
+    Function::size_type
+    countRows (const AugmentedLagrangianResidual::constraints_t& constraints)
+    {
+      Function::size_type rows = 0;
+      for (std::size_t i = 0; i < constraints.size (); ++i)
+	rows += constraints[i]->outputSize ();
+      return rows;
+    }
+  } // end of anonymous namespace.
+
+  AugmentedLagrangianResidual::AugmentedLagrangianResidual
+  (size_type inputSize,
+   const constraints_t& constraints,
+   const bounds_t& bounds)
+    throw (std::runtime_error)
+    : DifferentiableFunction (inputSize, countRows (constraints),
+			      "augmented Lagrangian residual"),
+      constraints_ (constraints),
+      rows_ (),
+      offsets_ (),
+      lower_ (),
+      upper_ (),
+      multipliers_ (),
+      penalty_ (1.)
+  {
+    if (constraints.size () != bounds.size ())
+      throw std::runtime_error ("constraints and bounds size mismatch");
+
+    size_type rows = 0;
+    for (std::size_t i = 0; i < constraints_.size (); ++i)
+      {
+	if (constraints_[i]->inputSize () != inputSize)
+	  {
+	    boost::format fmt
+	      ("constraint %d has an invalid input size (%d, expected %d)");
+	    fmt % i % constraints_[i]->inputSize () % inputSize;
+	    throw std::runtime_error (fmt.str ());
+	  }
+	if (static_cast<size_type> (bounds[i].size ())
+	    != constraints_[i]->outputSize ())
+	  {
+	    boost::format fmt
+	      ("constraint %d has invalid bounds (%d rows, expected %d)");
+	    fmt % i % bounds[i].size () % constraints_[i]->outputSize ();
+	    throw std::runtime_error (fmt.str ());
+	  }
+	offsets_.push_back (rows);
+	for (size_type k = 0; k < constraints_[i]->outputSize (); ++k)
+	  rows_.push_back (std::make_pair (i, k));
+	rows += constraints_[i]->outputSize ();
+      }
+
+    lower_.resize (rows);
+    upper_.resize (rows);
+    for (std::size_t i = 0; i < constraints_.size (); ++i)
+      for (std::size_t k = 0; k < bounds[i].size (); ++k)
+	{
+	  const size_type row = offsets_[i] + static_cast<size_type> (k);
+	  lower_[row] = bounds[i][k].first;
+	  upper_[row] = bounds[i][k].second;
+	}
+
+    multipliers_.resize (rows);
+    multipliers_.setZero ();
+  }
+
+  AugmentedLagrangianResidual::~AugmentedLagrangianResidual () throw ()
+  {
+  }
+
+  void
+  AugmentedLagrangianResidual::setMultipliers (const vector_t& multipliers)
+    throw (std::runtime_error)
+  {
+    if (multipliers.size () != outputSize ())
+      {
+	boost::format fmt
+	  ("invalid multipliers size (%d, expected %d)");
+	fmt % multipliers.size () % outputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+    multipliers_ = multipliers;
+    touch ();
+  }
+
+  void
+  AugmentedLagrangianResidual::setBounds (const vector_t& lower,
+					  const vector_t& upper)
+    throw (std::runtime_error)
+  {
+    if (lower.size () != outputSize () || upper.size () != outputSize ())
+      {
+	boost::format fmt
+	  ("invalid bounds size (%d and %d, expected %d)");
+	fmt % lower.size () % upper.size () % outputSize ();
+	throw std::runtime_error (fmt.str ());
+      }
+    lower_ = lower;
+    upper_ = upper;
+    touch ();
+  }
+
+  void
+  AugmentedLagrangianResidual::setPenalty (value_type penalty)
+    throw (std::runtime_error)
+  {
+    if (!(penalty > 0.))
+      throw std::runtime_error ("the penalty must be positive");
+    penalty_ = penalty;
+    touch ();
+  }
+
+  std::size_t
+  AugmentedLagrangianResidual::version () const throw ()
+  {
+    std::size_t version = DifferentiableFunction::version ();
+    for (std::size_t i = 0; i < constraints_.size (); ++i)
+      version += constraints_[i]->version ();
+    return version;
+  }
+
+  void
+  AugmentedLagrangianResidual::constraints (result_ref result,
+					    const argument_t& x)
+    const throw ()
+  {
+    for (std::size_t i = 0; i < constraints_.size (); ++i)
+      (*constraints_[i])
+	(result.segment (offsets_[i], constraints_[i]->outputSize ()), x);
+  }
+
+  bool
+  AugmentedLagrangianResidual::outside (size_type row, value_type value)
+    const throw ()
+  {
+    const value_type shifted = value + multipliers_[row] / penalty_;
+    return shifted < lower_[row] || shifted > upper_[row];
+  }
+
+  void
+  AugmentedLagrangianResidual::impl_compute (result_ref result,
+					     const argument_t& x)
+    const throw ()
+  {
+    constraints (result, x);
+    const value_type scale = std::sqrt (penalty_);
+    for (size_type row = 0; row < outputSize (); ++row)
+      {
+	const value_type shifted = result[row] + multipliers_[row] / penalty_;
+	const value_type projected =
+	  std::min (std::max (shifted, lower_[row]), upper_[row]);
+	result[row] = scale * (shifted - projected);
+      }
+  }
+
+  void
+  AugmentedLagrangianResidual::impl_gradient (gradient_t& gradient,
+					      const argument_t& x,
+					      size_type functionId)
+    const throw ()
+  {
+    // Only the constraint owning the row is evaluated.
+    const std::size_t i = rows_[static_cast<std::size_t> (functionId)].first;
+    const size_type k = rows_[static_cast<std::size_t> (functionId)].second;
+
+    detail::ScopedBuffer<result_t> value (constraints_[i]->outputSize ());
+    (*constraints_[i]) (*value, x);
+    if (!outside (functionId, (*value)[k]))
+      {
+	gradient.setZero ();
+	return;
+      }
+    constraints_[i]->gradient (gradient, x, k);
+    gradient *= std::sqrt (penalty_);
+  }
+
+  void
+  AugmentedLagrangianResidual::impl_jacobian (jacobian_ref jacobian,
+					      const argument_t& x)
+    const throw ()
+  {
+    const value_type scale = std::sqrt (penalty_);
+    for (std::size_t i = 0; i < constraints_.size (); ++i)
+      {
+	const size_type rows = constraints_[i]->outputSize ();
+	detail::ScopedBuffer<result_t> value (rows);
+	detail::ScopedBuffer<jacobian_t> block (rows, inputSize ());
+	(*constraints_[i]) (*value, x);
+	block->setZero ();
+	constraints_[i]->jacobian (*block, x);
+	for (size_type k = 0; k < rows; ++k)
+	  {
+	    const size_type row = offsets_[i] + k;
+	    if (outside (row, (*value)[k]))
+	      jacobian.row (row) = scale * block->row (k);
+	    else
+	      jacobian.row (row).setZero ();
+	  }
+      }
+  }
+
+} // end of namespace roboptim
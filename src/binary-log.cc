@@ -0,0 +1,367 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+#include <boost/format.hpp>
+
+#include "roboptim/core/binary-log.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    const char magic[8] = { 'R', 'O', 'B', 'O', 'P', 'T', 'L', 'G' };
+    const boost::uint32_t version = 1;
+    const boost::uint32_t byteOrderMark = 0x01020304;
+
+    template <typename T>
+    void writeValue (std::ostream& stream, const T& value)
+    {
+      stream.write (reinterpret_cast<const char*> (&value), sizeof (T));
+    }
+
+    template <typename T>
+    T readValue (std::istream& stream)
+    {
+      T value = T ();
+      stream.read (reinterpret_cast<char*> (&value), sizeof (T));
+      return value;
+    }
+
+    /// \brief Copy a value into a record buffer and move the cursor.
+    template <typename T>
+    void pack (char*& cursor, const T& value)
+    {
+      std::memcpy (cursor, &value, sizeof (T));
+      cursor += sizeof (T);
+    }
+
+    /// \brief Read a value from a record buffer and move the cursor.
+    template <typename T>
+    T unpack (const char*& cursor)
+    {
+      T value;
+      std::memcpy (&value, cursor, sizeof (T));
+      cursor += sizeof (T);
+      return value;
+    }
+  } // end of anonymous namespace.
+
+  BinaryLogSchema::size_type
+  BinaryLogSchema::constraintsOutputSize () const throw ()
+  {
+    size_type size = 0;
+    for (std::size_t i = 0; i < constraintsSizes.size (); ++i)
+      size += constraintsSizes[i];
+    return size;
+  }
+
+  std::size_t
+  BinaryLogSchema::recordSize () const throw ()
+  {
+    return sizeof (boost::uint64_t)
+      + 2 * sizeof (double)
+      + static_cast<std::size_t> (inputSize + constraintsOutputSize ())
+      * sizeof (double)
+      + sizeof (boost::uint64_t)
+      + jacobianCapacity * (2 * sizeof (boost::uint32_t) + sizeof (double));
+  }
+
+  BinaryLogWriter::BinaryLogWriter (const std::string& filename,
+				    const BinaryLogSchema& schema)
+    throw (std::runtime_error)
+    : schema_ (schema),
+      stream_ (filename.c_str (),
+	       std::ios::out | std::ios::binary | std::ios::trunc),
+      buffer_ (schema.recordSize ()),
+      size_ (0)
+  {
+    if (!stream_)
+      throw std::runtime_error
+	((boost::format ("failed to open binary log %1%") % filename).str ());
+    if (schema_.constraintsNames.size () != schema_.constraintsSizes.size ())
+      throw std::runtime_error
+	("constraints names and sizes mismatch in binary log schema");
+
+    std::size_t headerSize =
+      sizeof (magic) + 2 * sizeof (boost::uint32_t)
+      + 5 * sizeof (boost::uint64_t);
+    for (std::size_t i = 0; i < schema_.constraintsNames.size (); ++i)
+      headerSize += 2 * sizeof (boost::uint64_t)
+	+ schema_.constraintsNames[i].size ();
+
+    stream_.write (magic, sizeof (magic));
+    writeValue (stream_, version);
+    writeValue (stream_, byteOrderMark);
+    writeValue (stream_, static_cast<boost::uint64_t> (headerSize));
+    writeValue (stream_, static_cast<boost::uint64_t> (schema_.recordSize ()));
+    writeValue (stream_, static_cast<boost::uint64_t> (schema_.inputSize));
+    writeValue (stream_,
+		static_cast<boost::uint64_t> (schema_.jacobianCapacity));
+    writeValue (stream_,
+	   static_cast<boost::uint64_t> (schema_.constraintsNames.size ()));
+    for (std::size_t i = 0; i < schema_.constraintsNames.size (); ++i)
+      {
+	const std::string& name = schema_.constraintsNames[i];
+	writeValue (stream_, static_cast<boost::uint64_t>
+	       (schema_.constraintsSizes[i]));
+	writeValue (stream_, static_cast<boost::uint64_t> (name.size ()));
+	stream_.write (name.data (), static_cast<std::streamsize> (name.size ()));
+      }
+
+    if (!stream_)
+      throw std::runtime_error
+	((boost::format ("failed to write binary log %1%") % filename).str ());
+  }
+
+  BinaryLogWriter::~BinaryLogWriter () throw ()
+  {}
+
+  void
+  BinaryLogWriter::append (const BinaryLogRecord& record)
+    throw (std::runtime_error)
+  {
+    if (record.x.size () != schema_.inputSize)
+      throw std::runtime_error
+	((boost::format ("binary log record has %1% variables instead of %2%")
+	  % record.x.size () % schema_.inputSize).str ());
+    if (record.constraints.size () != schema_.constraintsOutputSize ())
+      throw std::runtime_error
+	((boost::format
+	  ("binary log record has %1% constraints values instead of %2%")
+	  % record.constraints.size ()
+	  % schema_.constraintsOutputSize ()).str ());
+    if (record.jacobian.size () > schema_.jacobianCapacity)
+      throw std::runtime_error
+	((boost::format
+	  ("binary log record has %1% jacobian nonzeros, capacity is %2%")
+	  % record.jacobian.size () % schema_.jacobianCapacity).str ());
+
+    const std::size_t capacity = schema_.jacobianCapacity;
+    const std::size_t nnz = record.jacobian.size ();
+
+    std::fill (buffer_.begin (), buffer_.end (), 0);
+    char* cursor = &buffer_[0];
+    pack (cursor, record.iteration);
+    pack (cursor, record.cost);
+    pack (cursor, record.constraintViolation);
+    for (BinaryLogRecord::size_type i = 0; i < record.x.size (); ++i)
+      pack (cursor, record.x[i]);
+    for (BinaryLogRecord::size_type i = 0; i < record.constraints.size (); ++i)
+      pack (cursor, record.constraints[i]);
+    pack (cursor, static_cast<boost::uint64_t> (nnz));
+
+    char* rows = cursor;
+    char* cols = rows + capacity * sizeof (boost::uint32_t);
+    char* values = cols + capacity * sizeof (boost::uint32_t);
+    for (std::size_t k = 0; k < nnz; ++k)
+      {
+	const BinaryLogRecord::triplet_t& triplet = record.jacobian[k];
+	pack (rows, static_cast<boost::uint32_t> (triplet.row ()));
+	pack (cols, static_cast<boost::uint32_t> (triplet.col ()));
+	pack (values, triplet.value ());
+      }
+
+    stream_.write (&buffer_[0], static_cast<std::streamsize> (buffer_.size ()));
+    if (!stream_)
+      throw std::runtime_error ("failed to append a binary log record");
+    ++size_;
+  }
+
+  void
+  BinaryLogWriter::flush () throw (std::runtime_error)
+  {
+    stream_.flush ();
+    if (!stream_)
+      throw std::runtime_error ("failed to flush binary log");
+  }
+
+  BinaryLogReader::BinaryLogReader (const std::string& filename)
+    throw (std::runtime_error)
+    : filename_ (filename),
+      schema_ (),
+      stream_ (filename.c_str (), std::ios::in | std::ios::binary),
+      headerSize_ (0),
+      buffer_ ()
+  {
+    if (!stream_)
+      throw std::runtime_error
+	((boost::format ("failed to open binary log %1%") % filename).str ());
+
+    char header[sizeof (magic)];
+    stream_.read (header, sizeof (header));
+    if (!stream_ || std::memcmp (header, magic, sizeof (magic)) != 0)
+      throw std::runtime_error
+	((boost::format ("%1% is not a binary log") % filename).str ());
+
+    const boost::uint32_t fileVersion = readValue<boost::uint32_t> (stream_);
+    if (fileVersion != version)
+      throw std::runtime_error
+	((boost::format ("unsupported binary log version %1%")
+	  % fileVersion).str ());
+    if (readValue<boost::uint32_t> (stream_) != byteOrderMark)
+      throw std::runtime_error
+	("binary log written with another byte order");
+
+    headerSize_ =
+      static_cast<std::size_t> (readValue<boost::uint64_t> (stream_));
+    const std::size_t recordSize =
+      static_cast<std::size_t> (readValue<boost::uint64_t> (stream_));
+    schema_.inputSize =
+      static_cast<BinaryLogSchema::size_type>
+      (readValue<boost::uint64_t> (stream_));
+    schema_.jacobianCapacity =
+      static_cast<std::size_t> (readValue<boost::uint64_t> (stream_));
+    const std::size_t nConstraints =
+      static_cast<std::size_t> (readValue<boost::uint64_t> (stream_));
+    for (std::size_t i = 0; i < nConstraints && stream_; ++i)
+      {
+	schema_.constraintsSizes.push_back
+	  (static_cast<BinaryLogSchema::size_type>
+	   (readValue<boost::uint64_t> (stream_)));
+	std::string name
+	  (static_cast<std::size_t> (readValue<boost::uint64_t> (stream_)), '\0');
+	if (!name.empty ())
+	  stream_.read (&name[0], static_cast<std::streamsize> (name.size ()));
+	schema_.constraintsNames.push_back (name);
+      }
+
+    if (!stream_ || recordSize != schema_.recordSize ())
+      throw std::runtime_error
+	((boost::format ("corrupted binary log header in %1%")
+	  % filename).str ());
+    buffer_.resize (recordSize);
+  }
+
+  BinaryLogReader::~BinaryLogReader () throw ()
+  {}
+
+  std::size_t
+  BinaryLogReader::size () throw (std::runtime_error)
+  {
+    stream_.clear ();
+    stream_.seekg (0, std::ios::end);
+    const std::streamoff fileSize = stream_.tellg ();
+    if (fileSize < 0)
+      throw std::runtime_error
+	((boost::format ("failed to read binary log %1%") % filename_).str ());
+    if (static_cast<std::size_t> (fileSize) < headerSize_)
+      return 0;
+    return (static_cast<std::size_t> (fileSize) - headerSize_)
+      / buffer_.size ();
+  }
+
+  void
+  BinaryLogReader::read (std::size_t i, BinaryLogRecord& record)
+    throw (std::runtime_error)
+  {
+    stream_.clear ();
+    stream_.seekg
+      (static_cast<std::streamoff> (headerSize_ + i * buffer_.size ()));
+    stream_.read (&buffer_[0], static_cast<std::streamsize> (buffer_.size ()));
+    if (!stream_)
+      throw std::runtime_error
+	((boost::format ("failed to read record %1% of binary log %2%")
+	  % i % filename_).str ());
+
+    const std::size_t capacity = schema_.jacobianCapacity;
+
+    const char* cursor = &buffer_[0];
+    record.iteration = unpack<boost::uint64_t> (cursor);
+    record.cost = unpack<double> (cursor);
+    record.constraintViolation = unpack<double> (cursor);
+    record.x.resize (schema_.inputSize);
+    for (BinaryLogRecord::size_type k = 0; k < record.x.size (); ++k)
+      record.x[k] = unpack<double> (cursor);
+    record.constraints.resize (schema_.constraintsOutputSize ());
+    for (BinaryLogRecord::size_type k = 0; k < record.constraints.size (); ++k)
+      record.constraints[k] = unpack<double> (cursor);
+
+    const std::size_t nnz =
+      static_cast<std::size_t> (unpack<boost::uint64_t> (cursor));
+    if (nnz > capacity)
+      throw std::runtime_error
+	((boost::format ("corrupted record %1% in binary log %2%")
+	  % i % filename_).str ());
+
+    const char* rows = cursor;
+    const char* cols = rows + capacity * sizeof (boost::uint32_t);
+    const char* values = cols + capacity * sizeof (boost::uint32_t);
+    record.jacobian.clear ();
+    record.jacobian.reserve (nnz);
+    for (std::size_t k = 0; k < nnz; ++k)
+      {
+	const int row = static_cast<int> (unpack<boost::uint32_t> (rows));
+	const int col = static_cast<int> (unpack<boost::uint32_t> (cols));
+	record.jacobian.push_back
+	  (BinaryLogRecord::triplet_t (row, col, unpack<double> (values)));
+      }
+  }
+
+  void
+  BinaryLogReader::exportCsv (std::ostream& stream) throw (std::runtime_error)
+  {
+    stream << "Iteration, Cost, Constraint violation";
+    for (BinaryLogSchema::size_type i = 0; i < schema_.inputSize; ++i)
+      stream << ", X " << i;
+    for (std::size_t c = 0; c < schema_.constraintsSizes.size (); ++c)
+      for (BinaryLogSchema::size_type i = 0;
+	   i < schema_.constraintsSizes[c]; ++i)
+	stream << ", constraint " << c << " output " << i;
+    stream << "\n";
+
+    BinaryLogRecord record;
+    const std::size_t n = size ();
+    for (std::size_t k = 0; k < n; ++k)
+      {
+	read (k, record);
+	stream << record.iteration
+	       << ", " << record.cost
+	       << ", " << record.constraintViolation;
+	for (BinaryLogRecord::size_type i = 0; i < record.x.size (); ++i)
+	  stream << ", " << record.x[i];
+	for (BinaryLogRecord::size_type i = 0;
+	     i < record.constraints.size (); ++i)
+	  stream << ", " << record.constraints[i];
+	stream << "\n";
+      }
+  }
+
+  void
+  BinaryLogReader::exportJacobianCsv (std::ostream& stream)
+    throw (std::runtime_error)
+  {
+    stream << "Iteration, Row, Column, Value\n";
+
+    BinaryLogRecord record;
+    const std::size_t n = size ();
+    for (std::size_t k = 0; k < n; ++k)
+      {
+	read (k, record);
+	for (std::size_t i = 0; i < record.jacobian.size (); ++i)
+	  stream << record.iteration
+		 << ", " << record.jacobian[i].row ()
+		 << ", " << record.jacobian[i].col ()
+		 << ", " << record.jacobian[i].value () << "\n";
+      }
+  }
+} // end of namespace roboptim.
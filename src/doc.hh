@@ -140,7 +140,7 @@ struct F : public TwiceDifferentiableFunction
   }
 
   void
-  impl_compute (result_t& result, const argument_t& x) const throw ()
+  impl_compute (result_ref result, const argument_t& x) const throw ()
   {
     result (0) = x[0] * x[3] * (x[0] + x[1] + x[2]) + x[3];
   }
@@ -197,7 +197,7 @@ struct G0 : public TwiceDifferentiableFunction
   }
 
   void
-  impl_compute (result_t& result, const argument_t& x) const throw ()
+  impl_compute (result_ref result, const argument_t& x) const throw ()
   {
     result (0) = x[0] * x[1] * x[2] * x[3];
   }
@@ -243,7 +243,7 @@ struct G1 : public TwiceDifferentiableFunction
   }
 
   void
-  impl_compute (result_t& result, const argument_t& x) const throw ()
+  impl_compute (result_ref result, const argument_t& x) const throw ()
   {
     result (0) = x[0]*x[0] + x[1]*x[1] + x[2]*x[2] + x[3]*x[3];
   }
@@ -0,0 +1,202 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+#include <Eigen/Cholesky>
+
+#include "roboptim/core/function.hh"
+#include "roboptim/core/problem.hh"
+#include "roboptim/core/plugin/gauss-newton.hh"
+
+namespace roboptim
+{
+  GaussNewtonSolver::GaussNewtonSolver (const problem_t& pb) throw ()
+    : boundConstrainedSolver_t (pb, 100, 1e-6),
+      damping_ (),
+      lastDamping_ (-1.)
+  {
+    damping_ = registerParameter
+      ("gauss-newton.damping",
+       "initial damping (relative to the largest diagonal element of J^T J)",
+       1e-3);
+  }
+
+  GaussNewtonSolver::~GaussNewtonSolver () throw ()
+  {
+  }
+
+  void
+  GaussNewtonSolver::resolveParameters ()
+  {
+    boundConstrainedSolver_t::resolveParameters ();
+    damping_ = parameterHandle<value_type> ("gauss-newton.damping");
+  }
+
+  GaussNewtonSolver::Termination
+  GaussNewtonSolver::minimize (vector_t& x)
+  {
+    typedef DifferentiableFunction::matrix_t matrix_t;
+
+    const DifferentiableFunction& residuals =
+      *problem ().function ().baseFunction ();
+    const size_type n = residuals.inputSize ();
+    const size_type m = residuals.outputSize ();
+
+    vector_t r (m);
+    vector_t rNext (m);
+    matrix_t jacobian (m, n);
+    matrix_t normal (n, n);
+    vector_t gradient (n);
+    vector_t xNext (n);
+    vector_t step (n);
+
+    residuals (r, x);
+    value_type cost = r.squaredNorm ();
+    jacobian.setZero ();
+    residuals.jacobian (jacobian, x);
+    normal = jacobian.transpose () * jacobian;
+    gradient = 2. * jacobian.transpose () * r;
+
+    const value_type tolerance = *tolerance_;
+    const value_type scale =
+      std::max (normal.diagonal ().maxCoeff (), value_type (1.));
+    value_type mu = (hasWarmStart () && lastDamping_ >= 0.)
+      ? lastDamping_ : std::max (*damping_, value_type (0.)) * scale;
+    value_type nu = 2.;
+
+    Termination termination = MAX_ITERATIONS;
+    for (int iteration = 0; ; ++iteration)
+      {
+	if (stationarity (x, gradient) <= tolerance)
+	  {
+	    termination = CONVERGED;
+	    break;
+	  }
+	if (iteration >= *maxIterations_)
+	  {
+	    termination = MAX_ITERATIONS;
+	    break;
+	  }
+
+	// The variables at a bound whose gradient points outside the
+	// bounds are fixed: their rows and columns are removed from
+	// the damped system.
+	matrix_t damped = normal;
+	damped.diagonal ().array () += mu;
+	vector_t rhs = -.5 * gradient;
+	for (size_type i = 0; i < n; ++i)
+	  if (!isFree (x, gradient, i))
+	    {
+	      damped.row (i).setZero ();
+	      damped.col (i).setZero ();
+	      damped (i, i) = 1.;
+	      rhs[i] = 0.;
+	    }
+	step = damped.ldlt ().solve (rhs);
+	if (!step.allFinite ())
+	  {
+	    // Singular Gauss-Newton system: fall back to damped steps.
+	    mu = std::max (mu * nu, scale * 1e-8);
+	    nu *= 2.;
+	    continue;
+	  }
+
+	xNext = x + step;
+	project (xNext);
+	step = xNext - x;
+	if (step.lpNorm<Eigen::Infinity> ()
+	    <= tolerance * (x.lpNorm<Eigen::Infinity> () + tolerance))
+	  {
+	    termination = CONVERGED;
+	    break;
+	  }
+
+	// Gain ratio between the actual and the predicted decrease.
+	residuals (rNext, xNext);
+	const value_type costNext = rNext.squaredNorm ();
+	const value_type predicted =
+	  cost - (r + jacobian * step).squaredNorm ();
+	const value_type gain =
+	  (predicted > 0.) ? (cost - costNext) / predicted : -1.;
+
+	if (gain <= 0.)
+	  {
+	    mu = (mu > 0.) ? mu * nu : scale * 1e-8;
+	    nu *= 2.;
+	    continue;
+	  }
+
+	const value_type t = 2. * gain - 1.;
+	mu *= std::max (1. / 3., 1. - t * t * t);
+	nu = 2.;
+
+	x = xNext;
+	r = rNext;
+	cost = costNext;
+	jacobian.setZero ();
+	residuals.jacobian (jacobian, x);
+	normal = jacobian.transpose () * jacobian;
+	gradient = 2. * jacobian.transpose () * r;
+
+	if (iterate (x, cost))
+	  {
+	    termination = STOPPED;
+	    break;
+	  }
+      }
+
+    lastDamping_ = mu;
+    return termination;
+  }
+
+} // end of namespace roboptim
+
+extern "C"
+{
+  using namespace roboptim;
+  typedef GaussNewtonSolver::parent_t solver_t;
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ();
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ();
+  ROBOPTIM_DLLEXPORT solver_t* create (const GaussNewtonSolver::problem_t& pb);
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p);
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ()
+  {
+    return sizeof (solver_t::problem_t);
+  }
+
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ()
+  {
+    return typeid (solver_t::problem_t::constraintsList_t).name ();
+  }
+
+  ROBOPTIM_DLLEXPORT solver_t* create (const GaussNewtonSolver::problem_t& pb)
+  {
+    return new GaussNewtonSolver (pb);
+  }
+
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p)
+  {
+    delete p;
+  }
+}
@@ -78,4 +78,21 @@ namespace roboptim
   {
     return o << "no solution";
   }
+
+  namespace detail
+  {
+    const Result*
+    solution (const GenericSolver::result_t& result) throw ()
+    {
+      switch (result.which ())
+	{
+	case GenericSolver::SOLVER_VALUE:
+	  return &boost::get<Result> (result);
+	case GenericSolver::SOLVER_VALUE_WARNINGS:
+	  return &boost::get<ResultWithWarnings> (result);
+	default:
+	  return 0;
+	}
+    }
+  } // end of namespace detail.
 } // end of namespace roboptim
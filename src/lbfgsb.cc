@@ -0,0 +1,244 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+#include <vector>
+
+#include "roboptim/core/function.hh"
+#include "roboptim/core/problem.hh"
+#include "roboptim/core/plugin/lbfgsb.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Sufficient decrease constant of the Armijo condition.
+    const Function::value_type armijo = 1e-4;
+    /// \brief Maximum number of step reductions per iteration.
+    const int maxBacktracking = 60;
+  } // end of anonymous namespace.
+
+  LbfgsbSolver::LbfgsbSolver (const problem_t& pb) throw ()
+    : boundConstrainedSolver_t (pb, 1000, 1e-6),
+      memory_ (),
+      s_ (),
+      y_ ()
+  {
+    memory_ = registerParameter
+      ("lbfgsb.memory", "number of curvature pairs kept", 10);
+  }
+
+  LbfgsbSolver::~LbfgsbSolver () throw ()
+  {
+  }
+
+  void
+  LbfgsbSolver::resolveParameters ()
+  {
+    boundConstrainedSolver_t::resolveParameters ();
+    memory_ = parameterHandle<int> ("lbfgsb.memory");
+  }
+
+  void
+  LbfgsbSolver::clearMemory () throw ()
+  {
+    s_.clear ();
+    y_.clear ();
+  }
+
+  void
+  LbfgsbSolver::searchDirection (vector_t& direction,
+				 const vector_t& x,
+				 const vector_t& gradient) const throw ()
+  {
+    const size_type n = x.size ();
+    const std::size_t m = s_.size ();
+
+    // The fixed variables are masked out of the recursion.
+    vector_t mask (n);
+    for (size_type i = 0; i < n; ++i)
+      mask[i] = isFree (x, gradient, i) ? 1. : 0.;
+
+    // Two-loop recursion. The pairs whose curvature vanishes on the
+    // free variables are skipped (zero rho).
+    std::vector<value_type> alpha (m, 0.);
+    std::vector<value_type> rho (m, 0.);
+    value_type gamma = 1.;
+    bool scaled = false;
+
+    vector_t q = mask.cwiseProduct (gradient);
+    for (std::size_t k = m; k-- > 0;)
+      {
+	const value_type sy = mask.cwiseProduct (s_[k]).dot (y_[k]);
+	if (sy <= 0.)
+	  continue;
+	rho[k] = 1. / sy;
+	alpha[k] = rho[k] * s_[k].dot (q);
+	q -= alpha[k] * mask.cwiseProduct (y_[k]);
+	if (!scaled)
+	  {
+	    gamma = sy / mask.cwiseProduct (y_[k]).squaredNorm ();
+	    scaled = true;
+	  }
+      }
+
+    direction = gamma * q;
+    for (std::size_t k = 0; k < m; ++k)
+      {
+	if (rho[k] == 0.)
+	  continue;
+	const value_type beta = rho[k] * y_[k].dot (direction);
+	direction += (alpha[k] - beta) * mask.cwiseProduct (s_[k]);
+      }
+    direction = -direction;
+  }
+
+  LbfgsbSolver::Termination
+  LbfgsbSolver::minimize (vector_t& x)
+  {
+    const DifferentiableFunction& f = problem ().function ();
+    const size_type n = f.inputSize ();
+    const std::size_t memory =
+      static_cast<std::size_t> (std::max (*memory_, 0));
+
+    // Only a warm-started solve reuses the curvature pairs.
+    if (!hasWarmStart ())
+      clearMemory ();
+    while (s_.size () > memory)
+      {
+	s_.pop_front ();
+	y_.pop_front ();
+      }
+
+    vector_t value (1);
+    vector_t gradient (n);
+    vector_t direction (n);
+    vector_t xNext (n);
+    vector_t gradientNext (n);
+
+    f (value, x);
+    value_type cost = value[0];
+    gradient.setZero ();
+    f.gradient (gradient, x, 0);
+
+    for (int iteration = 0; ; ++iteration)
+      {
+	if (stationarity (x, gradient) <= *tolerance_)
+	  return CONVERGED;
+	if (iteration >= *maxIterations_)
+	  return MAX_ITERATIONS;
+
+	searchDirection (direction, x, gradient);
+	if (gradient.dot (direction) >= 0.)
+	  {
+	    // Not a descent direction: restart from steepest descent.
+	    clearMemory ();
+	    searchDirection (direction, x, gradient);
+	  }
+
+	// Without curvature information, move each variable by at
+	// most one.
+	value_type step = s_.empty ()
+	  ? 1. / std::max (1., direction.lpNorm<Eigen::Infinity> ()) : 1.;
+
+	// Backtracking along the projection arc.
+	bool accepted = false;
+	for (int k = 0; k < maxBacktracking; ++k)
+	  {
+	    xNext = x + step * direction;
+	    project (xNext);
+	    f (value, xNext);
+	    if (value[0] <= cost + armijo * gradient.dot (xNext - x))
+	      {
+		accepted = true;
+		break;
+	      }
+	    step *= .5;
+	  }
+	if (!accepted || xNext == x)
+	  {
+	    // Retry once from steepest descent.
+	    if (s_.empty ())
+	      return STALLED;
+	    clearMemory ();
+	    continue;
+	  }
+
+	gradientNext.setZero ();
+	f.gradient (gradientNext, xNext, 0);
+
+	// Keep the pair if the curvature condition holds.
+	const vector_t s = xNext - x;
+	const vector_t y = gradientNext - gradient;
+	if (memory > 0
+	    && s.dot (y)
+	    > std::numeric_limits<value_type>::epsilon () * y.squaredNorm ())
+	  {
+	    s_.push_back (s);
+	    y_.push_back (y);
+	    if (s_.size () > memory)
+	      {
+		s_.pop_front ();
+		y_.pop_front ();
+	      }
+	  }
+
+	x = xNext;
+	gradient = gradientNext;
+	cost = value[0];
+
+	if (iterate (x, cost))
+	  return STOPPED;
+      }
+  }
+
+} // end of namespace roboptim
+
+extern "C"
+{
+  using namespace roboptim;
+  typedef LbfgsbSolver::parent_t solver_t;
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ();
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ();
+  ROBOPTIM_DLLEXPORT solver_t* create (const LbfgsbSolver::problem_t& pb);
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p);
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ()
+  {
+    return sizeof (solver_t::problem_t);
+  }
+
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ()
+  {
+    return typeid (solver_t::problem_t::constraintsList_t).name ();
+  }
+
+  ROBOPTIM_DLLEXPORT solver_t* create (const LbfgsbSolver::problem_t& pb)
+  {
+    return new LbfgsbSolver (pb);
+  }
+
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p)
+  {
+    delete p;
+  }
+}
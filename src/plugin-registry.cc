@@ -0,0 +1,241 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <sstream>
+#include <typeinfo>
+
+#include "roboptim/core/plugin-registry.hh"
+#include "roboptim/core/solver-factory.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Resolve a plug-in symbol.
+    void* symbol (lt_dlhandle handle, const char* name)
+      throw (std::runtime_error)
+    {
+      void* ptr = lt_dlsym (handle, name);
+      if (!ptr)
+	{
+	  std::stringstream sserror;
+	  sserror << "libltdl failed to find symbol ``" << name << "'': "
+		  << lt_dlerror ();
+	  throw std::runtime_error (sserror.str ());
+	}
+      return ptr;
+    }
+  } // end of anonymous namespace.
+
+  PluginRegistry::Plugin::Plugin ()
+    : name (),
+      handle (),
+      create (),
+      destroy (),
+      getSizeOfProblem (),
+      getTypeIdOfConstraintsList (),
+      references (0),
+      preloaded (false),
+      validated ()
+  {}
+
+  PluginRegistry::PluginRegistry ()
+    : plugins_ (),
+      mutex_ ()
+  {}
+
+  PluginRegistry::~PluginRegistry () throw ()
+  {
+    while (!plugins_.empty ())
+      close (plugins_.begin ());
+  }
+
+  PluginRegistry&
+  PluginRegistry::instance ()
+  {
+    static PluginRegistry registry;
+    return registry;
+  }
+
+  PluginRegistry::Plugin&
+  PluginRegistry::load (const std::string& name) throw (std::runtime_error)
+  {
+    plugins_t::iterator it = plugins_.find (name);
+    if (it != plugins_.end ())
+      return it->second;
+
+    if (lt_dlinit () > 0)
+      throw std::runtime_error ("failed to initialize libltdl.");
+
+    std::stringstream ss;
+    ss << "roboptim-core-plugin-" << name;
+    lt_dlhandle handle = lt_dlopenext (ss.str ().c_str ());
+    if (!handle)
+      {
+	std::stringstream sserror;
+	sserror << "libltdl failed to load plug-in ``"
+		<< ss.str () << "'': " << lt_dlerror ();
+	if (lt_dlexit ())
+	  sserror << " lt_dlexit failed too";
+	throw std::runtime_error (sserror.str ());
+      }
+
+    Plugin plugin;
+    plugin.name = name;
+    plugin.handle = handle;
+    try
+      {
+	plugin.getSizeOfProblem = symbol (handle, "getSizeOfProblem");
+	plugin.getTypeIdOfConstraintsList =
+	  symbol (handle, "getTypeIdOfConstraintsList");
+	plugin.create = symbol (handle, "create");
+	plugin.destroy = symbol (handle, "destroy");
+      }
+    catch (std::runtime_error& e)
+      {
+	std::stringstream sserror;
+	sserror << e.what ();
+	if (lt_dlclose (handle))
+	  sserror << " (lt_dlclose failed too)";
+	if (lt_dlexit ())
+	  sserror << " lt_dlexit failed too";
+	throw std::runtime_error (sserror.str ());
+      }
+
+    return plugins_.insert (std::make_pair (name, plugin)).first->second;
+  }
+
+  void
+  PluginRegistry::close (plugins_t::iterator it) throw ()
+  {
+    if (lt_dlclose (it->second.handle))
+      std::cerr << "libltdl failed to close plug-in ``"
+		<< it->first << "'': " << lt_dlerror () << std::endl;
+    if (lt_dlexit ())
+      std::cerr << "libltdl failed to call ``lt_dlexit'': "
+		<< lt_dlerror () << std::endl;
+    plugins_.erase (it);
+  }
+
+  const PluginRegistry::Plugin&
+  PluginRegistry::acquire (const std::string& name) throw (std::runtime_error)
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    Plugin& plugin = load (name);
+    ++plugin.references;
+    return plugin;
+  }
+
+  void
+  PluginRegistry::release (const Plugin& plugin) throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    plugins_t::iterator it = plugins_.find (plugin.name);
+    assert (it != plugins_.end () && it->second.references > 0);
+    if (--it->second.references == 0 && !it->second.preloaded)
+      close (it);
+  }
+
+  void
+  PluginRegistry::validate (const Plugin& plugin,
+			    std::size_t sizeOfProblem,
+			    const char* typeIdOfConstraintsList)
+    throw (std::runtime_error)
+  {
+    typedef std::size_t getsizeofproblem_t ();
+    typedef const char* gettypeidofconstraintslist_t ();
+
+    std::stringstream key;
+    key << sizeOfProblem << ":" << typeIdOfConstraintsList;
+
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    plugins_t::iterator it = plugins_.find (plugin.name);
+    assert (it != plugins_.end ());
+    Plugin& p = it->second;
+    if (p.validated.count (key.str ()))
+      return;
+
+    std::size_t pluginSizeOfProblem =
+      unionCast<getsizeofproblem_t> (p.getSizeOfProblem) ();
+    if (pluginSizeOfProblem != sizeOfProblem)
+      {
+	std::stringstream sserror;
+	sserror
+	  << "``Problem'' type size does not match in application and plug-in"
+	  << " (size is " << pluginSizeOfProblem
+	  << " byte(s) but " << sizeOfProblem
+	  << " byte(s) was expected by application)";
+	throw std::runtime_error (sserror.str ());
+      }
+
+    const std::string pluginTypeIdOfConstraintsList =
+      demangle (unionCast<gettypeidofconstraintslist_t>
+		(p.getTypeIdOfConstraintsList) ());
+    const std::string expectedTypeIdOfConstraintsList =
+      demangle (typeIdOfConstraintsList);
+    if (pluginTypeIdOfConstraintsList != expectedTypeIdOfConstraintsList)
+      {
+        std::stringstream sserror;
+        sserror
+          << "``Problem::constraintsList_t'' type id does not match in"
+          << " application and plug-in. Type id is:\n"
+          << pluginTypeIdOfConstraintsList
+          << "\nbut application expected:\n"
+          << expectedTypeIdOfConstraintsList;
+        throw std::runtime_error (sserror.str ());
+      }
+
+    p.validated.insert (key.str ());
+  }
+
+  void
+  PluginRegistry::preload (const std::string& name) throw (std::runtime_error)
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    load (name).preloaded = true;
+  }
+
+  void
+  PluginRegistry::unload (const std::string& name) throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    plugins_t::iterator it = plugins_.find (name);
+    if (it == plugins_.end ())
+      return;
+    it->second.preloaded = false;
+    if (it->second.references == 0)
+      close (it);
+  }
+
+  bool
+  PluginRegistry::isLoaded (const std::string& name) const throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    return plugins_.find (name) != plugins_.end ();
+  }
+
+  std::size_t
+  PluginRegistry::references (const std::string& name) const throw ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    plugins_t::const_iterator it = plugins_.find (name);
+    return it == plugins_.end () ? 0 : it->second.references;
+  }
+
+} // end of namespace roboptim
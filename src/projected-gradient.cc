@@ -0,0 +1,139 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "roboptim/core/function.hh"
+#include "roboptim/core/problem.hh"
+#include "roboptim/core/plugin/projected-gradient.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Sufficient decrease constant of the Armijo condition.
+    const Function::value_type armijo = 1e-4;
+    /// \brief Maximum number of step reductions per iteration.
+    const int maxBacktracking = 60;
+  } // end of anonymous namespace.
+
+  ProjectedGradientSolver::ProjectedGradientSolver (const problem_t& pb)
+    throw ()
+    : boundConstrainedSolver_t (pb, 1000, 1e-6)
+  {
+  }
+
+  ProjectedGradientSolver::~ProjectedGradientSolver () throw ()
+  {
+  }
+
+  ProjectedGradientSolver::Termination
+  ProjectedGradientSolver::minimize (vector_t& x)
+  {
+    const DifferentiableFunction& f = problem ().function ();
+    const size_type n = f.inputSize ();
+
+    vector_t value (1);
+    vector_t gradient (n);
+    vector_t xNext (n);
+    vector_t gradientNext (n);
+
+    f (value, x);
+    value_type cost = value[0];
+    gradient.setZero ();
+    f.gradient (gradient, x, 0);
+
+    // The first step moves each variable by at most one.
+    value_type step =
+      1. / std::max (1., gradient.lpNorm<Eigen::Infinity> ());
+
+    for (int iteration = 0; ; ++iteration)
+      {
+	if (stationarity (x, gradient) <= *tolerance_)
+	  return CONVERGED;
+	if (iteration >= *maxIterations_)
+	  return MAX_ITERATIONS;
+
+	// Backtracking along the projection arc.
+	bool accepted = false;
+	for (int k = 0; k < maxBacktracking; ++k)
+	  {
+	    xNext = x - step * gradient;
+	    project (xNext);
+	    f (value, xNext);
+	    if (value[0] <= cost + armijo * gradient.dot (xNext - x))
+	      {
+		accepted = true;
+		break;
+	      }
+	    step *= .5;
+	  }
+	if (!accepted || xNext == x)
+	  return STALLED;
+
+	gradientNext.setZero ();
+	f.gradient (gradientNext, xNext, 0);
+
+	// Barzilai-Borwein step for the next iteration.
+	const value_type ss = (xNext - x).squaredNorm ();
+	const value_type sy = (xNext - x).dot (gradientNext - gradient);
+	step = (sy > 0.) ? std::min (std::max (ss / sy, 1e-10), 1e10) : 1.;
+
+	x = xNext;
+	gradient = gradientNext;
+	cost = value[0];
+
+	if (iterate (x, cost))
+	  return STOPPED;
+      }
+  }
+
+} // end of namespace roboptim
+
+extern "C"
+{
+  using namespace roboptim;
+  typedef ProjectedGradientSolver::parent_t solver_t;
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ();
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ();
+  ROBOPTIM_DLLEXPORT solver_t* create (const ProjectedGradientSolver::problem_t& pb);
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p);
+
+  ROBOPTIM_DLLEXPORT std::size_t getSizeOfProblem ()
+  {
+    return sizeof (solver_t::problem_t);
+  }
+
+  ROBOPTIM_DLLEXPORT const char* getTypeIdOfConstraintsList ()
+  {
+    return typeid (solver_t::problem_t::constraintsList_t).name ();
+  }
+
+  ROBOPTIM_DLLEXPORT solver_t* create (const ProjectedGradientSolver::problem_t& pb)
+  {
+    return new ProjectedGradientSolver (pb);
+  }
+
+  ROBOPTIM_DLLEXPORT void destroy (solver_t* p)
+  {
+    delete p;
+  }
+}
@@ -0,0 +1,318 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+
+#include <boost/format.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include "roboptim/core/sampling.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Joe-Kuo initial direction numbers (new-joe-kuo-6.21201).
+    struct DirectionNumbers
+    {
+      /// \brief Primitive polynomial degree.
+      unsigned s;
+      /// \brief Primitive polynomial inner coefficients.
+      unsigned a;
+      /// \brief Initial direction numbers.
+      boost::uint32_t m[7];
+    };
+
+    const DirectionNumbers joeKuo[] =
+      {
+	{1, 0, {1}},
+	{2, 1, {1, 3}},
+	{3, 1, {1, 3, 1}},
+	{3, 2, {1, 1, 1}},
+	{4, 1, {1, 1, 3, 3}},
+	{4, 4, {1, 3, 5, 13}},
+	{5, 2, {1, 1, 5, 5, 17}},
+	{5, 4, {1, 1, 5, 5, 5}},
+	{5, 7, {1, 1, 7, 11, 19}},
+	{5, 11, {1, 1, 5, 1, 1}},
+	{5, 13, {1, 1, 1, 3, 11}},
+	{5, 14, {1, 3, 5, 5, 31}},
+	{6, 1, {1, 3, 3, 9, 7, 49}},
+	{6, 13, {1, 1, 1, 15, 21, 21}},
+	{6, 16, {1, 3, 1, 13, 27, 49}},
+	{6, 19, {1, 1, 1, 15, 7, 5}},
+	{6, 22, {1, 3, 1, 15, 13, 25}},
+	{6, 25, {1, 1, 5, 5, 19, 61}},
+	{7, 1, {1, 3, 7, 11, 23, 15, 103}},
+	{7, 4, {1, 3, 7, 13, 13, 15, 69}}
+      };
+
+    const std::size_t joeKuoSize = sizeof (joeKuo) / sizeof (joeKuo[0]);
+
+    /// \brief Product of two polynomials over GF(2), modulo p.
+    boost::uint64_t
+    mulMod (boost::uint64_t a, boost::uint64_t b,
+	    boost::uint64_t p, unsigned degree)
+    {
+      boost::uint64_t result = 0;
+      while (b)
+	{
+	  if (b & 1)
+	    result ^= a;
+	  b >>= 1;
+	  a <<= 1;
+	  if (a & (boost::uint64_t (1) << degree))
+	    a ^= p;
+	}
+      return result;
+    }
+
+    /// \brief x^e modulo p over GF(2).
+    boost::uint64_t
+    powMod (boost::uint64_t e, boost::uint64_t p, unsigned degree)
+    {
+      boost::uint64_t result = 1;
+      boost::uint64_t base = (degree == 1) ? 1 : 2;
+      while (e)
+	{
+	  if (e & 1)
+	    result = mulMod (result, base, p, degree);
+	  base = mulMod (base, base, p, degree);
+	  e >>= 1;
+	}
+      return result;
+    }
+
+    /// \brief Whether a polynomial of GF(2)[x] is primitive.
+    ///
+    /// p is primitive if x has order 2^degree - 1 modulo p.
+    bool
+    isPrimitive (boost::uint64_t p, unsigned degree)
+    {
+      const boost::uint64_t order = (boost::uint64_t (1) << degree) - 1;
+      if (powMod (order, p, degree) != 1)
+	return false;
+
+      boost::uint64_t n = order;
+      for (boost::uint64_t q = 2; q * q <= n; ++q)
+	{
+	  if (n % q)
+	    continue;
+	  if (powMod (order / q, p, degree) == 1)
+	    return false;
+	  while (!(n % q))
+	    n /= q;
+	}
+      // Remaining prime factor.
+      return n == 1 || powMod (order / n, p, degree) != 1;
+    }
+  } // end of anonymous namespace.
+
+  SobolSequence::SobolSequence (std::size_t dimension, boost::uint32_t seed)
+    throw (std::runtime_error)
+    : dimension_ (dimension),
+      directions_ (dimension * bits),
+      shift_ (dimension, 0),
+      state_ (dimension, 0),
+      index_ (0)
+  {
+    if (!dimension)
+      throw std::runtime_error ("Sobol sequence dimension must be positive");
+
+    // First dimension: van der Corput sequence.
+    for (std::size_t k = 0; k < bits; ++k)
+      directions_[k] = boost::uint32_t (1) << (bits - 1 - k);
+
+    // Other dimensions: one primitive polynomial each, by increasing
+    // degree then coefficients.
+    boost::random::mt19937 generator (5489u);
+    unsigned degree = 1;
+    boost::uint64_t a = 0;
+    for (std::size_t j = 1; j < dimension; ++j)
+      {
+	while (!isPrimitive ((boost::uint64_t (1) << degree) | (a << 1) | 1,
+			     degree))
+	  if (++a >= (boost::uint64_t (1) << (degree - 1)))
+	    {
+	      a = 0;
+	      if (++degree >= bits)
+		throw std::runtime_error
+		  ("Sobol sequence dimension is too large");
+	    }
+
+	boost::uint32_t* v = &directions_[j * bits];
+	const std::size_t s = degree;
+	const bool tabulated = j - 1 < joeKuoSize
+	  && joeKuo[j - 1].s == degree && joeKuo[j - 1].a == a;
+	for (std::size_t k = 0; k < s && k < bits; ++k)
+	  {
+	    boost::uint32_t m = 1;
+	    if (tabulated)
+	      m = joeKuo[j - 1].m[k];
+	    else if (k)
+	      {
+		// Any odd number lower than 2^(k + 1) is valid.
+		boost::random::uniform_int_distribution<boost::uint32_t>
+		  distribution (0, (boost::uint32_t (1) << k) - 1);
+		m = 2 * distribution (generator) + 1;
+	      }
+	    v[k] = m << (bits - 1 - k);
+	  }
+	for (std::size_t k = s; k < bits; ++k)
+	  {
+	    v[k] = v[k - s] ^ (v[k - s] >> s);
+	    for (std::size_t i = 1; i < s; ++i)
+	      if ((a >> (s - 1 - i)) & 1)
+		v[k] ^= v[k - i];
+	  }
+
+	if (++a >= (boost::uint64_t (1) << (degree - 1)))
+	  {
+	    a = 0;
+	    ++degree;
+	  }
+      }
+
+    if (seed)
+      {
+	boost::random::mt19937 shiftGenerator (seed);
+	for (std::size_t j = 0; j < dimension; ++j)
+	  shift_[j] = static_cast<boost::uint32_t> (shiftGenerator ());
+      }
+  }
+
+  std::size_t
+  SobolSequence::dimension () const throw ()
+  {
+    return dimension_;
+  }
+
+  boost::uint32_t
+  SobolSequence::index () const throw ()
+  {
+    return index_;
+  }
+
+  void
+  SobolSequence::next (Function::vector_t& x) throw (std::runtime_error)
+  {
+    if (index_ == ~boost::uint32_t (0))
+      throw std::runtime_error ("Sobol sequence is exhausted");
+
+    // Gray code: flip the direction of the lowest zero bit of the
+    // previous index.
+    if (index_)
+      {
+	boost::uint32_t previous = index_ - 1;
+	std::size_t c = 0;
+	while (previous & 1)
+	  {
+	    previous >>= 1;
+	    ++c;
+	  }
+	for (std::size_t j = 0; j < dimension_; ++j)
+	  state_[j] ^= directions_[j * bits + c];
+      }
+    ++index_;
+
+    x.resize (static_cast<Function::size_type> (dimension_));
+    for (std::size_t j = 0; j < dimension_; ++j)
+      x[static_cast<Function::size_type> (j)] =
+	static_cast<Function::value_type> (state_[j] ^ shift_[j])
+	/ 4294967296.;
+  }
+
+  void
+  SobolSequence::reset () throw ()
+  {
+    std::fill (state_.begin (), state_.end (), 0);
+    index_ = 0;
+  }
+
+  Function::matrix_t
+  sampleUnitHypercube (std::size_t n, std::size_t dimension,
+		       SamplingMethod method, boost::uint32_t seed)
+    throw (std::runtime_error)
+  {
+    typedef Function::size_type size_type;
+    typedef Function::value_type value_type;
+
+    Function::matrix_t points (static_cast<size_type> (dimension),
+			       static_cast<size_type> (n));
+    if (!n || !dimension)
+      return points;
+
+    boost::random::mt19937 generator (seed);
+    boost::random::uniform_real_distribution<value_type> uniform (0., 1.);
+
+    switch (method)
+      {
+      case SAMPLING_UNIFORM:
+	for (size_type i = 0; i < points.cols (); ++i)
+	  for (size_type j = 0; j < points.rows (); ++j)
+	    points (j, i) = uniform (generator);
+	break;
+
+      case SAMPLING_LATIN_HYPERCUBE:
+	{
+	  // One random permutation of the strata per coordinate.
+	  std::vector<std::size_t> strata (n);
+	  for (size_type j = 0; j < points.rows (); ++j)
+	    {
+	      for (std::size_t i = 0; i < n; ++i)
+		strata[i] = i;
+	      for (std::size_t i = n - 1; i > 0; --i)
+		{
+		  boost::random::uniform_int_distribution<std::size_t>
+		    distribution (0, i);
+		  std::swap (strata[i], strata[distribution (generator)]);
+		}
+	      for (std::size_t i = 0; i < n; ++i)
+		points (j, static_cast<size_type> (i)) =
+		  (static_cast<value_type> (strata[i]) + uniform (generator))
+		  / static_cast<value_type> (n);
+	    }
+	  break;
+	}
+
+      case SAMPLING_SOBOL:
+	{
+	  SobolSequence sequence (dimension, seed);
+	  Function::vector_t x (static_cast<size_type> (dimension));
+	  for (size_type i = 0; i < points.cols (); ++i)
+	    {
+	      sequence.next (x);
+	      points.col (i) = x;
+	    }
+	  break;
+	}
+
+      default:
+	{
+	  boost::format fmt ("Invalid sampling method (%d)");
+	  fmt % method;
+	  throw std::runtime_error (fmt.str ());
+	}
+      }
+    return points;
+  }
+
+} // end of namespace roboptim
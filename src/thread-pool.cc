@@ -0,0 +1,183 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <boost/bind.hpp>
+
+#include "roboptim/core/thread-pool.hh"
+
+namespace roboptim
+{
+  namespace
+  {
+    /// \brief Run one task.
+    ///
+    /// \return error message of the task, empty if it succeeded
+    std::string runTask (const ThreadPool::task_t& task, std::size_t i)
+    {
+      try
+	{
+	  task (i);
+	}
+      catch (const std::exception& e)
+	{
+	  return e.what ();
+	}
+      catch (...)
+	{
+	  return "unknown exception";
+	}
+      return std::string ();
+    }
+  } // end of anonymous namespace.
+
+  struct ThreadPool::Batch
+  {
+    Batch (std::size_t n, const task_t& t)
+      : task (t),
+	size (n),
+	next (0),
+	pending (n),
+	error (),
+	done ()
+    {}
+
+    /// \brief Task shared by the whole batch.
+    const task_t& task;
+    /// \brief Number of tasks.
+    std::size_t size;
+    /// \brief Index of the next task to start.
+    std::size_t next;
+    /// \brief Number of tasks not finished yet.
+    std::size_t pending;
+    /// \brief First error raised by a task, if any.
+    std::string error;
+    /// \brief Notified when the last task is finished.
+    boost::condition_variable done;
+  };
+
+  ThreadPool::ThreadPool (std::size_t nThreads)
+    : queue_ (),
+      mutex_ (),
+      taskQueued_ (),
+      stop_ (false),
+      threads_ (),
+      size_ (nThreads)
+  {
+    if (!size_)
+      {
+	unsigned hardware = boost::thread::hardware_concurrency ();
+	size_ = (hardware > 1) ? hardware - 1 : 1;
+      }
+
+    for (std::size_t i = 0; i < size_; ++i)
+      threads_.create_thread (boost::bind (&ThreadPool::work, this));
+  }
+
+  ThreadPool::~ThreadPool () throw ()
+  {
+    {
+      boost::unique_lock<boost::mutex> lock (mutex_);
+      stop_ = true;
+    }
+    taskQueued_.notify_all ();
+    threads_.join_all ();
+  }
+
+  std::size_t
+  ThreadPool::size () const throw ()
+  {
+    return size_;
+  }
+
+  void
+  ThreadPool::execute (boost::unique_lock<boost::mutex>& lock, Batch& batch)
+  {
+    const std::size_t i = batch.next++;
+    if (batch.next == batch.size)
+      queue_.erase (std::find (queue_.begin (), queue_.end (), &batch));
+
+    lock.unlock ();
+    const std::string error = runTask (batch.task, i);
+    lock.lock ();
+
+    if (!error.empty () && batch.error.empty ())
+      batch.error = error;
+    if (!--batch.pending)
+      batch.done.notify_all ();
+  }
+
+  void
+  ThreadPool::work ()
+  {
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    while (true)
+      {
+	while (queue_.empty () && !stop_)
+	  taskQueued_.wait (lock);
+	if (queue_.empty ())
+	  return;
+	execute (lock, *queue_.front ());
+      }
+  }
+
+  void
+  ThreadPool::run (std::size_t n, const task_t& task)
+    throw (std::runtime_error)
+  {
+    // Nothing to share: run in the calling thread, errors are
+    // reported as for a whole batch.
+    if (n == 1)
+      {
+	const std::string error = runTask (task, 0);
+	if (!error.empty ())
+	  throw std::runtime_error (error);
+	return;
+      }
+    if (!n)
+      return;
+
+    Batch batch (n, task);
+    boost::unique_lock<boost::mutex> lock (mutex_);
+    queue_.push_back (&batch);
+    taskQueued_.notify_all ();
+
+    // Help the workers with this batch only: a task of another batch
+    // could evaluate a filter this thread is in the middle of
+    // evaluating, and overwrite its per-thread buffers.
+    while (batch.next < batch.size)
+      execute (lock, batch);
+    while (batch.pending)
+      batch.done.wait (lock);
+
+    if (!batch.error.empty ())
+      throw std::runtime_error (batch.error);
+  }
+
+  ThreadPool&
+  ThreadPool::global ()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+} // end of namespace roboptim
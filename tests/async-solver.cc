@@ -0,0 +1,201 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <string>
+
+#include <boost/mpl/vector.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <roboptim/core/async-solver.hh>
+#include <roboptim/core/solver.hh>
+
+using namespace roboptim;
+
+typedef Solver<Function, boost::mpl::vector<Function> > parent_solver_t;
+
+struct F : public Function
+{
+  F () : Function (2, 1, "x^2 + y^2")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = x.squaredNorm ();
+  }
+};
+
+// Halve the argument at each iteration.
+class IterativeSolver : public parent_solver_t
+{
+public:
+  typedef parent_solver_t parent_t;
+
+  IterativeSolver (const problem_t& pb, int iterations,
+		   bool cooperative = true, bool callbacks = true) throw ()
+    : parent_t (pb),
+      iterations_ (iterations),
+      cooperative_ (cooperative),
+      callbacks_ (callbacks),
+      callback_ ()
+  {}
+
+  ~IterativeSolver () throw ()
+  {}
+
+  void setIterationCallback (callback_t callback) throw (std::runtime_error)
+  {
+    if (!callbacks_)
+      throw std::runtime_error
+	("iteration callback is not supported by this solver");
+    callback_ = callback;
+  }
+
+  void solve () throw ()
+  {
+    solverState_t state (problem ());
+    state.clearStopRequest ();
+
+    Result res (problem ().function ().inputSize (), 1);
+    res.x = *problem ().startingPoint ();
+    for (int k = 0; k < iterations_; ++k)
+      {
+	boost::this_thread::sleep (boost::posix_time::milliseconds (1));
+	res.x *= 0.5;
+
+	state.x () = res.x;
+	state.cost () = res.x.squaredNorm ();
+	if (callback_)
+	  callback_ (problem (), state);
+	if (cooperative_ && state.stopRequested ())
+	  break;
+      }
+    problem ().function () (res.value, res.x);
+    result_ = res;
+  }
+
+private:
+  int iterations_;
+  bool cooperative_;
+  bool callbacks_;
+  callback_t callback_;
+};
+
+typedef AsyncSolver<IterativeSolver> async_t;
+
+static int iterations = 0;
+
+static void countIterations (const IterativeSolver::problem_t&,
+			     IterativeSolver::solverState_t&)
+{
+  ++iterations;
+}
+
+static bool contains (const std::string& s, const std::string& pattern)
+{
+  return s.find (pattern) != std::string::npos;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (async_solver)
+{
+  F f;
+  IterativeSolver::problem_t pb (f);
+  Function::vector_t x0 (2);
+  x0 << 1., 2.;
+  pb.startingPoint () = x0;
+
+  // Uninterrupted solve.
+  {
+    IterativeSolver solver (pb, 5);
+    async_t async (solver);
+    BOOST_CHECK (async.interruptible ());
+
+    async.setIterationCallback (&countIterations);
+
+    async_t::future_t future = async.solve ();
+    const Result& res = boost::get<Result> (future.get ());
+    BOOST_CHECK_EQUAL (res.x, x0 / 32.);
+    async.wait ();
+    BOOST_CHECK (!async.running ());
+    BOOST_CHECK_EQUAL (iterations, 5);
+  }
+
+  // Deadline, cooperative solver: the partial result is kept.
+  {
+    IterativeSolver solver (pb, 100000);
+    async_t async (solver);
+    async.setGracePeriod (boost::posix_time::seconds (10));
+    async_t::future_t future =
+      async.solve (CancellationToken (), boost::posix_time::milliseconds (20));
+    const ResultWithWarnings& res =
+      boost::get<ResultWithWarnings> (future.get ());
+    BOOST_REQUIRE (!res.warnings.empty ());
+    BOOST_CHECK (contains (res.warnings.back ().what (), "deadline exceeded"));
+    BOOST_CHECK (res.x.norm () < x0.norm ());
+  }
+
+  // Cancellation, cooperative solver.
+  {
+    IterativeSolver solver (pb, 100000);
+    async_t async (solver);
+    async.setGracePeriod (boost::posix_time::seconds (10));
+    CancellationToken token;
+    async_t::future_t future = async.solve (token);
+    BOOST_CHECK_THROW (async.solve (), std::runtime_error);
+    boost::this_thread::sleep (boost::posix_time::milliseconds (10));
+    BOOST_CHECK (!future.is_ready ());
+    token.cancel ();
+    BOOST_CHECK (token.cancelled ());
+    const ResultWithWarnings& res =
+      boost::get<ResultWithWarnings> (future.get ());
+    BOOST_CHECK (contains (res.warnings.back ().what (), "cancelled"));
+  }
+
+  // Deadline, solver ignoring the stop request: the watchdog gives
+  // the best point seen so far.
+  {
+    IterativeSolver solver (pb, 1000, false);
+    async_t async (solver);
+    async_t::future_t future =
+      async.solve (CancellationToken (), boost::posix_time::milliseconds (20));
+    BOOST_CHECK (future.timed_wait (boost::posix_time::milliseconds (500)));
+    BOOST_CHECK (async.running ());
+    const SolverError& error = boost::get<SolverError> (future.get ());
+    BOOST_CHECK (contains (error.what (), "deadline exceeded"));
+    BOOST_REQUIRE (error.lastState ());
+    BOOST_CHECK (error.lastState ()->x.norm () < x0.norm ());
+    BOOST_CHECK_CLOSE (error.lastState ()->value[0],
+		       error.lastState ()->x.squaredNorm (), 1e-8);
+  }
+
+  // No iteration callback: the starting point is given.
+  {
+    IterativeSolver solver (pb, 1000, false, false);
+    async_t async (solver);
+    BOOST_CHECK (!async.interruptible ());
+    async_t::future_t future =
+      async.solve (CancellationToken (), boost::posix_time::milliseconds (20));
+    const SolverError& error = boost::get<SolverError> (future.get ());
+    BOOST_REQUIRE (error.lastState ());
+    BOOST_CHECK_EQUAL (error.lastState ()->x, x0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
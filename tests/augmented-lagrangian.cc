@@ -0,0 +1,196 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/augmented-lagrangian.hh>
+#include <roboptim/core/linear-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+
+using namespace roboptim;
+
+typedef Solver<DifferentiableFunction,
+	       boost::mpl::vector<LinearFunction, DifferentiableFunction> >
+solver_t;
+typedef AugmentedLagrangianSolver<solver_t> augmentedLagrangian_t;
+
+// f(x) = (x0 - 1)^2 + (x1 - 2)^2
+struct F : public DifferentiableFunction
+{
+  F () : DifferentiableFunction (2, 1, "(x0 - 1)^2 + (x1 - 2)^2")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = (x[0] - 1.) * (x[0] - 1.) + (x[1] - 2.) * (x[1] - 2.);
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = 2. * (x[0] - 1.);
+    gradient[1] = 2. * (x[1] - 2.);
+  }
+};
+
+// g(x) = x0^2
+struct G : public DifferentiableFunction
+{
+  G () : DifferentiableFunction (2, 1, "x0^2")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = x[0] * x[0];
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = 2. * x[0];
+    gradient[1] = 0.;
+  }
+};
+
+static int iterations = 0;
+
+static void countIterations (const solver_t::problem_t&,
+			     solver_t::solverState_t&)
+{
+  ++iterations;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (augmented_lagrangian_residual)
+{
+  Function::matrix_t a (2, 2);
+  a << 1., 1., 1., -1.;
+  Function::vector_t b (2);
+  b << 0., 0.;
+
+  AugmentedLagrangianResidual::constraints_t constraints;
+  constraints.push_back (boost::make_shared<NumericLinearFunction> (a, b));
+  constraints.push_back (boost::make_shared<G> ());
+  AugmentedLagrangianResidual::bounds_t bounds (2);
+  bounds[0].push_back (Function::makeInterval (0., 1.));
+  bounds[0].push_back (Function::makeLowerInterval (0.));
+  bounds[1].push_back (Function::makeUpperInterval (1.));
+
+  AugmentedLagrangianResidual residual (2, constraints, bounds);
+  BOOST_CHECK_EQUAL (residual.outputSize (), 3);
+
+  Function::vector_t multipliers (3);
+  multipliers << 0., -4., 1.;
+  residual.setMultipliers (multipliers);
+  residual.setPenalty (4.);
+  BOOST_CHECK_THROW (residual.setPenalty (0.), std::runtime_error);
+
+  // g = (3, -1, 1): v = g + lambda / rho = (3, -2, 1.25).
+  Function::vector_t x (2);
+  x << 1., 2.;
+  Function::vector_t r = residual (x);
+  BOOST_CHECK_CLOSE (r[0], 2. * 2., 1e-8);
+  BOOST_CHECK_CLOSE (r[1], 2. * -2., 1e-8);
+  BOOST_CHECK_CLOSE (r[2], 2. * .25, 1e-8);
+
+  // The jacobian matches the gradients.
+  Function::matrix_t jacobian = residual.jacobian (x);
+  for (Function::size_type i = 0; i < 3; ++i)
+    BOOST_CHECK (jacobian.row (i).transpose ()
+		 .isApprox (residual.gradient (x, i)));
+  BOOST_CHECK_CLOSE (jacobian (2, 0), 2. * 2., 1e-8);
+
+  // Inside the bounds, the residual and its gradient vanish.
+  x << .25, .25;
+  BOOST_CHECK_SMALL (residual (x)[0], 1e-12);
+  BOOST_CHECK (residual.gradient (x, 0).isZero ());
+}
+
+BOOST_AUTO_TEST_CASE (augmented_lagrangian)
+{
+  F f;
+  solver_t::problem_t pb (f);
+
+  // x0 + x1 = 1 and x0^2 >= 0.04
+  Function::matrix_t a (1, 2);
+  a << 1., 1.;
+  Function::vector_t b (1);
+  b << 0.;
+  boost::shared_ptr<LinearFunction> linear =
+    boost::make_shared<NumericLinearFunction> (a, b);
+  boost::shared_ptr<DifferentiableFunction> g = boost::make_shared<G> ();
+  pb.addConstraint (linear, Function::makeInterval (1., 1.));
+  pb.addConstraint (g, Function::makeLowerInterval (.04));
+
+  Function::vector_t x0 (2);
+  x0 << 1., 0.;
+  pb.startingPoint () = x0;
+  pb.argumentBounds ()[0] = Function::makeLowerInterval (0.);
+
+  // Solution: (0.2, 0.8), lambda = (2.4, -2).
+  const char* plugins[] = {"lbfgsb", "projected-gradient"};
+  for (std::size_t i = 0; i < 2; ++i)
+    {
+      augmentedLagrangian_t solver (pb, plugins[i]);
+      solver.parameters ()["max-iterations"].value = 10000;
+      solver.parameters ()["tolerance"].value = 1e-9;
+      solver.setIterationCallback (&countIterations);
+
+      iterations = 0;
+      BOOST_REQUIRE_EQUAL (solver.minimumType (), GenericSolver::SOLVER_VALUE);
+      const Result& result = solver.getMinimum<Result> ();
+      BOOST_CHECK_SMALL (result.x[0] - .2, 1e-5);
+      BOOST_CHECK_SMALL (result.x[1] - .8, 1e-5);
+      BOOST_CHECK_SMALL (result.lambda[0] - 2.4, 1e-4);
+      BOOST_CHECK_SMALL (result.lambda[1] + 2., 1e-4);
+      BOOST_CHECK_EQUAL (iterations, solver.outerIterations ());
+
+      // A warm-started solve converges at once.
+      solver.warmStart (Result (result));
+      BOOST_REQUIRE_EQUAL (solver.minimumType (), GenericSolver::SOLVER_VALUE);
+      BOOST_CHECK_EQUAL (solver.outerIterations (), 1);
+
+      // The sub-solver is rebound to new constraints bounds:
+      // x0 + x1 = 2 gives (0.5, 1.5), where g is inactive.
+      solver_t::intervals_t bounds (1, Function::makeInterval (2., 2.));
+      solver.setConstraintBounds (0, bounds);
+      solver.clearWarmStart ();
+      BOOST_REQUIRE_EQUAL (solver.minimumType (), GenericSolver::SOLVER_VALUE);
+      const Result& rebound = solver.getMinimum<Result> ();
+      BOOST_CHECK_SMALL (rebound.x[0] - .5, 1e-5);
+      BOOST_CHECK_SMALL (rebound.x[1] - 1.5, 1e-5);
+      BOOST_CHECK_SMALL (rebound.lambda[1], 1e-4);
+    }
+
+  // Outer iterations limit.
+  augmentedLagrangian_t solver (pb);
+  solver.parameters ()["augmented-lagrangian.max-iterations"].value = 1;
+  BOOST_CHECK_EQUAL (solver.minimumType (),
+		     GenericSolver::SOLVER_VALUE_WARNINGS);
+
+  // Unknown sub-solver.
+  solver.parameters ()["augmented-lagrangian.solver"].value =
+    std::string ("unknown");
+  solver.reset ();
+  BOOST_CHECK_EQUAL (solver.minimumType (), GenericSolver::SOLVER_ERROR);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
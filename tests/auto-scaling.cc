@@ -0,0 +1,122 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/test/test_case_template.hpp>
+
+#include <roboptim/core/auto-scaling.hh>
+#include <roboptim/core/io.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/problem.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (auto_scaling_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef GenericLinearFunction<T> linearFunction_t;
+  typedef GenericNumericLinearFunction<T> numericLinearFunction_t;
+  typedef Problem<differentiableFunction_t,
+		  boost::mpl::vector<linearFunction_t,
+				     differentiableFunction_t> > problem_t;
+  typedef typename numericLinearFunction_t::matrix_t matrix_t;
+  typedef typename problem_t::vector_t vector_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scales_t scales_t;
+  typedef AutoScaling<problem_t> autoScaling_t;
+
+  // Badly scaled cost and constraints.
+  Eigen::MatrixXd c (1, 2);
+  c << 1e3, 1e-3;
+  numericLinearFunction_t cost (matrix_t (c.sparseView ()), vector_t::Zero (1));
+
+  problem_t pb (cost);
+  pb.argumentBounds ()[0] = Function::makeInterval (-1., 1.);
+  pb.argumentBounds ()[1] = Function::makeLowerInterval (0.);
+
+  Eigen::MatrixXd a (2, 2);
+  a << 2e3, 0.,
+    0., 5e-3;
+  intervals_t bounds (2, Function::makeInterval (-1., 1.));
+  pb.addConstraint
+    (boost::static_pointer_cast<linearFunction_t>
+     (boost::make_shared<numericLinearFunction_t>
+      (matrix_t (a.sparseView ()), vector_t::Zero (2))),
+     bounds, scales_t (2, 1.));
+
+  // Equilibration: the largest scaled derivative of each row and
+  // column is one.
+  {
+    autoScaling_t scaling (pb, autoScaling_t::EQUILIBRATION);
+    BOOST_CHECK_EQUAL (scaling.samples ().size (), 1u);
+    BOOST_CHECK_CLOSE (scaling.argumentScales ()[0], 2e3, 1e-8);
+    BOOST_CHECK_CLOSE (scaling.argumentScales ()[1], 5e-3, 1e-8);
+    BOOST_CHECK_CLOSE (scaling.costScale (), 2., 1e-8);
+    BOOST_CHECK_CLOSE (scaling.constraintsScales ()[0], 1., 1e-8);
+    BOOST_CHECK_CLOSE (scaling.constraintsScales ()[1], 1., 1e-8);
+
+    // Scaled views.
+    vector_t x (2);
+    x << .5, 3.;
+    const vector_t y = scaling.scaleArgument (x);
+    BOOST_CHECK (scaling.unscaleArgument (y).isApprox (x));
+    BOOST_CHECK_CLOSE ((*scaling.scaledCost ()) (y)[0], 2. * cost (x)[0], 1e-8);
+
+    const Eigen::MatrixXd costJacobian (scaling.scaledCost ()->jacobian (y));
+    BOOST_CHECK_CLOSE (costJacobian.cwiseAbs ().maxCoeff (), 1., 1e-8);
+
+    const Eigen::MatrixXd jacobian
+      (scaling.scaledConstraint (0)->jacobian (y));
+    BOOST_CHECK (jacobian.isApprox (Eigen::MatrixXd::Identity (2, 2)));
+    BOOST_CHECK_THROW (scaling.scaledConstraint (1), std::runtime_error);
+
+    // Write the scales in the problem.
+    scaling.apply (pb);
+    BOOST_CHECK_CLOSE (pb.argumentScales ()[0], 2e3, 1e-8);
+    BOOST_CHECK_CLOSE (pb.scalesVector ()[0][1], 1., 1e-8);
+    BOOST_CHECK_CLOSE (pb.constraintsScales ()[1], 1., 1e-8);
+  }
+
+  // Geometric mean, several samples within the bounds.
+  {
+    autoScaling_t scaling (pb, autoScaling_t::GEOMETRIC_MEAN, 4);
+    BOOST_CHECK_EQUAL (scaling.samples ().size (), 4u);
+    for (std::size_t k = 0; k < scaling.samples ().size (); ++k)
+      {
+	BOOST_CHECK (std::fabs (scaling.samples ()[k][0]) <= 1.);
+	BOOST_CHECK (scaling.samples ()[k][1] >= 0.);
+      }
+    BOOST_CHECK_CLOSE (scaling.argumentScales ()[0],
+		       std::sqrt (1e3 * 2e3), 1e-8);
+    BOOST_CHECK_CLOSE (scaling.argumentScales ()[1],
+		       std::sqrt (1e-3 * 5e-3), 1e-8);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,149 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <roboptim/core/binary-log.hh>
+
+using namespace roboptim;
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (binary_log)
+{
+  const std::string filename =
+    (boost::filesystem::temp_directory_path ()
+     / "roboptim-core-binary-log.bin").string ();
+
+  BinaryLogSchema schema;
+  schema.inputSize = 3;
+  schema.constraintsNames.push_back ("g");
+  schema.constraintsNames.push_back ("h");
+  schema.constraintsSizes.push_back (1);
+  schema.constraintsSizes.push_back (2);
+  schema.jacobianCapacity = 4;
+
+  const std::size_t n = 10;
+  {
+    BinaryLogWriter writer (filename, schema);
+
+    BinaryLogRecord record;
+    record.x.resize (3);
+    record.constraints.resize (3);
+    for (std::size_t k = 0; k < n; ++k)
+      {
+	record.iteration = k;
+	record.cost = 1. / (1. + static_cast<double> (k));
+	record.constraintViolation = static_cast<double> (k);
+	record.x.setConstant (static_cast<double> (k));
+	record.constraints << 1., 2., static_cast<double> (k);
+
+	// Sparse jacobian, one more nonzero at each iteration.
+	Eigen::SparseMatrix<double, Eigen::RowMajor> jacobian (3, 3);
+	for (std::size_t i = 0; i < k % 4 + 1; ++i)
+	  jacobian.insert (static_cast<int> (i % 3), static_cast<int> (i / 3))
+	    = static_cast<double> (k);
+	record.setJacobian (jacobian);
+	writer.append (record);
+      }
+
+    // Too many nonzeros.
+    Function::matrix_t dense (3, 3);
+    dense.setOnes ();
+    record.setJacobian (dense);
+    BOOST_CHECK_EQUAL (record.jacobian.size (), 9u);
+    BOOST_CHECK_THROW (writer.append (record), std::runtime_error);
+
+    // Wrong size.
+    record.jacobian.clear ();
+    record.x.resize (2);
+    BOOST_CHECK_THROW (writer.append (record), std::runtime_error);
+
+    BOOST_CHECK_EQUAL (writer.size (), n);
+  }
+
+  BinaryLogReader reader (filename);
+  BOOST_CHECK_EQUAL (reader.schema ().inputSize, 3);
+  BOOST_CHECK_EQUAL (reader.schema ().constraintsNames.size (), 2u);
+  BOOST_CHECK_EQUAL (reader.schema ().constraintsNames[1], "h");
+  BOOST_CHECK_EQUAL (reader.schema ().constraintsSizes[1], 2);
+  BOOST_CHECK_EQUAL (reader.schema ().constraintsOutputSize (), 3);
+  BOOST_CHECK_EQUAL (reader.schema ().jacobianCapacity, 4u);
+  BOOST_REQUIRE_EQUAL (reader.size (), n);
+
+  // Random access.
+  BinaryLogRecord record;
+  const std::size_t order[] = { 7, 0, 9, 3 };
+  for (std::size_t j = 0; j < sizeof (order) / sizeof (order[0]); ++j)
+    {
+      const std::size_t k = order[j];
+      reader.read (k, record);
+      BOOST_CHECK_EQUAL (record.iteration, k);
+      BOOST_CHECK_EQUAL (record.cost, 1. / (1. + static_cast<double> (k)));
+      BOOST_CHECK_EQUAL (record.x[2], static_cast<double> (k));
+      BOOST_CHECK_EQUAL (record.constraints[2], static_cast<double> (k));
+      BOOST_REQUIRE_EQUAL (record.jacobian.size (), k % 4 + 1);
+      for (std::size_t i = 0; i < record.jacobian.size (); ++i)
+	{
+	  const BinaryLogRecord::triplet_t& triplet = record.jacobian[i];
+	  BOOST_CHECK_EQUAL (triplet.value (), static_cast<double> (k));
+	  BOOST_CHECK (triplet.row () + 3 * triplet.col () < 4);
+	}
+    }
+  BOOST_CHECK_THROW (reader.read (n, record), std::runtime_error);
+
+  // CSV export.
+  std::stringstream csv;
+  reader.exportCsv (csv);
+  std::string line;
+  std::getline (csv, line);
+  BOOST_CHECK_EQUAL (line,
+		     "Iteration, Cost, Constraint violation, X 0, X 1, X 2, "
+		     "constraint 0 output 0, constraint 1 output 0, "
+		     "constraint 1 output 1");
+  std::getline (csv, line);
+  BOOST_CHECK_EQUAL (line, "0, 1, 0, 0, 0, 0, 1, 2, 0");
+
+  std::stringstream jacobianCsv;
+  reader.exportJacobianCsv (jacobianCsv);
+  std::getline (jacobianCsv, line);
+  BOOST_CHECK_EQUAL (line, "Iteration, Row, Column, Value");
+  std::getline (jacobianCsv, line);
+  BOOST_CHECK_EQUAL (line, "0, 0, 0, 0");
+
+  // A truncated record is ignored.
+  boost::filesystem::resize_file
+    (filename, boost::filesystem::file_size (filename) - 1);
+  BOOST_CHECK_EQUAL (reader.size (), n - 1);
+
+  // Not a log.
+  {
+    std::ofstream stream (filename.c_str ());
+    stream << "not a log";
+  }
+  BOOST_CHECK_THROW (BinaryLogReader invalid (filename), std::runtime_error);
+
+  boost::filesystem::remove (filename);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
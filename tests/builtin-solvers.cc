@@ -0,0 +1,249 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/linear-function.hh>
+#include <roboptim/core/solver-factory.hh>
+#include <roboptim/core/sum-of-c1-squares.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::vector<LinearFunction, DifferentiableFunction>
+constraints_t;
+typedef Solver<DifferentiableFunction, constraints_t> solver_t;
+typedef Solver<SumOfC1Squares, constraints_t> leastSquaresSolver_t;
+
+// f(x) = (x0 - 3)^2 + 10 (x1 + 1)^2
+struct Quadratic : public DifferentiableFunction
+{
+  Quadratic () : DifferentiableFunction (2, 1, "quadratic")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = (x[0] - 3.) * (x[0] - 3.) + 10. * (x[1] + 1.) * (x[1] + 1.);
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = 2. * (x[0] - 3.);
+    gradient[1] = 20. * (x[1] + 1.);
+  }
+};
+
+// Rosenbrock function.
+struct Rosenbrock : public DifferentiableFunction
+{
+  Rosenbrock () : DifferentiableFunction (2, 1, "rosenbrock")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = (1. - x[0]) * (1. - x[0])
+      + 100. * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]);
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = -2. * (1. - x[0]) - 400. * x[0] * (x[1] - x[0] * x[0]);
+    gradient[1] = 200. * (x[1] - x[0] * x[0]);
+  }
+};
+
+// Residuals of the fit of a * exp (b t) on samples of 2 exp (-t / 2).
+struct Exponential : public DifferentiableFunction
+{
+  Exponential () : DifferentiableFunction (2, 10, "exponential fit")
+  {}
+
+  static double t (size_type i)
+  {
+    return .5 * static_cast<double> (i);
+  }
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    for (size_type i = 0; i < outputSize (); ++i)
+      result[i] = x[0] * std::exp (x[1] * t (i)) - 2. * std::exp (-.5 * t (i));
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type i) const throw ()
+  {
+    gradient[0] = std::exp (x[1] * t (i));
+    gradient[1] = x[0] * t (i) * std::exp (x[1] * t (i));
+  }
+};
+
+static int iterations = 0;
+
+static void countIterations (const solver_t::problem_t&,
+			     solver_t::solverState_t&)
+{
+  ++iterations;
+}
+
+static void stopAfterOneIteration (const solver_t::problem_t&,
+				   solver_t::solverState_t& state)
+{
+  state.requestStop ();
+}
+
+static void failingCallback (const solver_t::problem_t&,
+			     solver_t::solverState_t&)
+{
+  throw std::runtime_error ("callback failed");
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (builtin_solvers_bounds)
+{
+  Quadratic f;
+  solver_t::problem_t pb (f);
+  pb.argumentBounds ()[0] = Function::makeInterval (-1., 2.);
+  pb.argumentBounds ()[1] = Function::makeInterval (0., 5.);
+  Function::vector_t x0 (2);
+  x0 << -1., 4.;
+  pb.startingPoint () = x0;
+
+  const char* plugins[] = {"projected-gradient", "lbfgsb"};
+  for (std::size_t i = 0; i < 2; ++i)
+    {
+      SolverFactory<solver_t> factory (plugins[i], pb);
+      solver_t& solver = factory ();
+      BOOST_REQUIRE (solver.minimumType () == GenericSolver::SOLVER_VALUE);
+
+      const Result& result = solver.getMinimum<Result> ();
+      BOOST_CHECK_SMALL (result.x[0] - 2., 1e-6);
+      BOOST_CHECK_SMALL (result.x[1], 1e-6);
+      BOOST_CHECK_SMALL (result.value[0] - 11., 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (builtin_solvers_lbfgsb)
+{
+  Rosenbrock f;
+  solver_t::problem_t pb (f);
+  Function::vector_t x0 (2);
+  x0 << -1.2, 1.;
+  pb.startingPoint () = x0;
+
+  SolverFactory<solver_t> factory ("lbfgsb", pb);
+  solver_t& solver = factory ();
+  solver.setIterationCallback (&countIterations);
+
+  iterations = 0;
+  BOOST_REQUIRE (solver.minimumType () == GenericSolver::SOLVER_VALUE);
+  Result result = solver.getMinimum<Result> ();
+  BOOST_CHECK_SMALL (result.x[0] - 1., 1e-4);
+  BOOST_CHECK_SMALL (result.x[1] - 1., 1e-4);
+  BOOST_CHECK (iterations > 0);
+
+  // A warm-started solve from the solution does not iterate.
+  iterations = 0;
+  solver.warmStart (result);
+  BOOST_REQUIRE (solver.minimumType () == GenericSolver::SOLVER_VALUE);
+  BOOST_CHECK_EQUAL (iterations, 0);
+
+  // Iteration limit.
+  solver.clearWarmStart ();
+  solver.setStartingPoint (x0);
+  solver.parameters ()["max-iterations"].value = 2;
+  BOOST_CHECK (solver.minimumType ()
+	       == GenericSolver::SOLVER_VALUE_WARNINGS);
+
+  // Stop request.
+  solver.parameters ()["max-iterations"].value = 1000;
+  solver.setIterationCallback (&stopAfterOneIteration);
+  solver.reset ();
+  BOOST_REQUIRE (solver.minimumType ()
+		 == GenericSolver::SOLVER_VALUE_WARNINGS);
+  BOOST_CHECK (solver.getMinimum<ResultWithWarnings> ().x != x0);
+
+  // Callback errors are reported, not propagated.
+  solver.setIterationCallback (&failingCallback);
+  solver.reset ();
+  BOOST_REQUIRE (solver.minimumType () == GenericSolver::SOLVER_ERROR);
+  BOOST_CHECK (std::string (solver.getMinimum<SolverError> ().what ())
+	       .find ("callback failed") != std::string::npos);
+
+  // Invalid parameter type.
+  solver.parameters ()["max-iterations"].value = 1000.;
+  solver.reset ();
+  BOOST_CHECK (solver.minimumType () == GenericSolver::SOLVER_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE (builtin_solvers_constraints)
+{
+  Quadratic f;
+  solver_t::problem_t pb (f);
+  boost::shared_ptr<DifferentiableFunction> g =
+    boost::make_shared<Rosenbrock> ();
+  pb.addConstraint (g, Function::makeUpperInterval (1.));
+
+  SolverFactory<solver_t> factory ("projected-gradient", pb);
+  solver_t& solver = factory ();
+  BOOST_CHECK (solver.minimumType () == GenericSolver::SOLVER_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE (builtin_solvers_gauss_newton)
+{
+  boost::shared_ptr<DifferentiableFunction> residuals =
+    boost::make_shared<Exponential> ();
+  SumOfC1Squares cost (residuals, "exponential fit");
+  leastSquaresSolver_t::problem_t pb (cost);
+  Function::vector_t x0 (2);
+  x0 << 1., 0.;
+  pb.startingPoint () = x0;
+
+  for (int i = 0; i < 2; ++i)
+    {
+      // Levenberg-Marquardt, then pure Gauss-Newton.
+      SolverFactory<leastSquaresSolver_t> factory ("gauss-newton", pb);
+      leastSquaresSolver_t& solver = factory ();
+      if (i == 1)
+	solver.parameters ()["gauss-newton.damping"].value = 0.;
+
+      BOOST_REQUIRE (solver.minimumType ()
+		     == GenericSolver::SOLVER_VALUE);
+      const Result& result = solver.getMinimum<Result> ();
+      BOOST_CHECK_SMALL (result.x[0] - 2., 1e-5);
+      BOOST_CHECK_SMALL (result.x[1] + .5, 1e-5);
+      BOOST_CHECK_SMALL (result.value[0], 1e-10);
+    }
+
+  // Bounds exclude the exact fit.
+  pb.argumentBounds ()[0] = Function::makeInterval (0., 1.5);
+  SolverFactory<leastSquaresSolver_t> factory ("gauss-newton", pb);
+  leastSquaresSolver_t& solver = factory ();
+  BOOST_REQUIRE (solver.minimumType () == GenericSolver::SOLVER_VALUE);
+  BOOST_CHECK_SMALL (solver.getMinimum<Result> ().x[0] - 1.5, 1e-8);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -33,7 +33,7 @@ struct DenseF : public DifferentiableFunction
   DenseF () : DifferentiableFunction (2, 1, "2 * x * x + y")
   {}
 
-  void impl_compute (result_t& res, const argument_t& argument) const throw ()
+  void impl_compute (result_ref res, const argument_t& argument) const throw ()
   {
     (*output) << "computation (not cached)" << std::endl;
     res.setZero ();
@@ -49,7 +49,7 @@ struct DenseF : public DifferentiableFunction
     grad[1] = 1.;
   }
 
-  void impl_jacobian (jacobian_t& jacobian, const argument_t& argument)
+  void impl_jacobian (jacobian_ref jacobian, const argument_t& argument)
     const throw ()
   {
     (*output) << "jacobian computation (not cached)" << std::endl;
@@ -64,7 +64,7 @@ struct SparseF : public DifferentiableSparseFunction
   SparseF () : DifferentiableSparseFunction (2, 1, "2 * x * x + y")
   {}
 
-  void impl_compute (result_t& res, const argument_t& argument) const throw ()
+  void impl_compute (result_ref res, const argument_t& argument) const throw ()
   {
     (*output) << "computation (not cached)" << std::endl;
     res.setZero ();
@@ -80,7 +80,7 @@ struct SparseF : public DifferentiableSparseFunction
     grad.insert(1) = 1.;
   }
 
-  void impl_jacobian (jacobian_t& jacobian, const argument_t& argument)
+  void impl_jacobian (jacobian_ref jacobian, const argument_t& argument)
     const throw ()
   {
     (*output) << "jacobian computation (not cached)" << std::endl;
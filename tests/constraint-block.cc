@@ -0,0 +1,202 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <roboptim/core/constraint-block.hh>
+#include <roboptim/core/io.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/problem.hh>
+#include <roboptim/core/thread-pool.hh>
+#include <roboptim/core/filter/map.hh>
+#include <roboptim/core/function/cos.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+namespace
+{
+  /// \brief Sum of the arguments, slow to evaluate.
+  template <typename T>
+  struct Slow : public GenericDifferentiableFunction<T>
+  {
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericDifferentiableFunction<T>);
+
+    Slow () : GenericDifferentiableFunction<T> (3, 1, "slow")
+    {}
+
+    void impl_compute (result_ref result, const argument_t& x) const throw ()
+    {
+      boost::this_thread::sleep (boost::posix_time::milliseconds (5));
+      result[0] = x.sum ();
+    }
+
+    void impl_gradient (gradient_t& gradient, const argument_t&,
+			size_type) const throw ()
+    {
+      for (size_type j = 0; j < this->inputSize (); ++j)
+	gradient.coeffRef (j) = 1.;
+    }
+  };
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (constraint_block_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef GenericLinearFunction<T> linearFunction_t;
+  typedef Problem<differentiableFunction_t,
+		  boost::mpl::vector<linearFunction_t,
+				     differentiableFunction_t> > problem_t;
+  typedef typename GenericNumericLinearFunction<T>::matrix_t matrix_t;
+  typedef typename problem_t::vector_t vector_t;
+  typedef typename ConstraintBlock<problem_t>::jacobian_t jacobian_t;
+
+  // Cost: f(x) = x_0 + x_1 + x_2
+  matrix_t a (1, 3);
+  for (int j = 0; j < 3; ++j)
+    a.coeffRef (0, j) = 1.;
+  vector_t b (1);
+  b.setZero ();
+  GenericNumericLinearFunction<T> cost (a, b);
+
+  problem_t problem (cost);
+
+  // Linear constraint: 2 rows.
+  matrix_t c (2, 3);
+  c.coeffRef (0, 0) = 1.;
+  c.coeffRef (0, 2) = -1.;
+  c.coeffRef (1, 1) = 2.;
+  vector_t d (2);
+  d << 1., -1.;
+  boost::shared_ptr<linearFunction_t> linear =
+    boost::make_shared<GenericNumericLinearFunction<T> > (c, d);
+
+  // Nonlinear constraint: 3 rows.
+  boost::shared_ptr<differentiableFunction_t> cosinus =
+    boost::make_shared<Cos<T> > ();
+  boost::shared_ptr<differentiableFunction_t> cosinuses =
+    roboptim::map (cosinus, 3);
+
+  typename problem_t::intervals_t intervals2
+    (2, differentiableFunction_t::makeInterval (-1., 1.));
+  typename problem_t::intervals_t intervals3
+    (3, differentiableFunction_t::makeInterval (-1., 1.));
+  problem.template addConstraint<linearFunction_t>
+    (linear, intervals2, typename problem_t::scales_t (2, 1.));
+  problem.template addConstraint<differentiableFunction_t>
+    (cosinuses, intervals3, typename problem_t::scales_t (3, 1.));
+
+  ConstraintBlock<problem_t> block (problem);
+
+  BOOST_CHECK_EQUAL (block.inputSize (), 3);
+  BOOST_CHECK_EQUAL (block.outputSize (), 5);
+  BOOST_REQUIRE_EQUAL (block.offsets ().size (), 3);
+  BOOST_CHECK_EQUAL (block.offsets ()[0], 0);
+  BOOST_CHECK_EQUAL (block.offsets ()[1], 2);
+  BOOST_CHECK_EQUAL (block.offsets ()[2], 5);
+
+  vector_t x (3);
+  x << 0.5, -1., 2.;
+
+  vector_t expected (5);
+  expected.segment (0, 2) = (*linear) (x);
+  expected.segment (2, 3) = (*cosinuses) (x);
+  BOOST_CHECK (block (x) == expected);
+
+  typename linearFunction_t::jacobian_t linearJacobian = linear->jacobian (x);
+  typename differentiableFunction_t::jacobian_t cosJacobian =
+    cosinuses->jacobian (x);
+
+  // Evaluate twice to check that the jacobian is rebuilt from scratch.
+  jacobian_t jacobian = block.jacobian (x);
+  block.jacobian (jacobian, x);
+
+  for (int j = 0; j < 3; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+	BOOST_CHECK_EQUAL (jacobian.coeff (i, j), linearJacobian.coeff (i, j));
+      for (int i = 0; i < 3; ++i)
+	BOOST_CHECK_EQUAL (jacobian.coeff (2 + i, j), cosJacobian.coeff (i, j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (constraint_block_pool_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef Problem<differentiableFunction_t,
+		  boost::mpl::vector<differentiableFunction_t> > problem_t;
+  typedef typename problem_t::vector_t vector_t;
+  typedef typename ConstraintBlock<problem_t>::jacobian_t jacobian_t;
+
+  Slow<T> cost;
+  problem_t problem (cost);
+
+  boost::shared_ptr<differentiableFunction_t> cosinus =
+    boost::make_shared<Cos<T> > ();
+  boost::shared_ptr<differentiableFunction_t> cosinuses =
+    roboptim::map (cosinus, 3);
+  boost::shared_ptr<differentiableFunction_t> slow =
+    boost::make_shared<Slow<T> > ();
+
+  typename problem_t::intervals_t intervals
+    (3, differentiableFunction_t::makeInterval (-1., 1.));
+  typename problem_t::scales_t scales (3, 1.);
+  for (int i = 0; i < 3; ++i)
+    problem.template addConstraint<differentiableFunction_t>
+      (cosinuses, intervals, scales);
+  problem.template addConstraint<differentiableFunction_t>
+    (slow, differentiableFunction_t::makeInterval (-1., 1.));
+
+  ConstraintBlock<problem_t> serial (problem);
+  ConstraintBlock<problem_t> parallel (problem);
+  ThreadPool pool (2);
+  parallel.setThreadPool (&pool);
+
+  vector_t x (3);
+  x << 0.5, -1., 2.;
+
+  const vector_t expected = serial (x);
+  const jacobian_t expectedJacobian = serial.jacobian (x);
+
+  for (int k = 0; k < 3; ++k)
+    {
+      BOOST_CHECK (parallel (x) == expected);
+      jacobian_t jacobian = parallel.jacobian (x);
+      for (int i = 0; i < serial.outputSize (); ++i)
+	for (int j = 0; j < serial.inputSize (); ++j)
+	  BOOST_CHECK_EQUAL (jacobian.coeff (i, j),
+			     expectedJacobian.coeff (i, j));
+    }
+
+  // The slow constraint has been learned as the heaviest one.
+  BOOST_CHECK_EQUAL (parallel.valueSchedule ()[0], 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -37,7 +37,7 @@ struct Null : public GenericDifferentiableFunction<T>
   Null () : GenericDifferentiableFunction<T> (1, 1, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -58,7 +58,7 @@ struct NoTitle : public GenericDifferentiableFunction<T>
   NoTitle () : GenericDifferentiableFunction<T> (1, 1)
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -157,7 +157,7 @@ struct F : public GenericDifferentiableFunction<T>
   F () : GenericDifferentiableFunction<T> (4, 2, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t& x) const throw ()
+  void impl_compute (result_ref res, const argument_t& x) const throw ()
   {
     res[0] = x[0] * x[1];
     res[1] = x[2] * x[3];
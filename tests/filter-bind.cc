@@ -79,4 +79,69 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (rebind_test, T, functionTypes_t)
+{
+  typedef typename GenericIdentityFunction<T>::value_type value_type;
+  typedef typename GenericIdentityFunction<T>::vector_t vector_t;
+  typename GenericIdentityFunction<T>::result_t offset (5);
+  offset.setZero ();
+
+  boost::shared_ptr<GenericIdentityFunction<T> > identity =
+    boost::make_shared<GenericIdentityFunction<T> > (offset);
+
+  std::vector<boost::optional<value_type> > boundValues
+    (5, boost::optional<value_type> ());
+  boundValues[1] = 2.;
+  boundValues[3] = 3.;
+
+  boost::shared_ptr<Bind<GenericIdentityFunction<T> > >
+    fct = bind (identity, boundValues);
+
+  BOOST_CHECK_EQUAL (fct->inputSize (), 3);
+  BOOST_REQUIRE_EQUAL (fct->freeIndices ().size (), 3);
+  BOOST_CHECK_EQUAL (fct->freeIndices ()[0], 0);
+  BOOST_CHECK_EQUAL (fct->freeIndices ()[1], 2);
+  BOOST_CHECK_EQUAL (fct->freeIndices ()[2], 4);
+  BOOST_REQUIRE_EQUAL (fct->boundIndices ().size (), 2);
+  BOOST_CHECK_EQUAL (fct->boundIndices ()[0], 1);
+  BOOST_CHECK_EQUAL (fct->boundIndices ()[1], 3);
+
+  typename GenericIdentityFunction<T>::argument_t x (3);
+  x << 1., 2., 3.;
+
+  vector_t expected (5);
+  expected << 1., 2., 2., 3., 3.;
+  BOOST_CHECK ((*fct) (x) == expected);
+
+  // Rebind without rebuilding the filter.
+  vector_t values (2);
+  values << 7., 8.;
+  fct->setBoundValues (values);
+  BOOST_CHECK (fct->boundValues () == values);
+
+  expected << 1., 7., 2., 8., 3.;
+  BOOST_CHECK ((*fct) (x) == expected);
+
+  BOOST_CHECK_THROW (fct->setBoundValues (vector_t (3)),
+		     std::runtime_error);
+
+  typename GenericIdentityFunction<T>::jacobian_t
+    jacobian = fct->jacobian (x);
+  for (typename GenericIdentityFunction<T>::size_type i = 0; i < 5; ++i)
+    for (typename GenericIdentityFunction<T>::size_type j = 0; j < 3; ++j)
+      BOOST_CHECK_EQUAL (jacobian.coeff (i, j),
+			 i == fct->freeIndices ()[j] ? 1. : 0.);
+
+  // Gradients of bound outputs are zero, the others keep their
+  // nonzero on the free input.
+  typename GenericIdentityFunction<T>::gradient_t
+    gradient = fct->gradient (x, 2);
+  BOOST_CHECK_EQUAL (gradient.coeff (0), 0.);
+  BOOST_CHECK_EQUAL (gradient.coeff (1), 1.);
+  BOOST_CHECK_EQUAL (gradient.coeff (2), 0.);
+  gradient = fct->gradient (x, 3);
+  for (typename GenericIdentityFunction<T>::size_type j = 0; j < 3; ++j)
+    BOOST_CHECK_EQUAL (gradient.coeff (j), 0.);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
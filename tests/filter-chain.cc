@@ -27,6 +27,7 @@
 
 #include <roboptim/core/finite-difference-gradient.hh>
 #include <roboptim/core/io.hh>
+#include <roboptim/core/filter/bind.hh>
 #include <roboptim/core/filter/chain.hh>
 #include <roboptim/core/filter/selection.hh>
 #include <roboptim/core/numeric-linear-function.hh>
@@ -201,4 +202,168 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_jacobian_test, T, functionTypes_t)
     }
 }
 
+// Count how many times the function has been evaluated.
+//
+// f(x) = (x_0^2, x_0 * x_1, x_1^2)
+template <typename T>
+struct CountingFunction : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  CountingFunction ()
+    : GenericDifferentiableFunction<T> (2, 3, "counting function"),
+      computeCalls (0),
+      gradientCalls (0)
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    ++computeCalls;
+    result[0] = x[0] * x[0];
+    result[1] = x[0] * x[1];
+    result[2] = x[1] * x[1];
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type functionId = 0)
+    const throw ()
+  {
+    ++gradientCalls;
+    gradient.setZero ();
+    switch (functionId)
+      {
+      case 0:
+	gradient.coeffRef (0) = 2. * x[0];
+	break;
+      case 1:
+	gradient.coeffRef (0) = x[1];
+	gradient.coeffRef (1) = x[0];
+	break;
+      default:
+	gradient.coeffRef (1) = 2. * x[1];
+      }
+  }
+
+  mutable unsigned computeCalls;
+  mutable unsigned gradientCalls;
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (chain_cache_test, T, functionTypes_t)
+{
+  typedef typename GenericNumericLinearFunction<T>::matrix_t matrix_t;
+  typedef typename GenericNumericLinearFunction<T>::vector_t vector_t;
+
+  boost::shared_ptr<CountingFunction<T> > g =
+    boost::make_shared<CountingFunction<T> > ();
+
+  // f(y) = 2 * y_1: only the second output of g is needed to
+  // compute the chain gradient.
+  matrix_t A (1, 3);
+  A.setZero ();
+  A (0, 1) = 2.;
+  vector_t b (1);
+  b.setZero ();
+  boost::shared_ptr<GenericNumericLinearFunction<T> > f =
+    boost::make_shared<GenericNumericLinearFunction<T> > (A, b);
+
+  boost::shared_ptr<Chain<GenericDifferentiableFunction<T>,
+			  GenericDifferentiableFunction<T> > > h =
+    chain<
+      GenericDifferentiableFunction<T>,
+      GenericDifferentiableFunction<T> >
+  (f, g);
+
+  vector_t x (2);
+  x[0] = 3.;
+  x[1] = -2.;
+
+  // Compute and gradient at the same point: g is evaluated once, and
+  // only its second gradient is computed.
+  BOOST_CHECK_CLOSE ((*h) (x)[0], 2. * x[0] * x[1], 1e-8);
+  vector_t gradient = h->gradient (x, 0);
+  BOOST_CHECK_EQUAL (g->computeCalls, 1u);
+  BOOST_CHECK_EQUAL (g->gradientCalls, 1u);
+  BOOST_CHECK_CLOSE (gradient[0], 2. * x[1], 1e-8);
+  BOOST_CHECK_CLOSE (gradient[1], 2. * x[0], 1e-8);
+
+  // The jacobian reuses the cached inner value.
+  matrix_t jacobian = h->jacobian (x);
+  BOOST_CHECK_EQUAL (g->computeCalls, 1u);
+  BOOST_CHECK_EQUAL (g->gradientCalls, 4u);
+  BOOST_CHECK_CLOSE (jacobian (0, 0), gradient[0], 1e-8);
+  BOOST_CHECK_CLOSE (jacobian (0, 1), gradient[1], 1e-8);
+
+  // Once the inner jacobian is known, the gradient reuses it.
+  h->gradient (x, 0);
+  BOOST_CHECK_EQUAL (g->gradientCalls, 4u);
+
+  // Moving to another point invalidates the cache.
+  x[0] = 1.;
+  (*h) (x);
+  BOOST_CHECK_EQUAL (g->computeCalls, 2u);
+
+  // Invalidating the cache forces a new evaluation at the same point.
+  (*h) (x);
+  BOOST_CHECK_EQUAL (g->computeCalls, 2u);
+  h->jacobian (x);
+  const unsigned gradientCalls = g->gradientCalls;
+  h->invalidate ();
+  (*h) (x);
+  BOOST_CHECK_EQUAL (g->computeCalls, 3u);
+  h->jacobian (x);
+  BOOST_CHECK_EQUAL (g->gradientCalls, gradientCalls + 3u);
+
+  CHECK_GRADIENT (*h, 0, x);
+  CHECK_JACOBIAN (*h, x);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (chain_rebind_test, T, functionTypes_t)
+{
+  typedef typename GenericNumericLinearFunction<T>::matrix_t matrix_t;
+  typedef typename GenericNumericLinearFunction<T>::vector_t vector_t;
+  typedef typename GenericIdentityFunction<T>::value_type value_type;
+
+  vector_t offset (3);
+  offset.setZero ();
+  boost::shared_ptr<GenericIdentityFunction<T> > identity =
+    boost::make_shared<GenericIdentityFunction<T> > (offset);
+
+  std::vector<boost::optional<value_type> > boundValues
+    (3, boost::optional<value_type> ());
+  boundValues[1] = 2.;
+  boost::shared_ptr<Bind<GenericIdentityFunction<T> > >
+    g = bind (identity, boundValues);
+
+  // f(y) = y_0 + y_1 + y_2
+  matrix_t A (1, 3);
+  A.setOnes ();
+  vector_t b (1);
+  b.setZero ();
+  boost::shared_ptr<GenericNumericLinearFunction<T> > f =
+    boost::make_shared<GenericNumericLinearFunction<T> > (A, b);
+
+  boost::shared_ptr<Chain<GenericDifferentiableFunction<T>,
+			  GenericDifferentiableFunction<T> > > h =
+    chain<
+      GenericDifferentiableFunction<T>,
+      GenericDifferentiableFunction<T> >
+  (f, g);
+
+  vector_t x (2);
+  x[0] = 1.;
+  x[1] = 3.;
+  BOOST_CHECK_CLOSE ((*h) (x)[0], 6., 1e-8);
+
+  // Rebinding the inner function is seen by the chain without
+  // invalidating its cache.
+  vector_t values (1);
+  values[0] = 5.;
+  g->setBoundValues (values);
+  BOOST_CHECK_CLOSE ((*h) (x)[0], 9., 1e-8);
+  CHECK_GRADIENT (*h, 0, x);
+  CHECK_JACOBIAN (*h, x);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -24,10 +24,15 @@
 #include <iostream>
 
 #include <roboptim/core/io.hh>
+#include <roboptim/core/filter/chain.hh>
 #include <roboptim/core/filter/derivative.hh>
+#include <roboptim/core/filter/map.hh>
+#include <roboptim/core/filter/plus.hh>
+#include <roboptim/core/filter/product.hh>
 
 #include <roboptim/core/function/cos.hh>
 #include <roboptim/core/function/identity.hh>
+#include <roboptim/core/function/sin.hh>
 
 using namespace roboptim;
 
@@ -64,5 +69,41 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (nonscalar_derivative_test, T, functionTypes_t)
     << (*fct) (x) << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (directional_derivative_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+
+  boost::shared_ptr<function_t> cosinus = boost::make_shared<Cos<T> > ();
+  boost::shared_ptr<function_t> sinus = boost::make_shared<Sin<T> > ();
+
+  // f(x) = map (cos (sin (x)) + sin (x) cos (x), 3)
+  boost::shared_ptr<function_t> c = chain (cosinus, sinus);
+  boost::shared_ptr<function_t> p = product (sinus, cosinus);
+  boost::shared_ptr<function_t> f = roboptim::map (plus (c, p), 3);
+
+  typename function_t::argument_t x (3);
+  x << 0.1, -0.7, 1.3;
+  typename function_t::argument_t direction (3);
+  direction << 0.5, 2., -1.;
+
+  typename function_t::jacobian_t jacobian = f->jacobian (x);
+  typename function_t::result_t jd = f->directionalDerivative (x, direction);
+
+  for (typename function_t::size_type i = 0; i < f->outputSize (); ++i)
+    {
+      double expected = 0.;
+      for (typename function_t::size_type j = 0; j < f->inputSize (); ++j)
+	expected += jacobian.coeff (i, j) * direction[j];
+      BOOST_CHECK_CLOSE (jd[i] + 1., expected + 1., 1e-8);
+    }
+
+  // Each derivative is one column of the jacobian.
+  for (typename function_t::size_type j = 0; j < f->inputSize (); ++j)
+    {
+      typename function_t::result_t column = (*derivative (f, j)) (x);
+      for (typename function_t::size_type i = 0; i < f->outputSize (); ++i)
+	BOOST_CHECK_CLOSE (column[i] + 1., jacobian.coeff (i, j) + 1., 1e-8);
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,97 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/mpl/list.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/test/test_case_template.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/filter/multi-concatenate.hh>
+
+#include <roboptim/core/function/cos.hh>
+#include <roboptim/core/function/sin.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (multi_concatenate_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+
+  std::vector<boost::shared_ptr<function_t> > functions;
+  for (int i = 0; i < 4; ++i)
+    {
+      if (i % 2)
+	functions.push_back (boost::make_shared<Sin<T> > ());
+      else
+	functions.push_back (boost::make_shared<Cos<T> > ());
+    }
+
+  boost::shared_ptr<MultiConcatenate<function_t> >
+    fct = concatenate (functions);
+
+  BOOST_CHECK_EQUAL (fct->inputSize (), 1);
+  BOOST_CHECK_EQUAL (fct->outputSize (), 4);
+  BOOST_CHECK_EQUAL (fct->offset (2), 2);
+
+  typename function_t::argument_t x (1);
+  x[0] = 0.5;
+
+  typename function_t::result_t result = (*fct) (x);
+  for (typename function_t::size_type i = 0; i < 4; ++i)
+    {
+      BOOST_CHECK_CLOSE (result[i], (*functions[i]) (x)[0], 1e-8);
+      BOOST_CHECK_CLOSE (fct->gradient (x, i).coeff (0),
+			 functions[i]->gradient (x, 0).coeff (0), 1e-8);
+    }
+
+  typename function_t::jacobian_t jacobian = fct->jacobian (x);
+
+  // Concurrent evaluation must give the same results.
+  ThreadPool pool (2);
+  fct->setThreadPool (&pool);
+
+  typename function_t::result_t resultPool = (*fct) (x);
+  typename function_t::jacobian_t jacobianPool = fct->jacobian (x);
+  for (typename function_t::size_type i = 0; i < 4; ++i)
+    {
+      BOOST_CHECK_EQUAL (result[i], resultPool[i]);
+      BOOST_CHECK_EQUAL (jacobian.coeff (i, 0), jacobianPool.coeff (i, 0));
+    }
+
+  std::cout
+    << fct->getName () << "\n"
+    << resultPool << "\n"
+    << jacobianPool << std::endl;
+
+  // At least one function is required.
+  BOOST_CHECK_THROW
+    (concatenate (std::vector<boost::shared_ptr<function_t> > ()),
+     std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
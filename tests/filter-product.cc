@@ -23,7 +23,9 @@
 
 #include <iostream>
 
+#include <roboptim/core/finite-difference-gradient.hh>
 #include <roboptim/core/io.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 #include <roboptim/core/filter/product.hh>
 
 #include <roboptim/core/function/constant.hh>
@@ -62,4 +64,99 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (product_test, T, functionTypes_t)
     << fct->jacobian (x) << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (product_rule_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+  typedef typename GenericNumericLinearFunction<T>::matrix_t matrix_t;
+  typedef typename GenericNumericLinearFunction<T>::vector_t vector_t;
+
+  // f(x) = A x + b, g(x) = C x + d
+  matrix_t a (3, 4);
+  matrix_t c (3, 4);
+  vector_t b (3);
+  vector_t d (3);
+  for (int i = 0; i < 3; ++i)
+    {
+      a.coeffRef (i, i) = 1. + i;
+      a.coeffRef (i, 3) = -2.;
+      c.coeffRef (i, i + 1) = 0.5;
+      b[i] = 1.;
+      d[i] = -1. - i;
+    }
+
+  boost::shared_ptr<function_t> f =
+    boost::make_shared<GenericNumericLinearFunction<T> > (a, b);
+  boost::shared_ptr<function_t> g =
+    boost::make_shared<GenericNumericLinearFunction<T> > (c, d);
+  boost::shared_ptr<function_t> fct = f * g;
+
+  typename function_t::argument_t x (4);
+  x << 0.5, -1., 2., 0.25;
+
+  typename function_t::result_t fx = (*f) (x);
+  typename function_t::result_t gx = (*g) (x);
+
+  typename function_t::jacobian_t jacobian = fct->jacobian (x);
+
+  for (int i = 0; i < 3; ++i)
+    {
+      typename function_t::gradient_t gradient = fct->gradient (x, i);
+
+      // (f_i g_i)' = g_i a_i + f_i c_i
+      for (int j = 0; j < 4; ++j)
+	{
+	  double expected = gx[i] * a.coeff (i, j) + fx[i] * c.coeff (i, j);
+	  BOOST_CHECK_CLOSE (gradient.coeff (j) + 1., expected + 1., 1e-8);
+	  BOOST_CHECK_CLOSE (jacobian.coeff (i, j) + 1., expected + 1., 1e-8);
+	}
+      BOOST_CHECK (checkGradient (*fct, i, x));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (product_rule_zero_factor_test, T,
+			       functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+  typedef typename GenericNumericLinearFunction<T>::matrix_t matrix_t;
+  typedef typename GenericNumericLinearFunction<T>::vector_t vector_t;
+
+  // f(x) = x + b, g(x) = 2 x, evaluated at x = 0 so that g vanishes
+  // (and f too when b = 0).
+  matrix_t a (2, 2);
+  matrix_t c (2, 2);
+  vector_t b (2);
+  vector_t d (2);
+  for (int i = 0; i < 2; ++i)
+    {
+      a.coeffRef (i, i) = 1.;
+      c.coeffRef (i, i) = 2.;
+      d[i] = 0.;
+    }
+  b[0] = 0.;
+  b[1] = 1.;
+
+  boost::shared_ptr<function_t> f =
+    boost::make_shared<GenericNumericLinearFunction<T> > (a, b);
+  boost::shared_ptr<function_t> g =
+    boost::make_shared<GenericNumericLinearFunction<T> > (c, d);
+  boost::shared_ptr<function_t> fct = f * g;
+
+  typename function_t::argument_t x (2);
+  x.setZero ();
+
+  for (int i = 0; i < 2; ++i)
+    {
+      // The in-place API must not accumulate into a dirty buffer.
+      typename function_t::gradient_t gradient (2);
+      for (int j = 0; j < 2; ++j)
+	gradient.coeffRef (j) = 42.;
+      fct->gradient (gradient, x, i);
+
+      // (f_i g_i)' = g_i a_i + f_i c_i = b_i c_i
+      for (int j = 0; j < 2; ++j)
+	BOOST_CHECK_CLOSE (gradient.coeff (j) + 1.,
+			   b[i] * c.coeff (i, j) + 1., 1e-8);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
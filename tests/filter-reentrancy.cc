@@ -0,0 +1,218 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/mpl/list.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/aligned_storage.hpp>
+#include <boost/bind.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <vector>
+
+#include <roboptim/core/thread-pool.hh>
+#include <roboptim/core/detail/thread-local.hh>
+#include <roboptim/core/filter/chain.hh>
+#include <roboptim/core/filter/map.hh>
+#include <roboptim/core/filter/minus.hh>
+#include <roboptim/core/filter/plus.hh>
+
+#include <roboptim/core/function/cos.hh>
+#include <roboptim/core/function/sin.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense> functionTypes_t;
+
+namespace
+{
+  template <typename T>
+  struct Evaluate
+  {
+    typedef GenericDifferentiableFunction<T> function_t;
+
+    Evaluate (const function_t& f,
+	      std::vector<typename function_t::result_t>& results,
+	      std::vector<typename function_t::gradient_t>& gradients)
+      : f_ (f),
+	results_ (results),
+	gradients_ (gradients)
+    {}
+
+    void operator () (std::size_t i) const
+    {
+      typename function_t::argument_t x (f_.inputSize ());
+      x.setConstant (0.01 * static_cast<double> (i));
+      // Evaluate several times to interleave with other threads.
+      for (int k = 0; k < 10; ++k)
+	{
+	  f_ (results_[i], x);
+	  f_.gradient (gradients_[i], x, 0);
+	}
+    }
+
+    const function_t& f_;
+    std::vector<typename function_t::result_t>& results_;
+    std::vector<typename function_t::gradient_t>& gradients_;
+  };
+
+  typedef detail::ThreadLocal<int> threadLocal_t;
+
+  // Read a thread-local value before and after the object has been
+  // replaced by another one at the same address.
+  struct ReadTwice
+  {
+    ReadTwice (threadLocal_t* value, boost::barrier& barrier,
+	       std::vector<int>& seen)
+      : value_ (value),
+	barrier_ (barrier),
+	seen_ (seen)
+    {}
+
+    void operator () () const
+    {
+      seen_.push_back (value_->get ());
+      value_->get () = 42;
+      barrier_.wait ();
+      barrier_.wait ();
+      seen_.push_back (value_->get ());
+    }
+
+    threadLocal_t* value_;
+    boost::barrier& barrier_;
+    std::vector<int>& seen_;
+  };
+
+  // Count the living copies of a thread-local value.
+  struct Counted
+  {
+    Counted ()
+    {
+      ++alive;
+    }
+
+    Counted (const Counted&)
+    {
+      ++alive;
+    }
+
+    ~Counted ()
+    {
+      --alive;
+    }
+
+    static boost::atomic<int> alive;
+  };
+
+  boost::atomic<int> Counted::alive (0);
+
+  struct Touch
+  {
+    explicit Touch (const detail::ThreadLocal<Counted>& value)
+      : value_ (value)
+    {}
+
+    void operator () (std::size_t) const
+    {
+      value_.get ();
+      // Keep the worker busy so that all workers get a task.
+      boost::this_thread::sleep (boost::posix_time::milliseconds (10));
+    }
+
+    const detail::ThreadLocal<Counted>& value_;
+  };
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (reentrancy_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+
+  boost::shared_ptr<Cos<T> > cosinus = boost::make_shared<Cos<T> > ();
+  boost::shared_ptr<Sin<T> > sinus = boost::make_shared<Sin<T> > ();
+
+  // f(x) = map (cos (sin (x)) + sin (x) - cos (x), 2)
+  boost::shared_ptr<function_t> c = chain (cosinus, sinus);
+  boost::shared_ptr<function_t> m = minus (sinus, cosinus);
+  boost::shared_ptr<function_t> f = roboptim::map (plus (c, m), 2);
+
+  const std::size_t n = 64;
+  std::vector<typename function_t::result_t>
+    results (n, typename function_t::result_t (f->outputSize ()));
+  std::vector<typename function_t::gradient_t>
+    gradients (n, typename function_t::gradient_t (f->inputSize ()));
+  std::vector<typename function_t::result_t> expectedResults (results);
+  std::vector<typename function_t::gradient_t> expectedGradients (gradients);
+
+  for (std::size_t i = 0; i < n; ++i)
+    Evaluate<T> (*f, expectedResults, expectedGradients) (i);
+
+  // Evaluate the same filter objects from several threads.
+  ThreadPool pool (4);
+  pool.run (n, Evaluate<T> (*f, results, gradients));
+
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      BOOST_CHECK (results[i] == expectedResults[i]);
+      BOOST_CHECK (gradients[i] == expectedGradients[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (thread_local_reuse)
+{
+  boost::aligned_storage<sizeof (threadLocal_t),
+			 boost::alignment_of<threadLocal_t>::value> storage;
+  threadLocal_t* value = new (storage.address ()) threadLocal_t (1);
+
+  boost::barrier barrier (2);
+  std::vector<int> seen;
+  boost::thread thread (ReadTwice (value, barrier, seen));
+
+  // Replace the object while the thread still holds its value: the
+  // thread must not see the value of the destroyed object.
+  barrier.wait ();
+  value->~threadLocal_t ();
+  value = new (storage.address ()) threadLocal_t (7);
+  barrier.wait ();
+  thread.join ();
+
+  BOOST_REQUIRE_EQUAL (seen.size (), 2u);
+  BOOST_CHECK_EQUAL (seen[0], 1);
+  BOOST_CHECK_EQUAL (seen[1], 7);
+  value->~threadLocal_t ();
+}
+
+BOOST_AUTO_TEST_CASE (thread_local_release)
+{
+  // The pool workers outlive the values: the values must be released
+  // with their owner, not when the workers exit.
+  ThreadPool pool (4);
+  {
+    detail::ThreadLocal<Counted> value;
+    pool.run (16, Touch (value));
+    BOOST_CHECK_GT (Counted::alive, 1);
+  }
+  BOOST_CHECK_EQUAL (Counted::alive, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,117 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/test/test_case_template.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/filter/scaling.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+namespace
+{
+  /// \brief f(x) = (x0 x1, x0 + 3 x1)
+  template <typename T>
+  struct Quadratic : public GenericDifferentiableFunction<T>
+  {
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericDifferentiableFunction<T>);
+
+    Quadratic () : GenericDifferentiableFunction<T> (2, 2, "quadratic")
+    {}
+
+    void impl_compute (result_ref result, const argument_t& x) const throw ()
+    {
+      result[0] = x[0] * x[1];
+      result[1] = x[0] + 3. * x[1];
+    }
+
+    void impl_gradient (gradient_t& gradient, const argument_t& x,
+			size_type functionId) const throw ()
+    {
+      if (functionId == 0)
+	{
+	  gradient.coeffRef (0) = x[1];
+	  gradient.coeffRef (1) = x[0];
+	}
+      else
+	{
+	  gradient.coeffRef (0) = 1.;
+	  gradient.coeffRef (1) = 3.;
+	}
+    }
+  };
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (scaling_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef typename differentiableFunction_t::vector_t vector_t;
+
+  boost::shared_ptr<differentiableFunction_t> f =
+    boost::make_shared<Quadratic<T> > ();
+
+  vector_t r (2);
+  r << 2., .5;
+  vector_t s (2);
+  s << 10., .1;
+  boost::shared_ptr<Scaling<differentiableFunction_t> > g = scaling (f, r, s);
+
+  vector_t x (2);
+  x << 3., -2.;
+  const vector_t y = g->scaleArgument (x);
+  BOOST_CHECK_CLOSE (y[0], 30., 1e-8);
+  BOOST_CHECK (g->unscaleArgument (y).isApprox (x));
+
+  // Values: r * f (y / s).
+  const vector_t value = (*g) (y);
+  BOOST_CHECK_CLOSE (value[0], 2. * -6., 1e-8);
+  BOOST_CHECK_CLOSE (value[1], .5 * -3., 1e-8);
+
+  // Jacobian: diag (r) J diag (s)^-1.
+  Eigen::MatrixXd expected (2, 2);
+  expected <<
+    2. * -2. / 10., 2. * 3. / .1,
+    .5 * 1. / 10., .5 * 3. / .1;
+
+  const Eigen::MatrixXd jacobian (g->jacobian (y));
+  BOOST_CHECK (jacobian.isApprox (expected));
+
+  for (typename vector_t::Index i = 0; i < 2; ++i)
+    for (typename vector_t::Index j = 0; j < 2; ++j)
+      BOOST_CHECK_CLOSE (g->gradient (y, i).coeff (j), expected (i, j), 1e-8);
+
+  vector_t d (2);
+  d << 1., -1.;
+  BOOST_CHECK (g->directionalDerivative (y, d).isApprox (expected * d));
+
+  BOOST_CHECK_THROW (scaling (f, r, vector_t (3)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,117 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <boost/mpl/list.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/bind.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <roboptim/core/detail/workspace.hh>
+#include <roboptim/core/filter/plus.hh>
+
+#include <roboptim/core/function/cos.hh>
+#include <roboptim/core/function/sin.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense> functionTypes_t;
+
+namespace
+{
+  template <typename T>
+  void evaluate (const GenericDifferentiableFunction<T>& f,
+		 typename GenericDifferentiableFunction<T>::result_t& result,
+		 typename GenericDifferentiableFunction<T>::gradient_t& gradient,
+		 std::size_t& workspaceSize)
+  {
+    typedef GenericDifferentiableFunction<T> function_t;
+    typedef typename function_t::vector_t vector_t;
+
+    typename function_t::argument_t x (f.inputSize ());
+    x.setConstant (0.5);
+    f (result, x);
+    f.gradient (gradient, x, 0);
+    workspaceSize = detail::Workspace<vector_t>::local ().size ();
+  }
+
+  template <typename T>
+  void build (std::size_t& workspaceSize)
+  {
+    typedef GenericDifferentiableFunction<T> function_t;
+    typedef typename function_t::vector_t vector_t;
+
+    boost::shared_ptr<function_t> cosinus = boost::make_shared<Cos<T> > ();
+    boost::shared_ptr<function_t> sinus = boost::make_shared<Sin<T> > ();
+    boost::shared_ptr<function_t> f = plus (cosinus, sinus);
+    workspaceSize = detail::Workspace<vector_t>::local ().size ();
+  }
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (workspace_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+
+  boost::shared_ptr<function_t> cosinus = boost::make_shared<Cos<T> > ();
+  boost::shared_ptr<function_t> sinus = boost::make_shared<Sin<T> > ();
+
+  // f(x) = (cos (x) + sin (x)) + (sin (x) + cos (x))
+  boost::shared_ptr<function_t> left = plus (cosinus, sinus);
+  boost::shared_ptr<function_t> right = plus (sinus, cosinus);
+  boost::shared_ptr<function_t> f = plus (left, right);
+
+  typename function_t::result_t result (f->outputSize ());
+  typename function_t::gradient_t gradient (f->inputSize ());
+  std::size_t workspaceSize = 0;
+
+  // Use a new thread to start from an empty workspace.
+  boost::thread thread (boost::bind (&evaluate<T>, boost::cref (*f),
+				     boost::ref (result),
+				     boost::ref (gradient),
+				     boost::ref (workspaceSize)));
+  thread.join ();
+
+  const double expected = 2. * (std::cos (0.5) + std::sin (0.5));
+  BOOST_CHECK_CLOSE (result[0], expected, 1e-8);
+  BOOST_CHECK_CLOSE (gradient[0], 2. * (std::cos (0.5) - std::sin (0.5)),
+		     1e-8);
+
+  // The three Plus filters need one temporary each, but the
+  // temporaries of the two inner filters are never used at the same
+  // time: they share the same buffer.
+  BOOST_CHECK_EQUAL (workspaceSize, 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (workspace_reserve, T, functionTypes_t)
+{
+  std::size_t workspaceSize = 0;
+
+  // Building a filter reserves its buffers in the workspace of the
+  // building thread.
+  boost::thread thread (boost::bind (&build<T>, boost::ref (workspaceSize)));
+  thread.join ();
+
+  BOOST_CHECK_EQUAL (workspaceSize, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -41,7 +41,7 @@ struct FGood : public GenericDifferentiableFunction<T>
   FGood () : GenericDifferentiableFunction<T> (1, 1, "x * x")
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) = argument[0] * argument[0];
@@ -79,7 +79,7 @@ struct FBad : public GenericDifferentiableFunction<T>
   FBad () : GenericDifferentiableFunction<T> (1, 1, "x * x")
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) = argument[0] * argument[0];
@@ -116,7 +116,7 @@ struct Polynomial : public GenericDifferentiableFunction<T>
   Polynomial () : GenericDifferentiableFunction<T> (1, 1)
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) = -24 * argument[0] * argument[0] + 33 * argument[0] + 5;
@@ -154,7 +154,7 @@ struct CircleXY : public GenericDifferentiableFunction<T>
   CircleXY () : GenericDifferentiableFunction<T> (1, 2)
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) = sin (argument[0]);
@@ -219,7 +219,7 @@ struct Times : public GenericDifferentiableFunction<T>
   Times () : GenericDifferentiableFunction<T> (2, 1)
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const vector_t& argument) const throw ()
   {
     result (0) = argument[0] * argument[1];
@@ -42,7 +42,7 @@ struct FGood : public GenericDifferentiableFunction<T>
              (2, 2, "x * x + x * y + 2 * y, 3 * x * x * y")
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) =   argument[0] * argument[0]
@@ -54,7 +54,7 @@ struct FGood : public GenericDifferentiableFunction<T>
   void impl_gradient (gradient_t& grad, const argument_t& argument,
 		      size_type) const throw ();
 
-  void impl_jacobian (jacobian_t& jacobian,
+  void impl_jacobian (jacobian_ref jacobian,
                       const argument_t& argument) const throw ();
 
 };
@@ -73,7 +73,7 @@ FGood<T>::impl_gradient
 template <>
 void
 FGood<EigenMatrixSparse>::impl_jacobian
-(jacobian_t& jacobian, const argument_t& argument) const throw ()
+(jacobian_ref jacobian, const argument_t& argument) const throw ()
 {
   jacobian.setZero ();
   jacobian.insert(0,0) = 2. * argument[0] + argument[1];
@@ -85,7 +85,7 @@ FGood<EigenMatrixSparse>::impl_jacobian
 template <typename T>
 void
 FGood<T>::impl_jacobian
-(jacobian_t& jacobian, const argument_t& argument) const throw ()
+(jacobian_ref jacobian, const argument_t& argument) const throw ()
 {
   jacobian.setZero ();
   jacobian(0,0) = 2. * argument[0] + argument[1];
@@ -106,7 +106,7 @@ struct FBad : public GenericDifferentiableFunction<T>
             (2, 2, "x * x + x * y + 2 * y, 3 * x * x * y")
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) =   argument[0] * argument[0]
@@ -118,7 +118,7 @@ struct FBad : public GenericDifferentiableFunction<T>
   void impl_gradient (gradient_t& grad, const argument_t& argument,
 		      size_type) const throw ();
 
-  void impl_jacobian (jacobian_t& jacobian,
+  void impl_jacobian (jacobian_ref jacobian,
                       const argument_t& argument) const throw ();
 };
 
@@ -135,7 +135,7 @@ FBad<T>::impl_gradient
 template <>
 void
 FBad<EigenMatrixSparse>::impl_jacobian
-(jacobian_t& jacobian, const argument_t& argument) const throw ()
+(jacobian_ref jacobian, const argument_t& argument) const throw ()
 {
   jacobian.setZero ();
   jacobian.insert(0,0) = 2. * argument[0] + argument[1];
@@ -147,7 +147,7 @@ FBad<EigenMatrixSparse>::impl_jacobian
 template <typename T>
 void
 FBad<T>::impl_jacobian
-(jacobian_t& jacobian, const argument_t& argument) const throw ()
+(jacobian_ref jacobian, const argument_t& argument) const throw ()
 {
   jacobian.setZero ();
   jacobian(0,0) = 2. * argument[0] + argument[1];
@@ -33,11 +33,12 @@ struct Null : public GenericFunction<T>
 {
   typedef typename GenericFunction<T>::argument_t argument_t;
   typedef typename GenericFunction<T>::result_t result_t;
+  typedef typename GenericFunction<T>::result_ref result_ref;
 
   Null () : GenericFunction<T> (1, 1, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -48,11 +49,12 @@ struct NoTitle : public GenericFunction<T>
 {
   typedef typename GenericFunction<T>::argument_t argument_t;
   typedef typename GenericFunction<T>::result_t result_t;
+  typedef typename GenericFunction<T>::result_ref result_ref;
 
   NoTitle () : GenericFunction<T> (1, 1)
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -112,7 +114,7 @@ struct F : public Function
   F () : Function (1, 1, "first line\nsecond line\nthirdline")
   {}
     
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
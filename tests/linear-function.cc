@@ -29,7 +29,7 @@ struct Null : public LinearFunction
   Null () : LinearFunction (1, 1, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -46,7 +46,7 @@ struct NoTitle : public LinearFunction
   NoTitle () : LinearFunction (1, 1)
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -0,0 +1,275 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <vector>
+
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/linear-function.hh>
+#include <roboptim/core/multi-start.hh>
+#include <roboptim/core/sampling.hh>
+
+using namespace roboptim;
+
+typedef Solver<Function, boost::mpl::vector<Function> > solver_t;
+typedef Solver<DifferentiableFunction,
+	       boost::mpl::vector<LinearFunction, DifferentiableFunction> >
+differentiableSolver_t;
+
+struct F : public Function
+{
+  F () : Function (4, 1, "a * d * (a + b + c) + d")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& argument)
+    const throw ()
+  {
+    result (0) = argument[0] * argument[3]
+      * (argument[0] + argument[1] + argument[2]) + argument[3];
+  }
+};
+
+// Tilted double well: f(x) = (x^2 - 1)^2 + 0.3 x
+//
+// Local minima: x = -1.0355787 (f = -0.3054285, global) and
+// x = 0.9601496 (f = 0.2941465), separated by a maximum at
+// x = 0.0754292.
+struct DoubleWell : public DifferentiableFunction
+{
+  DoubleWell () : DifferentiableFunction (1, 1, "(x^2 - 1)^2 + 0.3 x")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    result[0] = (x[0] * x[0] - 1.) * (x[0] * x[0] - 1.) + .3 * x[0];
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = 4. * x[0] * (x[0] * x[0] - 1.) + .3;
+  }
+};
+
+// Check that each coordinate has exactly one point per stratum.
+static bool stratified (const Function::matrix_t& points)
+{
+  const Function::size_type n = points.cols ();
+  for (Function::size_type j = 0; j < points.rows (); ++j)
+    {
+      std::vector<int> count (static_cast<std::size_t> (n), 0);
+      for (Function::size_type i = 0; i < n; ++i)
+	{
+	  if (points (j, i) < 0. || points (j, i) >= 1.)
+	    return false;
+	  ++count[static_cast<std::size_t>
+		  (points (j, i) * static_cast<double> (n))];
+	}
+      for (std::size_t k = 0; k < count.size (); ++k)
+	if (count[k] != 1)
+	  return false;
+    }
+  return true;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (sampling)
+{
+  // Uniform sampling is reproducible.
+  Function::matrix_t uniform =
+    sampleUnitHypercube (50, 3, SAMPLING_UNIFORM, 42);
+  BOOST_CHECK_EQUAL (uniform.rows (), 3);
+  BOOST_CHECK_EQUAL (uniform.cols (), 50);
+  BOOST_CHECK (uniform.minCoeff () >= 0.);
+  BOOST_CHECK (uniform.maxCoeff () < 1.);
+  BOOST_CHECK (uniform == sampleUnitHypercube (50, 3, SAMPLING_UNIFORM, 42));
+  BOOST_CHECK (uniform != sampleUnitHypercube (50, 3, SAMPLING_UNIFORM, 43));
+
+  // Latin hypercube sampling: one point per stratum.
+  BOOST_CHECK (stratified
+	       (sampleUnitHypercube (37, 5, SAMPLING_LATIN_HYPERCUBE)));
+
+  // Sobol sequence: first points of the unshifted sequence.
+  SobolSequence sequence (2);
+  Function::vector_t x;
+  const double expected[4][2] =
+    {{0., 0.}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75}};
+  for (int i = 0; i < 4; ++i)
+    {
+      sequence.next (x);
+      BOOST_CHECK_EQUAL (x[0], expected[i][0]);
+      BOOST_CHECK_EQUAL (x[1], expected[i][1]);
+    }
+  BOOST_CHECK_EQUAL (sequence.index (), 4u);
+  sequence.reset ();
+  sequence.next (x);
+  BOOST_CHECK_EQUAL (x[0], 0.);
+
+  // 2^k Sobol points are stratified, with or without shift, for
+  // tabulated and generated direction numbers.
+  BOOST_CHECK (stratified (sampleUnitHypercube (1024, 21, SAMPLING_SOBOL)));
+  BOOST_CHECK (stratified
+	       (sampleUnitHypercube (256, 100, SAMPLING_SOBOL, 0)));
+
+  // The two first dimensions form a (0, m, 2)-net.
+  Function::matrix_t sobol = sampleUnitHypercube (16, 2, SAMPLING_SOBOL);
+  std::vector<int> cells (16, 0);
+  for (Function::size_type i = 0; i < 16; ++i)
+    ++cells[static_cast<std::size_t> (4 * static_cast<int> (sobol (0, i) * 4.)
+				      + static_cast<int> (sobol (1, i) * 4.))];
+  for (std::size_t k = 0; k < cells.size (); ++k)
+    BOOST_CHECK_EQUAL (cells[k], 1);
+
+  BOOST_CHECK_THROW (SobolSequence (0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (multi_start)
+{
+  F f;
+  solver_t::problem_t pb (f);
+  for (std::size_t j = 0; j < 4; ++j)
+    pb.argumentBounds ()[j] = Function::makeInterval (-1., 3.);
+  pb.argumentBounds ()[3] = Function::makeInterval (2., Function::infinity ());
+
+  MultiStart<solver_t> multiStart ("dummy", pb, 8, SAMPLING_SOBOL);
+  multiStart.setClusterTolerance (1e-3);
+  multiStart.solve ();
+
+  BOOST_CHECK_EQUAL (multiStart.startingPoints ().size (), 8u);
+  BOOST_CHECK_EQUAL (multiStart.results ().size (), 8u);
+  for (std::size_t i = 0; i < 8; ++i)
+    {
+      const Function::vector_t& x = multiStart.startingPoints ()[i];
+      BOOST_CHECK (x.head (3).minCoeff () >= -1.);
+      BOOST_CHECK (x.head (3).maxCoeff () <= 3.);
+      // Infinite bound: unit-relative box around the projected zero.
+      BOOST_CHECK (x[3] >= 2. && x[3] <= 5.);
+
+      // The dummy solver always fails.
+      BOOST_CHECK_EQUAL (multiStart.results ()[i].which (),
+			 GenericSolver::SOLVER_ERROR);
+      BOOST_CHECK_EQUAL (multiStart.clusters ()[i], -1);
+    }
+  BOOST_CHECK (!multiStart.hasSolution ());
+  BOOST_CHECK (!multiStart.targetReached ());
+  BOOST_CHECK (multiStart.minima ().empty ());
+  BOOST_CHECK_THROW (multiStart.best (), std::runtime_error);
+
+  // Unknown plug-ins are reported before any start.
+  MultiStart<solver_t> invalid ("does-not-exist", pb, 2);
+  BOOST_CHECK_THROW (invalid.solve (), std::runtime_error);
+  BOOST_CHECK_THROW (MultiStart<solver_t> ("dummy", pb, 0),
+		     std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (multi_start_minima)
+{
+  DoubleWell f;
+  differentiableSolver_t::problem_t pb (f);
+  pb.argumentBounds ()[0] = Function::makeInterval (-2., 2.);
+
+  const char* plugins[] = {"lbfgsb", "projected-gradient"};
+  for (std::size_t p = 0; p < 2; ++p)
+    {
+      MultiStart<differentiableSolver_t> multiStart
+	(plugins[p], pb, 8, SAMPLING_SOBOL);
+      multiStart.parameters ()["tolerance"].value = 1e-10;
+      multiStart.setClusterTolerance (1e-3);
+      multiStart.solve ();
+
+      // Every start converges to one of the two local minima.
+      BOOST_REQUIRE (multiStart.hasSolution ());
+      BOOST_REQUIRE_EQUAL (multiStart.minima ().size (), 2u);
+      BOOST_CHECK (!multiStart.targetReached ());
+      std::size_t left = 0;
+      for (std::size_t i = 0; i < 8; ++i)
+	{
+	  const Result* result =
+	    detail::solution (multiStart.results ()[i]);
+	  BOOST_REQUIRE (result);
+	  const Function::size_type c = multiStart.clusters ()[i];
+	  BOOST_REQUIRE (c == 0 || c == 1);
+	  const Result& minimum = *detail::solution
+	    (multiStart.results ()[static_cast<std::size_t>
+				   (multiStart.minima ()
+				    [static_cast<std::size_t> (c)])]);
+	  BOOST_CHECK_SMALL (result->x[0] - minimum.x[0], 1e-3);
+	  if (c == 0)
+	    ++left;
+	}
+      BOOST_CHECK (left > 0 && left < 8);
+
+      // The best start is the global minimum, the minima are sorted
+      // by cost.
+      BOOST_CHECK_EQUAL (multiStart.bestIndex (),
+			 static_cast<std::size_t> (multiStart.minima ()[0]));
+      BOOST_CHECK_SMALL (multiStart.best ().x[0] + 1.0355787, 1e-5);
+      BOOST_CHECK_SMALL (multiStart.best ().value[0] + 0.3054285, 1e-6);
+      const Result& other = *detail::solution
+	(multiStart.results ()[static_cast<std::size_t>
+			       (multiStart.minima ()[1])]);
+      BOOST_CHECK_SMALL (other.x[0] - 0.9601496, 1e-5);
+
+      // Without clustering, each start is its own minimum.
+      multiStart.setClusterTolerance (0.);
+      multiStart.solve ();
+      BOOST_CHECK_EQUAL (multiStart.minima ().size (), 8u);
+      BOOST_CHECK_SMALL (multiStart.best ().x[0] + 1.0355787, 1e-5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (multi_start_target)
+{
+  DoubleWell f;
+  differentiableSolver_t::problem_t pb (f);
+  pb.argumentBounds ()[0] = Function::makeInterval (-2., 2.);
+
+  // The two first Sobol points (-2 and 0) are in the basin of the
+  // global minimum. The pool has one worker: at most the worker and
+  // the calling thread solve them, and the first one finishing
+  // reaches the target before any other start is dequeued. The
+  // other six starts are skipped.
+  ThreadPool pool (1);
+  MultiStart<differentiableSolver_t> multiStart
+    ("lbfgsb", pb, 8, SAMPLING_SOBOL);
+  multiStart.setSeed (0);
+  multiStart.setThreadPool (pool);
+  multiStart.setTargetCost (-.3);
+  multiStart.solve ();
+
+  BOOST_CHECK_SMALL (multiStart.startingPoints ()[0][0] + 2., 1e-12);
+  BOOST_CHECK_SMALL (multiStart.startingPoints ()[1][0], 1e-12);
+  BOOST_CHECK (multiStart.targetReached ());
+  BOOST_REQUIRE (multiStart.hasSolution ());
+  BOOST_CHECK (multiStart.best ().value[0] <= -.3);
+
+  std::size_t solved = 0;
+  for (std::size_t i = 0; i < 8; ++i)
+    if (multiStart.results ()[i].which () != GenericSolver::SOLVER_NO_SOLUTION)
+      {
+	BOOST_CHECK (i < 2);
+	++solved;
+      }
+  BOOST_CHECK (solved == 1 || solved == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
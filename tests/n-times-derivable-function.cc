@@ -32,7 +32,7 @@ struct F : public NTimesDerivableFunction<10>
   F () : NTimesDerivableFunction<10> (4, "0")
   {}
 
-  virtual void impl_compute (result_t& result, double) const throw ()
+  virtual void impl_compute (result_ref result, double) const throw ()
   {
     result.setZero ();
   }
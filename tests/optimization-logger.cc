@@ -0,0 +1,441 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <algorithm>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/binary-log.hh>
+#include <roboptim/core/io.hh>
+#include <roboptim/core/linear-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/optimization-logger.hh>
+#include <roboptim/core/solver.hh>
+
+using namespace roboptim;
+
+template <typename T>
+struct F : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  F () : GenericDifferentiableFunction<T> (2, 1, "x^2 + y^2")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = x.squaredNorm ();
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    for (size_type j = 0; j < this->inputSize (); ++j)
+      gradient.coeffRef (j) = 2. * x[j];
+  }
+};
+
+// g (x) = max (x_0 - 0.3, 0)^2, whose gradient is only stored when
+// nonzero.
+struct Kink : public DifferentiableSparseFunction
+{
+  Kink () : DifferentiableSparseFunction (2, 1, "max (x - 0.3, 0)^2")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    const value_type d = std::max (x[0] - .3, 0.);
+    result[0] = d * d;
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    if (x[0] > .3)
+      gradient.coeffRef (0) = 2. * (x[0] - .3);
+  }
+};
+
+// Halve the argument at each iteration, without giving the cost.
+template <typename T>
+class IterativeSolver
+  : public Solver<GenericDifferentiableFunction<T>,
+		  boost::mpl::vector<GenericLinearFunction<T>,
+				     GenericDifferentiableFunction<T> > >
+{
+public:
+  typedef Solver<GenericDifferentiableFunction<T>,
+		 boost::mpl::vector<GenericLinearFunction<T>,
+				    GenericDifferentiableFunction<T> > >
+  parent_t;
+  typedef typename parent_t::problem_t problem_t;
+  typedef typename parent_t::solverState_t solverState_t;
+  typedef typename parent_t::callback_t callback_t;
+
+  IterativeSolver (const problem_t& pb, int iterations) throw ()
+    : parent_t (pb),
+      iterations_ (iterations),
+      callback_ ()
+  {}
+
+  ~IterativeSolver () throw ()
+  {}
+
+  void setIterationCallback (callback_t callback) throw (std::runtime_error)
+  {
+    callback_ = callback;
+  }
+
+  void solve () throw ()
+  {
+    solverState_t state (this->problem ());
+
+    Result res (this->problem ().function ().inputSize (), 1);
+    res.x = *this->problem ().startingPoint ();
+    for (int k = 0; k < iterations_; ++k)
+      {
+	res.x *= 0.5;
+	state.x () = res.x;
+	if (callback_)
+	  callback_ (this->problem (), state);
+      }
+    this->problem ().function () (res.value, res.x);
+    this->result_ = res;
+  }
+
+private:
+  int iterations_;
+  callback_t callback_;
+};
+
+typedef IterativeSolver<EigenMatrixDense> solver_t;
+typedef OptimizationLogger<solver_t> logger_t;
+
+// Give access to the iterations kept in memory.
+class HistoryLogger : public logger_t
+{
+public:
+  HistoryLogger (solver_t& solver,
+		 const boost::filesystem::path& path,
+		 const OptimizationLoggerOptions& options)
+    : logger_t (solver, path, options)
+  {}
+
+  std::size_t historySize () const
+  {
+    return xHistory ().size ();
+  }
+};
+
+static std::string readFile (const boost::filesystem::path& path)
+{
+  boost::filesystem::ifstream stream (path);
+  std::string content ((std::istreambuf_iterator<char> (stream)),
+		       std::istreambuf_iterator<char> ());
+  return content;
+}
+
+static boost::filesystem::path iterationPath
+(const boost::filesystem::path& path, int iteration)
+{
+  return path / (boost::format ("iteration-%d") % iteration).str ();
+}
+
+static int countIterations (const boost::filesystem::path& path, int n)
+{
+  int count = 0;
+  for (int i = 0; i < n; ++i)
+    if (boost::filesystem::exists (iterationPath (path, i)))
+      ++count;
+  return count;
+}
+
+static void solve (solver_t::problem_t& pb, int iterations,
+		   const boost::filesystem::path& path,
+		   const OptimizationLoggerOptions& options,
+		   unsigned& dropped)
+{
+  solver_t solver (pb, iterations);
+  logger_t logger (solver, path, options);
+  solver.solve ();
+  logger.flush ();
+  dropped = logger.droppedIterations ();
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (optimization_logger)
+{
+  const boost::filesystem::path tmp =
+    boost::filesystem::temp_directory_path ();
+  const boost::filesystem::path syncPath =
+    tmp / "roboptim-core-optimization-logger-sync";
+  const boost::filesystem::path asyncPath =
+    tmp / "roboptim-core-optimization-logger-async";
+
+  F<EigenMatrixDense> f;
+  solver_t::problem_t pb (f);
+  Function::vector_t x0 (2);
+  x0 << 1., 2.;
+  pb.startingPoint () = x0;
+
+  NumericLinearFunction::matrix_t a (1, 2);
+  a << 1., 1.;
+  NumericLinearFunction::vector_t b (1);
+  b << -1.;
+  solver_t::problem_t::intervals_t
+    bounds (1, Function::makeUpperInterval (0.));
+  solver_t::problem_t::scales_t scales (1, 1.);
+  pb.addConstraint
+    (boost::static_pointer_cast<LinearFunction>
+     (boost::make_shared<NumericLinearFunction> (a, b)),
+     bounds, scales);
+
+  const int n = 5;
+  unsigned dropped = 0;
+
+  // Synchronous logger.
+  solve (pb, n, syncPath, OptimizationLoggerOptions (), dropped);
+  BOOST_CHECK_EQUAL (dropped, 0u);
+  BOOST_CHECK_EQUAL (countIterations (syncPath, n), n);
+  BOOST_CHECK_EQUAL (readFile (syncPath / "cost-evolution.csv"),
+		     "Cost\n1.25\n0.3125\n0.078125\n0.0195312\n0.00488281\n");
+
+  // Asynchronous logger: same logs.
+  OptimizationLoggerOptions options;
+  options.asynchronous = true;
+  options.queueSize = 2;
+  solve (pb, n, asyncPath, options, dropped);
+  BOOST_CHECK_EQUAL (dropped, 0u);
+  BOOST_CHECK_EQUAL (countIterations (asyncPath, n), n);
+
+  const char* files[] =
+    {
+      "x.csv",
+      "cost",
+      "constraint-violation",
+      "constraint-0/name",
+      "constraint-0/value.csv",
+      "constraint-0/jacobian.csv"
+    };
+  for (int i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < sizeof (files) / sizeof (files[0]); ++j)
+      BOOST_CHECK_EQUAL (readFile (iterationPath (asyncPath, i) / files[j]),
+			 readFile (iterationPath (syncPath, i) / files[j]));
+
+  const char* evolutions[] =
+    {
+      "cost-evolution.csv",
+      "constraint-violation-evolution.csv",
+      "x-evolution.csv",
+      "constraint-0-evolution.csv"
+    };
+  for (std::size_t j = 0; j < sizeof (evolutions) / sizeof (evolutions[0]);
+       ++j)
+    BOOST_CHECK_EQUAL (readFile (asyncPath / evolutions[j]),
+		       readFile (syncPath / evolutions[j]));
+
+  // Dropping: the iterations are either written or dropped.
+  const int m = 200;
+  options.queueSize = 1;
+  options.backpressure = LOGGER_DROP;
+  solve (pb, m, asyncPath, options, dropped);
+  BOOST_CHECK_EQUAL (countIterations (asyncPath, m) + dropped, m);
+
+  // Sampling: one iteration out of samplingPeriod is always written.
+  options.backpressure = LOGGER_SAMPLE;
+  options.samplingPeriod = 20;
+  solve (pb, m, asyncPath, options, dropped);
+  BOOST_CHECK_EQUAL (countIterations (asyncPath, m) + dropped, m);
+  for (int i = 0; i < m; i += options.samplingPeriod)
+    BOOST_CHECK (boost::filesystem::exists (iterationPath (asyncPath, i)));
+
+  // Binary log: same values as the CSV logs.
+  OptimizationLoggerOptions binaryOptions;
+  binaryOptions.format = LOGGER_BINARY;
+  solve (pb, n, asyncPath, binaryOptions, dropped);
+  BOOST_CHECK (!boost::filesystem::exists (iterationPath (asyncPath, 0)));
+  BOOST_CHECK (!boost::filesystem::exists (asyncPath / "cost-evolution.csv"));
+  {
+    BinaryLogReader reader ((asyncPath / "log.bin").string ());
+    BOOST_CHECK_EQUAL (reader.schema ().inputSize, 2);
+    BOOST_CHECK_EQUAL (reader.schema ().constraintsSizes.size (), 1u);
+    BOOST_CHECK_EQUAL (reader.schema ().constraintsNames[0] + "\n",
+		       readFile (iterationPath (syncPath, 0)
+				 / "constraint-0/name"));
+    BOOST_REQUIRE_EQUAL (reader.size (), static_cast<std::size_t> (n));
+
+    BinaryLogRecord record;
+    Function::vector_t x = x0;
+    for (int i = 0; i < n; ++i)
+      {
+	x *= 0.5;
+	reader.read (static_cast<std::size_t> (i), record);
+	BOOST_CHECK_EQUAL (record.iteration, static_cast<std::size_t> (i));
+	BOOST_CHECK_EQUAL (record.x, x);
+	BOOST_CHECK_EQUAL (record.cost, x.squaredNorm ());
+	BOOST_CHECK_EQUAL (record.constraints[0], x[0] + x[1] - 1.);
+	BOOST_CHECK_EQUAL (record.constraintViolation,
+			   std::max (x[0] + x[1] - 1., 0.));
+	BOOST_REQUIRE_EQUAL (record.jacobian.size (), 2u);
+	BOOST_CHECK_EQUAL (record.jacobian[1].col (), 1);
+	BOOST_CHECK_EQUAL (record.jacobian[1].value (), 1.);
+      }
+  }
+
+  // Binary log: iterations whose jacobian exceeds the capacity are
+  // reported by the next flush.
+  binaryOptions.jacobianCapacity = 1;
+  {
+    solver_t solver (pb, n);
+    logger_t logger (solver, asyncPath, binaryOptions);
+    solver.solve ();
+    BOOST_CHECK_THROW (logger.flush (), std::runtime_error);
+    BOOST_CHECK_NO_THROW (logger.flush ());
+    BOOST_CHECK_EQUAL (logger.summary ().iterations, 0u);
+  }
+  {
+    BinaryLogReader reader ((asyncPath / "log.bin").string ());
+    BOOST_CHECK_EQUAL (reader.schema ().jacobianCapacity, 1u);
+    BOOST_CHECK_EQUAL (reader.size (), 0u);
+  }
+
+  // Streaming: same whole run logs, bounded history.
+  OptimizationLoggerOptions streamingOptions;
+  streamingOptions.streaming = true;
+  streamingOptions.flushPeriod = 2;
+  streamingOptions.historySize = 2;
+  {
+    solver_t solver (pb, n);
+    HistoryLogger logger (solver, asyncPath, streamingOptions);
+    solver.solve ();
+    logger.flush ();
+    BOOST_CHECK_EQUAL (logger.historySize (), 2u);
+
+    // The whole run logs are complete before the logger is destroyed.
+    for (std::size_t j = 0; j < sizeof (evolutions) / sizeof (evolutions[0]);
+	 ++j)
+      BOOST_CHECK_EQUAL (readFile (asyncPath / evolutions[j]),
+			 readFile (syncPath / evolutions[j]));
+
+    const OptimizationLoggerSummary& summary = logger.summary ();
+    BOOST_CHECK_EQUAL (summary.iterations, static_cast<std::size_t> (n));
+    BOOST_CHECK_EQUAL (summary.lastIteration, static_cast<std::size_t> (n - 1));
+    BOOST_CHECK_EQUAL (summary.bestIteration, static_cast<std::size_t> (n - 1));
+    BOOST_CHECK_EQUAL (summary.lastCost, summary.bestCost);
+    BOOST_CHECK_EQUAL (summary.lastCost, (x0 / 32.).squaredNorm ());
+    BOOST_CHECK_EQUAL (summary.lastConstraintViolation, 0.);
+  }
+  for (std::size_t j = 0; j < sizeof (evolutions) / sizeof (evolutions[0]);
+       ++j)
+    BOOST_CHECK_EQUAL (readFile (asyncPath / evolutions[j]),
+		       readFile (syncPath / evolutions[j]));
+
+  boost::filesystem::remove_all (syncPath);
+  boost::filesystem::remove_all (asyncPath);
+}
+
+
+BOOST_AUTO_TEST_CASE (optimization_logger_sparse_jacobian)
+{
+  typedef IterativeSolver<EigenMatrixSparse> sparseSolver_t;
+  typedef sparseSolver_t::problem_t problem_t;
+  typedef GenericNumericLinearFunction<EigenMatrixSparse> numericLinear_t;
+
+  const boost::filesystem::path path =
+    boost::filesystem::temp_directory_path ()
+    / "roboptim-core-optimization-logger-sparse";
+
+  F<EigenMatrixSparse> f;
+  problem_t pb (f);
+  Function::vector_t x0 (2);
+  x0 << 1., 2.;
+  pb.startingPoint () = x0;
+
+  // Constant pattern.
+  numericLinear_t::matrix_t a (2, 2);
+  a.insert (0, 0) = 1.;
+  a.insert (1, 1) = 2.;
+  numericLinear_t::vector_t b (2);
+  b.setZero ();
+  pb.addConstraint
+    (boost::static_pointer_cast<LinearSparseFunction>
+     (boost::make_shared<numericLinear_t> (a, b)),
+     problem_t::intervals_t (2, Function::makeUpperInterval (1.)),
+     problem_t::scales_t (2, 1.));
+
+  // Pattern changing after the first iteration.
+  pb.addConstraint
+    (boost::static_pointer_cast<DifferentiableSparseFunction>
+     (boost::make_shared<Kink> ()),
+     problem_t::intervals_t (1, Function::makeUpperInterval (1.)),
+     problem_t::scales_t (1, 1.));
+
+  {
+    sparseSolver_t solver (pb, 3);
+    OptimizationLogger<sparseSolver_t> logger (solver, path);
+    solver.solve ();
+  }
+
+  const boost::filesystem::path constraint0 = "constraint-0";
+  const boost::filesystem::path constraint1 = "constraint-1";
+
+  // Constant pattern: written once.
+  BOOST_CHECK_EQUAL
+    (readFile (iterationPath (path, 0) / constraint0 / "jacobian-pattern.csv"),
+     "Row, Column\n0, 0\n1, 1\n");
+  for (int i = 0; i < 3; ++i)
+    {
+      BOOST_CHECK_EQUAL
+	(readFile (iterationPath (path, i) / constraint0
+		   / "jacobian-values.csv"), "1, 2\n");
+      BOOST_CHECK (!boost::filesystem::exists
+		   (iterationPath (path, i) / constraint0 / "jacobian.csv"));
+    }
+  BOOST_CHECK (!boost::filesystem::exists
+	       (iterationPath (path, 1) / constraint0
+		/ "jacobian-pattern.csv"));
+
+  // Changing pattern: written again when it changes.
+  BOOST_CHECK_EQUAL
+    (readFile (iterationPath (path, 0) / constraint1 / "jacobian-pattern.csv"),
+     "Row, Column\n0, 0\n");
+  BOOST_CHECK_EQUAL
+    (readFile (iterationPath (path, 0) / constraint1 / "jacobian-values.csv"),
+     "0.4\n");
+  BOOST_CHECK_EQUAL
+    (readFile (iterationPath (path, 1) / constraint1 / "jacobian-pattern.csv"),
+     "Row, Column\n");
+  BOOST_CHECK_EQUAL
+    (readFile (iterationPath (path, 1) / constraint1 / "jacobian-values.csv"),
+     "\n");
+  BOOST_CHECK (!boost::filesystem::exists
+	       (iterationPath (path, 2) / constraint1
+		/ "jacobian-pattern.csv"));
+
+  boost::filesystem::remove_all (path);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
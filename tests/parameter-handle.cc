@@ -0,0 +1,144 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <string>
+
+#include <boost/format.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/solver.hh>
+#include <roboptim/core/solver-state.hh>
+
+using namespace roboptim;
+
+typedef Solver<Function, boost::mpl::vector<Function> > parent_solver_t;
+
+struct F : public Function
+{
+  F () : Function (2, 1, "x + y")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x) const throw ()
+  {
+    result[0] = x.sum ();
+  }
+};
+
+class HandleSolver : public parent_solver_t
+{
+public:
+  typedef parent_solver_t parent_t;
+
+  explicit HandleSolver (const problem_t& pb) throw ()
+    : parent_t (pb),
+      maxIterations_ ()
+  {
+    // Register the parameter once, then use the handle.
+    maxIterations_ = registerParameter ("max-iterations",
+					"maximum number of iterations", 10);
+  }
+
+  ~HandleSolver () throw ()
+  {}
+
+  void solve () throw ()
+  {
+    solverState_t state (problem ());
+    ParameterHandle<int, StateParameter<Function> > iteration =
+      state.registerParameter ("iteration", "current iteration", 0);
+
+    Result res (2, 1);
+    res.x.setZero ();
+    for (*iteration = 0; *iteration < *maxIterations_; ++*iteration)
+      res.x[0] += 1.;
+    problem ().function () (res.value, res.x);
+    result_ = res;
+  }
+
+private:
+  ParameterHandle<int, Parameter> maxIterations_;
+};
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (parameter_handle)
+{
+  F f;
+  HandleSolver::problem_t pb (f);
+  HandleSolver solver (pb);
+
+  // Handles and string lookups see the same value.
+  ParameterHandle<int, Parameter> maxIterations =
+    solver.parameterHandle<int> ("max-iterations");
+  BOOST_CHECK (maxIterations.valid ());
+  BOOST_CHECK_EQUAL (*maxIterations, 10);
+  BOOST_CHECK_EQUAL (maxIterations.parameter ().description,
+		     "maximum number of iterations");
+
+  *maxIterations = 3;
+  BOOST_CHECK_EQUAL (solver.getParameter<int> ("max-iterations"), 3);
+  BOOST_CHECK_EQUAL (boost::get<Result> (solver.minimum ()).x[0], 3.);
+
+  solver.parameters ()["max-iterations"].value = 5;
+  BOOST_CHECK_EQUAL (*maxIterations, 5);
+
+  // Other parameters do not invalidate the handle.
+  solver.registerParameter ("name", "solver name", std::string ("handle"));
+  for (int i = 0; i < 100; ++i)
+    solver.parameters ()[boost::str (boost::format ("p%d") % i)].value = i;
+  BOOST_CHECK_EQUAL (*maxIterations, 5);
+  BOOST_CHECK_EQUAL (*solver.parameterHandle<std::string> ("name"),
+		     "handle");
+
+  // String literals are stored as strings.
+  ParameterHandle<std::string, Parameter> method =
+    solver.registerParameter ("method", "solver method", "newton");
+  BOOST_CHECK_EQUAL (*method, "newton");
+  BOOST_CHECK_EQUAL (solver.getParameter<std::string> ("method"), "newton");
+
+  // Unknown key, wrong type.
+  BOOST_CHECK_THROW (solver.parameterHandle<int> ("unknown"),
+		     std::out_of_range);
+  BOOST_CHECK_THROW (solver.parameterHandle<double> ("max-iterations"),
+		     boost::bad_get);
+  typedef ParameterHandle<int, Parameter> intHandle_t;
+  BOOST_CHECK (!intHandle_t ().valid ());
+
+  // Solver state handles.
+  SolverState<HandleSolver::problem_t> state (pb);
+  ParameterHandle<bool, StateParameter<Function> > converged =
+    state.registerParameter ("converged", "whether the solver converged",
+			     false);
+  *converged = true;
+  BOOST_CHECK (state.getParameter<bool> ("converged"));
+  ParameterHandle<std::string, StateParameter<Function> > message =
+    state.registerParameter ("message", "solver message", "running");
+  BOOST_CHECK_EQUAL (*message, "running");
+  BOOST_CHECK_EQUAL (state.getParameter<std::string> ("message"), "running");
+  ParameterHandle<Function::vector_t, StateParameter<Function> > direction =
+    state.registerParameter ("direction", "search direction",
+			     Function::vector_t (Function::vector_t::Ones (2)));
+  direction->setZero ();
+  BOOST_CHECK_EQUAL (state.getParameter<Function::vector_t> ("direction"),
+		     Function::vector_t::Zero (2));
+  BOOST_CHECK_THROW (state.parameterHandle<int> ("converged"),
+		     boost::bad_get);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,89 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/plugin-registry.hh>
+#include <roboptim/core/solver-factory.hh>
+
+using namespace roboptim;
+
+typedef Solver<Function, boost::mpl::vector<Function> > solver_t;
+
+struct F : public Function
+{
+  F () : Function (4, 1, "a * d * (a + b + c) + d")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& argument)
+    const throw ()
+  {
+    result (0) = argument[0] * argument[3]
+      * (argument[0] + argument[1] + argument[2]) + argument[3];
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (plugin_registry)
+{
+  PluginRegistry& registry = PluginRegistry::instance ();
+
+  F f;
+  solver_t::problem_t pb (f);
+
+  BOOST_CHECK (!registry.isLoaded ("dummy"));
+
+  {
+    SolverFactory<solver_t> factory1 ("dummy", pb);
+    BOOST_CHECK (registry.isLoaded ("dummy"));
+    BOOST_CHECK_EQUAL (registry.references ("dummy"), 1u);
+
+    // The second factory reuses the loaded plug-in.
+    SolverFactory<solver_t> factory2 ("dummy", pb);
+    BOOST_CHECK_EQUAL (registry.references ("dummy"), 2u);
+
+    factory1 ().solve ();
+    factory2 ().solve ();
+  }
+
+  // The last factory unloads the plug-in.
+  BOOST_CHECK (!registry.isLoaded ("dummy"));
+  BOOST_CHECK_EQUAL (registry.references ("dummy"), 0u);
+
+  // Preloaded plug-ins stay loaded without references.
+  registry.preload ("dummy");
+  BOOST_CHECK (registry.isLoaded ("dummy"));
+  {
+    SolverFactory<solver_t> factory ("dummy", pb);
+    BOOST_CHECK_EQUAL (registry.references ("dummy"), 1u);
+  }
+  BOOST_CHECK (registry.isLoaded ("dummy"));
+  BOOST_CHECK_EQUAL (registry.references ("dummy"), 0u);
+
+  registry.unload ("dummy");
+  BOOST_CHECK (!registry.isLoaded ("dummy"));
+
+  // Invalid plug-ins are not kept.
+  BOOST_CHECK_THROW (SolverFactory<solver_t> ("does-not-exist", pb),
+		     std::runtime_error);
+  BOOST_CHECK (!registry.isLoaded ("does-not-exist"));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
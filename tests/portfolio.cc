@@ -0,0 +1,204 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/linear-function.hh>
+#include <roboptim/core/portfolio.hh>
+#include <roboptim/core/result-with-warnings.hh>
+
+using namespace roboptim;
+
+typedef Solver<Function, boost::mpl::vector<Function> > solver_t;
+typedef Solver<DifferentiableFunction,
+	       boost::mpl::vector<LinearFunction, DifferentiableFunction> >
+differentiableSolver_t;
+
+struct F : public Function
+{
+  F () : Function (4, 1, "a * d * (a + b + c) + d")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& argument)
+    const throw ()
+  {
+    result (0) = argument[0] * argument[3]
+      * (argument[0] + argument[1] + argument[2]) + argument[3];
+  }
+};
+
+// Rosenbrock function, made slow so that the race lasts long enough
+// for the losing solver to be stopped.
+struct Rosenbrock : public DifferentiableFunction
+{
+  Rosenbrock () : DifferentiableFunction (2, 1, "Rosenbrock")
+  {}
+
+  void impl_compute (result_ref result, const argument_t& x)
+    const throw ()
+  {
+    boost::this_thread::sleep (boost::posix_time::microseconds (100));
+    result[0] = (1. - x[0]) * (1. - x[0])
+      + 100. * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]);
+  }
+
+  void impl_gradient (gradient_t& gradient, const argument_t& x,
+		      size_type) const throw ()
+  {
+    gradient[0] = -2. * (1. - x[0])
+      - 400. * x[0] * (x[1] - x[0] * x[0]);
+    gradient[1] = 200. * (x[1] - x[0] * x[0]);
+  }
+};
+
+static bool nearMinimum (const Result& result)
+{
+  return result.value[0] < 1e-8;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (portfolio)
+{
+  F f;
+  solver_t::problem_t pb (f);
+
+  Portfolio<solver_t> portfolio (pb);
+  BOOST_CHECK_THROW (portfolio.solve (), std::runtime_error);
+
+  solver_t::parameters_t parameters;
+  parameters["dummy-parameter"].value = 1.;
+  BOOST_CHECK_EQUAL (portfolio.add ("dummy"), 0u);
+  BOOST_CHECK_EQUAL (portfolio.add ("dummy-laststate", parameters,
+				    "last state"), 1u);
+  BOOST_CHECK_EQUAL (portfolio.size (), 2u);
+  BOOST_CHECK_EQUAL (portfolio.name (0), "dummy");
+  BOOST_CHECK_EQUAL (portfolio.name (1), "last state");
+  BOOST_CHECK_THROW (portfolio.name (2), std::runtime_error);
+  BOOST_CHECK_THROW (portfolio.add ("does-not-exist"), std::runtime_error);
+
+  // The plug-ins stay loaded while the portfolio exists.
+  BOOST_CHECK (PluginRegistry::instance ().isLoaded ("dummy"));
+
+  // The dummy solvers always fail: no winner, the first result
+  // returned is given back.
+  for (std::size_t k = 1; k <= 3; ++k)
+    {
+      const Portfolio<solver_t>::result_t& result = portfolio.solve ();
+      BOOST_CHECK_EQUAL (result.which (), GenericSolver::SOLVER_ERROR);
+      BOOST_CHECK (!portfolio.hasWinner ());
+      BOOST_CHECK_THROW (portfolio.winner (), std::runtime_error);
+
+      const std::vector<Portfolio<solver_t>::result_t>& results =
+	portfolio.results ();
+      BOOST_CHECK_EQUAL (results.size (), 2u);
+      BOOST_CHECK_EQUAL (results[0].which (), GenericSolver::SOLVER_ERROR);
+      BOOST_CHECK_EQUAL (results[1].which (), GenericSolver::SOLVER_ERROR);
+
+      for (std::size_t i = 0; i < portfolio.size (); ++i)
+	{
+	  Portfolio<solver_t>::Statistics statistics =
+	    portfolio.statistics (i);
+	  BOOST_CHECK_EQUAL (statistics.runs, k);
+	  BOOST_CHECK_EQUAL (statistics.failures, k);
+	  BOOST_CHECK_EQUAL (statistics.wins, 0u);
+	  BOOST_CHECK_EQUAL (statistics.solutions, 0u);
+	  BOOST_CHECK (statistics.minTime <= statistics.meanTime ());
+	  BOOST_CHECK (statistics.meanTime () <= statistics.maxTime);
+	}
+    }
+
+  // The dummy solver with last state keeps its result.
+  const SolverError& error =
+    boost::get<SolverError> (portfolio.results ()[1]);
+  BOOST_CHECK (error.lastState ());
+
+  std::vector<std::size_t> ranking = portfolio.ranking ();
+  BOOST_CHECK_EQUAL (ranking.size (), 2u);
+  BOOST_CHECK (ranking[0] != ranking[1]);
+}
+
+BOOST_AUTO_TEST_CASE (portfolio_race)
+{
+  Rosenbrock f;
+  differentiableSolver_t::problem_t pb (f);
+  Function::vector_t x0 (2);
+  x0 << -1.2, 1.;
+  pb.startingPoint () = x0;
+
+  // L-BFGS-B reaches the minimum in a few dozens of iterations,
+  // while the projected gradient crawls along the valley.
+  Portfolio<differentiableSolver_t> portfolio (pb);
+  differentiableSolver_t::parameters_t fast;
+  fast["tolerance"].value = 1e-10;
+  differentiableSolver_t::parameters_t slow;
+  slow["tolerance"].value = 0.;
+  slow["max-iterations"].value = 100000000;
+  BOOST_CHECK_EQUAL (portfolio.add ("projected-gradient", slow), 0u);
+  BOOST_CHECK_EQUAL (portfolio.add ("lbfgsb", fast), 1u);
+  portfolio.setAcceptance (&nearMinimum);
+
+  for (std::size_t k = 1; k <= 2; ++k)
+    {
+      const Portfolio<differentiableSolver_t>::result_t& result =
+	portfolio.solve ();
+      BOOST_REQUIRE (portfolio.hasWinner ());
+      BOOST_CHECK_EQUAL (portfolio.winner (), 1u);
+      const Result* solution = detail::solution (result);
+      BOOST_REQUIRE (solution);
+      BOOST_CHECK_SMALL (solution->x[0] - 1., 1e-3);
+      BOOST_CHECK_SMALL (solution->x[1] - 1., 1e-3);
+
+      // The loser observed the stop request.
+      const std::vector<Portfolio<differentiableSolver_t>::result_t>&
+	results = portfolio.results ();
+      BOOST_REQUIRE_EQUAL (results[0].which (),
+			   GenericSolver::SOLVER_VALUE_WARNINGS);
+      const ResultWithWarnings& stopped =
+	boost::get<ResultWithWarnings> (results[0]);
+      BOOST_REQUIRE_EQUAL (stopped.warnings.size (), 1u);
+      BOOST_CHECK_EQUAL (std::string (stopped.warnings[0].what ()),
+			 "stopped by the iteration callback");
+
+      Portfolio<differentiableSolver_t>::Statistics winner =
+	portfolio.statistics (1);
+      BOOST_CHECK_EQUAL (winner.runs, k);
+      BOOST_CHECK_EQUAL (winner.wins, k);
+      BOOST_CHECK_EQUAL (winner.solutions, k);
+      BOOST_CHECK_EQUAL (winner.failures, 0u);
+      BOOST_CHECK_EQUAL (winner.cancellations, 0u);
+
+      Portfolio<differentiableSolver_t>::Statistics loser =
+	portfolio.statistics (0);
+      BOOST_CHECK_EQUAL (loser.runs, k);
+      BOOST_CHECK_EQUAL (loser.wins, 0u);
+      BOOST_CHECK_EQUAL (loser.solutions, 0u);
+      BOOST_CHECK_EQUAL (loser.cancellations, k);
+    }
+
+  // The winner ranks first.
+  BOOST_CHECK_EQUAL (portfolio.ranking ()[0], 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,196 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/variant/get.hpp>
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/test/test_case_template.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/presolve.hh>
+#include <roboptim/core/problem.hh>
+
+using namespace roboptim;
+
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+namespace
+{
+  /// \brief f(x) = x0 x2 + x1
+  template <typename T>
+  struct Bilinear : public GenericDifferentiableFunction<T>
+  {
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericDifferentiableFunction<T>);
+
+    Bilinear () : GenericDifferentiableFunction<T> (3, 1, "bilinear")
+    {}
+
+    void impl_compute (result_ref result, const argument_t& x) const throw ()
+    {
+      result[0] = x[0] * x[2] + x[1];
+    }
+
+    void impl_gradient (gradient_t& gradient, const argument_t& x,
+			size_type) const throw ()
+    {
+      gradient.coeffRef (0) = x[2];
+      gradient.coeffRef (1) = 1.;
+      gradient.coeffRef (2) = x[0];
+    }
+  };
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (presolve_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef GenericLinearFunction<T> linearFunction_t;
+  typedef GenericNumericLinearFunction<T> numericLinearFunction_t;
+  typedef Problem<differentiableFunction_t,
+		  boost::mpl::vector<linearFunction_t,
+				     differentiableFunction_t> > problem_t;
+  typedef typename numericLinearFunction_t::matrix_t matrix_t;
+  typedef typename problem_t::vector_t vector_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scales_t scales_t;
+
+  Eigen::MatrixXd c (1, 3);
+  c << 1., 2., 3.;
+  vector_t zero1 (1);
+  zero1.setZero ();
+  numericLinearFunction_t cost (matrix_t (c.sparseView ()), zero1);
+
+  problem_t pb (cost);
+  pb.argumentBounds ()[0] = Function::makeInterval (0., 1.);
+  pb.argumentBounds ()[1] = Function::makeInterval (2., 2.);
+  pb.argumentBounds ()[2] = Function::makeInterval (0., 1.);
+  vector_t x0 (3);
+  x0 << .5, 2., .5;
+  pb.startingPoint () = x0;
+
+  // Two rows: x0 + x2 in [1, 1.5] and x1 in [0, 5] (implied).
+  Eigen::MatrixXd a1 (2, 3);
+  a1 << 1., 0., 1.,
+    0., 1., 0.;
+  vector_t b1 (2);
+  b1.setZero ();
+  intervals_t bounds1;
+  bounds1.push_back (Function::makeInterval (1., 1.5));
+  bounds1.push_back (Function::makeInterval (0., 5.));
+  pb.addConstraint
+    (boost::static_pointer_cast<linearFunction_t>
+     (boost::make_shared<numericLinearFunction_t>
+      (matrix_t (a1.sparseView ()), b1)),
+     bounds1, scales_t (2, 1.));
+
+  // Duplicate of the first row: x0 + x2 in [.5, 1.2].
+  Eigen::MatrixXd a2 (1, 3);
+  a2 << 1., 0., 1.;
+  pb.addConstraint
+    (boost::static_pointer_cast<linearFunction_t>
+     (boost::make_shared<numericLinearFunction_t>
+      (matrix_t (a2.sparseView ()), zero1)),
+     Function::makeInterval (.5, 1.2));
+
+  // Implied by the bounds: x0 + x1 in [-10, 10].
+  Eigen::MatrixXd a3 (1, 3);
+  a3 << 1., 1., 0.;
+  pb.addConstraint
+    (boost::static_pointer_cast<linearFunction_t>
+     (boost::make_shared<numericLinearFunction_t>
+      (matrix_t (a3.sparseView ()), zero1)),
+     Function::makeInterval (-10., 10.));
+
+  // Non-linear constraint.
+  pb.addConstraint
+    (boost::static_pointer_cast<differentiableFunction_t>
+     (boost::make_shared<Bilinear<T> > ()),
+     Function::makeInterval (0., 3.));
+
+  Presolve<problem_t> presolve (pb);
+  const problem_t& reduced = presolve.problem ();
+
+  BOOST_CHECK_EQUAL (presolve.fixedIndices ().size (), 1u);
+  BOOST_CHECK_EQUAL (presolve.fixedIndices ()[0], 1);
+  BOOST_CHECK_EQUAL (reduced.function ().inputSize (), 2);
+  BOOST_CHECK_EQUAL (reduced.argumentBounds ()[1].second, 1.);
+  BOOST_CHECK_EQUAL ((*reduced.startingPoint ())[1], .5);
+
+  // One linear row and the non-linear constraint remain.
+  BOOST_CHECK_EQUAL (reduced.constraints ().size (), 2u);
+  BOOST_CHECK_EQUAL (reduced.constraintsOutputSize (), 2);
+  BOOST_CHECK_EQUAL (presolve.removedRows (), 3);
+  BOOST_CHECK_EQUAL (presolve.rows ().size (), 5u);
+  BOOST_CHECK_EQUAL (presolve.rows ()[0], 0);
+  BOOST_CHECK_EQUAL (presolve.rows ()[1], -1);
+  BOOST_CHECK_EQUAL (presolve.rows ()[2], -1);
+  BOOST_CHECK_EQUAL (presolve.rows ()[3], -1);
+  BOOST_CHECK_EQUAL (presolve.rows ()[4], 1);
+
+  // Merged bounds.
+  BOOST_CHECK_EQUAL (reduced.constraintsLowerBounds ()[0], 1.);
+  BOOST_CHECK_EQUAL (reduced.constraintsUpperBounds ()[0], 1.2);
+
+  // Reduced functions match the original ones on the lifted argument.
+  vector_t y (2);
+  y << .5, .25;
+  const vector_t x = presolve.liftArgument (y);
+  BOOST_CHECK_EQUAL (x[1], 2.);
+  BOOST_CHECK_CLOSE (reduced.function () (y)[0], cost (x)[0], 1e-8);
+
+  boost::shared_ptr<linearFunction_t> linear =
+    boost::get<boost::shared_ptr<linearFunction_t> >
+    (reduced.constraints ()[0]);
+  BOOST_CHECK_CLOSE ((*linear) (y)[0], .75, 1e-8);
+
+  boost::shared_ptr<differentiableFunction_t> bilinear =
+    boost::get<boost::shared_ptr<differentiableFunction_t> >
+    (reduced.constraints ()[1]);
+  BOOST_CHECK_CLOSE ((*bilinear) (y)[0], 2.125, 1e-8);
+  BOOST_CHECK_CLOSE (bilinear->gradient (y, 0).coeff (1), .5, 1e-8);
+
+  // Lift a result.
+  Result result (2, 1);
+  result.x = y;
+  result.value = reduced.function () (y);
+  result.lambda.resize (2);
+  result.lambda << 3., 4.;
+
+  Result lifted = presolve.liftResult (result);
+  BOOST_CHECK_EQUAL (lifted.x.size (), 3);
+  BOOST_CHECK_EQUAL (lifted.lambda.size (), 5);
+  BOOST_CHECK_EQUAL (lifted.lambda[0], 3.);
+  BOOST_CHECK_EQUAL (lifted.lambda[2], 0.);
+  BOOST_CHECK_EQUAL (lifted.lambda[4], 4.);
+  BOOST_CHECK_EQUAL (lifted.constraints.size (), 5);
+  BOOST_CHECK_CLOSE (lifted.constraints[1], 2., 1e-8);
+  BOOST_CHECK_CLOSE (lifted.constraints[4], 2.125, 1e-8);
+
+  BOOST_CHECK_THROW (presolve.liftArgument (x), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -17,11 +17,13 @@
 
 #include "shared-tests/fixture.hh"
 
+#include <boost/make_shared.hpp>
 #include <boost/mpl/vector.hpp>
 
 #include <roboptim/core/io.hh>
 #include <roboptim/core/function/constant.hh>
 #include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 #include <roboptim/core/problem.hh>
 
 using namespace roboptim;
@@ -60,4 +62,61 @@ BOOST_AUTO_TEST_CASE (problem_copy_constructor)
   }
 }
 
+BOOST_AUTO_TEST_CASE (problem_flat_bounds)
+{
+  typedef Problem<DifferentiableFunction,
+		  boost::mpl::vector<DifferentiableFunction> > problem_t;
+
+  ConstantFunction::vector_t v (1);
+  v.setZero ();
+  ConstantFunction f (v);
+
+  problem_t pb (f);
+  BOOST_CHECK_EQUAL (pb.constraintsOutputSize (), 0);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ().size (), 0);
+
+  pb.addConstraint
+    (boost::make_shared<ConstantFunction> (v),
+     Function::makeInterval (-1., 2.), 0.5);
+
+  NumericLinearFunction::matrix_t a (2, 1);
+  a.setZero ();
+  NumericLinearFunction::vector_t b (2);
+  b.setZero ();
+  problem_t::intervals_t bounds;
+  bounds.push_back (Function::makeLowerInterval (3.));
+  bounds.push_back (Function::makeUpperInterval (4.));
+  problem_t::scales_t scales (2, 2.);
+  pb.addConstraint
+    (boost::make_shared<NumericLinearFunction> (a, b), bounds, scales);
+
+  BOOST_CHECK_EQUAL (pb.constraintsOutputSize (), 3);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ()[0], -1.);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ()[1], 3.);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ()[2], -Function::infinity ());
+  BOOST_CHECK_EQUAL (pb.constraintsUpperBounds ()[0], 2.);
+  BOOST_CHECK_EQUAL (pb.constraintsUpperBounds ()[1], Function::infinity ());
+  BOOST_CHECK_EQUAL (pb.constraintsUpperBounds ()[2], 4.);
+  BOOST_CHECK_EQUAL (pb.constraintsScales ()[0], 0.5);
+  BOOST_CHECK_EQUAL (pb.constraintsScales ()[2], 2.);
+
+  // Argument views follow the interval vector.
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds ().size (), 1);
+  pb.argumentBounds ()[0] = Function::makeInterval (-5., 6.);
+  pb.argumentScales ()[0] = 3.;
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds ()[0], -5.);
+  BOOST_CHECK_EQUAL (pb.argumentUpperBounds ()[0], 6.);
+  BOOST_CHECK_EQUAL (pb.argumentScalesMap ()[0], 3.);
+
+  // Bounds modified through a kept reference are seen by new views.
+  problem_t::intervals_t& argumentBounds = pb.argumentBounds ();
+  argumentBounds[0].first = -7.;
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds ()[0], -7.);
+  BOOST_CHECK_EQUAL (pb.argumentUpperBounds ()[0], 6.);
+
+  // Copies carry the stacked bounds.
+  problem_t copy (pb);
+  BOOST_CHECK (copy.constraintsUpperBounds () == pb.constraintsUpperBounds ());
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -29,7 +29,7 @@ struct Null : public QuadraticFunction
   Null () : QuadraticFunction (1, 1, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -52,7 +52,7 @@ struct NoTitle : public QuadraticFunction
   NoTitle () : QuadraticFunction (1, 1)
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
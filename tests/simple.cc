@@ -35,7 +35,7 @@ struct F : public Function
   F () : Function (4, 1, "a * d * (a + b + c) + d")
   {}
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result (0) = argument[0] * argument[3]
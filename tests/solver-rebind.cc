@@ -0,0 +1,189 @@
+// Copyright (C) 2009 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <roboptim/core/function/constant.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/solver.hh>
+
+using namespace roboptim;
+
+typedef Solver<DifferentiableFunction,
+	       boost::mpl::vector<LinearFunction, DifferentiableFunction> >
+parent_solver_t;
+
+// Solver returning its starting point, clamped to the argument bounds.
+class RebindSolver : public parent_solver_t
+{
+public:
+  typedef parent_solver_t parent_t;
+
+  explicit RebindSolver (const problem_t& pb) throw ()
+    : parent_t (pb),
+      rebinds (0),
+      warmStarts (0),
+      solves (0)
+  {}
+
+  ~RebindSolver () throw ()
+  {}
+
+  void solve () throw ()
+  {
+    ++solves;
+
+    Result res (problem ().function ().inputSize (),
+		problem ().function ().outputSize ());
+    res.x = *problem ().startingPoint ();
+    for (std::size_t i = 0; i < problem ().argumentBounds ().size (); ++i)
+      {
+	const Function::interval_t& b = problem ().argumentBounds ()[i];
+	Function::vector_t::Index j = static_cast<Function::vector_t::Index> (i);
+	res.x[j] = std::min (std::max (res.x[j], b.first), b.second);
+      }
+    problem ().function () (res.value, res.x);
+    res.lambda.resize (problem ().constraintsOutputSize ());
+    res.lambda.setConstant (static_cast<double> (solves));
+    result_ = res;
+  }
+
+  int rebinds;
+  int warmStarts;
+  int solves;
+
+protected:
+  void impl_rebind () throw ()
+  {
+    ++rebinds;
+  }
+
+  void impl_warmStart (const Result&) throw ()
+  {
+    ++warmStarts;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (solver_rebind)
+{
+  Function::vector_t a (2);
+  a << 1., 1.;
+  ConstantFunction cost (a);
+
+  Function::matrix_t A (1, 2);
+  A << 1., -1.;
+  Function::vector_t b (1);
+  b << 0.;
+  boost::shared_ptr<LinearFunction> g =
+    boost::make_shared<NumericLinearFunction> (A, b);
+
+  RebindSolver::problem_t pb (cost);
+  pb.addConstraint (g, Function::makeInterval (-1., 1.));
+  pb.argumentBounds ()[0] = Function::makeInterval (-2., 2.);
+  Function::vector_t x0 (2);
+  x0 << 0., 0.;
+  pb.startingPoint () = x0;
+
+  RebindSolver solver (pb);
+  BOOST_CHECK (!solver.hasWarmStart ());
+  Result res0 = solver.getMinimum<Result> ();
+  BOOST_CHECK_EQUAL (solver.solves, 1);
+
+  // The result is cached until the problem is rebound.
+  solver.minimum ();
+  BOOST_CHECK_EQUAL (solver.solves, 1);
+
+  // Rebind a new starting point.
+  Function::vector_t x1 (2);
+  x1 << 3., 0.5;
+  solver.setStartingPoint (x1);
+  BOOST_CHECK_EQUAL (solver.rebinds, 1);
+  Result res1 = solver.getMinimum<Result> ();
+  BOOST_CHECK_EQUAL (solver.solves, 2);
+  BOOST_CHECK_EQUAL (res1.x[0], 2.);
+  BOOST_CHECK_EQUAL (res1.x[1], 0.5);
+
+  // Rebind the argument and constraint bounds.
+  RebindSolver::intervals_t bounds = pb.argumentBounds ();
+  bounds[0] = Function::makeInterval (-1., 1.);
+  solver.setArgumentBounds (bounds);
+  BOOST_CHECK_EQUAL (solver.getMinimum<Result> ().x[0], 1.);
+
+  RebindSolver::intervals_t cBounds (1, Function::makeInterval (-2., 3.));
+  solver.setConstraintBounds (0, cBounds);
+  BOOST_CHECK_EQUAL (solver.problem ().boundsVector ()[0][0].second, 3.);
+  BOOST_CHECK_EQUAL (solver.problem ().constraintsUpperBounds ()[0], 3.);
+  BOOST_CHECK_EQUAL (solver.rebinds, 3);
+
+  BOOST_CHECK_THROW (solver.setConstraintBounds (1, cBounds),
+		     std::runtime_error);
+  BOOST_CHECK_THROW (solver.setStartingPoint (Function::vector_t (3)),
+		     std::runtime_error);
+
+  // Warm start from the last result.
+  Result last = solver.getMinimum<Result> ();
+  solver.warmStart (last);
+  BOOST_CHECK (solver.hasWarmStart ());
+  BOOST_CHECK_EQUAL (solver.warmStarts, 1);
+  BOOST_CHECK_EQUAL (*solver.problem ().startingPoint (), last.x);
+  BOOST_CHECK_EQUAL (solver.warmStartMultipliers (), last.lambda);
+  solver.clearWarmStart ();
+  BOOST_CHECK (!solver.hasWarmStart ());
+
+  // Rebind a whole problem sharing the same functions.
+  RebindSolver::problem_t pb2 (pb);
+  pb2.argumentBounds ()[1] = Function::makeInterval (0., 0.25);
+  pb2.setConstraintBounds (0, RebindSolver::intervals_t
+			   (1, Function::makeInterval (-0.5, 0.5)));
+  solver.rebind (pb2);
+  BOOST_CHECK_EQUAL (solver.problem ().argumentBounds ()[0].second, 2.);
+  BOOST_CHECK_EQUAL (solver.problem ().argumentBounds ()[1].second, 0.25);
+  BOOST_CHECK_EQUAL (solver.problem ().constraintsUpperBounds ()[0], 0.5);
+  BOOST_CHECK_EQUAL (*solver.problem ().startingPoint (), x0);
+
+  // Problems with other functions can not be rebound.
+  ConstantFunction otherCost (a);
+  RebindSolver::problem_t pb3 (otherCost);
+  BOOST_CHECK_THROW (solver.rebind (pb3), std::runtime_error);
+
+  RebindSolver::problem_t pb4 (cost);
+  boost::shared_ptr<LinearFunction> otherG =
+    boost::make_shared<NumericLinearFunction> (A, b);
+  pb4.addConstraint (otherG, Function::makeInterval (-1., 1.));
+  BOOST_CHECK_THROW (solver.rebind (pb4), std::runtime_error);
+
+  // A failed rebind leaves the problem untouched.
+  RebindSolver::problem_t pb5 (cost);
+  pb5.addConstraint (g, Function::makeInterval (-1., 1.));
+  pb5.addConstraint (g, Function::makeInterval (-1., 1.));
+  RebindSolver solver5 (pb5);
+
+  RebindSolver::problem_t pb6 (cost);
+  pb6.addConstraint (g, Function::makeInterval (-4., 4.));
+  pb6.addConstraint (otherG, Function::makeInterval (-1., 1.));
+  BOOST_CHECK_THROW (solver5.rebind (pb6), std::runtime_error);
+  BOOST_CHECK_EQUAL (solver5.problem ().boundsVector ()[0][0].second, 1.);
+  BOOST_CHECK_EQUAL (solver5.problem ().constraintsUpperBounds ()[0], 1.);
+  BOOST_CHECK_EQUAL (solver5.rebinds, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -30,22 +30,36 @@ using namespace roboptim;
 
 struct F : public DifferentiableFunction
 {
-  F () : DifferentiableFunction (1, 10, "f_n (x) = n * x")
+  F () : DifferentiableFunction (1, 10, "f_n (x) = n * x"),
+	 evaluations (0),
+	 factor_ (1.)
   {}
 
-  void impl_compute (result_t& res, const argument_t& argument) const throw ()
+  void setFactor (value_type factor)
   {
+    factor_ = factor;
+    touch ();
+  }
+
+  void impl_compute (result_ref res, const argument_t& argument) const throw ()
+  {
+    ++evaluations;
     res.setZero ();
     for (size_type i = 0; i < outputSize (); ++i)
-      res[i] = (value_type)i * argument[0];
+      res[i] = factor_ * (value_type)i * argument[0];
   }
 
   void impl_gradient (gradient_t& grad, const argument_t&,
 		      size_type functionId) const throw ()
   {
     grad.setZero ();
-    grad[0] = (value_type)functionId;
+    grad[0] = factor_ * (value_type)functionId;
   }
+
+  mutable int evaluations;
+
+private:
+  value_type factor_;
 };
 
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
@@ -80,4 +94,51 @@ BOOST_AUTO_TEST_CASE (split)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE (split_all)
+{
+  boost::shared_ptr<F> f (new F ());
+
+  std::vector<boost::shared_ptr<Split<DifferentiableFunction> > >
+    splits = splitAll (boost::shared_ptr<const DifferentiableFunction> (f));
+  BOOST_CHECK_EQUAL (splits.size (), 10u);
+
+  Function::vector_t x (1);
+  for (double i = 0.; i < 10.; i += 0.5)
+    {
+      x[0] = i;
+      f->evaluations = 0;
+      for (std::size_t id = 0; id < splits.size (); ++id)
+	{
+	  BOOST_CHECK_EQUAL ((*splits[id]) (x)[0], (double)id * i);
+	  BOOST_CHECK_EQUAL (splits[id]->gradient (x)[0], (double)id);
+	}
+      // All the splits share a single evaluation.
+      BOOST_CHECK_EQUAL (f->evaluations, 1);
+    }
+
+  // An invalidated buffer evaluates the function again.
+  f->evaluations = 0;
+  splits[0]->buffer ()->invalidate ();
+  (*splits[1]) (x);
+  (*splits[2]) (x);
+  BOOST_CHECK_EQUAL (f->evaluations, 1);
+
+  // Changing the function evaluates it again without invalidating
+  // the buffer.
+  f->evaluations = 0;
+  f->setFactor (2.);
+  BOOST_CHECK_EQUAL ((*splits[1]) (x)[0], 2. * x[0]);
+  BOOST_CHECK_EQUAL ((*splits[2]) (x)[0], 4. * x[0]);
+  BOOST_CHECK_EQUAL (f->evaluations, 1);
+  f->setFactor (1.);
+
+  // A standalone split is not cached.
+  Split<DifferentiableFunction> single (f, 3);
+  BOOST_CHECK (!single.buffer ());
+  f->evaluations = 0;
+  BOOST_CHECK_EQUAL (single (x)[0], 3. * x[0]);
+  BOOST_CHECK_EQUAL (single (x)[0], 3. * x[0]);
+  BOOST_CHECK_EQUAL (f->evaluations, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
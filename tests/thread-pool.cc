@@ -0,0 +1,116 @@
+// Copyright (C) 2014 by Thomas Moulard, AIST, CNRS, INRIA.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <roboptim/core/thread-pool.hh>
+
+using namespace roboptim;
+
+namespace
+{
+  // Record the task, fail on the given index.
+  void task (std::vector<int>& done, std::size_t failing, std::size_t i)
+  {
+    done[i] = 1;
+    if (i == failing)
+      throw std::logic_error ("task failed");
+  }
+
+  void unknownError (std::size_t)
+  {
+    throw 42;
+  }
+
+  // Record the thread running the task.
+  void slowTask (std::vector<boost::thread::id>& threads, std::size_t i)
+  {
+    threads[i] = boost::this_thread::get_id ();
+    boost::this_thread::sleep (boost::posix_time::milliseconds (20));
+  }
+
+  void runBatch (ThreadPool& pool, std::vector<boost::thread::id>& threads)
+  {
+    pool.run (threads.size (),
+	      boost::bind (&slowTask, boost::ref (threads), _1));
+  }
+} // end of anonymous namespace.
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (thread_pool)
+{
+  ThreadPool pool (2);
+  BOOST_CHECK_EQUAL (pool.size (), 2u);
+
+  for (std::size_t n = 0; n < 5; ++n)
+    {
+      std::vector<int> done (n, 0);
+      pool.run (n, boost::bind (&task, boost::ref (done), n, _1));
+      BOOST_CHECK (std::find (done.begin (), done.end (), 0) == done.end ());
+    }
+
+  // Errors are reported as std::runtime_error once the whole batch
+  // is done, including when the task runs in the calling thread.
+  for (std::size_t n = 1; n < 5; ++n)
+    {
+      std::vector<int> done (n, 0);
+      try
+	{
+	  pool.run (n, boost::bind (&task, boost::ref (done), n - 1, _1));
+	  BOOST_ERROR ("no error reported");
+	}
+      catch (const std::runtime_error& e)
+	{
+	  BOOST_CHECK_EQUAL (std::string (e.what ()), "task failed");
+	}
+      BOOST_CHECK (std::find (done.begin (), done.end (), 0) == done.end ());
+    }
+
+  BOOST_CHECK_THROW (pool.run (1, &unknownError), std::runtime_error);
+  BOOST_CHECK_THROW (pool.run (3, &unknownError), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (thread_pool_batch_isolation)
+{
+  ThreadPool pool (1);
+
+  // Queue a long batch from another thread.
+  std::vector<boost::thread::id> other (8);
+  boost::thread thread (boost::bind (&runBatch, boost::ref (pool),
+				     boost::ref (other)));
+  boost::this_thread::sleep (boost::posix_time::milliseconds (5));
+
+  // While waiting for its own batch, this thread must not run the
+  // tasks of the other batch.
+  std::vector<boost::thread::id> mine (2);
+  runBatch (pool, mine);
+  thread.join ();
+
+  BOOST_CHECK (std::find (other.begin (), other.end (),
+			  boost::this_thread::get_id ()) == other.end ());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
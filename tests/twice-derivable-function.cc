@@ -30,7 +30,7 @@ struct Null : public TwiceDifferentiableFunction
   Null () : TwiceDifferentiableFunction (1, 1, "null function")
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
@@ -53,7 +53,7 @@ struct NoTitle : public TwiceDifferentiableFunction
   NoTitle () : TwiceDifferentiableFunction (1, 1)
   {}
 
-  void impl_compute (result_t& res, const argument_t&) const throw ()
+  void impl_compute (result_ref res, const argument_t&) const throw ()
   {
     res.setZero ();
   }
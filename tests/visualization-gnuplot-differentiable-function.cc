@@ -37,7 +37,7 @@ struct FortyTwoDense : public DifferentiableFunction
   {
   }
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result[0] = argument[0] + argument[4] + argument[5];
@@ -54,7 +54,7 @@ struct FortyTwoDense : public DifferentiableFunction
   {
   }
 
-  void impl_jacobian (jacobian_t& jac, const argument_t&)
+  void impl_jacobian (jacobian_ref jac, const argument_t&)
     const throw ()
   {
     jac.setZero();
@@ -91,7 +91,7 @@ struct FortyTwoSparse : public DifferentiableSparseFunction
   {
   }
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result[0] = argument[0] + argument[4] + argument[5];
@@ -108,7 +108,7 @@ struct FortyTwoSparse : public DifferentiableSparseFunction
   {
   }
 
-  void impl_jacobian (jacobian_t& jac, const argument_t&)
+  void impl_jacobian (jacobian_ref jac, const argument_t&)
     const throw ()
   {
     jac.setZero();
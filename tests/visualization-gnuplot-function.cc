@@ -37,7 +37,7 @@ struct Square : public Function
   {
   }
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result[0] = argument[0] * argument[0];
@@ -53,7 +53,7 @@ struct Circle : public Function
   {
   }
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
 		     const argument_t& argument) const throw ()
   {
     result[0] = sin (argument[0]) * r_;
@@ -71,7 +71,7 @@ struct Poly : public Function
   {
   }
 
-  void impl_compute (result_t& result,
+  void impl_compute (result_ref result,
                      const argument_t& argument) const throw ()
   {
     result[0] = argument[0] * argument[0] * argument[0];